@@ -183,9 +183,12 @@ android {
     //    - Los modelos ya están optimizados y no comprimen bien
     //    - Ahorro típico: <5% vs costo de rendimiento significativo
     //
+    // 4. El índice nutricional (.nvni) también se mapea con mmap desde el APK
+    //    (nutrition_index.cpp); comprimido habría que inflarlo a heap
+    //
     // noCompress: Lista de extensiones que NO deben comprimirse
     aaptOptions {
-        noCompress += listOf("tflite", "lite")
+        noCompress += listOf("tflite", "lite", "nvni")
     }
 
     // ─────────────────────────────────────────────────────────────────────────────
@@ -314,6 +317,16 @@ dependencies {
     // implementation("androidx.camera:camera-core:1.3.0")
 }
 
+// ═══════════════════════════════════════════════════════════════════════════════
+// SECCIÓN 5: ÍNDICE NUTRICIONAL
+// ═══════════════════════════════════════════════════════════════════════════════
+// Genera assets/data/nutrition_index.nvni (tabla binaria por classId) desde los
+// JSON de nutrición antes de empaquetar los assets de Flutter. Corre sola en
+// cada build (preBuild y compileFlutterBuild*) y queda UP-TO-DATE mientras no
+// cambien sus entradas; a mano: ./gradlew :app:generateNutritionIndex
+
+apply(from = "nutrition_index.gradle.kts")
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // NOTAS TÉCNICAS ADICIONALES
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,316 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                        nutrition_index.gradle.kts                             ║
+// ║          Generación del índice nutricional binario (.nvni) en el build        ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Convierte nutrition_fdc.json + standard_portions.json a filas de layout      ║
+// ║  fijo por classId de labels.txt. La app lo mapea con mmap (dart:ffi) en vez   ║
+// ║  de parsear JSON al arrancar. Layout: android/app/src/main/cpp/               ║
+// ║  nutrition_index.h (cualquier cambio sube FORMAT_VERSION en ambos lados).     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import groovy.json.JsonSlurper
+import java.io.ByteArrayOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TAREA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Entradas y salida declaradas: Gradle la marca UP-TO-DATE mientras no
+ * cambien los JSON, labels.txt ni el .nvni, aunque cuelgue de cada build.
+ */
+abstract class GenerateNutritionIndexTask : DefaultTask() {
+
+    companion object {
+        const val MAGIC = 0x494E564E          // "NVNI"
+        const val FORMAT_VERSION = 1
+
+        const val HEADER_SIZE = 80
+        const val ROW_SIZE = 64
+        const val PORTION_SIZE = 20
+        const val COMPONENT_SIZE = 16
+
+        const val KIND_INGREDIENT = 0
+        const val KIND_DISH = 1
+        const val KIND_MISSING = 2
+
+        const val STATUS_FOUND = 0
+        const val STATUS_LOW_SCORE = 1
+        const val STATUS_NOT_FOUND = 2
+
+        const val COMPONENT_FLAG_MISSING = 1
+
+        val NUTRIENT_KEYS = listOf(
+            "energy_kcal", "protein_g", "fat_g", "carbohydrates_g", "fiber_g", "sugars_g"
+        )
+    }
+
+    @get:InputFile
+    @get:PathSensitive(PathSensitivity.RELATIVE)
+    abstract val nutritionJson: RegularFileProperty
+
+    @get:InputFile
+    @get:PathSensitive(PathSensitivity.RELATIVE)
+    abstract val portionsJson: RegularFileProperty
+
+    @get:InputFile
+    @get:PathSensitive(PathSensitivity.RELATIVE)
+    abstract val labelsFile: RegularFileProperty
+
+    @get:OutputFile
+    abstract val outputFile: RegularFileProperty
+
+    /** Pool de strings UTF-8 deduplicado; referencias (offset, length). */
+    private class StringPool {
+        val bytes = ByteArrayOutputStream()
+        private val refs = HashMap<String, Pair<Int, Int>>()
+
+        fun add(value: String?): Pair<Int, Int> {
+            if (value.isNullOrEmpty()) return 0 to 0
+            return refs.getOrPut(value) {
+                val encoded = value.toByteArray(Charsets.UTF_8)
+                val offset = bytes.size()
+                bytes.write(encoded)
+                offset to encoded.size
+            }
+        }
+    }
+
+    private class Portion(val grams: Float, val name: Pair<Int, Int>, val description: Pair<Int, Int>)
+
+    private class Component(val label: Pair<Int, Int>, val percent: Float, val flags: Int)
+
+    private class Row(
+        val nutrients: FloatArray,
+        val matchScore: Float,
+        val fdcId: Int,
+        val kind: Int,
+        val status: Int,
+        val portionFirst: Int,
+        val portionCount: Int,
+        val componentFirst: Int,
+        val componentCount: Int,
+        val label: Pair<Int, Int>,
+        val description: Pair<Int, Int>,
+    )
+
+    @TaskAction
+    fun generate() {
+        val labels = labelsFile.get().asFile.readLines(Charsets.UTF_8)
+            .map { it.trim() }
+            .filter { it.isNotEmpty() }
+
+        @Suppress("UNCHECKED_CAST")
+        val nutrition = JsonSlurper().parse(nutritionJson.get().asFile, "UTF-8") as Map<String, Any?>
+        @Suppress("UNCHECKED_CAST")
+        val metadata = nutrition["metadata"] as? Map<String, Any?> ?: emptyMap()
+        @Suppress("UNCHECKED_CAST")
+        val foods = nutrition["foods"] as? Map<String, Map<String, Any?>> ?: emptyMap()
+        @Suppress("UNCHECKED_CAST")
+        val portionsByLabel =
+            JsonSlurper().parse(portionsJson.get().asFile, "UTF-8") as Map<String, List<Map<String, Any?>>>
+
+        // Las filas se indexan por classId: todo tiene que existir en labels.txt
+        val classIds = labels.withIndex().associate { (index, label) -> label to index }
+        for ((label, food) in foods) {
+            val classId = classIds[label]
+                ?: throw GradleException("nutrition_fdc.json: '$label' no está en labels.txt")
+            val declared = (food["class_id"] as? Number)?.toInt()
+            if (declared != null && declared != classId) {
+                throw GradleException(
+                    "nutrition_fdc.json: '$label' tiene class_id $declared y labels.txt $classId"
+                )
+            }
+        }
+        portionsByLabel.keys.firstOrNull { it !in classIds }?.let {
+            throw GradleException("standard_portions.json: '$it' no está en labels.txt")
+        }
+
+        val strings = StringPool()
+        val rows = ArrayList<Row>(labels.size)
+        val portions = ArrayList<Portion>()
+        val components = ArrayList<Component>()
+
+        for (label in labels) {
+            val food = foods[label]
+            val isDish = food?.get("type") == "dish"
+
+            @Suppress("UNCHECKED_CAST")
+            val nutrients = food?.get("nutrients_per_100g") as? Map<String, Any?> ?: emptyMap()
+            val values = FloatArray(NUTRIENT_KEYS.size) { i ->
+                (nutrients[NUTRIENT_KEYS[i]] as? Number)?.toFloat() ?: 0f
+            }
+
+            val portionFirst = portions.size
+            for (portion in portionsByLabel[label].orEmpty()) {
+                portions += Portion(
+                    grams = (portion["grams"] as Number).toFloat(),
+                    name = strings.add(portion["name"] as String),
+                    description = strings.add(portion["description"] as? String),
+                )
+            }
+
+            // Componentes del plato; los faltantes sin porcentaje llevan NaN
+            val componentFirst = components.size
+            if (isDish) {
+                @Suppress("UNCHECKED_CAST")
+                val percents = food?.get("components") as? Map<String, Any?> ?: emptyMap()
+                @Suppress("UNCHECKED_CAST")
+                val missing = (food?.get("missing_components") as? List<String>).orEmpty().toSet()
+                for ((component, percent) in percents) {
+                    components += Component(
+                        label = strings.add(component),
+                        percent = (percent as Number).toFloat(),
+                        flags = if (component in missing) COMPONENT_FLAG_MISSING else 0,
+                    )
+                }
+                for (component in missing - percents.keys) {
+                    components += Component(strings.add(component), Float.NaN, COMPONENT_FLAG_MISSING)
+                }
+            }
+
+            val status = when {
+                food == null -> STATUS_NOT_FOUND
+                isDish -> STATUS_FOUND
+                food["status"] == "found" -> STATUS_FOUND
+                food["status"] == "low_score" -> STATUS_LOW_SCORE
+                else -> STATUS_NOT_FOUND
+            }
+
+            rows += Row(
+                nutrients = values,
+                matchScore = if (isDish) 100f else (food?.get("match_score") as? Number)?.toFloat() ?: 0f,
+                fdcId = if (isDish) -1 else (food?.get("fdc_id") as? Number)?.toInt() ?: -1,
+                kind = when {
+                    food == null -> KIND_MISSING
+                    isDish -> KIND_DISH
+                    else -> KIND_INGREDIENT
+                },
+                status = status,
+                portionFirst = portionFirst,
+                portionCount = portions.size - portionFirst,
+                componentFirst = componentFirst,
+                componentCount = components.size - componentFirst,
+                label = strings.add(label),
+                description = if (isDish) 0 to 0 else strings.add(food?.get("fdc_description") as? String),
+            )
+        }
+
+        val schemaVersion = strings.add(nutrition["schema_version"] as? String)
+        val source = strings.add(metadata["source"] as? String)
+        val apiUrl = strings.add(metadata["api_url"] as? String)
+        val generatedAt = strings.add(metadata["generated_at"] as? String)
+
+        // Orden por bytes UTF-8 (sin signo) y luego longitud: el de memcmp nativo
+        val encodedLabels = labels.map { it.toByteArray(Charsets.UTF_8) }
+        val labelOrder = labels.indices.sortedWith { a, b ->
+            val x = encodedLabels[a]
+            val y = encodedLabels[b]
+            var cmp = 0
+            for (i in 0 until minOf(x.size, y.size)) {
+                cmp = (x[i].toInt() and 0xFF) - (y[i].toInt() and 0xFF)
+                if (cmp != 0) break
+            }
+            if (cmp != 0) cmp else x.size - y.size
+        }
+
+        val rowsOffset = HEADER_SIZE
+        val labelOrderOffset = rowsOffset + rows.size * ROW_SIZE
+        val portionsOffset = labelOrderOffset + rows.size * 4
+        val componentsOffset = portionsOffset + portions.size * PORTION_SIZE
+        val stringsOffset = componentsOffset + components.size * COMPONENT_SIZE
+        val stringBytes = strings.bytes.toByteArray()
+        val fileSize = stringsOffset + (stringBytes.size + 3) / 4 * 4
+
+        val out = ByteBuffer.allocate(fileSize).order(ByteOrder.LITTLE_ENDIAN)
+        fun putRef(ref: Pair<Int, Int>) {
+            out.putInt(ref.first)
+            out.putInt(ref.second)
+        }
+
+        out.putInt(MAGIC)
+        out.putInt(FORMAT_VERSION)
+        out.putInt(fileSize)
+        out.putInt(rows.size)
+        out.putInt(rowsOffset)
+        out.putInt(labelOrderOffset)
+        out.putInt(portions.size)
+        out.putInt(portionsOffset)
+        out.putInt(components.size)
+        out.putInt(componentsOffset)
+        out.putInt(stringsOffset)
+        out.putInt(stringBytes.size)
+        putRef(schemaVersion)
+        putRef(source)
+        putRef(apiUrl)
+        putRef(generatedAt)
+
+        for (row in rows) {
+            row.nutrients.forEach { out.putFloat(it) }
+            out.putFloat(row.matchScore)
+            out.putInt(row.fdcId)
+            out.put(row.kind.toByte())
+            out.put(row.status.toByte())
+            out.putShort(row.portionCount.toShort())
+            out.putShort(row.componentCount.toShort())
+            out.putShort(0)
+            out.putInt(row.portionFirst)
+            out.putInt(row.componentFirst)
+            putRef(row.label)
+            putRef(row.description)
+        }
+        labelOrder.forEach { out.putInt(it) }
+        for (portion in portions) {
+            out.putFloat(portion.grams)
+            putRef(portion.name)
+            putRef(portion.description)
+        }
+        for (component in components) {
+            putRef(component.label)
+            out.putFloat(component.percent)
+            out.putInt(component.flags)
+        }
+        out.put(stringBytes)
+
+        // Mismo contenido (p. ej. tras un clean): no se reescribe, así el asset
+        // conserva su fecha y el empaquetado de Flutter no se invalida
+        val file = outputFile.get().asFile
+        val bytes = out.array()
+        if (file.isFile && file.readBytes().contentEquals(bytes)) {
+            logger.info("Índice nutricional sin cambios: ${file.name}")
+            return
+        }
+        file.parentFile.mkdirs()
+        file.writeBytes(bytes)
+        logger.lifecycle(
+            "Índice nutricional: ${rows.size} clases, ${portions.size} porciones, " +
+                "$fileSize bytes → ${file.name}"
+        )
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGISTRO
+// ═══════════════════════════════════════════════════════════════════════════════
+// El índice se escribe en assets/data/ (declarado en pubspec.yaml) antes de
+// que el plugin de Flutter empaquete los assets, así que corre sola antes de
+// preBuild y de cada compileFlutterBuild*. Está en .gitignore: sin build de
+// Android (flutter test) la app vuelve a los JSON.
+
+val flutterProjectDir = file("../..")
+
+val generateNutritionIndex = tasks.register<GenerateNutritionIndexTask>("generateNutritionIndex") {
+    group = "build"
+    description = "Genera assets/data/nutrition_index.nvni desde los JSON de nutrición"
+    nutritionJson.set(flutterProjectDir.resolve("assets/data/nutrition_fdc.json"))
+    portionsJson.set(flutterProjectDir.resolve("assets/data/standard_portions.json"))
+    labelsFile.set(flutterProjectDir.resolve("assets/labels/labels.txt"))
+    outputFile.set(flutterProjectDir.resolve("assets/data/nutrition_index.nvni"))
+}
+
+tasks.named("preBuild") { dependsOn(generateNutritionIndex) }
+tasks.matching { it.name.startsWith("compileFlutterBuild") }.configureEach {
+    dependsOn(generateNutritionIndex)
+}
@@ -0,0 +1,441 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           nutrivision_bench.cpp                               ║
+// ║              Benchmark de los kernels nativos (ejecutable adb shell)          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Mide cada kernel sobre frames sintéticos con las resoluciones y layouts de   ║
+// ║  CameraX. Emite JSON Lines (una línea por caso) para comparar entre SoCs.     ║
+// ║  Uso: nutrivision_bench [--iterations=N] [--warmup=N] [--threads=N]           ║
+// ║                         [--rotations=0,90] [--filter=texto]                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
+#include "thread_pool.h"
+#include "yolo_decoder.h"
+#include "yuv_preprocess.h"
+#include "yuv_to_rgb.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONFIGURACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Lado del tensor de entrada del modelo (yolo_service.dart).
+constexpr int kModelInputSize = 640;
+
+/// Salida del modelo: 4 bbox + 83 clases × 8400 predicciones.
+constexpr int kModelClasses = 83;
+constexpr int kModelPredictions = 8400;
+
+struct Resolution {
+    int width;
+    int height;
+};
+
+constexpr Resolution kResolutions[] = {
+    {640, 480},
+    {1280, 720},
+    {1920, 1080},
+    {4032, 3024},
+};
+
+/**
+ * Disposición de planos tal como la entrega CameraX.
+ */
+struct FrameLayout {
+    const char* name;
+    int uvPixelStride;  // 1 planar (I420), 2 semi-planar (NV21)
+    bool padded;        // rowStride mayor que el ancho
+};
+
+constexpr FrameLayout kLayouts[] = {
+    {"i420", 1, false},
+    {"nv21", 2, false},
+    {"nv21_padded", 2, true},
+};
+
+struct Options {
+    int iterations = 30;
+    int warmup = 3;
+    int threads = 0;  // <= 0: valor por defecto del pool
+    std::vector<int> rotations = {0, 90};
+    std::string filter;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FRAMES SINTÉTICOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Frame YUV420 con el layout indicado. En NV21 U y V apuntan al mismo
+ * buffer entrelazado (V primero), como los planos de ImageProxy.
+ */
+struct Frame {
+    int width;
+    int height;
+    int yRowStride;
+    int uvRowStride;
+    int uvPixelStride;
+    std::vector<uint8_t> yData;
+    std::vector<uint8_t> uData;
+    std::vector<uint8_t> vData;
+    const uint8_t* y;
+    const uint8_t* u;
+    const uint8_t* v;
+
+    /// Bytes de entrada efectivos (Y + U + V), base de los MB/s.
+    double inputBytes() const { return width * static_cast<double>(height) * 1.5; }
+};
+
+/**
+ * Generador determinista: mismos datos en todas las ejecuciones y SoCs.
+ */
+struct Lcg {
+    uint32_t state;
+
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    float unit() { return static_cast<float>(next() & 0xFFFF) / 65535.0f; }
+};
+
+void fillRandom(std::vector<uint8_t>& data, Lcg& rng) {
+    for (uint8_t& byte : data) byte = static_cast<uint8_t>(rng.next());
+}
+
+Frame makeFrame(Resolution resolution, const FrameLayout& layout) {
+    Frame frame{};
+    frame.width = resolution.width;
+    frame.height = resolution.height;
+    frame.uvPixelStride = layout.uvPixelStride;
+
+    // Relleno típico de HAL: alineado a 64 bytes más una línea de caché
+    const int chromaWidth = (frame.width + 1) / 2;
+    const int chromaHeight = (frame.height + 1) / 2;
+    const int padding = layout.padded ? 64 + (64 - frame.width % 64) % 64 : 0;
+    frame.yRowStride = frame.width + padding;
+    frame.uvRowStride = layout.uvPixelStride == 2
+        ? frame.width + padding
+        : chromaWidth + padding / 2;
+
+    Lcg rng{static_cast<uint32_t>(frame.width * 31 + frame.height)};
+    frame.yData.resize(static_cast<size_t>(frame.yRowStride) * frame.height);
+    fillRandom(frame.yData, rng);
+
+    if (layout.uvPixelStride == 2) {
+        frame.vData.resize(static_cast<size_t>(frame.uvRowStride) * chromaHeight);
+        fillRandom(frame.vData, rng);
+        frame.v = frame.vData.data();
+        frame.u = frame.vData.data() + 1;
+    } else {
+        frame.uData.resize(static_cast<size_t>(frame.uvRowStride) * chromaHeight);
+        frame.vData.resize(static_cast<size_t>(frame.uvRowStride) * chromaHeight);
+        fillRandom(frame.uData, rng);
+        fillRandom(frame.vData, rng);
+        frame.u = frame.uData.data();
+        frame.v = frame.vData.data();
+    }
+    frame.y = frame.yData.data();
+    return frame;
+}
+
+/**
+ * Salida YOLO sintética: predicciones de fondo con score bajo y grupos de
+ * cajas solapadas alrededor de unos pocos objetos, para ejercitar el NMS.
+ */
+std::vector<float> makeYoloOutput() {
+    const int rows = 4 + kModelClasses;
+    std::vector<float> output(static_cast<size_t>(rows) * kModelPredictions);
+    Lcg rng{87};
+
+    for (int row = 4; row < rows; row++) {
+        float* scores = output.data() + static_cast<size_t>(row) * kModelPredictions;
+        for (int i = 0; i < kModelPredictions; i++) scores[i] = rng.unit() * 0.1f;
+    }
+
+    constexpr int kObjects = 12;
+    for (int i = 0; i < kModelPredictions; i++) {
+        const int object = static_cast<int>(rng.next() % kObjects);
+        const float cx = (object % 4 + 0.5f) / 4.0f + (rng.unit() - 0.5f) * 0.02f;
+        const float cy = (object / 4 + 0.5f) / 3.0f + (rng.unit() - 0.5f) * 0.02f;
+        output[0 * kModelPredictions + i] = cx;
+        output[1 * kModelPredictions + i] = cy;
+        output[2 * kModelPredictions + i] = 0.15f + rng.unit() * 0.05f;
+        output[3 * kModelPredictions + i] = 0.15f + rng.unit() * 0.05f;
+
+        // ~3 % de predicciones sobre el umbral
+        if (rng.next() % 32 == 0) {
+            const int classId = object * 7 % kModelClasses;
+            output[static_cast<size_t>(4 + classId) * kModelPredictions + i] =
+                0.3f + rng.unit() * 0.65f;
+        }
+    }
+    return output;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEDICIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+struct Stats {
+    int64_t minNs;
+    int64_t medianNs;
+    int64_t p99Ns;
+};
+
+int64_t nowNs() {
+    // steady_clock es CLOCK_MONOTONIC en bionic y glibc
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Stats measure(const Options& options, const std::function<void()>& body) {
+    for (int i = 0; i < options.warmup; i++) body();
+
+    std::vector<int64_t> samples(std::max(options.iterations, 1));
+    for (int64_t& sample : samples) {
+        const int64_t start = nowNs();
+        body();
+        sample = nowNs() - start;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const size_t count = samples.size();
+    const size_t p99Index = std::min(count - 1, (count * 99 + 99) / 100 - 1);
+    return {samples.front(), samples[count / 2], samples[p99Index]};
+}
+
+/**
+ * Caso de benchmark: un kernel sobre un frame con una rotación.
+ */
+struct BenchCase {
+    const char* kernel;
+    const char* layout;
+    int width;
+    int height;
+    int rotation;
+    int threads;
+    double bytes;
+};
+
+void printResult(const BenchCase& benchCase, const Stats& stats) {
+    const double seconds = static_cast<double>(stats.medianNs) * 1e-9;
+    const double megabytesPerSecond = seconds > 0 ? benchCase.bytes / seconds / 1e6 : 0.0;
+
+    std::printf(
+        "{\"type\":\"result\",\"kernel\":\"%s\",\"layout\":\"%s\","
+        "\"width\":%d,\"height\":%d,\"rotation\":%d,\"threads\":%d,"
+        "\"min_ns\":%lld,\"median_ns\":%lld,\"p99_ns\":%lld,\"mb_per_s\":%.1f}\n",
+        benchCase.kernel, benchCase.layout, benchCase.width, benchCase.height,
+        benchCase.rotation, benchCase.threads,
+        static_cast<long long>(stats.minNs), static_cast<long long>(stats.medianNs),
+        static_cast<long long>(stats.p99Ns), megabytesPerSecond);
+    std::fflush(stdout);
+}
+
+bool selected(const Options& options, const char* kernel) {
+    return options.filter.empty() || std::strstr(kernel, options.filter.c_str());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// KERNELS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+using ConvertFn = void (*)(
+    const uint8_t*, const uint8_t*, const uint8_t*, uint8_t*,
+    int, int, int, int, int, int, bool);
+
+/**
+ * Versiones de conversión directas (un hilo), solo las que la CPU soporta.
+ */
+struct DirectKernel {
+    const char* name;
+    ConvertFn fn;
+};
+
+std::vector<DirectKernel> directKernels() {
+    std::vector<DirectKernel> kernels = {{"convert_scalar", convertYuv420ToRgbScalar}};
+    const uint32_t features = cpuFeatures();
+    (void)features;
+
+#if defined(__aarch64__) || defined(__arm__)
+    if (features & kCpuNeon) kernels.push_back({"convert_neon", convertYuv420ToRgbNeon});
+#endif
+#if defined(__x86_64__)
+    if (features & kCpuSse41) kernels.push_back({"convert_sse41", convertYuv420ToRgbSse41});
+    if (features & kCpuAvx2) kernels.push_back({"convert_avx2", convertYuv420ToRgbAvx2});
+#endif
+    return kernels;
+}
+
+void benchFrame(const Options& options, const Frame& frame, const char* layout,
+                int rotation) {
+    const int threads = ThreadPool::shared().threadCount();
+    const bool rotated = rotation == 90 || rotation == 270;
+    const int dstWidth = rotated ? frame.height : frame.width;
+    const int dstHeight = rotated ? frame.width : frame.height;
+
+    std::vector<uint8_t> rgb(static_cast<size_t>(frame.width) * frame.height * 3);
+    const BenchCase base{"", layout, frame.width, frame.height, rotation, threads,
+                         frame.inputBytes()};
+
+    // Conversión completa con el kernel instalado y el pool de hilos
+    if (selected(options, "convert")) {
+        BenchCase benchCase = base;
+        benchCase.kernel = "convert";
+        printResult(benchCase, measure(options, [&] {
+            convertYuv420ToRgb(frame.y, frame.u, frame.v, rgb.data(),
+                               frame.width, frame.height, frame.yRowStride,
+                               frame.uvRowStride, frame.uvPixelStride, rotation, false);
+        }));
+    }
+
+    for (const DirectKernel& kernel : directKernels()) {
+        if (!selected(options, kernel.name)) continue;
+        BenchCase benchCase = base;
+        benchCase.kernel = kernel.name;
+        benchCase.threads = 1;
+        printResult(benchCase, measure(options, [&] {
+            kernel.fn(frame.y, frame.u, frame.v, rgb.data(),
+                      frame.width, frame.height, frame.yRowStride,
+                      frame.uvRowStride, frame.uvPixelStride, rotation, false);
+        }));
+    }
+
+    // Conversión con reducción a la zona útil del tensor (modo en vivo)
+    if (selected(options, "convert_scaled")) {
+        const LetterboxParams letterbox =
+            computeLetterbox(dstWidth, dstHeight, kModelInputSize);
+        BenchCase benchCase = base;
+        benchCase.kernel = "convert_scaled";
+        printResult(benchCase, measure(options, [&] {
+            convertYuv420ToRgbScaled(frame.y, frame.u, frame.v,
+                                     frame.width, frame.height, frame.yRowStride,
+                                     frame.uvRowStride, frame.uvPixelStride,
+                                     rotation, false, letterbox.newWidth,
+                                     letterbox.newHeight, rgb.data());
+        }));
+    }
+
+    if (selected(options, "preprocess_tensor")) {
+        std::vector<float> tensor(static_cast<size_t>(kModelInputSize) * kModelInputSize * 3);
+        BenchCase benchCase = base;
+        benchCase.kernel = "preprocess_tensor";
+        printResult(benchCase, measure(options, [&] {
+            preprocessYuv420ToTensor(frame.y, frame.u, frame.v,
+                                     frame.width, frame.height, frame.yRowStride,
+                                     frame.uvRowStride, frame.uvPixelStride,
+                                     rotation, false, kModelInputSize, tensor.data());
+        }));
+    }
+}
+
+void benchDecoder(const Options& options) {
+    if (!selected(options, "decode_yolo")) return;
+
+    const std::vector<float> output = makeYoloOutput();
+    std::vector<float> detections(100 * kDetectionStride);
+
+    YoloDecodeParams params{};
+    params.numClasses = kModelClasses;
+    params.numPredictions = kModelPredictions;
+    params.inputSize = kModelInputSize;
+    params.confidenceThreshold = 0.25f;
+    params.iouThreshold = 0.45f;
+    params.scale = 1.0;
+    params.imageWidth = kModelInputSize;
+    params.imageHeight = kModelInputSize;
+
+    const BenchCase benchCase{"decode_yolo", "-", kModelInputSize, kModelInputSize, 0, 1,
+                              static_cast<double>(output.size() * sizeof(float))};
+    printResult(benchCase, measure(options, [&] {
+        decodeYoloOutput(output.data(), params, detections.data(), 100);
+    }));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ARGUMENTOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool parseArgument(const char* argument, const char* name, const char** value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(argument, name, length) != 0 || argument[length] != '=') return false;
+    *value = argument + length + 1;
+    return true;
+}
+
+std::vector<int> parseList(const char* value) {
+    std::vector<int> result;
+    const char* cursor = value;
+    while (*cursor) {
+        char* end = nullptr;
+        result.push_back(static_cast<int>(std::strtol(cursor, &end, 10)));
+        if (end == cursor) break;
+        cursor = *end == ',' ? end + 1 : end;
+    }
+    return result;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* value = nullptr;
+        if (parseArgument(argv[i], "--iterations", &value)) {
+            options.iterations = std::max(std::atoi(value), 1);
+        } else if (parseArgument(argv[i], "--warmup", &value)) {
+            options.warmup = std::max(std::atoi(value), 0);
+        } else if (parseArgument(argv[i], "--threads", &value)) {
+            options.threads = std::atoi(value);
+        } else if (parseArgument(argv[i], "--rotations", &value)) {
+            options.rotations = parseList(value);
+        } else if (parseArgument(argv[i], "--filter", &value)) {
+            options.filter = value;
+        } else {
+            std::fprintf(stderr,
+                         "Uso: %s [--iterations=N] [--warmup=N] [--threads=N] "
+                         "[--rotations=0,90] [--filter=texto]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    const int threads = ThreadPool::shared().setThreadCount(options.threads);
+    std::printf(
+        "{\"type\":\"meta\",\"kernel\":\"%s\",\"cpu_features\":\"%s\","
+        "\"threads\":%d,\"iterations\":%d,\"warmup\":%d}\n",
+        yuvKernelName(), cpuFeatureString(cpuFeatures()).c_str(),
+        threads, options.iterations, options.warmup);
+
+    for (const Resolution& resolution : kResolutions) {
+        for (const FrameLayout& layout : kLayouts) {
+            const Frame frame = makeFrame(resolution, layout);
+            for (int rotation : options.rotations) {
+                benchFrame(options, frame, layout.name, rotation);
+            }
+        }
+    }
+    benchDecoder(options);
+    return 0;
+}
@@ -0,0 +1,727 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                       nutrivision_pipeline_bench.cpp                          ║
+// ║          Benchmark del pipeline completo sobre frames grabados (.nvyuv)       ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Reproduce frames YUV_420_888 por conversión, preprocesado, inferencia        ║
+// ║  (API C de TFLite) y decodificación+NMS. Emite JSON Lines con p50/p95/p99     ║
+// ║  por etapa y el RSS pico. Formato .nvyuv: yuv_frame_dump.dart.                ║
+// ║  Uso: nutrivision_pipeline_bench [--frames=a.nvyuv,b.nvyuv] [--model=x]       ║
+// ║       [--passes=N] [--warmup=N] [--threads=N] [--baseline=previo.jsonl]       ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include <dlfcn.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
+#include "thread_pool.h"
+#include "yolo_decoder.h"
+#include "yuv_preprocess.h"
+#include "yuv_to_rgb.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONFIGURACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Lado del tensor de entrada del modelo (yolo_service.dart).
+constexpr int kModelInputSize = 640;
+
+/// Salida por defecto sin modelo: 4 bbox + 83 clases × 8400 predicciones.
+constexpr int kModelClasses = 83;
+constexpr int kModelPredictions = 8400;
+
+/// Detecciones máximas por frame (kMaxDetections de yolo_service.dart).
+constexpr int kMaxDetections = 100;
+
+/// Margen tolerado sobre el p95 de --baseline.
+constexpr double kRegressionFactor = 1.2;
+
+struct Options {
+    std::vector<std::string> framePaths;
+    std::string modelPath;
+    std::string baselinePath;
+    int passes = 3;
+    int warmup = 5;
+    int threads = 0;  // <= 0: valor por defecto del pool
+    float confidence = 0.25f;
+    float iou = 0.45f;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FRAMES .NVYUV
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// "NVYU" en little-endian, versión y tamaño del header (yuv_frame_dump.dart).
+constexpr uint32_t kDumpMagic = 0x5559564E;
+constexpr uint32_t kDumpVersion = 1;
+constexpr size_t kDumpHeaderBytes = 64;
+constexpr uint32_t kDumpFlagMirror = 1;
+
+struct Frame {
+    int width;
+    int height;
+    int yRowStride;
+    int uvRowStride;
+    int uvPixelStride;
+    int sensorOrientation;
+    bool mirror;
+    std::vector<uint8_t> y;
+    std::vector<uint8_t> u;
+    std::vector<uint8_t> v;
+};
+
+template <typename T>
+T readLe(const uint8_t* data) {
+    // Android y x86_64 son little-endian, como el formato
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/// true si los planos alcanzan para lo que los kernels leen según los strides.
+bool planesCoverStrides(const Frame& frame) {
+    if (frame.width <= 0 || frame.height <= 0 || frame.uvPixelStride < 1) return false;
+    if (frame.yRowStride < frame.width) return false;
+
+    const size_t chromaWidth = (frame.width + 1) / 2;
+    const size_t chromaHeight = (frame.height + 1) / 2;
+    const size_t yNeeded = static_cast<size_t>(frame.yRowStride) * (frame.height - 1) +
+                           frame.width;
+    const size_t uvNeeded = static_cast<size_t>(frame.uvRowStride) * (chromaHeight - 1) +
+                            (chromaWidth - 1) * frame.uvPixelStride + 1;
+    return frame.y.size() >= yNeeded && frame.u.size() >= uvNeeded &&
+           frame.v.size() >= uvNeeded;
+}
+
+/**
+ * Añade a frames todos los de un .nvyuv. Retorna false (con mensaje) si el
+ * archivo no existe o algún frame está truncado o no es válido.
+ */
+bool loadDump(const std::string& path, std::vector<Frame>& frames) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", path.c_str());
+        return false;
+    }
+
+    bool ok = true;
+    uint8_t header[kDumpHeaderBytes];
+    while (true) {
+        const size_t read = std::fread(header, 1, kDumpHeaderBytes, file);
+        if (read == 0) break;
+        if (read != kDumpHeaderBytes ||
+            readLe<uint32_t>(header) != kDumpMagic ||
+            readLe<uint32_t>(header + 4) != kDumpVersion) {
+            std::fprintf(stderr, "%s: header inválido en el frame %zu\n",
+                         path.c_str(), frames.size());
+            ok = false;
+            break;
+        }
+
+        Frame frame{};
+        frame.width = readLe<int32_t>(header + 8);
+        frame.height = readLe<int32_t>(header + 12);
+        frame.yRowStride = readLe<int32_t>(header + 16);
+        frame.uvRowStride = readLe<int32_t>(header + 20);
+        frame.uvPixelStride = readLe<int32_t>(header + 24);
+        frame.sensorOrientation = readLe<int32_t>(header + 28);
+        frame.mirror = (readLe<uint32_t>(header + 52) & kDumpFlagMirror) != 0;
+        frame.y.resize(readLe<uint32_t>(header + 40));
+        frame.u.resize(readLe<uint32_t>(header + 44));
+        frame.v.resize(readLe<uint32_t>(header + 48));
+
+        if (std::fread(frame.y.data(), 1, frame.y.size(), file) != frame.y.size() ||
+            std::fread(frame.u.data(), 1, frame.u.size(), file) != frame.u.size() ||
+            std::fread(frame.v.data(), 1, frame.v.size(), file) != frame.v.size() ||
+            !planesCoverStrides(frame)) {
+            std::fprintf(stderr, "%s: planos truncados en el frame %zu\n",
+                         path.c_str(), frames.size());
+            ok = false;
+            break;
+        }
+        frames.push_back(std::move(frame));
+    }
+
+    std::fclose(file);
+    return ok;
+}
+
+/**
+ * Generador determinista: mismos datos en todas las ejecuciones y SoCs.
+ */
+struct Lcg {
+    uint32_t state;
+
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    float unit() { return static_cast<float>(next() & 0xFFFF) / 65535.0f; }
+};
+
+/**
+ * Frame sintético con los mismos gradientes que el fallback de
+ * integration_test/frame_pipeline_benchmark_test.dart.
+ */
+Frame makeFrame(int width, int height, int rowStride, int uvPixelStride,
+                int sensorOrientation, int seed) {
+    Frame frame{};
+    frame.width = width;
+    frame.height = height;
+    frame.yRowStride = rowStride;
+    frame.uvPixelStride = uvPixelStride;
+    frame.sensorOrientation = sensorOrientation;
+
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    frame.uvRowStride = uvPixelStride == 2 ? rowStride : chromaWidth;
+
+    frame.y.resize(static_cast<size_t>(rowStride) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            frame.y[static_cast<size_t>(y) * rowStride + x] =
+                static_cast<uint8_t>(x + y + seed * 7);
+        }
+    }
+
+    const size_t uvLength = static_cast<size_t>(frame.uvRowStride) * (chromaHeight - 1) +
+                            static_cast<size_t>(chromaWidth - 1) * uvPixelStride + 1;
+    frame.u.resize(uvLength);
+    frame.v.resize(uvLength);
+    for (int y = 0; y < chromaHeight; y++) {
+        for (int x = 0; x < chromaWidth; x++) {
+            const size_t index = static_cast<size_t>(y) * frame.uvRowStride +
+                                 static_cast<size_t>(x) * uvPixelStride;
+            frame.u[index] = static_cast<uint8_t>(128 + x - y + seed);
+            frame.v[index] = static_cast<uint8_t>(128 + y - x - seed);
+        }
+    }
+    return frame;
+}
+
+std::vector<Frame> syntheticFrames() {
+    std::vector<Frame> frames;
+    for (int i = 0; i < 10; i++) {
+        frames.push_back(makeFrame(640, 480, 704, 2, 90, i));
+        frames.push_back(makeFrame(1280, 720, 1280 + 64, 2, 90, i + 100));
+        frames.push_back(makeFrame(640, 480, 640, 1, 0, i + 200));
+    }
+    return frames;
+}
+
+/**
+ * Salida YOLO sintética para medir el decodificador sin modelo: fondo con
+ * score bajo y ~3 % de predicciones sobre el umbral agrupadas en objetos.
+ */
+std::vector<float> makeYoloOutput() {
+    const int rows = 4 + kModelClasses;
+    std::vector<float> output(static_cast<size_t>(rows) * kModelPredictions);
+    Lcg rng{87};
+
+    for (size_t i = 4 * static_cast<size_t>(kModelPredictions); i < output.size(); i++) {
+        output[i] = rng.unit() * 0.1f;
+    }
+
+    constexpr int kObjects = 12;
+    for (int i = 0; i < kModelPredictions; i++) {
+        const int object = static_cast<int>(rng.next() % kObjects);
+        output[0 * kModelPredictions + i] = (object % 4 + 0.5f) / 4.0f;
+        output[1 * kModelPredictions + i] = (object / 4 + 0.5f) / 3.0f;
+        output[2 * kModelPredictions + i] = 0.15f + rng.unit() * 0.05f;
+        output[3 * kModelPredictions + i] = 0.15f + rng.unit() * 0.05f;
+        if (rng.next() % 32 == 0) {
+            const int classId = object * 7 % kModelClasses;
+            output[static_cast<size_t>(4 + classId) * kModelPredictions + i] =
+                0.3f + rng.unit() * 0.65f;
+        }
+    }
+    return output;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// API C DE TFLITE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// TfLiteType (tensorflow/lite/core/c/c_api_types.h).
+constexpr int kTfLiteFloat32 = 1;
+constexpr int kTfLiteUInt8 = 3;
+constexpr int kTfLiteInt8 = 9;
+constexpr int kTfLiteFloat16 = 10;
+
+struct TfLiteQuantizationParams {
+    float scale;
+    int32_t zeroPoint;
+};
+
+/**
+ * Subconjunto de la API C de TFLite. libtensorflowlite_jni.so (la que usa
+ * tflite_flutter) la exporta; se copia junto al ejecutable con adb push.
+ */
+struct TfLiteApi {
+    void* (*modelCreateFromFile)(const char*) = nullptr;
+    void (*modelDelete)(void*) = nullptr;
+    void* (*optionsCreate)() = nullptr;
+    void (*optionsSetNumThreads)(void*, int32_t) = nullptr;
+    void (*optionsDelete)(void*) = nullptr;
+    void* (*interpreterCreate)(const void*, const void*) = nullptr;
+    void (*interpreterDelete)(void*) = nullptr;
+    int (*allocateTensors)(void*) = nullptr;
+    void* (*getInputTensor)(const void*, int32_t) = nullptr;
+    const void* (*getOutputTensor)(const void*, int32_t) = nullptr;
+    int (*invoke)(void*) = nullptr;
+    int (*tensorType)(const void*) = nullptr;
+    int32_t (*tensorNumDims)(const void*) = nullptr;
+    int32_t (*tensorDim)(const void*, int32_t) = nullptr;
+    size_t (*tensorByteSize)(const void*) = nullptr;
+    TfLiteQuantizationParams (*tensorQuantization)(const void*) = nullptr;
+    int (*copyFromBuffer)(void*, const void*, size_t) = nullptr;
+    int (*copyToBuffer)(const void*, void*, size_t) = nullptr;
+
+    bool loaded() const {
+        return modelCreateFromFile && modelDelete && optionsCreate &&
+               optionsSetNumThreads && optionsDelete && interpreterCreate &&
+               interpreterDelete && allocateTensors && getInputTensor &&
+               getOutputTensor && invoke && tensorType && tensorNumDims &&
+               tensorDim && tensorByteSize && tensorQuantization &&
+               copyFromBuffer && copyToBuffer;
+    }
+};
+
+template <typename Fn>
+void resolve(void* library, const char* name, Fn& fn) {
+    fn = reinterpret_cast<Fn>(dlsym(library, name));
+}
+
+bool loadTfLite(TfLiteApi& api) {
+    void* library = dlopen("libtensorflowlite_jni.so", RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        std::fprintf(stderr, "libtensorflowlite_jni.so no disponible: %s\n", dlerror());
+        return false;
+    }
+
+    resolve(library, "TfLiteModelCreateFromFile", api.modelCreateFromFile);
+    resolve(library, "TfLiteModelDelete", api.modelDelete);
+    resolve(library, "TfLiteInterpreterOptionsCreate", api.optionsCreate);
+    resolve(library, "TfLiteInterpreterOptionsSetNumThreads", api.optionsSetNumThreads);
+    resolve(library, "TfLiteInterpreterOptionsDelete", api.optionsDelete);
+    resolve(library, "TfLiteInterpreterCreate", api.interpreterCreate);
+    resolve(library, "TfLiteInterpreterDelete", api.interpreterDelete);
+    resolve(library, "TfLiteInterpreterAllocateTensors", api.allocateTensors);
+    resolve(library, "TfLiteInterpreterGetInputTensor", api.getInputTensor);
+    resolve(library, "TfLiteInterpreterGetOutputTensor", api.getOutputTensor);
+    resolve(library, "TfLiteInterpreterInvoke", api.invoke);
+    resolve(library, "TfLiteTensorType", api.tensorType);
+    resolve(library, "TfLiteTensorNumDims", api.tensorNumDims);
+    resolve(library, "TfLiteTensorDim", api.tensorDim);
+    resolve(library, "TfLiteTensorByteSize", api.tensorByteSize);
+    resolve(library, "TfLiteTensorQuantizationParams", api.tensorQuantization);
+    resolve(library, "TfLiteTensorCopyFromBuffer", api.copyFromBuffer);
+    resolve(library, "TfLiteTensorCopyToBuffer", api.copyToBuffer);
+    if (!api.loaded()) {
+        std::fprintf(stderr, "API C de TFLite incompleta\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Intérprete CPU (XNNPack por defecto) con los formatos de entrada y salida
+ * leídos del modelo, como los resuelve YoloDetector.
+ */
+struct Model {
+    TfLiteApi api;
+    void* model = nullptr;
+    void* interpreter = nullptr;
+    void* input = nullptr;
+    const void* output = nullptr;
+    TensorOutputFormat inputFormat;
+    int outputType = kTfLiteFloat32;
+    TfLiteQuantizationParams outputQuantization{1.0f, 0};
+    int numClasses = 0;
+    int numPredictions = 0;
+    std::vector<uint8_t> inputBytes;
+    std::vector<uint8_t> outputBytes;
+
+    ~Model() {
+        if (interpreter) api.interpreterDelete(interpreter);
+        if (model) api.modelDelete(model);
+    }
+};
+
+bool openModel(const std::string& path, int threads, Model& result) {
+    TfLiteApi& api = result.api;
+    if (!loadTfLite(api)) return false;
+
+    result.model = api.modelCreateFromFile(path.c_str());
+    if (!result.model) {
+        std::fprintf(stderr, "No se pudo cargar el modelo %s\n", path.c_str());
+        return false;
+    }
+
+    void* options = api.optionsCreate();
+    if (threads > 0) api.optionsSetNumThreads(options, threads);
+    result.interpreter = api.interpreterCreate(result.model, options);
+    api.optionsDelete(options);
+    if (!result.interpreter || api.allocateTensors(result.interpreter) != 0) {
+        std::fprintf(stderr, "No se pudo crear el intérprete\n");
+        return false;
+    }
+
+    result.input = api.getInputTensor(result.interpreter, 0);
+    result.output = api.getOutputTensor(result.interpreter, 0);
+    if (!result.input || !result.output ||
+        api.tensorNumDims(result.input) != 4 || api.tensorNumDims(result.output) != 3) {
+        std::fprintf(stderr, "Forma de tensores inesperada\n");
+        return false;
+    }
+
+    // Entrada [1, 640, 640, 3] (NHWC) o [1, 3, 640, 640] (NCHW)
+    TensorOutputFormat& format = result.inputFormat;
+    format.layout = api.tensorDim(result.input, 1) == 3 ? TensorLayout::Nchw
+                                                        : TensorLayout::Nhwc;
+    switch (api.tensorType(result.input)) {
+        case kTfLiteFloat32: format.dataType = TensorDataType::Float32; break;
+        case kTfLiteFloat16: format.dataType = TensorDataType::Float16; break;
+        case kTfLiteUInt8: format.dataType = TensorDataType::Uint8; break;
+        case kTfLiteInt8: format.dataType = TensorDataType::Int8; break;
+        default:
+            std::fprintf(stderr, "Tipo de entrada no soportado\n");
+            return false;
+    }
+    if (format.dataType == TensorDataType::Uint8 || format.dataType == TensorDataType::Int8) {
+        const TfLiteQuantizationParams quantization = api.tensorQuantization(result.input);
+        format.scale = quantization.scale;
+        format.zeroPoint = quantization.zeroPoint;
+    }
+    result.inputBytes.resize(api.tensorByteSize(result.input));
+    const size_t expectedInput = static_cast<size_t>(kModelInputSize) * kModelInputSize * 3 *
+                                 tensorElementBytes(format.dataType);
+    if (!validTensorFormat(format) || result.inputBytes.size() != expectedInput) {
+        std::fprintf(stderr, "Tensor de entrada no es de %dx%d\n",
+                     kModelInputSize, kModelInputSize);
+        return false;
+    }
+
+    // Salida [1, 4 + clases, predicciones]
+    result.outputType = api.tensorType(result.output);
+    if (result.outputType != kTfLiteFloat32 && result.outputType != kTfLiteUInt8 &&
+        result.outputType != kTfLiteInt8) {
+        std::fprintf(stderr, "Tipo de salida no soportado\n");
+        return false;
+    }
+    result.outputQuantization = api.tensorQuantization(result.output);
+    result.numClasses = api.tensorDim(result.output, 1) - 4;
+    result.numPredictions = api.tensorDim(result.output, 2);
+    result.outputBytes.resize(api.tensorByteSize(result.output));
+    return result.numClasses > 0 && result.numPredictions > 0;
+}
+
+/// Copia la salida del intérprete a floats, decuantizando si hace falta.
+void readOutput(const Model& model, std::vector<float>& output) {
+    const size_t count = static_cast<size_t>(4 + model.numClasses) * model.numPredictions;
+    output.resize(count);
+    if (model.outputType == kTfLiteFloat32) {
+        std::memcpy(output.data(), model.outputBytes.data(), count * sizeof(float));
+        return;
+    }
+
+    const float scale = model.outputQuantization.scale;
+    const int32_t zeroPoint = model.outputQuantization.zeroPoint;
+    for (size_t i = 0; i < count; i++) {
+        const int32_t value = model.outputType == kTfLiteUInt8
+            ? static_cast<int32_t>(model.outputBytes[i])
+            : static_cast<int32_t>(static_cast<int8_t>(model.outputBytes[i]));
+        output[i] = static_cast<float>(value - zeroPoint) * scale;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEDICIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+enum Stage { kConvert, kPreprocess, kInference, kDecodeNms, kTotal, kStageCount };
+
+constexpr const char* kStageNames[kStageCount] = {
+    "convert", "preprocess", "inference", "decode_nms", "total",
+};
+
+int64_t nowNs() {
+    // steady_clock es CLOCK_MONOTONIC en bionic y glibc
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Percentil por rango más cercano sobre muestras ordenadas.
+int64_t percentile(const std::vector<int64_t>& sorted, int percent) {
+    if (sorted.empty()) return 0;
+    const size_t count = sorted.size();
+    const size_t rank = std::max<size_t>(1, (count * percent + 99) / 100);
+    return sorted[std::min(count, rank) - 1];
+}
+
+/**
+ * Buffers reutilizados entre frames: el pipeline de la app tampoco reserva
+ * por frame (FrameBufferPool), así que el benchmark no mide el allocator.
+ */
+struct Workspace {
+    std::vector<uint8_t> rgb;
+    std::vector<uint8_t> tensor;
+    std::vector<float> output;
+    std::vector<float> detections;
+};
+
+/**
+ * Pasa un frame por el pipeline y escribe la duración de cada etapa.
+ */
+bool runFrame(const Options& options, Model* model, const std::vector<float>& syntheticOutput,
+              const Frame& frame, Workspace& workspace, int64_t (&stageNs)[kStageCount]) {
+    const bool rotated = frame.sensorOrientation == 90 || frame.sensorOrientation == 270;
+    const int rotatedWidth = rotated ? frame.height : frame.width;
+    const int rotatedHeight = rotated ? frame.width : frame.height;
+    const LetterboxParams letterbox =
+        computeLetterbox(rotatedWidth, rotatedHeight, kModelInputSize);
+
+    // Conversión RGB a la zona útil (respaldo del modo en vivo)
+    workspace.rgb.resize(static_cast<size_t>(letterbox.newWidth) * letterbox.newHeight * 3);
+    int64_t start = nowNs();
+    convertYuv420ToRgbScaled(frame.y.data(), frame.u.data(), frame.v.data(),
+                             frame.width, frame.height, frame.yRowStride,
+                             frame.uvRowStride, frame.uvPixelStride,
+                             frame.sensorOrientation, frame.mirror,
+                             letterbox.newWidth, letterbox.newHeight, workspace.rgb.data());
+    stageNs[kConvert] = nowNs() - start;
+
+    const TensorOutputFormat format = model ? model->inputFormat : TensorOutputFormat{};
+    workspace.tensor.resize(static_cast<size_t>(kModelInputSize) * kModelInputSize * 3 *
+                            tensorElementBytes(format.dataType));
+    start = nowNs();
+    const LetterboxParams params = preprocessYuv420ToTensorAs(
+        frame.y.data(), frame.u.data(), frame.v.data(),
+        frame.width, frame.height, frame.yRowStride,
+        frame.uvRowStride, frame.uvPixelStride,
+        frame.sensorOrientation, frame.mirror, kModelInputSize, format,
+        workspace.tensor.data());
+    stageNs[kPreprocess] = nowNs() - start;
+
+    // Sin modelo la inferencia no se mide y el decodificador usa la salida
+    // sintética. Con modelo se mide como Interpreter.run: copia e invoke
+    const float* output = syntheticOutput.data();
+    YoloDecodeParams decode{};
+    decode.numClasses = kModelClasses;
+    decode.numPredictions = kModelPredictions;
+    stageNs[kInference] = 0;
+    if (model) {
+        const TfLiteApi& api = model->api;
+        start = nowNs();
+        if (api.copyFromBuffer(model->input, workspace.tensor.data(),
+                               workspace.tensor.size()) != 0 ||
+            api.invoke(model->interpreter) != 0 ||
+            api.copyToBuffer(model->output, model->outputBytes.data(),
+                             model->outputBytes.size()) != 0) {
+            return false;
+        }
+        stageNs[kInference] = nowNs() - start;
+        decode.numClasses = model->numClasses;
+        decode.numPredictions = model->numPredictions;
+    }
+
+    start = nowNs();
+    if (model) {
+        readOutput(*model, workspace.output);
+        output = workspace.output.data();
+    }
+    decode.inputSize = kModelInputSize;
+    decode.confidenceThreshold = options.confidence;
+    decode.iouThreshold = options.iou;
+    decode.scale = params.scale;
+    decode.padLeft = params.padLeft;
+    decode.padTop = params.padTop;
+    decode.imageWidth = rotatedWidth;
+    decode.imageHeight = rotatedHeight;
+    workspace.detections.resize(static_cast<size_t>(kMaxDetections) * kDetectionStride);
+    decodeYoloOutput(output, decode, workspace.detections.data(), kMaxDetections);
+    stageNs[kDecodeNms] = nowNs() - start;
+
+    stageNs[kTotal] = stageNs[kConvert] + stageNs[kPreprocess] +
+                      stageNs[kInference] + stageNs[kDecodeNms];
+    return true;
+}
+
+/**
+ * p95 por etapa de una ejecución anterior (las líneas "stage" de su salida).
+ */
+bool readBaseline(const std::string& path, int64_t (&p95Ns)[kStageCount]) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", path.c_str());
+        return false;
+    }
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        if (!std::strstr(line, "\"type\":\"stage\"")) continue;
+        const char* p95 = std::strstr(line, "\"p95_ns\":");
+        if (!p95) continue;
+        for (int stage = 0; stage < kStageCount; stage++) {
+            const std::string key = std::string("\"stage\":\"") + kStageNames[stage] + "\"";
+            if (std::strstr(line, key.c_str())) {
+                p95Ns[stage] = std::strtoll(p95 + std::strlen("\"p95_ns\":"), nullptr, 10);
+            }
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ARGUMENTOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool parseArgument(const char* argument, const char* name, const char** value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(argument, name, length) != 0 || argument[length] != '=') return false;
+    *value = argument + length + 1;
+    return true;
+}
+
+std::vector<std::string> parsePaths(const char* value) {
+    std::vector<std::string> result;
+    const char* cursor = value;
+    while (*cursor) {
+        const char* end = std::strchr(cursor, ',');
+        if (!end) end = cursor + std::strlen(cursor);
+        if (end > cursor) result.emplace_back(cursor, end);
+        cursor = *end == ',' ? end + 1 : end;
+    }
+    return result;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* value = nullptr;
+        if (parseArgument(argv[i], "--frames", &value)) {
+            options.framePaths = parsePaths(value);
+        } else if (parseArgument(argv[i], "--model", &value)) {
+            options.modelPath = value;
+        } else if (parseArgument(argv[i], "--baseline", &value)) {
+            options.baselinePath = value;
+        } else if (parseArgument(argv[i], "--passes", &value)) {
+            options.passes = std::max(std::atoi(value), 1);
+        } else if (parseArgument(argv[i], "--warmup", &value)) {
+            options.warmup = std::max(std::atoi(value), 0);
+        } else if (parseArgument(argv[i], "--threads", &value)) {
+            options.threads = std::atoi(value);
+        } else if (parseArgument(argv[i], "--confidence", &value)) {
+            options.confidence = static_cast<float>(std::atof(value));
+        } else if (parseArgument(argv[i], "--iou", &value)) {
+            options.iou = static_cast<float>(std::atof(value));
+        } else {
+            std::fprintf(stderr,
+                         "Uso: %s [--frames=a.nvyuv,b.nvyuv] [--model=modelo.tflite] "
+                         "[--passes=N] [--warmup=N] [--threads=N] [--confidence=F] "
+                         "[--iou=F] [--baseline=previo.jsonl]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::vector<Frame> frames;
+    for (const std::string& path : options.framePaths) {
+        if (!loadDump(path, frames)) return 1;
+    }
+    const bool recorded = !frames.empty();
+    if (!recorded) frames = syntheticFrames();
+
+    Model model;
+    const bool hasModel = !options.modelPath.empty();
+    if (hasModel && !openModel(options.modelPath, options.threads, model)) return 1;
+    const std::vector<float> syntheticOutput = hasModel ? std::vector<float>() : makeYoloOutput();
+
+    const int threads = ThreadPool::shared().setThreadCount(options.threads);
+    std::printf(
+        "{\"type\":\"meta\",\"kernel\":\"%s\",\"cpu_features\":\"%s\","
+        "\"threads\":%d,\"fixtures\":\"%s\",\"frames\":%zu,\"passes\":%d,"
+        "\"warmup\":%d,\"model\":%s}\n",
+        yuvKernelName(), cpuFeatureString(cpuFeatures()).c_str(), threads,
+        recorded ? "recorded" : "synthetic", frames.size(), options.passes,
+        options.warmup, hasModel ? "true" : "false");
+    std::fflush(stdout);
+
+    std::vector<int64_t> samples[kStageCount];
+    Workspace workspace;
+    int processed = 0;
+    for (int pass = 0; pass < options.passes; pass++) {
+        for (const Frame& frame : frames) {
+            int64_t stageNs[kStageCount];
+            if (!runFrame(options, hasModel ? &model : nullptr, syntheticOutput,
+                          frame, workspace, stageNs)) {
+                std::fprintf(stderr, "La inferencia falló\n");
+                return 1;
+            }
+            if (++processed <= options.warmup) continue;
+            for (int stage = 0; stage < kStageCount; stage++) {
+                samples[stage].push_back(stageNs[stage]);
+            }
+        }
+    }
+
+    int64_t p95Ns[kStageCount] = {};
+    for (int stage = 0; stage < kStageCount; stage++) {
+        std::vector<int64_t>& sorted = samples[stage];
+        std::sort(sorted.begin(), sorted.end());
+        p95Ns[stage] = percentile(sorted, 95);
+        std::printf(
+            "{\"type\":\"stage\",\"stage\":\"%s\",\"samples\":%zu,"
+            "\"p50_ns\":%lld,\"p95_ns\":%lld,\"p99_ns\":%lld,\"max_ns\":%lld}\n",
+            kStageNames[stage], sorted.size(),
+            static_cast<long long>(percentile(sorted, 50)),
+            static_cast<long long>(p95Ns[stage]),
+            static_cast<long long>(percentile(sorted, 99)),
+            static_cast<long long>(sorted.empty() ? 0 : sorted.back()));
+    }
+
+    // ru_maxrss está en KB en Linux/Android
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("{\"type\":\"memory\",\"peak_rss_kb\":%ld}\n", usage.ru_maxrss);
+    std::fflush(stdout);
+
+    if (options.baselinePath.empty()) return 0;
+
+    int64_t baselineNs[kStageCount] = {};
+    if (!readBaseline(options.baselinePath, baselineNs)) return 1;
+    bool regressed = false;
+    for (int stage = 0; stage < kStageCount; stage++) {
+        if (baselineNs[stage] <= 0) continue;
+        if (static_cast<double>(p95Ns[stage]) > baselineNs[stage] * kRegressionFactor) {
+            std::fprintf(stderr, "Regresión en %s: p95 %lld ns → %lld ns\n",
+                         kStageNames[stage], static_cast<long long>(baselineNs[stage]),
+                         static_cast<long long>(p95Ns[stage]));
+            regressed = true;
+        }
+    }
+    return regressed ? 2 : 0;
+}
@@ -0,0 +1,239 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             box_tracker.cpp                                   ║
+// ║          Seguimiento de cajas entre inferencias (IoU + Kalman)                ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "box_tracker.h"
+
+#include <algorithm>
+
+#include "yolo_decoder.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Desviaciones como fracción del lado mayor de la caja (por segundo para la
+// velocidad y por segundo² para la aceleración)
+constexpr float kMeasurementStd = 0.05f;
+constexpr float kInitialVelocityStd = 1.0f;
+constexpr float kAccelerationStd = 4.0f;
+
+// Lado mínimo usado para escalar los ruidos (cajas degeneradas)
+constexpr float kMinNoiseSize = 1.0f;
+
+constexpr float kNsPerSecond = 1e9f;
+
+/**
+ * Par pista-detección candidato a asociarse.
+ */
+struct Match {
+    float iou;
+    int track;
+    int detection;
+};
+
+float iou(const float a[4], const float b[4]) {
+    const float ix = std::min(a[2], b[2]) - std::max(a[0], b[0]);
+    const float iy = std::min(a[3], b[3]) - std::max(a[1], b[1]);
+    if (ix <= 0.0f || iy <= 0.0f) return 0.0f;
+
+    const float intersection = ix * iy;
+    const float areaA = (a[2] - a[0]) * (a[3] - a[1]);
+    const float areaB = (b[2] - b[0]) * (b[3] - b[1]);
+    const float unionArea = areaA + areaB - intersection;
+    return unionArea > 0.0f ? intersection / unionArea : 0.0f;
+}
+
+float noiseSize(float width, float height) {
+    return std::max(std::max(width, height), kMinNoiseSize);
+}
+
+float secondsBetween(int64_t fromNs, int64_t toNs) {
+    return toNs > fromNs ? static_cast<float>(toNs - fromNs) / kNsPerSecond : 0.0f;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FILTRO POR EJE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void BoxTracker::AxisFilter::init(float position, float positionVariance,
+                                  float velocityVariance) {
+    x = position;
+    v = 0.0f;
+    p00 = positionVariance;
+    p01 = 0.0f;
+    p11 = velocityVariance;
+}
+
+void BoxTracker::AxisFilter::advance(float dt, float accelerationVariance) {
+    if (dt <= 0.0f) return;
+
+    // P = F P Fᵀ + Q, con F = [1 dt; 0 1] y Q de aceleración blanca continua
+    const float dt2 = dt * dt;
+    x += v * dt;
+    p00 += dt * (2.0f * p01 + dt * p11) + accelerationVariance * dt2 * dt / 3.0f;
+    p01 += dt * p11 + accelerationVariance * dt2 / 2.0f;
+    p11 += accelerationVariance * dt;
+}
+
+void BoxTracker::AxisFilter::correct(float measurement, float measurementVariance) {
+    const float innovation = measurement - x;
+    const float s = p00 + measurementVariance;
+    const float k0 = p00 / s;
+    const float k1 = p01 / s;
+
+    x += k0 * innovation;
+    v += k1 * innovation;
+    p11 -= k1 * p01;
+    p01 *= 1.0f - k0;
+    p00 *= 1.0f - k0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TRACKER
+// ═══════════════════════════════════════════════════════════════════════════════
+
+BoxTracker::BoxTracker(const TrackerParams& params) : params_(params) {
+    tracks_.reserve(kMaxTracks);
+}
+
+void BoxTracker::boxAt(const Track& track, float dt, float box[4]) {
+    const float cx = track.axes[CenterX].at(dt);
+    const float cy = track.axes[CenterY].at(dt);
+    const float halfW = std::max(track.axes[Width].at(dt), 0.0f) * 0.5f;
+    const float halfH = std::max(track.axes[Height].at(dt), 0.0f) * 0.5f;
+    box[0] = cx - halfW;
+    box[1] = cy - halfH;
+    box[2] = cx + halfW;
+    box[3] = cy + halfH;
+}
+
+int BoxTracker::update(const float* detections, int count, int64_t timestampNs) {
+    if (!detections) count = 0;
+
+    // 1. Avanzar cada pista al instante del frame inferido
+    for (auto& track : tracks_) {
+        const float dt = secondsBetween(track.updatedNs, timestampNs);
+        const float size = noiseSize(track.axes[Width].x, track.axes[Height].x);
+        const float accelerationVariance = (kAccelerationStd * size) * (kAccelerationStd * size);
+        for (auto& axis : track.axes) {
+            axis.advance(dt, accelerationVariance);
+        }
+        track.updatedNs = std::max(track.updatedNs, timestampNs);
+    }
+
+    // 2. Pares de la misma clase con IoU suficiente, de mayor a menor
+    thread_local TrackedVector<Match, MemoryArena::Tracker> matches;
+    matches.clear();
+    for (int t = 0; t < static_cast<int>(tracks_.size()); t++) {
+        float predicted[4];
+        boxAt(tracks_[t], 0.0f, predicted);
+        for (int d = 0; d < count; d++) {
+            const float* detection = detections + d * kDetectionStride;
+            if (static_cast<int>(detection[5]) != tracks_[t].classId) continue;
+            const float overlap = iou(predicted, detection);
+            if (overlap >= params_.iouThreshold) {
+                matches.push_back({overlap, t, d});
+            }
+        }
+    }
+    std::sort(matches.begin(), matches.end(),
+              [](const Match& a, const Match& b) { return a.iou > b.iou; });
+
+    // 3. Asociación voraz y corrección de las pistas asociadas
+    thread_local TrackedVector<uint8_t, MemoryArena::Tracker> trackMatched;
+    thread_local TrackedVector<uint8_t, MemoryArena::Tracker> detectionMatched;
+    trackMatched.assign(tracks_.size(), 0);
+    detectionMatched.assign(static_cast<size_t>(std::max(count, 0)), 0);
+    for (const Match& match : matches) {
+        if (trackMatched[match.track] || detectionMatched[match.detection]) continue;
+        trackMatched[match.track] = 1;
+        detectionMatched[match.detection] = 1;
+
+        Track& track = tracks_[match.track];
+        const float* detection = detections + match.detection * kDetectionStride;
+        const float width = detection[2] - detection[0];
+        const float height = detection[3] - detection[1];
+        const float deviation = kMeasurementStd * noiseSize(width, height);
+        const float measurementVariance = deviation * deviation;
+
+        track.axes[CenterX].correct((detection[0] + detection[2]) * 0.5f, measurementVariance);
+        track.axes[CenterY].correct((detection[1] + detection[3]) * 0.5f, measurementVariance);
+        track.axes[Width].correct(width, measurementVariance);
+        track.axes[Height].correct(height, measurementVariance);
+        track.score = detection[4];
+        track.misses = 0;
+    }
+
+    // 4. Pistas sin asociar: se conservan hasta maxMisses inferencias
+    int kept = 0;
+    for (int t = 0; t < static_cast<int>(tracks_.size()); t++) {
+        Track& track = tracks_[t];
+        if (!trackMatched[t] && ++track.misses > params_.maxMisses) continue;
+        if (kept != t) tracks_[kept] = track;
+        kept++;
+    }
+    tracks_.resize(kept);
+
+    // 5. Detecciones libres → pistas nuevas (en orden de score del decodificador)
+    for (int d = 0; d < count && static_cast<int>(tracks_.size()) < kMaxTracks; d++) {
+        if (detectionMatched[d]) continue;
+
+        const float* detection = detections + d * kDetectionStride;
+        const float width = detection[2] - detection[0];
+        const float height = detection[3] - detection[1];
+        if (width <= 0.0f || height <= 0.0f) continue;
+
+        const float size = noiseSize(width, height);
+        const float positionVariance = (kMeasurementStd * size) * (kMeasurementStd * size);
+        const float velocityVariance = (kInitialVelocityStd * size) * (kInitialVelocityStd * size);
+
+        Track track;
+        track.id = nextId_++;
+        track.classId = static_cast<int>(detection[5]);
+        track.score = detection[4];
+        track.updatedNs = timestampNs;
+        track.axes[CenterX].init((detection[0] + detection[2]) * 0.5f, positionVariance,
+                                 velocityVariance);
+        track.axes[CenterY].init((detection[1] + detection[3]) * 0.5f, positionVariance,
+                                 velocityVariance);
+        track.axes[Width].init(width, positionVariance, velocityVariance);
+        track.axes[Height].init(height, positionVariance, velocityVariance);
+        tracks_.push_back(track);
+    }
+
+    return static_cast<int>(std::count_if(tracks_.begin(), tracks_.end(), [this](const Track& t) {
+        return t.misses <= params_.maxVisibleMisses;
+    }));
+}
+
+int BoxTracker::predict(int64_t timestampNs, float* tracksOut, int maxTracks) const {
+    if (!tracksOut || maxTracks <= 0) return 0;
+
+    int written = 0;
+    for (const Track& track : tracks_) {
+        if (track.misses > params_.maxVisibleMisses) continue;
+        if (written >= maxTracks) break;
+
+        const int64_t elapsedNs =
+            std::min(timestampNs - track.updatedNs, kMaxExtrapolationNs);
+        const float dt = secondsBetween(0, elapsedNs);
+
+        float* out = tracksOut + written * kTrackStride;
+        boxAt(track, dt, out);
+        out[4] = track.score;
+        out[5] = static_cast<float>(track.classId);
+        out[6] = static_cast<float>(track.id);
+        written++;
+    }
+    return written;
+}
+
+void BoxTracker::reset() {
+    tracks_.clear();
+}
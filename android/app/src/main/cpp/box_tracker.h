@@ -0,0 +1,125 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              box_tracker.h                                    ║
+// ║          Seguimiento de cajas entre inferencias (IoU + Kalman)                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Asocia las detecciones de cada inferencia con las pistas por IoU y predice   ║
+// ║  su posición en cada frame de cámara con un filtro de velocidad constante.    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef BOX_TRACKER_H
+#define BOX_TRACKER_H
+
+#include <cstdint>
+
+#include "native_memory.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Floats por pista empaquetada: x1, y1, x2, y2, score, classId, trackId.
+constexpr int kTrackStride = 7;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PARÁMETROS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Parámetros de asociación y ciclo de vida de las pistas.
+ */
+struct TrackerParams {
+    float iouThreshold = 0.3f;  // IoU mínimo (caja predicha vs detección) para asociar
+    int maxMisses = 3;          // Inferencias sin asociar antes de eliminar la pista
+    int maxVisibleMisses = 1;   // Inferencias sin asociar que la pista se sigue mostrando
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TRACKER
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Tracker multi-objeto para las detecciones de YOLO.
+ *
+ * Cada pista filtra centro, ancho y alto con cuatro filtros de Kalman
+ * independientes de posición + velocidad (el modelo de SORT, que es diagonal
+ * por bloques). update() avanza las pistas al instante de la inferencia, las
+ * asocia con las detecciones de la misma clase por IoU (voraz, de mayor a
+ * menor) y crea pistas nuevas para las detecciones libres. predict() solo
+ * extrapola, así que se puede llamar en cada frame de cámara sin alterar el
+ * estado.
+ *
+ * Los tiempos son nanosegundos de un reloj monótono elegido por el llamador
+ * (el mismo en update y predict). Los ruidos escalan con el tamaño de la
+ * caja: los parámetros valen igual para cualquier resolución.
+ *
+ * No es thread-safe: un solo llamador (el isolate de Dart).
+ */
+class BoxTracker {
+public:
+    /// Pistas máximas simultáneas (las detecciones de menor score sobran).
+    static constexpr int kMaxTracks = 128;
+
+    /// Extrapolación máxima de predict() desde la última actualización.
+    static constexpr int64_t kMaxExtrapolationNs = 300'000'000;
+
+    explicit BoxTracker(const TrackerParams& params = TrackerParams{});
+
+    /**
+     * @brief Incorpora el resultado de una inferencia.
+     * @param detections  [count][x1, y1, x2, y2, score, classId] (kDetectionStride)
+     * @param timestampNs Instante del frame inferido
+     * @return Pistas visibles tras la actualización
+     */
+    int update(const float* detections, int count, int64_t timestampNs);
+
+    /**
+     * @brief Escribe las pistas visibles extrapoladas a timestampNs.
+     *
+     * La extrapolación se limita a kMaxExtrapolationNs desde la última
+     * actualización: con la inferencia pausada las cajas quedan quietas en
+     * vez de seguir su última velocidad.
+     *
+     * @param tracksOut Salida [maxTracks][kTrackStride]
+     * @return Pistas escritas, en orden de creación
+     */
+    int predict(int64_t timestampNs, float* tracksOut, int maxTracks) const;
+
+    /** Elimina todas las pistas (los ids siguen creciendo). */
+    void reset();
+
+    int trackCount() const { return static_cast<int>(tracks_.size()); }
+
+private:
+    /// Filtro de Kalman 1D de posición + velocidad (aceleración como ruido).
+    struct AxisFilter {
+        float x = 0.0f;
+        float v = 0.0f;
+        float p00 = 0.0f;
+        float p01 = 0.0f;
+        float p11 = 0.0f;
+
+        void init(float position, float positionVariance, float velocityVariance);
+        void advance(float dt, float accelerationVariance);
+        void correct(float measurement, float measurementVariance);
+        float at(float dt) const { return x + v * dt; }
+    };
+
+    enum Axis { CenterX = 0, CenterY, Width, Height, AxisCount };
+
+    struct Track {
+        int64_t id = 0;
+        int classId = 0;
+        float score = 0.0f;
+        int64_t updatedNs = 0;
+        int misses = 0;
+        AxisFilter axes[AxisCount];
+    };
+
+    static void boxAt(const Track& track, float dt, float box[4]);
+
+    TrackerParams params_;
+    TrackedVector<Track, MemoryArena::Tracker> tracks_;
+    int64_t nextId_ = 1;
+};
+
+#endif // BOX_TRACKER_H
@@ -0,0 +1,84 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             cpu_features.cpp                                  ║
+// ║              Detección en tiempo de ejecución de extensiones SIMD             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Bits HWCAP definidos localmente: los headers del NDK antiguo no traen los    ║
+// ║  de ARMv8.2+ (SVE2, I8MM). Sin getauxval se asume solo lo del ABI.            ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "cpu_features.h"
+
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <sys/auxv.h>
+#endif
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// BITS HWCAP (uapi asm/hwcap.h)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+#if defined(__aarch64__)
+constexpr unsigned long kHwcapAsimd   = 1ul << 1;
+constexpr unsigned long kHwcapAsimdHp = 1ul << 10;
+constexpr unsigned long kHwcapAsimdDp = 1ul << 20;
+constexpr unsigned long kHwcapSve     = 1ul << 22;
+constexpr unsigned long kHwcap2Sve2   = 1ul << 1;
+constexpr unsigned long kHwcap2I8mm   = 1ul << 13;
+#elif defined(__arm__)
+constexpr unsigned long kHwcapNeon    = 1ul << 12;
+#endif
+
+uint32_t detectCpuFeatures() {
+    uint32_t features = 0;
+
+#if defined(__aarch64__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    const unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    // ASIMD es obligatorio en arm64; si getauxval falla (0) se asume igual
+    if ((hwcap & kHwcapAsimd) || hwcap == 0) features |= kCpuNeon;
+    if (hwcap & kHwcapAsimdHp) features |= kCpuFp16;
+    if (hwcap & kHwcapAsimdDp) features |= kCpuDotProd;
+    if (hwcap & kHwcapSve)     features |= kCpuSve;
+    if (hwcap2 & kHwcap2Sve2)  features |= kCpuSve2;
+    if (hwcap2 & kHwcap2I8mm)  features |= kCpuI8mm;
+#elif defined(__arm__)
+    if (getauxval(AT_HWCAP) & kHwcapNeon) features |= kCpuNeon;
+#elif defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) features |= kCpuSse41;
+    if (__builtin_cpu_supports("avx2"))   features |= kCpuAvx2;
+#endif
+
+    return features;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════════
+
+uint32_t cpuFeatures() {
+    static const uint32_t features = detectCpuFeatures();
+    return features;
+}
+
+std::string cpuFeatureString(uint32_t features) {
+    static const struct {
+        CpuFeature feature;
+        const char* name;
+    } kNames[] = {
+        {kCpuNeon, "neon"},   {kCpuFp16, "fp16"},   {kCpuDotProd, "dotprod"},
+        {kCpuI8mm, "i8mm"},   {kCpuSve, "sve"},     {kCpuSve2, "sve2"},
+        {kCpuSse41, "sse4.1"}, {kCpuAvx2, "avx2"},
+    };
+
+    std::string result;
+    for (const auto& entry : kNames) {
+        if (!(features & entry.feature)) continue;
+        if (!result.empty()) result += ' ';
+        result += entry.name;
+    }
+    return result;
+}
@@ -0,0 +1,47 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              cpu_features.h                                   ║
+// ║              Detección en tiempo de ejecución de extensiones SIMD             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Lee getauxval(AT_HWCAP / AT_HWCAP2) en ARM y cpuid en x86_64 una sola vez.   ║
+// ║  Los kernels se eligen con este resultado, no con macros de compilación.      ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <cstdint>
+#include <string>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// EXTENSIONES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Extensiones relevantes para los kernels, como máscara de bits.
+ */
+enum CpuFeature : uint32_t {
+    kCpuNeon    = 1u << 0,  // ARMv7 NEON / ARMv8 ASIMD
+    kCpuFp16    = 1u << 1,  // ARMv8.2 aritmética fp16 en ASIMD
+    kCpuDotProd = 1u << 2,  // ARMv8.2 SDOT/UDOT
+    kCpuI8mm    = 1u << 3,  // ARMv8.6 multiplicación de matrices int8
+    kCpuSve     = 1u << 4,
+    kCpuSve2    = 1u << 5,
+    kCpuSse41   = 1u << 6,
+    kCpuAvx2    = 1u << 7,
+};
+
+/**
+ * @brief Extensiones de la CPU actual (detectadas en la primera llamada).
+ *
+ * Se consideran homogéneas entre núcleos, como garantiza el kernel de Linux
+ * al exponer solo las comunes a todos.
+ */
+uint32_t cpuFeatures();
+
+/**
+ * @brief Nombres separados por espacios de las extensiones presentes
+ *        (p. ej. "neon fp16 dotprod"), para telemetría y logs.
+ */
+std::string cpuFeatureString(uint32_t features);
+
+#endif // CPU_FEATURES_H
@@ -0,0 +1,100 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          frame_buffer_pool.cpp                                ║
+// ║              Anillo de buffers de salida reutilizables por frame              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "frame_buffer_pool.h"
+
+#include <algorithm>
+
+#include "native_memory.h"
+
+size_t bytesPerPixel(BufferFormat format) {
+    switch (format) {
+        case BufferFormat::Rgb888:
+            return 3;
+        case BufferFormat::TensorFloat32:
+            return 3 * sizeof(float);
+        case BufferFormat::TensorFloat16:
+            return 3 * sizeof(uint16_t);
+        case BufferFormat::TensorQuant8:
+            return 3;
+    }
+    return 0;
+}
+
+FrameBufferPool::FrameBufferPool(int slotCount)
+    : slots_(std::min(std::max(slotCount, 1), kMaxSlots), nullptr) {}
+
+FrameBufferPool::~FrameBufferPool() {
+    releaseSlots();
+}
+
+int FrameBufferPool::acquire(int width, int height, BufferFormat format) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (width != width_ || height != height_ || format != format_ ||
+        slots_[0] == nullptr) {
+        if (!reconfigure(width, height, format)) {
+            return -1;
+        }
+    }
+
+    const int slot = next_;
+    next_ = (next_ + 1) % static_cast<int>(slots_.size());
+    return slot;
+}
+
+uint8_t* FrameBufferPool::slotData(int slot) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot < 0 || slot >= static_cast<int>(slots_.size())) {
+        return nullptr;
+    }
+    return slots_[slot];
+}
+
+size_t FrameBufferPool::slotBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slotBytes_;
+}
+
+uint64_t FrameBufferPool::generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+bool FrameBufferPool::reconfigure(int width, int height, BufferFormat format) {
+    const size_t bpp = bytesPerPixel(format);
+    if (width <= 0 || height <= 0 || bpp == 0) {
+        return false;
+    }
+
+    releaseSlots();
+
+    const size_t bytes = static_cast<size_t>(width) * height * bpp;
+    for (auto& slot : slots_) {
+        slot = static_cast<uint8_t*>(alignedAlloc(bytes, MemoryArena::Frames));
+        if (slot == nullptr) {
+            releaseSlots();
+            return false;
+        }
+    }
+
+    width_ = width;
+    height_ = height;
+    format_ = format;
+    slotBytes_ = bytes;
+    next_ = 0;
+    generation_++;
+    return true;
+}
+
+void FrameBufferPool::releaseSlots() {
+    for (auto& slot : slots_) {
+        alignedFree(slot);
+        slot = nullptr;
+    }
+    width_ = 0;
+    height_ = 0;
+    slotBytes_ = 0;
+}
@@ -0,0 +1,93 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           frame_buffer_pool.h                                 ║
+// ║              Anillo de buffers de salida reutilizables por frame              ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Sustituye el new[]/delete[] por frame: los buffers se reservan una vez y     ║
+// ║  solo se realocan cuando cambia la resolución o el formato.                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef FRAME_BUFFER_POOL_H
+#define FRAME_BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FORMATOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Formato de los buffers del pool.
+ *
+ * Valores estables: se usan tal cual desde JNI y dart:ffi.
+ */
+enum class BufferFormat : int32_t {
+    Rgb888 = 0,         // 3 bytes por píxel
+    TensorFloat32 = 1,  // 3 floats por píxel (NHWC)
+    TensorFloat16 = 2,  // 3 halfs por píxel (NHWC)
+    TensorQuant8 = 3,   // 3 bytes uint8/int8 por píxel (NHWC)
+};
+
+/**
+ * @brief Bytes por píxel de un formato, o 0 si no es válido.
+ */
+size_t bytesPerPixel(BufferFormat format);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POOL
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Anillo de buffers alineados a 64 bytes para la salida de frames.
+ *
+ * Cada acquire() entrega el siguiente slot del anillo (su índice es el
+ * handle). Con N slots, el resultado de un frame sigue siendo válido mientras
+ * se escriben los N-1 siguientes. En régimen estable no hay reservas de
+ * memoria: solo se realoca al cambiar ancho, alto o formato, y en ese caso se
+ * incrementa generation() para que los llamadores invaliden vistas cacheadas.
+ */
+class FrameBufferPool {
+public:
+    static constexpr int kMaxSlots = 8;
+
+    explicit FrameBufferPool(int slotCount);
+    ~FrameBufferPool();
+
+    FrameBufferPool(const FrameBufferPool&) = delete;
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+    /**
+     * @brief Entrega el siguiente slot configurado para (width, height, format).
+     * @return Índice del slot, o -1 si los parámetros no son válidos o falla
+     *         la reserva
+     */
+    int acquire(int width, int height, BufferFormat format);
+
+    /** Puntero al slot, o nullptr si el índice no es válido. */
+    uint8_t* slotData(int slot) const;
+
+    /** Tamaño en bytes de cada slot para la configuración actual. */
+    size_t slotBytes() const;
+
+    int slotCount() const { return static_cast<int>(slots_.size()); }
+
+    /** Contador de realocaciones. */
+    uint64_t generation() const;
+
+private:
+    bool reconfigure(int width, int height, BufferFormat format);
+    void releaseSlots();
+
+    mutable std::mutex mutex_;
+    std::vector<uint8_t*> slots_;
+    int width_ = 0;
+    int height_ = 0;
+    BufferFormat format_ = BufferFormat::Rgb888;
+    size_t slotBytes_ = 0;
+    int next_ = 0;
+    uint64_t generation_ = 0;
+};
+
+#endif // FRAME_BUFFER_POOL_H
@@ -0,0 +1,332 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             frame_queue.cpp                                   ║
+// ║          Cola asíncrona de frames con preprocesado en un hilo nativo          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "frame_queue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "native_memory.h"
+#include "native_stats.h"
+
+namespace {
+
+/// Redondea al múltiplo de kNativeBufferAlignment para alinear cada plano.
+size_t alignUp(size_t bytes) {
+    return (bytes + kNativeBufferAlignment - 1) & ~(kNativeBufferAlignment - 1);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CICLO DE VIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+FrameQueue::FrameQueue(int slotCount, int targetSize, const TensorOutputFormat& format)
+    : targetSize_(targetSize),
+      format_(format),
+      slots_(std::min(std::max(slotCount, kMinSlots), kMaxSlots)) {
+    if (targetSize <= 0 || !validTensorFormat(format)) return;
+
+    const size_t tensorBytes = static_cast<size_t>(targetSize) * targetSize * 3 *
+                               tensorElementBytes(format.dataType);
+    for (size_t i = 0; i < slots_.size(); i++) {
+        slots_[i].tensor = alignedAlloc(tensorBytes, MemoryArena::Tensors);
+        if (slots_[i].tensor != nullptr) continue;
+        if (static_cast<int>(i) < kMinSlots) return;
+        // Sin presupuesto para más slots: la cola funciona con menos
+        slots_.resize(i);
+        break;
+    }
+
+    valid_ = true;
+    worker_ = std::thread(&FrameQueue::workerLoop, this);
+}
+
+FrameQueue::~FrameQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    pending_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    for (auto& slot : slots_) {
+        alignedFree(slot.planes);
+        alignedFree(slot.tensor);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PRODUCTOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int64_t FrameQueue::submit(
+    const uint8_t* yPlane, size_t yLength,
+    const uint8_t* uPlane, size_t uLength,
+    const uint8_t* vPlane, size_t vLength,
+    int width, int height,
+    int yRowStride, int uvRowStride, int uvPixelStride,
+    int sensorOrientation, bool mirror
+) {
+    if (!valid_ || !yPlane || !uPlane || !vPlane || width <= 0 || height <= 0 ||
+        yLength == 0 || uLength == 0 || vLength == 0) {
+        return -1;
+    }
+
+    int index;
+    int64_t frameId;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.submitted++;
+        index = claimSlotLocked();
+        if (index < 0) {
+            stats_.dropped++;
+            return -1;
+        }
+        frameId = nextFrameId_++;
+        slots_[index].state = SlotState::Writing;
+    }
+
+    // El slot es exclusivo de este hilo mientras esté en Writing
+    Slot& slot = slots_[index];
+    const size_t uOffset = alignUp(yLength);
+    const size_t vOffset = uOffset + alignUp(uLength);
+    const size_t needed = vOffset + vLength;
+
+    bool copied = true;
+    if (needed > slot.planesCapacity) {
+        alignedFree(slot.planes);
+        slot.planes = static_cast<uint8_t*>(alignedAlloc(needed, MemoryArena::Frames));
+        slot.planesCapacity = slot.planes ? needed : 0;
+        copied = slot.planes != nullptr;
+    }
+
+    if (copied) {
+        // Cada plano conserva su stride: los kernels semi-planares solo leen
+        // desde su propio puntero, así que U y V no necesitan seguir intercalados
+        ScopedStageTimer timer(NativeStage::PlaneAccess,
+                               static_cast<int64_t>(yLength + uLength + vLength) * 2);
+        std::memcpy(slot.planes, yPlane, yLength);
+        std::memcpy(slot.planes + uOffset, uPlane, uLength);
+        std::memcpy(slot.planes + vOffset, vPlane, vLength);
+
+        slot.uOffset = uOffset;
+        slot.vOffset = vOffset;
+        slot.width = width;
+        slot.height = height;
+        slot.yRowStride = yRowStride;
+        slot.uvRowStride = uvRowStride;
+        slot.uvPixelStride = uvPixelStride;
+        slot.sensorOrientation = sensorOrientation;
+        slot.mirror = mirror;
+    }
+
+    if (!copied) {
+        // Sin presupuesto para la copia: se convierte ya desde los planos del
+        // llamador (el tensor del slot está reservado desde la construcción)
+        slot.width = width;
+        slot.height = height;
+        slot.sensorOrientation = sensorOrientation;
+        slot.letterbox = preprocessYuv420ToTensorAs(
+            yPlane, uPlane, vPlane,
+            width, height, yRowStride, uvRowStride, uvPixelStride,
+            sensorOrientation, mirror, targetSize_, format_, slot.tensor);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.frameId = frameId;
+        slot.submitNs = monotonicNs();
+        slot.readyNs = slot.submitNs;
+        slot.state = SlotState::Ready;
+        stats_.converted++;
+        return frameId;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.frameId = frameId;
+        slot.submitNs = monotonicNs();
+        slot.state = SlotState::Pending;
+    }
+    pending_.notify_one();
+    return frameId;
+}
+
+int64_t FrameQueue::convertInPlace(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width, int height,
+    int yRowStride, int uvRowStride, int uvPixelStride,
+    int sensorOrientation, bool mirror
+) {
+    if (!valid_ || !yPlane || !uPlane || !vPlane || width <= 0 || height <= 0) {
+        return -1;
+    }
+
+    const int64_t submitNs = monotonicNs();
+    int index;
+    int64_t frameId;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.submitted++;
+        index = claimSlotLocked();
+        if (index < 0) {
+            stats_.dropped++;
+            return -1;
+        }
+        frameId = nextFrameId_++;
+        slots_[index].state = SlotState::Converting;
+    }
+
+    Slot& slot = slots_[index];
+    slot.width = width;
+    slot.height = height;
+    slot.sensorOrientation = sensorOrientation;
+    slot.letterbox = preprocessYuv420ToTensorAs(
+        yPlane, uPlane, vPlane,
+        width, height, yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror, targetSize_, format_, slot.tensor);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    slot.frameId = frameId;
+    slot.submitNs = submitNs;
+    slot.readyNs = monotonicNs();
+    slot.state = SlotState::Ready;
+    stats_.converted++;
+    return frameId;
+}
+
+int FrameQueue::claimSlotLocked() {
+    for (int i = 0; i < slotCount(); ++i) {
+        if (slots_[i].state == SlotState::Free) return i;
+    }
+
+    // Drop-oldest: primero un pendiente sin empezar, después un listo que
+    // nadie recogió
+    int victim = oldestLocked(SlotState::Pending);
+    if (victim < 0) {
+        victim = oldestLocked(SlotState::Ready);
+    }
+    if (victim >= 0) {
+        stats_.dropped++;
+    }
+    return victim;
+}
+
+int FrameQueue::oldestLocked(SlotState state) const {
+    int oldest = -1;
+    for (int i = 0; i < slotCount(); ++i) {
+        if (slots_[i].state == state &&
+            (oldest < 0 || slots_[i].frameId < slots_[oldest].frameId)) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// HILO DE PREPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void FrameQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        pending_.wait(lock, [this] {
+            return stop_ || oldestLocked(SlotState::Pending) >= 0;
+        });
+        if (stop_) return;
+
+        // Solo interesa el pendiente más reciente: los anteriores ya serían
+        // viejos cuando terminara su conversión
+        int index = -1;
+        for (int i = 0; i < slotCount(); ++i) {
+            if (slots_[i].state != SlotState::Pending) continue;
+            if (index < 0) {
+                index = i;
+            } else if (slots_[i].frameId > slots_[index].frameId) {
+                slots_[index].state = SlotState::Free;
+                stats_.dropped++;
+                index = i;
+            } else {
+                slots_[i].state = SlotState::Free;
+                stats_.dropped++;
+            }
+        }
+
+        Slot& slot = slots_[index];
+        slot.state = SlotState::Converting;
+        lock.unlock();
+
+        slot.letterbox = preprocessYuv420ToTensorAs(
+            slot.planes, slot.planes + slot.uOffset, slot.planes + slot.vOffset,
+            slot.width, slot.height,
+            slot.yRowStride, slot.uvRowStride, slot.uvPixelStride,
+            slot.sensorOrientation, slot.mirror, targetSize_, format_, slot.tensor);
+
+        lock.lock();
+        slot.readyNs = monotonicNs();
+        slot.state = SlotState::Ready;
+        stats_.converted++;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSUMIDOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int FrameQueue::acquireLatest(QueuedFrameInfo* info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int latest = -1;
+    for (int i = 0; i < slotCount(); ++i) {
+        if (slots_[i].state != SlotState::Ready) continue;
+        if (latest < 0 || slots_[i].frameId > slots_[latest].frameId) {
+            latest = i;
+        }
+    }
+    if (latest < 0) return -1;
+
+    for (int i = 0; i < slotCount(); ++i) {
+        if (i != latest && slots_[i].state == SlotState::Ready) {
+            slots_[i].state = SlotState::Free;
+            stats_.stale++;
+        }
+    }
+
+    Slot& slot = slots_[latest];
+    slot.state = SlotState::Acquired;
+    if (info) {
+        const bool swap = slot.sensorOrientation == 90 || slot.sensorOrientation == 270;
+        info->frameId = slot.frameId;
+        info->letterbox = slot.letterbox;
+        info->imageWidth = swap ? slot.height : slot.width;
+        info->imageHeight = swap ? slot.width : slot.height;
+        info->latencyNs = slot.readyNs - slot.submitNs;
+    }
+    return latest;
+}
+
+void* FrameQueue::tensor(int slot) const {
+    if (!valid_ || slot < 0 || slot >= slotCount()) return nullptr;
+    return slots_[slot].tensor;
+}
+
+bool FrameQueue::release(int slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot < 0 || slot >= slotCount() ||
+        slots_[slot].state != SlotState::Acquired) {
+        return false;
+    }
+    slots_[slot].state = SlotState::Free;
+    return true;
+}
+
+FrameQueueStats FrameQueue::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
@@ -0,0 +1,187 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              frame_queue.h                                    ║
+// ║          Cola asíncrona de frames con preprocesado en un hilo nativo          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Anillo acotado de 2–3 slots: el callback de cámara encola planos, un hilo    ║
+// ║  propio genera el tensor y Dart toma el más reciente descartando los viejos.  ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "yuv_preprocess.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Metadatos del tensor entregado por FrameQueue::acquireLatest.
+ */
+struct QueuedFrameInfo {
+    int64_t frameId;
+    LetterboxParams letterbox;
+    int imageWidth;   // Dimensiones de la imagen ya rotada
+    int imageHeight;
+    int64_t latencyNs;  // Desde submit() hasta que el tensor quedó listo
+};
+
+/**
+ * @brief Contadores acumulados de la cola.
+ */
+struct FrameQueueStats {
+    int64_t submitted;
+    int64_t converted;
+    int64_t dropped;   // Pendientes reemplazados o rechazados al encolar
+    int64_t stale;     // Listos descartados por uno más reciente
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COLA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Cola acotada de frames YUV420 con semántica drop-oldest.
+ *
+ * Cada slot guarda su propia copia de los planos y su tensor (en el formato
+ * de la cola: float32, float16 o cuantizado), de modo que la conversión del
+ * frame N+1 se solapa con la inferencia del frame N.
+ * Estados de un slot: Free → Writing → Pending → Converting → Ready →
+ * Acquired → Free. Un slot Acquired nunca se reutiliza hasta release(), así
+ * que el tensor entregado es estable mientras dure la inferencia.
+ *
+ * submit() y acquireLatest() no bloquean más que el tiempo de copiar los
+ * planos: aptos para llamadas FFI leaf.
+ */
+class FrameQueue {
+public:
+    static constexpr int kMinSlots = 2;
+    static constexpr int kMaxSlots = 3;
+
+    FrameQueue(int slotCount, int targetSize,
+               const TensorOutputFormat& format = TensorOutputFormat{});
+    ~FrameQueue();
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /**
+     * false si el formato no es válido o no se pudieron reservar kMinSlots
+     * tensores. Con el presupuesto justo la cola puede tener menos slots de
+     * los pedidos (slotCount()).
+     */
+    bool valid() const { return valid_; }
+
+    /**
+     * @brief Copia un frame en un slot y lo marca para preprocesar.
+     *
+     * Usa un slot libre; si no hay, reemplaza el pendiente más antiguo y, en
+     * su defecto, el listo más antiguo aún no entregado. Si todos los slots
+     * están en uso (convirtiendo o entregados) el frame se descarta. Si la
+     * copia no cabe en el presupuesto de memoria se preprocesa en el hilo
+     * llamador, como convertInPlace().
+     *
+     * @return Id del frame (creciente), o -1 si se descartó o es inválido
+     */
+    int64_t submit(
+        const uint8_t* yPlane, size_t yLength,
+        const uint8_t* uPlane, size_t uLength,
+        const uint8_t* vPlane, size_t vLength,
+        int width, int height,
+        int yRowStride, int uvRowStride, int uvPixelStride,
+        int sensorOrientation, bool mirror
+    );
+
+    /**
+     * @brief Preprocesa en el hilo llamador directamente desde planos ajenos
+     *        y deja el tensor listo, sin copiar los planos.
+     *
+     * Para productores que ya tienen los planos bloqueados durante la
+     * llamada (AImage de un AImageReader). Mismo reemplazo drop-oldest que
+     * submit().
+     *
+     * @return Id del frame, o -1 si se descartó o es inválido
+     */
+    int64_t convertInPlace(
+        const uint8_t* yPlane,
+        const uint8_t* uPlane,
+        const uint8_t* vPlane,
+        int width, int height,
+        int yRowStride, int uvRowStride, int uvPixelStride,
+        int sensorOrientation, bool mirror
+    );
+
+    /**
+     * @brief Entrega el tensor listo más reciente y descarta los anteriores.
+     * @return Índice del slot (queda Acquired), o -1 si no hay ninguno listo
+     */
+    int acquireLatest(QueuedFrameInfo* info);
+
+    /**
+     * Tensor del slot (targetSize² * 3 elementos del formato de la cola), o
+     * nullptr si no es válido.
+     */
+    void* tensor(int slot) const;
+
+    /** Devuelve un slot entregado por acquireLatest a la cola. */
+    bool release(int slot);
+
+    FrameQueueStats stats() const;
+
+    int slotCount() const { return static_cast<int>(slots_.size()); }
+    int targetSize() const { return targetSize_; }
+    const TensorOutputFormat& format() const { return format_; }
+
+private:
+    enum class SlotState { Free, Writing, Pending, Converting, Ready, Acquired };
+
+    struct Slot {
+        SlotState state = SlotState::Free;
+        int64_t frameId = -1;
+        int64_t submitNs = 0;
+        int64_t readyNs = 0;
+
+        // Copia de los planos (un solo bloque: Y, U, V consecutivos)
+        uint8_t* planes = nullptr;
+        size_t planesCapacity = 0;
+        size_t uOffset = 0;
+        size_t vOffset = 0;
+
+        int width = 0;
+        int height = 0;
+        int yRowStride = 0;
+        int uvRowStride = 0;
+        int uvPixelStride = 0;
+        int sensorOrientation = 0;
+        bool mirror = false;
+
+        void* tensor = nullptr;
+        LetterboxParams letterbox{};
+    };
+
+    int claimSlotLocked();
+    int oldestLocked(SlotState state) const;
+    void workerLoop();
+
+    const int targetSize_;
+    const TensorOutputFormat format_;
+    bool valid_ = false;
+    std::vector<Slot> slots_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable pending_;
+    std::thread worker_;
+    bool stop_ = false;
+
+    int64_t nextFrameId_ = 0;
+    FrameQueueStats stats_{};
+};
+
+#endif // FRAME_QUEUE_H
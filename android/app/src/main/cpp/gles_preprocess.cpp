@@ -0,0 +1,477 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           gles_preprocess.cpp                                 ║
+// ║          Preprocesamiento YUV420 → tensor en compute shader GLES 3.1          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "gles_preprocess.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl31.h>
+#include <android/log.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "yuv_preprocess_internal.h"
+
+#define LOG_TAG "NutriVisionGles"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SELECCIÓN DE BACKEND
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+std::atomic<int32_t> requestedBackend{static_cast<int32_t>(PreprocessBackend::Cpu)};
+std::atomic<int32_t> lastBackend{static_cast<int32_t>(PreprocessBackend::Cpu)};
+
+} // namespace
+
+void setPreprocessBackend(PreprocessBackend backend) {
+    requestedBackend.store(static_cast<int32_t>(backend), std::memory_order_relaxed);
+}
+
+PreprocessBackend preprocessBackend() {
+    return static_cast<PreprocessBackend>(requestedBackend.load(std::memory_order_relaxed));
+}
+
+const char* preprocessBackendName() {
+    return lastBackend.load(std::memory_order_relaxed) ==
+                   static_cast<int32_t>(PreprocessBackend::Gpu)
+               ? "gles31"
+               : "cpu";
+}
+
+void notePreprocessBackendUsed(PreprocessBackend backend) {
+    lastBackend.store(static_cast<int32_t>(backend), std::memory_order_relaxed);
+}
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SHADER
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Grupo de trabajo: bloques de 8×8 píxeles del tensor
+constexpr int kLocalSize = 8;
+
+// Bindings de los SSBO (GLES 3.1 garantiza solo 4 por etapa de cómputo)
+enum Binding : GLuint {
+    kBindingLuma = 0,
+    kBindingChroma = 1,
+    kBindingTaps = 2,
+    kBindingTensor = 3,
+    kBindingCount = 4,
+};
+
+// Ubicaciones explícitas de los uniforms
+constexpr GLint kUniformRegion = 0;
+constexpr GLint kUniformTargetSize = 1;
+constexpr GLint kUniformVOffset = 2;
+constexpr GLint kUniformPadValue = 3;
+constexpr GLint kUniformChannelStride = 4;
+constexpr GLint kUniformLut = 5;
+
+/**
+ * Traducción directa de sampleRow + yuvToRgbPixelQ8: la aritmética entera es
+ * la misma (>> sobre int con signo extiende el signo en GLSL ES) y el float
+ * final sale de la misma LUT, así que el tensor coincide bit a bit.
+ *
+ * Los planos llegan como uint[] (bytes empaquetados little-endian). Las
+ * tablas de columnas ocupan taps[0, newWidth) y las de filas le siguen.
+ */
+const char* kComputeShader = R"(#version 310 es
+layout(local_size_x = 8, local_size_y = 8) in;
+
+struct AxisTap {
+    int luma0;
+    int luma1;
+    int chroma0;
+    int chroma1;
+    int weight1;
+};
+
+layout(std430, binding = 0) readonly buffer LumaPlane { uint luma[]; };
+layout(std430, binding = 1) readonly buffer ChromaPlanes { uint chroma[]; };
+layout(std430, binding = 2) readonly buffer SamplingTaps { AxisTap taps[]; };
+layout(std430, binding = 3) writeonly buffer Tensor { float tensor[]; };
+
+layout(location = 0) uniform ivec4 uRegion;  // padLeft, padTop, newWidth, newHeight
+layout(location = 1) uniform int uTargetSize;
+layout(location = 2) uniform int uVOffset;
+layout(location = 3) uniform float uPadValue;
+layout(location = 4) uniform int uChannelStride;  // 1 en NHWC, targetSize² en NCHW
+layout(location = 5) uniform float uLut[256];
+
+int lumaAt(int i) {
+    return int((luma[i >> 2] >> (uint(i & 3) * 8u)) & 0xFFu);
+}
+
+int chromaAt(int i) {
+    return int((chroma[i >> 2] >> (uint(i & 3) * 8u)) & 0xFFu);
+}
+
+int bilinear(int p00, int p01, int p10, int p11, int wx, int wy) {
+    int top = p00 * (256 - wx) + p01 * wx;
+    int bottom = p10 * (256 - wx) + p11 * wx;
+    return (top * (256 - wy) + bottom * wy + 32768) >> 16;
+}
+
+void main() {
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    if (p.x >= uTargetSize || p.y >= uTargetSize) return;
+
+    int pixel = p.y * uTargetSize + p.x;
+    int base = uChannelStride == 1 ? pixel * 3 : pixel;
+    int tx = p.x - uRegion.x;
+    int ty = p.y - uRegion.y;
+    if (tx < 0 || ty < 0 || tx >= uRegion.z || ty >= uRegion.w) {
+        tensor[base] = uPadValue;
+        tensor[base + uChannelStride] = uPadValue;
+        tensor[base + 2 * uChannelStride] = uPadValue;
+        return;
+    }
+
+    AxisTap col = taps[tx];
+    AxisTap row = taps[uRegion.z + ty];
+    int wx = col.weight1;
+    int wy = row.weight1;
+
+    int y = bilinear(lumaAt(row.luma0 + col.luma0), lumaAt(row.luma0 + col.luma1),
+                     lumaAt(row.luma1 + col.luma0), lumaAt(row.luma1 + col.luma1),
+                     wx, wy);
+    int u = bilinear(chromaAt(row.chroma0 + col.chroma0), chromaAt(row.chroma0 + col.chroma1),
+                     chromaAt(row.chroma1 + col.chroma0), chromaAt(row.chroma1 + col.chroma1),
+                     wx, wy);
+    int v = bilinear(chromaAt(uVOffset + row.chroma0 + col.chroma0),
+                     chromaAt(uVOffset + row.chroma0 + col.chroma1),
+                     chromaAt(uVOffset + row.chroma1 + col.chroma0),
+                     chromaAt(uVOffset + row.chroma1 + col.chroma1),
+                     wx, wy);
+
+    int du = u - 128;
+    int dv = v - 128;
+    int r = clamp(y + ((359 * dv) >> 8), 0, 255);
+    int g = clamp(y - ((88 * du) >> 8) - ((183 * dv) >> 8), 0, 255);
+    int b = clamp(y + ((454 * du) >> 8), 0, 255);
+
+    tensor[base] = uLut[r];
+    tensor[base + uChannelStride] = uLut[g];
+    tensor[base + 2 * uChannelStride] = uLut[b];
+}
+)";
+
+static_assert(sizeof(AxisTap) == 5 * sizeof(int32_t),
+              "AxisTap debe coincidir con el struct std430 del shader");
+
+inline size_t alignTo4(size_t bytes) {
+    return (bytes + 3) & ~static_cast<size_t>(3);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONTEXTO POR HILO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Contexto EGL propio del hilo que preprocesa, con el programa y los SSBO.
+ *
+ * Se hace actual solo durante cada frame y después se restaura el contexto
+ * que tuviera el hilo, por si el llamador ya usa GL.
+ */
+class GlesContext {
+public:
+    ~GlesContext() { destroy(); }
+
+    /** true si el contexto existe o se acaba de crear; false si falló. */
+    bool ensure() {
+        if (failed_) return false;
+        if (ready_) return true;
+        ready_ = init();
+        if (!ready_) {
+            failed_ = true;
+            destroy();
+        }
+        return ready_;
+    }
+
+    /** Deshabilita el contexto tras un error (el hilo vuelve a CPU). */
+    void fail() {
+        failed_ = true;
+        ready_ = false;
+        destroy();
+    }
+
+    bool makeCurrent() {
+        savedDisplay_ = eglGetCurrentDisplay();
+        savedDraw_ = eglGetCurrentSurface(EGL_DRAW);
+        savedRead_ = eglGetCurrentSurface(EGL_READ);
+        savedContext_ = eglGetCurrentContext();
+        return eglMakeCurrent(display_, surface_, surface_, context_) == EGL_TRUE;
+    }
+
+    void restoreCurrent() {
+        if (savedContext_ != EGL_NO_CONTEXT) {
+            eglMakeCurrent(savedDisplay_, savedDraw_, savedRead_, savedContext_);
+        } else {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+    }
+
+    /**
+     * Asegura capacidad para bytes en el SSBO y sube data (si no es nullptr)
+     * a partir de offset. Deja el buffer enlazado a GL_SHADER_STORAGE_BUFFER.
+     */
+    void upload(Binding binding, size_t capacity, const void* data,
+                size_t bytes, size_t offset) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers_[binding]);
+        if (capacity > capacity_[binding]) {
+            glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(capacity),
+                         nullptr, GL_STREAM_DRAW);
+            capacity_[binding] = capacity;
+        }
+        if (data && bytes > 0) {
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(offset),
+                            static_cast<GLsizeiptr>(bytes), data);
+        }
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffers_[binding]);
+    }
+
+    GLuint program() const { return program_; }
+    GLuint buffer(Binding binding) const { return buffers_[binding]; }
+
+private:
+    bool init();
+    bool compileProgram();
+    void destroy();
+
+    bool ready_ = false;
+    bool failed_ = false;
+
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    EGLSurface surface_ = EGL_NO_SURFACE;
+    EGLContext context_ = EGL_NO_CONTEXT;
+
+    EGLDisplay savedDisplay_ = EGL_NO_DISPLAY;
+    EGLSurface savedDraw_ = EGL_NO_SURFACE;
+    EGLSurface savedRead_ = EGL_NO_SURFACE;
+    EGLContext savedContext_ = EGL_NO_CONTEXT;
+
+    GLuint program_ = 0;
+    GLuint buffers_[kBindingCount] = {};
+    size_t capacity_[kBindingCount] = {};
+};
+
+bool GlesContext::init() {
+    display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display_ == EGL_NO_DISPLAY || eglInitialize(display_, nullptr, nullptr) != EGL_TRUE) {
+        LOGE("EGL no disponible");
+        display_ = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE,
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (eglChooseConfig(display_, configAttribs, &config, 1, &configCount) != EGL_TRUE ||
+        configCount < 1) {
+        LOGE("Sin configuración EGL para GLES 3");
+        return false;
+    }
+
+    const EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context_ == EGL_NO_CONTEXT) {
+        LOGE("eglCreateContext falló: 0x%x", eglGetError());
+        return false;
+    }
+
+    // El cómputo no dibuja: basta un pbuffer mínimo para hacer actual
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    surface_ = eglCreatePbufferSurface(display_, config, surfaceAttribs);
+    if (surface_ == EGL_NO_SURFACE) {
+        LOGE("eglCreatePbufferSurface falló: 0x%x", eglGetError());
+        return false;
+    }
+
+    if (!makeCurrent()) {
+        LOGE("eglMakeCurrent falló: 0x%x", eglGetError());
+        return false;
+    }
+
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    bool ok = major > 3 || (major == 3 && minor >= 1);
+    if (!ok) {
+        LOGD("GLES %d.%d sin compute shaders", major, minor);
+    } else {
+        ok = compileProgram();
+    }
+
+    if (ok) {
+        glGenBuffers(kBindingCount, buffers_);
+        glUseProgram(program_);
+        // La LUT es constante: se carga una vez por contexto
+        glUniform1fv(kUniformLut, 256, normalizationLut());
+        glUniform1f(kUniformPadValue, kPadValue);
+        ok = glGetError() == GL_NO_ERROR;
+    }
+
+    restoreCurrent();
+    if (ok) {
+        LOGD("Compute shader GLES %d.%d listo", major, minor);
+    }
+    return ok;
+}
+
+bool GlesContext::compileProgram() {
+    const GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(shader, 1, &kComputeShader, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[512] = {};
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        LOGE("Compute shader no compila: %s", log);
+        glDeleteShader(shader);
+        return false;
+    }
+
+    program_ = glCreateProgram();
+    glAttachShader(program_, shader);
+    glLinkProgram(program_);
+    glDeleteShader(shader);
+
+    glGetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[512] = {};
+        glGetProgramInfoLog(program_, sizeof(log), nullptr, log);
+        LOGE("Programa de cómputo no enlaza: %s", log);
+        return false;
+    }
+    return true;
+}
+
+void GlesContext::destroy() {
+    if (display_ == EGL_NO_DISPLAY) return;
+
+    if (context_ != EGL_NO_CONTEXT && (program_ != 0 || buffers_[0] != 0) && makeCurrent()) {
+        if (buffers_[0] != 0) glDeleteBuffers(kBindingCount, buffers_);
+        if (program_ != 0) glDeleteProgram(program_);
+        restoreCurrent();
+    }
+    std::memset(buffers_, 0, sizeof(buffers_));
+    std::memset(capacity_, 0, sizeof(capacity_));
+    program_ = 0;
+
+    if (surface_ != EGL_NO_SURFACE) eglDestroySurface(display_, surface_);
+    if (context_ != EGL_NO_CONTEXT) eglDestroyContext(display_, context_);
+    surface_ = EGL_NO_SURFACE;
+    context_ = EGL_NO_CONTEXT;
+    display_ = EGL_NO_DISPLAY;
+}
+
+GlesContext& threadContext() {
+    thread_local GlesContext context;
+    return context;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COMPUTE SHADER
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool glesPreprocessYuv420ToTensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    const LetterboxParams& params,
+    TensorLayout layout,
+    float* tensorOut
+) {
+    GlesContext& gles = threadContext();
+    if (!gles.ensure()) return false;
+
+    // Bytes que el muestreo puede tocar en cada plano (último píxel incluido)
+    const size_t lumaBytes = static_cast<size_t>(yRowStride) * (height - 1) + width;
+    const size_t chromaBytes = static_cast<size_t>(uvRowStride) * ((height - 1) >> 1) +
+                               static_cast<size_t>(uvPixelStride) * ((width - 1) >> 1) + 1;
+    const size_t vOffset = alignTo4(chromaBytes);
+    const size_t tensorBytes =
+        static_cast<size_t>(targetSize) * targetSize * 3 * sizeof(float);
+
+    thread_local AxisTapVector colTaps;
+    thread_local AxisTapVector rowTaps;
+    buildSamplingTaps(colTaps, rowTaps, width, height,
+                      yRowStride, uvRowStride, uvPixelStride,
+                      sensorOrientation, mirror, params.newWidth, params.newHeight);
+    const size_t colBytes = colTaps.size() * sizeof(AxisTap);
+    const size_t rowBytes = rowTaps.size() * sizeof(AxisTap);
+
+    if (!gles.makeCurrent()) {
+        LOGE("eglMakeCurrent falló: 0x%x", eglGetError());
+        gles.fail();
+        return false;
+    }
+
+    glUseProgram(gles.program());
+
+    gles.upload(kBindingLuma, alignTo4(lumaBytes), yPlane, lumaBytes, 0);
+    gles.upload(kBindingChroma, vOffset + alignTo4(chromaBytes), uPlane, chromaBytes, 0);
+    gles.upload(kBindingChroma, 0, vPlane, chromaBytes, vOffset);
+    gles.upload(kBindingTaps, colBytes + rowBytes, colTaps.data(), colBytes, 0);
+    gles.upload(kBindingTaps, 0, rowTaps.data(), rowBytes, colBytes);
+    gles.upload(kBindingTensor, tensorBytes, nullptr, 0, 0);
+
+    glUniform4i(kUniformRegion, params.padLeft, params.padTop,
+                params.newWidth, params.newHeight);
+    glUniform1i(kUniformTargetSize, targetSize);
+    glUniform1i(kUniformVOffset, static_cast<GLint>(vOffset));
+    glUniform1i(kUniformChannelStride,
+                layout == TensorLayout::Nchw ? targetSize * targetSize : 1);
+
+    const GLuint groups = static_cast<GLuint>((targetSize + kLocalSize - 1) / kLocalSize);
+    glDispatchCompute(groups, groups, 1);
+
+    // Hace visibles las escrituras del shader al mapeo del buffer
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    bool ok = false;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gles.buffer(kBindingTensor));
+    const void* mapped = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0,
+                                          static_cast<GLsizeiptr>(tensorBytes),
+                                          GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(tensorOut, mapped, tensorBytes);
+        ok = glUnmapBuffer(GL_SHADER_STORAGE_BUFFER) == GL_TRUE;
+    }
+
+    const GLenum error = glGetError();
+    gles.restoreCurrent();
+
+    if (!ok || error != GL_NO_ERROR) {
+        LOGE("Frame GLES fallido (0x%x): se usa el camino CPU", error);
+        gles.fail();
+        return false;
+    }
+    return true;
+}
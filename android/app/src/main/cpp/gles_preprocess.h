@@ -0,0 +1,83 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            gles_preprocess.h                                  ║
+// ║          Preprocesamiento YUV420 → tensor en compute shader GLES 3.1          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Mismo muestreo, BT.601 Q8 y letterbox que el kernel CPU (bit a bit). Si el   ║
+// ║  contexto EGL no se puede crear o falla un frame, se usa el camino CPU.       ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef GLES_PREPROCESS_H
+#define GLES_PREPROCESS_H
+
+#include <cstdint>
+
+#include "yuv_preprocess.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SELECCIÓN DE BACKEND
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Backend del preprocesado fusionado (preprocessYuv420ToTensor).
+ */
+enum class PreprocessBackend : int32_t {
+    Cpu = 0,  ///< Kernel CPU repartido en el pool de hilos
+    Gpu = 1,  ///< Compute shader GLES 3.1, con el kernel CPU como respaldo
+};
+
+/**
+ * @brief Fija el backend de los frames siguientes (todas las rutas: JNI, FFI,
+ *        cola de frames e ingesta). Por defecto Cpu.
+ */
+void setPreprocessBackend(PreprocessBackend backend);
+
+/**
+ * @brief Backend pedido con setPreprocessBackend.
+ */
+PreprocessBackend preprocessBackend();
+
+/**
+ * @brief Backend que generó el último tensor: "gles31" o "cpu" (cadena
+ *        estática). Con Gpu pedido, "cpu" indica que se usó el respaldo.
+ */
+const char* preprocessBackendName();
+
+/**
+ * @brief Registra qué backend generó el último tensor.
+ */
+void notePreprocessBackendUsed(PreprocessBackend backend);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COMPUTE SHADER
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Genera el tensor float32 completo (padding incluido) en la GPU.
+ *
+ * Cada hilo que llama tiene su propio contexto EGL (pbuffer 1×1), creado en
+ * la primera llamada. Los planos y las tablas de muestreo se suben a SSBOs,
+ * el shader escribe el tensor en otro SSBO y se lee de vuelta a tensorOut.
+ * Tras un error de EGL/GL el contexto del hilo queda deshabilitado.
+ *
+ * @param params Letterbox ya calculado (newWidth/newHeight > 0)
+ * @param layout NHWC intercalado o NCHW planar
+ * @return true si tensorOut quedó escrito; false para usar el camino CPU
+ */
+bool glesPreprocessYuv420ToTensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    const LetterboxParams& params,
+    TensorLayout layout,
+    float* tensorOut
+);
+
+#endif // GLES_PREPROCESS_H
@@ -0,0 +1,122 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            gpu_delegate.cpp                                   ║
+// ║          GPU delegate de TFLite con caché de kernels serializados             ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "gpu_delegate.h"
+
+#include <android/log.h>
+#include <dlfcn.h>
+
+#include <cstdint>
+#include <new>
+
+#define LOG_TAG "NutriVisionGpuDelegate"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SÍMBOLOS DE LIBTENSORFLOWLITE_GPU_JNI
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// TFLITE_GPU_EXPERIMENTAL_FLAGS_ENABLE_SERIALIZATION (delegate_options.h).
+constexpr int64_t kExperimentalFlagEnableSerialization = 1 << 3;
+
+/**
+ * Espejo de TfLiteGpuDelegateOptionsV2 (tensorflow/lite/delegates/gpu/
+ * delegate_options.h) hasta model_token, el último campo que se toca aquí.
+ * Las versiones nuevas añaden campos al final: el relleno deja sitio para
+ * que TfLiteGpuDelegateOptionsV2Default, que devuelve el struct por valor
+ * a través de memoria del llamador, los escriba sin desbordar.
+ */
+struct GpuDelegateOptions {
+    int32_t isPrecisionLossAllowed;
+    int32_t inferencePreference;
+    int32_t inferencePriority1;
+    int32_t inferencePriority2;
+    int32_t inferencePriority3;
+    int64_t experimentalFlags;
+    int32_t maxDelegatedPartitions;
+    const char* serializationDir;
+    const char* modelToken;
+    uint8_t reserved[128];
+};
+
+/**
+ * API C del GPU delegate. tflite_flutter ya carga la biblioteca para su
+ * GpuDelegateV2, así que dlopen normalmente solo devuelve el handle.
+ */
+struct GpuDelegateApi {
+    GpuDelegateOptions (*optionsDefault)() = nullptr;
+    void* (*create)(const GpuDelegateOptions*) = nullptr;
+    void (*destroy)(void*) = nullptr;
+
+    bool loaded() const { return optionsDefault && create && destroy; }
+};
+
+template <typename Fn>
+void resolve(void* library, const char* name, Fn& fn) {
+    fn = reinterpret_cast<Fn>(dlsym(library, name));
+}
+
+const GpuDelegateApi& gpuDelegateApi() {
+    static const GpuDelegateApi api = [] {
+        GpuDelegateApi result;
+        void* library = dlopen("libtensorflowlite_gpu_jni.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            LOGE("libtensorflowlite_gpu_jni.so no disponible: %s", dlerror());
+            return result;
+        }
+
+        resolve(library, "TfLiteGpuDelegateOptionsV2Default", result.optionsDefault);
+        resolve(library, "TfLiteGpuDelegateV2Create", result.create);
+        resolve(library, "TfLiteGpuDelegateV2Delete", result.destroy);
+        if (!result.loaded()) {
+            LOGE("API del GPU delegate incompleta");
+            return GpuDelegateApi{};
+        }
+        return result;
+    }();
+    return api;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DELEGATE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+SerializedGpuDelegate* SerializedGpuDelegate::create(const char* serializationDir,
+                                                     const char* modelToken,
+                                                     bool precisionLossAllowed) {
+    if (!serializationDir || !modelToken || !*serializationDir || !*modelToken) {
+        return nullptr;
+    }
+
+    const GpuDelegateApi& api = gpuDelegateApi();
+    if (!api.loaded()) return nullptr;
+
+    auto* result = new (std::nothrow) SerializedGpuDelegate();
+    if (!result) return nullptr;
+    result->serializationDir_ = serializationDir;
+    result->modelToken_ = modelToken;
+
+    GpuDelegateOptions options = api.optionsDefault();
+    options.isPrecisionLossAllowed = precisionLossAllowed ? 1 : 0;
+    options.experimentalFlags |= kExperimentalFlagEnableSerialization;
+    options.serializationDir = result->serializationDir_.c_str();
+    options.modelToken = result->modelToken_.c_str();
+
+    result->delegate_ = api.create(&options);
+    if (!result->delegate_) {
+        LOGE("TfLiteGpuDelegateV2Create falló");
+        delete result;
+        return nullptr;
+    }
+    return result;
+}
+
+SerializedGpuDelegate::~SerializedGpuDelegate() {
+    if (delegate_) gpuDelegateApi().destroy(delegate_);
+}
@@ -0,0 +1,53 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             gpu_delegate.h                                    ║
+// ║          GPU delegate de TFLite con caché de kernels serializados             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  tflite_flutter no expone serialization_dir/model_token: el delegate se crea  ║
+// ║  aquí con las funciones C de libtensorflowlite_gpu_jni.so (dlsym) y Dart lo   ║
+// ║  añade al intérprete como cualquier otro TfLiteDelegate*.                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef GPU_DELEGATE_H
+#define GPU_DELEGATE_H
+
+#include <string>
+
+/**
+ * @brief GPU delegate (TfLiteGpuDelegateV2) que guarda los programas
+ *        compilados en disco.
+ *
+ * Con serialización, la primera creación del intérprete compila los kernels
+ * OpenCL y los escribe en serializationDir; las siguientes con el mismo
+ * modelToken los cargan en vez de recompilar. Solo el backend OpenCL
+ * serializa: con OpenGL el delegate funciona igual, sin caché.
+ */
+class SerializedGpuDelegate {
+public:
+    /**
+     * @param serializationDir Directorio privado de la app (debe existir)
+     * @param modelToken Identificador del modelo (p. ej. su MD5): cambiarlo
+     *        invalida la caché
+     * @param precisionLossAllowed Permite FP16 en los kernels
+     * @return Delegate, o nullptr si la biblioteca GPU no está o falla
+     */
+    static SerializedGpuDelegate* create(const char* serializationDir, const char* modelToken,
+                                         bool precisionLossAllowed);
+
+    ~SerializedGpuDelegate();
+
+    SerializedGpuDelegate(const SerializedGpuDelegate&) = delete;
+    SerializedGpuDelegate& operator=(const SerializedGpuDelegate&) = delete;
+
+    /** TfLiteDelegate* para TfLiteInterpreterOptionsAddDelegate. */
+    void* delegate() const { return delegate_; }
+
+private:
+    SerializedGpuDelegate() = default;
+
+    // El delegate copia las rutas, pero se conservan por si una versión no lo hace
+    std::string serializationDir_;
+    std::string modelToken_;
+    void* delegate_ = nullptr;
+};
+
+#endif // GPU_DELEGATE_H
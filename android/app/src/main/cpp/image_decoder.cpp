@@ -0,0 +1,205 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            image_decoder.cpp                                  ║
+// ║          Decodificación de imágenes JPEG/PNG/WebP con AImageDecoder           ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "image_decoder.h"
+
+#include <android/api-level.h>
+#include <android/bitmap.h>
+#include <android/imagedecoder.h>
+#include <android/log.h>
+#include <dlfcn.h>
+
+#include "native_memory.h"
+#include "native_stats.h"
+#include "yuv_preprocess.h"
+
+#define LOG_TAG "NutriVisionDecoder"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SÍMBOLOS DE LIBJNIGRAPHICS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Funciones de AImageDecoder (API 30). Se resuelven una vez: la biblioteca
+ * ya enlaza libjnigraphics, así que dlopen solo devuelve el handle cargado.
+ */
+struct DecoderApi {
+    int (*createFromBuffer)(const void*, size_t, AImageDecoder**) = nullptr;
+    const AImageDecoderHeaderInfo* (*getHeaderInfo)(const AImageDecoder*) = nullptr;
+    int32_t (*headerWidth)(const AImageDecoderHeaderInfo*) = nullptr;
+    int32_t (*headerHeight)(const AImageDecoderHeaderInfo*) = nullptr;
+    int (*setAndroidBitmapFormat)(AImageDecoder*, int32_t) = nullptr;
+    int (*setUnpremultipliedRequired)(AImageDecoder*, bool) = nullptr;
+    int (*computeSampledSize)(const AImageDecoder*, int, int32_t*, int32_t*) = nullptr;
+    int (*setTargetSize)(AImageDecoder*, int32_t, int32_t) = nullptr;
+    size_t (*getMinimumStride)(AImageDecoder*) = nullptr;
+    int (*decodeImage)(AImageDecoder*, void*, size_t, size_t) = nullptr;
+    void (*destroy)(AImageDecoder*) = nullptr;
+
+    bool loaded() const {
+        return createFromBuffer && getHeaderInfo && headerWidth && headerHeight &&
+               setAndroidBitmapFormat && setUnpremultipliedRequired &&
+               computeSampledSize && setTargetSize && getMinimumStride && decodeImage && destroy;
+    }
+};
+
+template <typename Fn>
+void resolve(void* library, const char* name, Fn& fn) {
+    fn = reinterpret_cast<Fn>(dlsym(library, name));
+}
+
+const DecoderApi& decoderApi() {
+    static const DecoderApi api = [] {
+        DecoderApi result;
+        if (android_get_device_api_level() < 30) return result;
+
+        void* library = dlopen("libjnigraphics.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) return result;
+
+        resolve(library, "AImageDecoder_createFromBuffer", result.createFromBuffer);
+        resolve(library, "AImageDecoder_getHeaderInfo", result.getHeaderInfo);
+        resolve(library, "AImageDecoderHeaderInfo_getWidth", result.headerWidth);
+        resolve(library, "AImageDecoderHeaderInfo_getHeight", result.headerHeight);
+        resolve(library, "AImageDecoder_setAndroidBitmapFormat", result.setAndroidBitmapFormat);
+        resolve(library, "AImageDecoder_setUnpremultipliedRequired",
+                result.setUnpremultipliedRequired);
+        resolve(library, "AImageDecoder_computeSampledSize", result.computeSampledSize);
+        resolve(library, "AImageDecoder_setTargetSize", result.setTargetSize);
+        resolve(library, "AImageDecoder_getMinimumStride", result.getMinimumStride);
+        resolve(library, "AImageDecoder_decodeImage", result.decodeImage);
+        resolve(library, "AImageDecoder_delete", result.destroy);
+        if (!result.loaded()) {
+            LOGE("AImageDecoder incompleto en libjnigraphics");
+            return DecoderApi{};
+        }
+        return result;
+    }();
+    return api;
+}
+
+/// Submuestreo máximo probado (JPEG escala en DCT hasta 1/8).
+constexpr int kMaxSampleSize = 64;
+
+/**
+ * Reduce la salida al mayor submuestreo potencia de 2 cuyas dimensiones
+ * siguen cubriendo la zona útil del letterbox (sin ampliar después). Si el
+ * RGBA no cabe en maxBytes (presupuesto de memoria) sigue reduciendo aunque
+ * deje de cubrirla: mejor un tensor ampliado que una reserva rechazada.
+ * width/height pasan a ser las de salida.
+ */
+void applyTargetSize(const DecoderApi& api, AImageDecoder* decoder,
+                     int& width, int& height, int targetSize, size_t maxBytes) {
+    // Sin targetSize no hay zona útil que cubrir: solo manda el presupuesto
+    const LetterboxParams params = targetSize > 0
+        ? computeLetterbox(width, height, targetSize)
+        : LetterboxParams{};
+    if (targetSize > 0 && (params.newWidth <= 0 || params.newHeight <= 0)) return;
+
+    auto rgbaBytes = [](int32_t w, int32_t h) { return static_cast<size_t>(w) * h * 4; };
+
+    int32_t bestWidth = width;
+    int32_t bestHeight = height;
+    for (int sample = 2; sample <= kMaxSampleSize; sample *= 2) {
+        int32_t sampledWidth = 0;
+        int32_t sampledHeight = 0;
+        if (api.computeSampledSize(decoder, sample, &sampledWidth, &sampledHeight) !=
+            ANDROID_IMAGE_DECODER_SUCCESS) {
+            break;
+        }
+        const bool covers = targetSize > 0 &&
+                            sampledWidth >= params.newWidth && sampledHeight >= params.newHeight;
+        if (!covers && rgbaBytes(bestWidth, bestHeight) <= maxBytes) break;
+        bestWidth = sampledWidth;
+        bestHeight = sampledHeight;
+    }
+
+    if (bestWidth < params.newWidth || bestHeight < params.newHeight ||
+        (targetSize <= 0 && bestWidth != width)) {
+        LOGD("Presupuesto de memoria: decodificando %dx%d a %dx%d",
+             width, height, bestWidth, bestHeight);
+    }
+
+    if ((bestWidth != width || bestHeight != height) &&
+        api.setTargetSize(decoder, bestWidth, bestHeight) == ANDROID_IMAGE_DECODER_SUCCESS) {
+        width = bestWidth;
+        height = bestHeight;
+    }
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DECODIFICACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+DecodedImage::~DecodedImage() {
+    alignedFree(pixels);
+}
+
+bool imageDecoderAvailable() {
+    return decoderApi().loaded();
+}
+
+bool decodeImageRgba(const uint8_t* data, size_t length, int targetSize, DecodedImage& out) {
+    const DecoderApi& api = decoderApi();
+    if (!api.loaded() || !data || length == 0) return false;
+
+    ScopedStageTimer timer(NativeStage::ImageDecode, static_cast<int64_t>(length));
+
+    AImageDecoder* decoder = nullptr;
+    int status = api.createFromBuffer(data, length, &decoder);
+    if (status != ANDROID_IMAGE_DECODER_SUCCESS || !decoder) {
+        LOGE("AImageDecoder_createFromBuffer falló: %d", status);
+        return false;
+    }
+
+    // RGBA sin premultiplicar: el tensor usa el color tal cual (PNG con alfa)
+    api.setAndroidBitmapFormat(decoder, ANDROID_BITMAP_FORMAT_RGBA_8888);
+    api.setUnpremultipliedRequired(decoder, true);
+
+    // Dimensiones de la imagen ya orientada según su EXIF
+    const AImageDecoderHeaderInfo* info = api.getHeaderInfo(decoder);
+    const int sourceWidth = api.headerWidth(info);
+    const int sourceHeight = api.headerHeight(info);
+    int width = sourceWidth;
+    int height = sourceHeight;
+    // El buffer actual se libera antes de reservar, así que cuenta como libre
+    const size_t headroom = memoryHeadroom();
+    const size_t maxBytes = headroom == SIZE_MAX ? SIZE_MAX : headroom + out.capacity;
+    if ((targetSize > 0 || maxBytes != SIZE_MAX) && width > 0 && height > 0) {
+        applyTargetSize(api, decoder, width, height, targetSize, maxBytes);
+    }
+
+    // getMinimumStride ya refleja el tamaño de salida elegido
+    const size_t stride = api.getMinimumStride(decoder);
+    const size_t bytes = stride * static_cast<size_t>(height);
+
+    bool decoded = false;
+    if (width > 0 && height > 0 && bytes > out.capacity) {
+        alignedFree(out.pixels);
+        out.pixels = static_cast<uint8_t*>(alignedAlloc(bytes, MemoryArena::Decode));
+        out.capacity = out.pixels ? bytes : 0;
+        if (!out.pixels) LOGE("Sin memoria para decodificar %dx%d", width, height);
+    }
+    if (width > 0 && height > 0 && out.pixels) {
+        status = api.decodeImage(decoder, out.pixels, stride, bytes);
+        decoded = status == ANDROID_IMAGE_DECODER_SUCCESS;
+        if (!decoded) LOGE("AImageDecoder_decodeImage falló: %d", status);
+    }
+    api.destroy(decoder);
+
+    if (!decoded) return false;
+    out.width = width;
+    out.height = height;
+    out.sourceWidth = sourceWidth;
+    out.sourceHeight = sourceHeight;
+    out.rowStride = static_cast<int>(stride);
+    timer.setBytes(static_cast<int64_t>(length) + static_cast<int64_t>(bytes));
+    return true;
+}
@@ -0,0 +1,67 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             image_decoder.h                                   ║
+// ║          Decodificación de imágenes JPEG/PNG/WebP con AImageDecoder           ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  AImageDecoder existe desde API 30 y minSdk es 26: las funciones se           ║
+// ║  resuelven con dlsym y, si no están, la decodificación no está disponible.    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DECODIFICACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Imagen decodificada a RGBA8888 sin premultiplicar, ya orientada
+ *        según su EXIF.
+ *
+ * El buffer conserva su capacidad entre decodificaciones: reutilizar la misma
+ * instancia evita reservar en cada imagen.
+ */
+struct DecodedImage {
+    uint8_t* pixels = nullptr;  // alignedAlloc
+    size_t capacity = 0;
+    int width = 0;         // Dimensiones decodificadas (reducidas si se pidió)
+    int height = 0;
+    int rowStride = 0;     // Bytes entre filas (>= width * 4)
+    int sourceWidth = 0;   // Dimensiones completas de la imagen orientada
+    int sourceHeight = 0;
+
+    DecodedImage() = default;
+    ~DecodedImage();
+
+    DecodedImage(const DecodedImage&) = delete;
+    DecodedImage& operator=(const DecodedImage&) = delete;
+};
+
+/**
+ * @brief true si AImageDecoder está disponible (Android 11+).
+ */
+bool imageDecoderAvailable();
+
+/**
+ * @brief Decodifica una imagen codificada (JPEG, PNG, WebP, HEIF...).
+ *
+ * AImageDecoder aplica la orientación EXIF al decodificar (mismo
+ * comportamiento que android.graphics.ImageDecoder), así que width/height y
+ * sourceWidth/sourceHeight ya son los de la imagen orientada.
+ *
+ * Con targetSize > 0 la imagen se decodifica reducida: se elige el mayor
+ * submuestreo potencia de 2 (escalado DCT en JPEG) que aún cubre la zona útil
+ * del letterbox a targetSize, de modo que una foto de 12 MP ocupa unos pocos
+ * MB en vez de ~48 MB de RGBA y el letterbox solo reduce el resto.
+ *
+ * @param data       Bytes del archivo; solo se leen durante la llamada
+ * @param length     Longitud de data
+ * @param targetSize Lado del tensor de destino, o 0 para resolución completa
+ * @param out        Imagen de salida
+ * @return false si no hay decodificador o el archivo no es válido
+ */
+bool decodeImageRgba(const uint8_t* data, size_t length, int targetSize, DecodedImage& out);
+
+#endif // IMAGE_DECODER_H
@@ -0,0 +1,184 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                         image_reader_ingest.cpp                               ║
+// ║          Ingesta de cámara nativa vía AImageReader (YUV_420_888)              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "image_reader_ingest.h"
+
+#include <android/hardware_buffer.h>
+#include <android/log.h>
+#include <media/NdkImage.h>
+
+#include <mutex>
+#include <new>
+
+#include "native_stats.h"
+
+#define LOG_TAG "NutriVisionIngest"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CICLO DE VIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+std::unique_ptr<ImageReaderIngest> ImageReaderIngest::create(
+    int width, int height, int maxImages,
+    int sensorOrientation, bool mirror, int targetSize,
+    const TensorOutputFormat& format
+) {
+    if (width <= 0 || height <= 0 || targetSize <= 0 || !validTensorFormat(format)) {
+        return nullptr;
+    }
+    if (maxImages <= 0) maxImages = kDefaultMaxImages;
+
+    AImageReader* reader = nullptr;
+    media_status_t status = AImageReader_newWithUsage(
+        width, height, AIMAGE_FORMAT_YUV_420_888,
+        AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, maxImages, &reader);
+    if (status != AMEDIA_OK || !reader) {
+        LOGE("AImageReader_newWithUsage falló: %d", status);
+        return nullptr;
+    }
+
+    ANativeWindow* window = nullptr;
+    status = AImageReader_getWindow(reader, &window);
+    if (status != AMEDIA_OK || !window) {
+        LOGE("AImageReader_getWindow falló: %d", status);
+        AImageReader_delete(reader);
+        return nullptr;
+    }
+
+    std::unique_ptr<ImageReaderIngest> ingest(new (std::nothrow) ImageReaderIngest(
+        reader, window, sensorOrientation, mirror, targetSize, format));
+    if (!ingest || !ingest->queue_.valid()) {
+        if (!ingest) AImageReader_delete(reader);
+        return nullptr;
+    }
+
+    AImageReader_ImageListener listener{ingest.get(), &ImageReaderIngest::onImageAvailable};
+    status = AImageReader_setImageListener(reader, &listener);
+    if (status != AMEDIA_OK) {
+        LOGE("AImageReader_setImageListener falló: %d", status);
+        return nullptr;
+    }
+
+    LOGD("Ingesta nativa %dx%d (%d imágenes, tensor %d)",
+         width, height, maxImages, targetSize);
+    return ingest;
+}
+
+ImageReaderIngest::ImageReaderIngest(AImageReader* reader, ANativeWindow* window,
+                                     int sensorOrientation, bool mirror, int targetSize,
+                                     const TensorOutputFormat& format)
+    : reader_(reader),
+      window_(window),
+      queue_(FrameQueue::kMaxSlots, targetSize, format),
+      sensorOrientation_(sensorOrientation),
+      mirror_(mirror) {}
+
+ImageReaderIngest::~ImageReaderIngest() {
+    // Sin listener no llegan más callbacks; AImageReader_delete detiene el
+    // hilo del lector y cierra las imágenes que sigan abiertas
+    AImageReader_setImageListener(reader_, nullptr);
+    AImageReader_delete(reader_);
+}
+
+void ImageReaderIngest::setOrientation(int sensorOrientation, bool mirror) {
+    sensorOrientation_.store(sensorOrientation, std::memory_order_relaxed);
+    mirror_.store(mirror, std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FRAMES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void ImageReaderIngest::onImageAvailable(void* context, AImageReader* reader) {
+    AImage* image = nullptr;
+    // La más reciente: las anteriores se cierran sin convertir (drop-oldest
+    // ya en el lector)
+    if (AImageReader_acquireLatestImage(reader, &image) != AMEDIA_OK || !image) {
+        return;
+    }
+    static_cast<ImageReaderIngest*>(context)->handleImage(image);
+    AImage_delete(image);
+}
+
+void ImageReaderIngest::handleImage(AImage* image) {
+    received_.fetch_add(1, std::memory_order_relaxed);
+
+    int32_t width = 0;
+    int32_t height = 0;
+    AImage_getWidth(image, &width);
+    AImage_getHeight(image, &height);
+
+    uint8_t* planes[3] = {nullptr, nullptr, nullptr};
+    int32_t rowStrides[3] = {0, 0, 0};
+    int32_t uvPixelStride = 0;
+    {
+        ScopedStageTimer timer(NativeStage::PlaneAccess);
+        for (int i = 0; i < 3; ++i) {
+            int length = 0;
+            if (AImage_getPlaneData(image, i, &planes[i], &length) != AMEDIA_OK ||
+                AImage_getPlaneRowStride(image, i, &rowStrides[i]) != AMEDIA_OK) {
+                LOGE("Plano %d no disponible", i);
+                return;
+            }
+        }
+        AImage_getPlanePixelStride(image, 1, &uvPixelStride);
+    }
+
+    queue_.convertInPlace(
+        planes[0], planes[1], planes[2],
+        width, height, rowStrides[0], rowStrides[1], uvPixelStride,
+        sensorOrientation_.load(std::memory_order_relaxed),
+        mirror_.load(std::memory_order_relaxed));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INGESTA ACTIVA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+std::mutex& activeIngestMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::shared_ptr<ImageReaderIngest>& activeIngestSlot() {
+    static std::shared_ptr<ImageReaderIngest> ingest;
+    return ingest;
+}
+
+} // namespace
+
+std::shared_ptr<ImageReaderIngest> startActiveIngest(
+    int width, int height, int maxImages,
+    int sensorOrientation, bool mirror, int targetSize,
+    const TensorOutputFormat& format
+) {
+    // La anterior se suelta antes de crear la nueva: sin referencias de
+    // Dart, su lector se cierra antes de abrir otro
+    stopActiveIngest();
+    std::shared_ptr<ImageReaderIngest> ingest = ImageReaderIngest::create(
+        width, height, maxImages, sensorOrientation, mirror, targetSize, format);
+
+    std::lock_guard<std::mutex> lock(activeIngestMutex());
+    activeIngestSlot() = ingest;
+    return ingest;
+}
+
+void stopActiveIngest() {
+    // Se destruye fuera del mutex (si era la última referencia)
+    std::shared_ptr<ImageReaderIngest> ingest;
+    {
+        std::lock_guard<std::mutex> lock(activeIngestMutex());
+        ingest = std::move(activeIngestSlot());
+    }
+}
+
+std::shared_ptr<ImageReaderIngest> activeIngest() {
+    std::lock_guard<std::mutex> lock(activeIngestMutex());
+    return activeIngestSlot();
+}
@@ -0,0 +1,111 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          image_reader_ingest.h                                ║
+// ║          Ingesta de cámara nativa vía AImageReader (YUV_420_888)              ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  La sesión Camera2 escribe en la Surface del lector; cada AImage se           ║
+// ║  preprocesa desde sus planos bloqueados, sin copias a Java ni a Dart.         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef IMAGE_READER_INGEST_H
+#define IMAGE_READER_INGEST_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <android/native_window.h>
+#include <media/NdkImageReader.h>
+
+#include "frame_queue.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INGESTA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Lector YUV_420_888 cuyos frames alimentan un FrameQueue.
+ *
+ * Los buffers del lector se piden con AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN,
+ * así que los planos que entrega AImage son la memoria del AHardwareBuffer
+ * escrita por la cámara. El listener corre en el hilo interno del lector:
+ * toma la imagen más reciente (las anteriores se cierran sin convertir),
+ * preprocesa directamente desde sus planos con FrameQueue::convertInPlace y
+ * la devuelve al lector. Dart consume el tensor con nv_frame_queue_acquire.
+ */
+class ImageReaderIngest {
+public:
+    /// Imágenes en vuelo del lector (una convirtiendo, una en cola).
+    static constexpr int kDefaultMaxImages = 2;
+
+    /**
+     * @brief Crea el lector y su cola de tensores.
+     * @return Instancia, o nullptr si falla AImageReader o la reserva
+     */
+    static std::unique_ptr<ImageReaderIngest> create(
+        int width, int height, int maxImages,
+        int sensorOrientation, bool mirror, int targetSize,
+        const TensorOutputFormat& format = TensorOutputFormat{}
+    );
+
+    ~ImageReaderIngest();
+
+    ImageReaderIngest(const ImageReaderIngest&) = delete;
+    ImageReaderIngest& operator=(const ImageReaderIngest&) = delete;
+
+    /** Ventana del lector (destino de la sesión de captura). No liberar. */
+    ANativeWindow* window() const { return window_; }
+
+    /** Cola con los tensores listos. */
+    FrameQueue& queue() { return queue_; }
+
+    /** Cambia rotación y espejo (p. ej. al girar el dispositivo). */
+    void setOrientation(int sensorOrientation, bool mirror);
+
+    /** Imágenes recibidas del lector (convertidas o no). */
+    int64_t receivedFrames() const { return received_.load(std::memory_order_relaxed); }
+
+private:
+    ImageReaderIngest(AImageReader* reader, ANativeWindow* window,
+                      int sensorOrientation, bool mirror, int targetSize,
+                      const TensorOutputFormat& format);
+
+    static void onImageAvailable(void* context, AImageReader* reader);
+    void handleImage(AImage* image);
+
+    AImageReader* reader_;
+    ANativeWindow* window_;
+    FrameQueue queue_;
+    std::atomic<int> sensorOrientation_;
+    std::atomic<bool> mirror_;
+    std::atomic<int64_t> received_{0};
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INGESTA ACTIVA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Reemplaza la ingesta activa (una por proceso) por una nueva.
+ *
+ * La crea JNI (la sesión Camera2 vive en Kotlin) y la consume dart:ffi. La
+ * anterior se destruye cuando suelta su última referencia (nv_ingest_release
+ * si Dart aún la tiene).
+ * @return Ingesta creada, o nullptr si falla
+ */
+std::shared_ptr<ImageReaderIngest> startActiveIngest(
+    int width, int height, int maxImages,
+    int sensorOrientation, bool mirror, int targetSize,
+    const TensorOutputFormat& format = TensorOutputFormat{}
+);
+
+/**
+ * @brief Suelta la ingesta activa. La sesión de captura ya debe estar
+ *        cerrada; si Dart todavía tiene una referencia, la ingesta vive
+ *        hasta que la libere.
+ */
+void stopActiveIngest();
+
+/** Referencia a la ingesta activa, o nullptr. */
+std::shared_ptr<ImageReaderIngest> activeIngest();
+
+#endif // IMAGE_READER_INGEST_H
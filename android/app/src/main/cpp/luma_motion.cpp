@@ -0,0 +1,140 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             luma_motion.cpp                                   ║
+// ║          Puntaje de cambio entre frames a partir del plano Y                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "luma_motion.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "native_stats.h"
+
+// Para instrucciones NEON en ARM
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+namespace {
+
+constexpr int kRegionWidth = LumaMotionDetector::kThumbWidth / LumaMotionDetector::kRegionsX;
+constexpr int kRegionHeight = LumaMotionDetector::kThumbHeight / LumaMotionDetector::kRegionsY;
+
+static_assert(kRegionWidth == 16, "Una fila de región debe ser un vector de 16 bytes");
+static_assert(kRegionHeight * 2 * 255 <= 65535, "El acumulador u16 no debe desbordar");
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SAD
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Suma de diferencias absolutas de una región (kRegionHeight filas de
+ * kRegionWidth celdas) entre dos miniaturas de ancho `stride`.
+ */
+uint32_t regionSad(const uint8_t* a, const uint8_t* b, int stride) {
+#if USE_NEON
+    uint16x8_t acc = vdupq_n_u16(0);
+    for (int row = 0; row < kRegionHeight; row++) {
+        const uint8x16_t diff = vabdq_u8(vld1q_u8(a + row * stride), vld1q_u8(b + row * stride));
+        acc = vpadalq_u8(acc, diff);
+    }
+    const uint64x2_t total = vpaddlq_u32(vpaddlq_u16(acc));
+    return static_cast<uint32_t>(vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1));
+#else
+    uint32_t sum = 0;
+    for (int row = 0; row < kRegionHeight; row++) {
+        for (int col = 0; col < kRegionWidth; col++) {
+            sum += static_cast<uint32_t>(
+                std::abs(a[row * stride + col] - b[row * stride + col]));
+        }
+    }
+    return sum;
+#endif
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MINIATURA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void LumaMotionDetector::buildThumbnail(const uint8_t* yPlane, int yRowStride) {
+    for (int ty = 0; ty < kThumbHeight; ty++) {
+        const uint8_t* rows[kSamples];
+        for (int s = 0; s < kSamples; s++) {
+            rows[s] = yPlane + static_cast<size_t>(sampleRows_[ty * kSamples + s]) * yRowStride;
+        }
+
+        uint8_t* out = current_ + ty * kThumbWidth;
+        for (int tx = 0; tx < kThumbWidth; tx++) {
+            const int* columns = sampleColumns_ + tx * kSamples;
+            uint32_t sum = 0;
+            for (int s = 0; s < kSamples; s++) {
+                const uint8_t* row = rows[s];
+                sum += row[columns[0]] + row[columns[1]] + row[columns[2]] + row[columns[3]];
+            }
+            out[tx] = static_cast<uint8_t>((sum + kSamples * kSamples / 2) /
+                                           (kSamples * kSamples));
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PUNTAJE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+float LumaMotionDetector::score(const uint8_t* yPlane, size_t yLength, int width, int height,
+                                int yRowStride) {
+    if (!yPlane || width <= 0 || height <= 0 || yRowStride < width ||
+        yLength < static_cast<size_t>(yRowStride) * (height - 1) + width) {
+        return -1.0f;
+    }
+
+    ScopedStageTimer timer(NativeStage::MotionScore,
+                           static_cast<int64_t>(kCells) * (kSamples * kSamples + 2));
+
+    if (width != width_ || height != height_) {
+        // Centros de kThumbWidth·kSamples (kThumbHeight·kSamples) franjas
+        // iguales: las muestras de cada celda cubren toda su área
+        for (int i = 0; i < kThumbWidth * kSamples; i++) {
+            sampleColumns_[i] = static_cast<int>(
+                (2LL * i + 1) * width / (2 * kThumbWidth * kSamples));
+        }
+        for (int i = 0; i < kThumbHeight * kSamples; i++) {
+            sampleRows_[i] = static_cast<int>(
+                (2LL * i + 1) * height / (2 * kThumbHeight * kSamples));
+        }
+        width_ = width;
+        height_ = height;
+        hasReference_ = false;
+    }
+
+    buildThumbnail(yPlane, yRowStride);
+    hasCurrent_ = true;
+    if (!hasReference_) return kNoReference;
+
+    uint32_t worst = 0;
+    for (int ry = 0; ry < kRegionsY; ry++) {
+        for (int rx = 0; rx < kRegionsX; rx++) {
+            const int offset = ry * kRegionHeight * kThumbWidth + rx * kRegionWidth;
+            worst = std::max(worst, regionSad(current_ + offset, reference_ + offset, kThumbWidth));
+        }
+    }
+    return static_cast<float>(worst) / (kRegionWidth * kRegionHeight);
+}
+
+bool LumaMotionDetector::commitReference() {
+    if (!hasCurrent_) return false;
+    std::memcpy(reference_, current_, kCells);
+    hasReference_ = true;
+    return true;
+}
+
+void LumaMotionDetector::reset() {
+    hasCurrent_ = false;
+    hasReference_ = false;
+}
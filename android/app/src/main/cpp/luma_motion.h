@@ -0,0 +1,86 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              luma_motion.h                                    ║
+// ║          Puntaje de cambio entre frames a partir del plano Y                  ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Miniatura de luma 64×48 por frame y SAD (NEON) contra la miniatura de        ║
+// ║  referencia: decide si vale la pena volver a inferir una escena.              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef LUMA_MOTION_H
+#define LUMA_MOTION_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DETECTOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Detector de cambios de escena sobre el plano Y de la cámara.
+ *
+ * Cada frame se reduce a una miniatura de kThumbWidth × kThumbHeight celdas
+ * (promedio de 4×4 muestras por celda, ~50 K lecturas sin importar la
+ * resolución) y se compara con la miniatura de referencia. El puntaje es la
+ * diferencia absoluta media (0–255 niveles de luma) de la peor de las
+ * kRegionsX × kRegionsY regiones: un objeto que entra en una esquina pesa
+ * igual que un cambio global, y el ruido del sensor queda promediado.
+ *
+ * La referencia solo cambia con commitReference(): el llamador la fija en
+ * el frame que infirió, así que un movimiento lento acumula puntaje hasta
+ * superar el umbral en vez de perderse entre frames consecutivos.
+ *
+ * No es thread-safe: un solo llamador (el isolate de Dart).
+ */
+class LumaMotionDetector {
+public:
+    static constexpr int kThumbWidth = 64;
+    static constexpr int kThumbHeight = 48;
+    static constexpr int kRegionsX = 4;   // 16 celdas por región: un vector NEON
+    static constexpr int kRegionsY = 4;   // 12 filas por región
+
+    /// Puntaje sin referencia (primer frame o tras reset): siempre inferir.
+    static constexpr float kNoReference = 255.0f;
+
+    LumaMotionDetector() = default;
+
+    /**
+     * @brief Reduce el plano Y a la miniatura actual y la compara con la
+     *        referencia.
+     *
+     * Un cambio de resolución descarta la referencia (cambio de cámara).
+     *
+     * @param yLength Bytes disponibles en yPlane
+     * @return Puntaje 0–255, kNoReference si no hay referencia, o -1 si los
+     *         parámetros no son válidos
+     */
+    float score(const uint8_t* yPlane, size_t yLength, int width, int height,
+                int yRowStride);
+
+    /**
+     * @brief Toma la última miniatura de score() como referencia.
+     * @return false si aún no se calculó ninguna
+     */
+    bool commitReference();
+
+    /** Descarta la referencia y la miniatura actual. */
+    void reset();
+
+private:
+    static constexpr int kCells = kThumbWidth * kThumbHeight;
+    static constexpr int kSamples = 4;  // Muestras por eje y celda
+
+    void buildThumbnail(const uint8_t* yPlane, int yRowStride);
+
+    alignas(16) uint8_t current_[kCells] = {};
+    alignas(16) uint8_t reference_[kCells] = {};
+    bool hasCurrent_ = false;
+    bool hasReference_ = false;
+
+    int width_ = 0;
+    int height_ = 0;
+    int sampleColumns_[kThumbWidth * kSamples] = {};
+    int sampleRows_[kThumbHeight * kSamples] = {};
+};
+
+#endif // LUMA_MOTION_H
@@ -1,26 +1,33 @@
 // ╔═══════════════════════════════════════════════════════════════════════════════╗
 // ║                        native_image_processor.cpp                             ║
-// ║              Procesador de imágenes nativo para NutriVision                   ║
+// ║              Bindings JNI del procesador de imágenes nativo                   ║
 // ╠═══════════════════════════════════════════════════════════════════════════════╣
-// ║  Implementación de conversión YUV420 a RGB optimizada con NEON.               ║
-// ║  JNI bindings para acceso desde Dart vía Platform Channels.                   ║
+// ║  Solo bindings JNI de NativeImageProcessor.kt (respaldo MethodChannel de      ║
+// ║  dart:ffi): conversión, pools, tensor, ajustes, stats e ingesta. Los          ║
+// ║  kernels viven en yuv_to_rgb*.cpp y yuv_preprocess.cpp.                       ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
 #include <jni.h>
+#include <android/asset_manager_jni.h>
 #include <android/log.h>
+#include <android/native_window_jni.h>
 #include <cstdint>
 #include <cstring>
-
+#include <mutex>
+#include <new>
+
+#include "cpu_features.h"
+#include "frame_buffer_pool.h"
+#include "gles_preprocess.h"
+#include "image_reader_ingest.h"
+#include "native_memory.h"
+#include "native_stats.h"
+#include "native_trace.h"
+#include "nutrition_index.h"
+#include "thread_pool.h"
+#include "yuv_preprocess.h"
 #include "yuv_to_rgb.h"
 
-// Para instrucciones NEON en ARM
-#if defined(__ARM_NEON) || defined(__ARM_NEON__)
-#include <arm_neon.h>
-#define USE_NEON 1
-#else
-#define USE_NEON 0
-#endif
-
 // ═══════════════════════════════════════════════════════════════════════════════
 // LOGGING
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -30,190 +37,66 @@
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
 // ═══════════════════════════════════════════════════════════════════════════════
-// CONVERSIÓN ESCALAR (Fallback)
+// POOL INTERNO (API JNI LEGACY)
 // ═══════════════════════════════════════════════════════════════════════════════
 
-void convertYuv420ToRgbScalar(
-    const uint8_t* yPlane,
-    const uint8_t* uPlane,
-    const uint8_t* vPlane,
-    uint8_t* rgbOutput,
-    int width,
-    int height,
-    int yRowStride,
-    int uvRowStride,
-    int uvPixelStride
-) {
-    int rgbIndex = 0;
-
-    for (int row = 0; row < height; row++) {
-        for (int col = 0; col < width; col++) {
-            // Índice en plano Y
-            int yIndex = row * yRowStride + col;
-
-            // Índice en planos UV (submuestreado 2x2)
-            int uvRow = row / 2;
-            int uvCol = col / 2;
-            int uvIndex = uvRow * uvRowStride + uvCol * uvPixelStride;
-
-            // Valores YUV
-            int y = yPlane[yIndex] & 0xFF;
-            int u = uPlane[uvIndex] & 0xFF;
-            int v = vPlane[uvIndex] & 0xFF;
-
-            // Conversión ITU-R BT.601
-            // R = Y + 1.402 * (V - 128)
-            // G = Y - 0.344136 * (U - 128) - 0.714136 * (V - 128)
-            // B = Y + 1.772 * (U - 128)
-            int r = y + (int)(1.402f * (v - 128));
-            int g = y - (int)(0.344136f * (u - 128)) - (int)(0.714136f * (v - 128));
-            int b = y + (int)(1.772f * (u - 128));
-
-            // Clamp a [0, 255]
-            rgbOutput[rgbIndex++] = clamp255(r);
-            rgbOutput[rgbIndex++] = clamp255(g);
-            rgbOutput[rgbIndex++] = clamp255(b);
-        }
-    }
-}
+namespace {
 
-// ═══════════════════════════════════════════════════════════════════════════════
-// CONVERSIÓN NEON OPTIMIZADA
-// ═══════════════════════════════════════════════════════════════════════════════
+/**
+ * Buffer de trabajo de convertYuvToRgb: evita new[]/delete[] por frame.
+ * Un solo slot basta porque el contenido se copia al jbyteArray bajo el lock.
+ */
+FrameBufferPool& legacyRgbPool() {
+    static FrameBufferPool pool(1);
+    return pool;
+}
 
-#if USE_NEON
-void convertYuv420ToRgbNeon(
-    const uint8_t* yPlane,
-    const uint8_t* uPlane,
-    const uint8_t* vPlane,
-    uint8_t* rgbOutput,
-    int width,
-    int height,
-    int yRowStride,
-    int uvRowStride,
-    int uvPixelStride
-) {
-    // Constantes de conversión en formato Q8 (punto fijo)
-    // Multiplicamos por 256 para trabajar con enteros
-    const int16x8_t v_c1 = vdupq_n_s16(359);   // 1.402 * 256
-    const int16x8_t v_c2 = vdupq_n_s16(88);    // 0.344136 * 256
-    const int16x8_t v_c3 = vdupq_n_s16(183);   // 0.714136 * 256
-    const int16x8_t v_c4 = vdupq_n_s16(454);   // 1.772 * 256
-    const int16x8_t v_128 = vdupq_n_s16(128);
-
-    for (int row = 0; row < height; row++) {
-        int uvRow = row / 2;
-        int rgbRowOffset = row * width * 3;
-        int yRowOffset = row * yRowStride;
-        int uvRowOffset = uvRow * uvRowStride;
-
-        // Procesar 8 píxeles a la vez
-        int col = 0;
-        for (; col + 8 <= width; col += 8) {
-            // Cargar 8 valores Y
-            uint8x8_t y8 = vld1_u8(&yPlane[yRowOffset + col]);
-            int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(y8));
-
-            // Cargar 4 valores U y V (submuestreados), duplicar para 8 píxeles
-            uint8_t u_vals[4], v_vals[4];
-            for (int i = 0; i < 4; i++) {
-                int uvIndex = uvRowOffset + ((col / 2) + i) * uvPixelStride;
-                u_vals[i] = uPlane[uvIndex];
-                v_vals[i] = vPlane[uvIndex];
-            }
-
-            // Duplicar cada valor UV para 2 píxeles adyacentes
-            uint8_t u8[8] = {u_vals[0], u_vals[0], u_vals[1], u_vals[1],
-                            u_vals[2], u_vals[2], u_vals[3], u_vals[3]};
-            uint8_t v8[8] = {v_vals[0], v_vals[0], v_vals[1], v_vals[1],
-                            v_vals[2], v_vals[2], v_vals[3], v_vals[3]};
-
-            int16x8_t u = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u8)));
-            int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v8)));
-
-            // U - 128, V - 128
-            int16x8_t u_shifted = vsubq_s16(u, v_128);
-            int16x8_t v_shifted = vsubq_s16(v, v_128);
-
-            // Calcular R, G, B
-            // R = Y + 1.402 * V'
-            int16x8_t r_contrib = vshrq_n_s16(vmulq_s16(v_c1, v_shifted), 8);
-            int16x8_t r = vaddq_s16(y, r_contrib);
-
-            // G = Y - 0.344136 * U' - 0.714136 * V'
-            int16x8_t g_contrib1 = vshrq_n_s16(vmulq_s16(v_c2, u_shifted), 8);
-            int16x8_t g_contrib2 = vshrq_n_s16(vmulq_s16(v_c3, v_shifted), 8);
-            int16x8_t g = vsubq_s16(vsubq_s16(y, g_contrib1), g_contrib2);
-
-            // B = Y + 1.772 * U'
-            int16x8_t b_contrib = vshrq_n_s16(vmulq_s16(v_c4, u_shifted), 8);
-            int16x8_t b = vaddq_s16(y, b_contrib);
-
-            // Clamp a [0, 255] y convertir a uint8
-            uint8x8_t r8 = vqmovun_s16(r);
-            uint8x8_t g8 = vqmovun_s16(g);
-            uint8x8_t b8 = vqmovun_s16(b);
-
-            // Intercalar RGB y almacenar
-            uint8x8x3_t rgb;
-            rgb.val[0] = r8;
-            rgb.val[1] = g8;
-            rgb.val[2] = b8;
-            vst3_u8(&rgbOutput[rgbRowOffset + col * 3], rgb);
-        }
-
-        // Procesar píxeles restantes con método escalar
-        for (; col < width; col++) {
-            int yIndex = yRowOffset + col;
-            int uvIndex = uvRowOffset + (col / 2) * uvPixelStride;
-
-            int y_val = yPlane[yIndex];
-            int u_val = uPlane[uvIndex];
-            int v_val = vPlane[uvIndex];
-
-            int r = y_val + (int)(1.402f * (v_val - 128));
-            int g = y_val - (int)(0.344136f * (u_val - 128)) - (int)(0.714136f * (v_val - 128));
-            int b_val = y_val + (int)(1.772f * (u_val - 128));
-
-            int rgbIdx = rgbRowOffset + col * 3;
-            rgbOutput[rgbIdx] = clamp255(r);
-            rgbOutput[rgbIdx + 1] = clamp255(g);
-            rgbOutput[rgbIdx + 2] = clamp255(b_val);
-        }
-    }
+std::mutex& legacyRgbMutex() {
+    static std::mutex mutex;
+    return mutex;
 }
-#endif
 
-// ═══════════════════════════════════════════════════════════════════════════════
-// FUNCIÓN PRINCIPAL DE CONVERSIÓN
-// ═══════════════════════════════════════════════════════════════════════════════
+FrameBufferPool* poolFromHandle(jlong handle) {
+    return reinterpret_cast<FrameBufferPool*>(handle);
+}
 
-void convertYuv420ToRgb(
-    const uint8_t* yPlane,
-    const uint8_t* uPlane,
-    const uint8_t* vPlane,
-    uint8_t* rgbOutput,
-    int width,
-    int height,
-    int yRowStride,
-    int uvRowStride,
-    int uvPixelStride
-) {
-#if USE_NEON
-    convertYuv420ToRgbNeon(yPlane, uPlane, vPlane, rgbOutput,
-                          width, height, yRowStride, uvRowStride, uvPixelStride);
-#else
-    convertYuv420ToRgbScalar(yPlane, uPlane, vPlane, rgbOutput,
-                            width, height, yRowStride, uvRowStride, uvPixelStride);
-#endif
+/**
+ * Planos Y/U/V de un frame (ByteBuffer directos).
+ */
+struct DirectPlanes {
+    uint8_t* y;
+    uint8_t* u;
+    uint8_t* v;
+};
+
+DirectPlanes directPlanes(JNIEnv* env, jobject yBuffer, jobject uBuffer, jobject vBuffer) {
+    ScopedStageTimer timer(NativeStage::PlaneAccess);
+    return {
+        static_cast<uint8_t*>(env->GetDirectBufferAddress(yBuffer)),
+        static_cast<uint8_t*>(env->GetDirectBufferAddress(uBuffer)),
+        static_cast<uint8_t*>(env->GetDirectBufferAddress(vBuffer)),
+    };
 }
 
+} // namespace
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // JNI BINDINGS
 // ═══════════════════════════════════════════════════════════════════════════════
 
 extern "C" {
 
+/**
+ * Carga de la biblioteca: detecta la CPU, instala el kernel de conversión y
+ * crea el pool de hilos antes del primer frame.
+ */
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+    LOGD("CPU: [%s], kernel YUV: %s",
+         cpuFeatureString(cpuFeatures()).c_str(), yuvKernelName());
+    LOGD("Pool de hilos nativo: %d hilos", ThreadPool::shared().threadCount());
+    return JNI_VERSION_1_6;
+}
+
 /**
  * Convierte frame YUV420 a RGB888.
  *
@@ -241,46 +124,568 @@ Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_convert
     jint uvPixelStride
 ) {
     // Obtener punteros a los buffers
-    auto* yPlane = static_cast<uint8_t*>(env->GetDirectBufferAddress(yBuffer));
-    auto* uPlane = static_cast<uint8_t*>(env->GetDirectBufferAddress(uBuffer));
-    auto* vPlane = static_cast<uint8_t*>(env->GetDirectBufferAddress(vBuffer));
+    const auto [yPlane, uPlane, vPlane] = directPlanes(env, yBuffer, uBuffer, vBuffer);
 
     if (!yPlane || !uPlane || !vPlane) {
         LOGE("Error: buffers inválidos");
         return nullptr;
     }
 
-    // Crear buffer de salida RGB
-    int rgbSize = width * height * 3;
-    auto* rgbOutput = new uint8_t[rgbSize];
+    std::lock_guard<std::mutex> lock(legacyRgbMutex());
+
+    // Buffer de salida RGB persistente (solo se realoca al cambiar resolución)
+    FrameBufferPool& pool = legacyRgbPool();
+    const int slot = pool.acquire(width, height, BufferFormat::Rgb888);
+    uint8_t* rgbOutput = pool.slotData(slot);
+    if (!rgbOutput) {
+        LOGE("Error: no se pudo reservar buffer RGB");
+        return nullptr;
+    }
 
     // Convertir
     convertYuv420ToRgb(yPlane, uPlane, vPlane, rgbOutput,
                        width, height, yRowStride, uvRowStride, uvPixelStride);
 
     // Crear y llenar array Java
+    const int rgbSize = width * height * 3;
+    ScopedStageTimer copyTimer(NativeStage::CopyOut, rgbSize);
     jbyteArray result = env->NewByteArray(rgbSize);
     env->SetByteArrayRegion(result, 0, rgbSize, reinterpret_cast<jbyte*>(rgbOutput));
 
-    // Liberar memoria
-    delete[] rgbOutput;
+    return result;
+}
+
+/**
+ * Crea un pool (anillo) de buffers de salida reutilizables.
+ *
+ * @param slotCount Número de slots del anillo (1-8)
+ * @return Handle del pool (0 si falla)
+ */
+JNIEXPORT jlong JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_createBufferPool(
+    JNIEnv* env,
+    jclass clazz,
+    jint slotCount
+) {
+    return reinterpret_cast<jlong>(new (std::nothrow) FrameBufferPool(slotCount));
+}
+
+/**
+ * Destruye un pool y libera sus buffers.
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_destroyBufferPool(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle
+) {
+    delete poolFromHandle(handle);
+}
+
+/**
+ * Entrega el siguiente slot del pool para (width, height, format).
+ *
+ * @return Índice del slot, o -1 si falla
+ */
+JNIEXPORT jint JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_acquirePoolSlot(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle,
+    jint width,
+    jint height,
+    jint format
+) {
+    FrameBufferPool* pool = poolFromHandle(handle);
+    if (!pool) return -1;
+    return pool->acquire(width, height, static_cast<BufferFormat>(format));
+}
+
+/**
+ * Envuelve un slot del pool en un ByteBuffer directo (sin copia).
+ *
+ * El llamador debe cachearlo y pedirlo de nuevo solo cuando cambie la
+ * generación del pool.
+ */
+JNIEXPORT jobject JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getPoolBuffer(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle,
+    jint slot
+) {
+    FrameBufferPool* pool = poolFromHandle(handle);
+    if (!pool) return nullptr;
+
+    uint8_t* data = pool->slotData(slot);
+    if (!data) return nullptr;
+    return env->NewDirectByteBuffer(data, static_cast<jlong>(pool->slotBytes()));
+}
+
+/**
+ * Generación del pool: cambia cada vez que los slots se realocan.
+ */
+JNIEXPORT jlong JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getPoolGeneration(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle
+) {
+    FrameBufferPool* pool = poolFromHandle(handle);
+    return pool ? static_cast<jlong>(pool->generation()) : 0;
+}
+
+/**
+ * Convierte un frame YUV420 a RGB888 en el siguiente slot del pool, rotado
+ * y espejado en la misma pasada.
+ *
+ * @return Índice del slot con el resultado, o -1 si falla
+ */
+JNIEXPORT jint JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_convertYuvToRgbPooled(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle,
+    jobject yBuffer,
+    jobject uBuffer,
+    jobject vBuffer,
+    jint width,
+    jint height,
+    jint yRowStride,
+    jint uvRowStride,
+    jint uvPixelStride,
+    jint sensorOrientation,
+    jboolean mirror
+) {
+    FrameBufferPool* pool = poolFromHandle(handle);
+    const auto [yPlane, uPlane, vPlane] = directPlanes(env, yBuffer, uBuffer, vBuffer);
+
+    if (!pool || !yPlane || !uPlane || !vPlane) {
+        LOGE("Error: buffers inválidos");
+        return -1;
+    }
+
+    // El slot se dimensiona con la imagen ya rotada
+    const OutputMapping map = computeOutputMapping(width, height, sensorOrientation, mirror);
+    const int slot = pool->acquire(map.dstWidth, map.dstHeight, BufferFormat::Rgb888);
+    uint8_t* rgbOutput = pool->slotData(slot);
+    if (!rgbOutput) {
+        return -1;
+    }
+
+    convertYuv420ToRgb(yPlane, uPlane, vPlane, rgbOutput,
+                       width, height, yRowStride, uvRowStride, uvPixelStride,
+                       sensorOrientation, mirror == JNI_TRUE);
+    return slot;
+}
+
+/**
+ * Convierte un frame YUV420 a RGB888 muestreado directamente a
+ * dstWidth × dstHeight (imagen ya rotada) en el siguiente slot del pool.
+ *
+ * @param dstWidth Ancho de salida
+ * @param dstHeight Alto de salida
+ * @return Índice del slot con el resultado, o -1 si falla
+ */
+JNIEXPORT jint JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_convertYuvToRgbScaledPooled(
+    JNIEnv* env,
+    jclass clazz,
+    jlong handle,
+    jobject yBuffer,
+    jobject uBuffer,
+    jobject vBuffer,
+    jint width,
+    jint height,
+    jint yRowStride,
+    jint uvRowStride,
+    jint uvPixelStride,
+    jint sensorOrientation,
+    jboolean mirror,
+    jint dstWidth,
+    jint dstHeight
+) {
+    FrameBufferPool* pool = poolFromHandle(handle);
+    const auto [yPlane, uPlane, vPlane] = directPlanes(env, yBuffer, uBuffer, vBuffer);
+
+    if (!pool || !yPlane || !uPlane || !vPlane || dstWidth <= 0 || dstHeight <= 0) {
+        LOGE("Error: buffers inválidos");
+        return -1;
+    }
+
+    const int slot = pool->acquire(dstWidth, dstHeight, BufferFormat::Rgb888);
+    uint8_t* rgbOutput = pool->slotData(slot);
+    if (!rgbOutput) {
+        return -1;
+    }
+
+    convertYuv420ToRgbScaled(yPlane, uPlane, vPlane,
+                             width, height, yRowStride, uvRowStride, uvPixelStride,
+                             sensorOrientation, mirror == JNI_TRUE,
+                             dstWidth, dstHeight, rgbOutput);
+    return slot;
+}
+
+/**
+ * Preprocesa un frame YUV420 directamente al tensor de entrada YOLO.
+ *
+ * Fusiona conversión, rotación, espejo, resize, letterbox y normalización.
+ * El tensor (tipo y disposición del modelo) se escribe en un ByteBuffer
+ * directo provisto por el llamador, que puede reutilizarse entre frames.
+ *
+ * @param yBuffer ByteBuffer del plano Y
+ * @param uBuffer ByteBuffer del plano U
+ * @param vBuffer ByteBuffer del plano V
+ * @param width Ancho del frame del sensor
+ * @param height Alto del frame del sensor
+ * @param yRowStride Stride del plano Y
+ * @param uvRowStride Stride del plano UV
+ * @param uvPixelStride Stride de píxel UV
+ * @param sensorOrientation Rotación a aplicar (0, 90, 180, 270)
+ * @param mirror Espejo horizontal (cámara frontal)
+ * @param targetSize Lado del tensor (640)
+ * @param dataType Tipo de elemento (TensorDataType: 0 f32, 1 f16, 2 uint8, 3 int8)
+ * @param quantScale Escala de cuantización del modelo (uint8/int8)
+ * @param zeroPoint Zero-point de cuantización del modelo (uint8/int8)
+ * @param layout Disposición (TensorLayout: 0 NHWC, 1 NCHW)
+ * @param tensorBuffer ByteBuffer directo de salida (targetSize² * 3 elementos)
+ * @return DoubleArray [scale, padLeft, padTop, newWidth, newHeight] o null
+ */
+JNIEXPORT jdoubleArray JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_preprocessYuvToTensor(
+    JNIEnv* env,
+    jclass clazz,
+    jobject yBuffer,
+    jobject uBuffer,
+    jobject vBuffer,
+    jint width,
+    jint height,
+    jint yRowStride,
+    jint uvRowStride,
+    jint uvPixelStride,
+    jint sensorOrientation,
+    jboolean mirror,
+    jint targetSize,
+    jint dataType,
+    jfloat quantScale,
+    jint zeroPoint,
+    jint layout,
+    jobject tensorBuffer
+) {
+    const auto [yPlane, uPlane, vPlane] = directPlanes(env, yBuffer, uBuffer, vBuffer);
+    void* tensor = env->GetDirectBufferAddress(tensorBuffer);
+
+    if (!yPlane || !uPlane || !vPlane || !tensor) {
+        LOGE("Error: buffers inválidos");
+        return nullptr;
+    }
+
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    if (!validTensorFormat(format)) {
+        LOGE("Error: formato de tensor inválido (%d, %f, %d)", dataType, quantScale, layout);
+        return nullptr;
+    }
+
+    const jlong requiredBytes = static_cast<jlong>(targetSize) * targetSize * 3 *
+                                static_cast<jlong>(tensorElementBytes(format.dataType));
+    if (env->GetDirectBufferCapacity(tensorBuffer) < requiredBytes) {
+        LOGE("Error: tensor de salida demasiado pequeño");
+        return nullptr;
+    }
 
+    const LetterboxParams params = preprocessYuv420ToTensorAs(
+        yPlane, uPlane, vPlane,
+        width, height, yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror == JNI_TRUE, targetSize, format, tensor);
+
+    const jdouble values[5] = {
+        params.scale,
+        static_cast<jdouble>(params.padLeft),
+        static_cast<jdouble>(params.padTop),
+        static_cast<jdouble>(params.newWidth),
+        static_cast<jdouble>(params.newHeight),
+    };
+
+    jdoubleArray result = env->NewDoubleArray(5);
+    env->SetDoubleArrayRegion(result, 0, 5, values);
     return result;
 }
 
 /**
- * Verifica si NEON está disponible.
+ * Fija el número de hilos de conversión y preprocesado.
+ *
+ * @param count Hilos incluido el llamador (<= 0 restaura el valor por defecto)
+ * @return Número de hilos efectivo
+ */
+JNIEXPORT jint JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_setWorkerCount(
+    JNIEnv* env,
+    jclass clazz,
+    jint count
+) {
+    return ThreadPool::shared().setThreadCount(count);
+}
+
+/**
+ * Número de hilos actual de conversión y preprocesado.
+ */
+JNIEXPORT jint JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getWorkerCount(
+    JNIEnv* env,
+    jclass clazz
+) {
+    return ThreadPool::shared().threadCount();
+}
+
+/**
+ * Elige el backend del preprocesado (0 CPU, 1 GPU con respaldo CPU).
+ *
+ * @return true si el backend existe
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_setPreprocessBackend(
+    JNIEnv* env,
+    jclass clazz,
+    jint backend
+) {
+    if (backend != static_cast<jint>(PreprocessBackend::Cpu) &&
+        backend != static_cast<jint>(PreprocessBackend::Gpu)) {
+        LOGE("Backend de preprocesado inválido: %d", backend);
+        return JNI_FALSE;
+    }
+    setPreprocessBackend(static_cast<PreprocessBackend>(backend));
+    return JNI_TRUE;
+}
+
+/**
+ * Backend que generó el último tensor ("gles31" o "cpu").
+ */
+JNIEXPORT jstring JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getPreprocessBackendName(
+    JNIEnv* env,
+    jclass clazz
+) {
+    return env->NewStringUTF(preprocessBackendName());
+}
+
+/**
+ * Snapshot de tiempos por etapa y contadores nativos.
+ *
+ * @return LongArray con el formato de writeStatsSnapshot (native_stats.h)
+ */
+JNIEXPORT jlongArray JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getNativeStats(
+    JNIEnv* env,
+    jclass clazz
+) {
+    int64_t values[kStatsSnapshotSize];
+    writeStatsSnapshot(values, kStatsSnapshotSize);
+
+    jlongArray result = env->NewLongArray(kStatsSnapshotSize);
+    if (!result) return nullptr;
+    env->SetLongArrayRegion(result, 0, kStatsSnapshotSize,
+                            reinterpret_cast<const jlong*>(values));
+    return result;
+}
+
+/**
+ * Pone a cero los tiempos y contadores nativos.
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_resetNativeStats(
+    JNIEnv* env,
+    jclass clazz
+) {
+    resetStats();
+}
+
+/**
+ * Contabilidad de memoria nativa por arena y presupuesto.
+ *
+ * @return LongArray con el formato de writeMemoryStats (native_memory.h)
+ */
+JNIEXPORT jlongArray JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getNativeMemoryStats(
+    JNIEnv* env,
+    jclass clazz
+) {
+    int64_t values[kMemoryStatsSize];
+    writeMemoryStats(values, kMemoryStatsSize);
+
+    jlongArray result = env->NewLongArray(kMemoryStatsSize);
+    if (!result) return nullptr;
+    env->SetLongArrayRegion(result, 0, kMemoryStatsSize,
+                            reinterpret_cast<const jlong*>(values));
+    return result;
+}
+
+/**
+ * Lleva los picos de memoria a los bytes vivos actuales.
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_resetNativeMemoryPeaks(
+    JNIEnv* env,
+    jclass clazz
+) {
+    resetMemoryPeaks();
+}
+
+/**
+ * Fija el presupuesto de memoria nativa (> 0 límite, 0 sin límite, < 0 por
+ * defecto).
+ *
+ * @return Presupuesto vigente
+ */
+JNIEXPORT jlong JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_setNativeMemoryBudget(
+    JNIEnv* env,
+    jclass clazz,
+    jlong bytes
+) {
+    return setMemoryBudget(bytes);
+}
+
+/**
+ * Activa o desactiva las secciones ATrace por etapa (solo se emiten durante
+ * una captura de Perfetto/systrace).
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_setTraceEnabled(
+    JNIEnv* env,
+    jclass clazz,
+    jboolean enabled
+) {
+    setTraceEnabled(enabled == JNI_TRUE);
+}
+
+/**
+ * Estado del interruptor de trazas.
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_isTraceEnabled(
+    JNIEnv* env,
+    jclass clazz
+) {
+    return traceEnabled() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Crea la ingesta nativa (AImageReader YUV_420_888) y devuelve su Surface
+ * para usarla como destino de la sesión Camera2. Reemplaza la anterior.
+ *
+ * @param maxImages Imágenes en vuelo del lector (<= 0 usa el valor por defecto)
+ * @param targetSize Lado del tensor que genera cada frame
+ * @param dataType Tipo de elemento del tensor (TensorDataType)
+ * @param quantScale Escala de cuantización (uint8/int8)
+ * @param zeroPoint Zero-point de cuantización (uint8/int8)
+ * @param layout Disposición del tensor (TensorLayout)
+ * @return Surface del lector, o null si falla
+ */
+JNIEXPORT jobject JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_startIngest(
+    JNIEnv* env,
+    jclass clazz,
+    jint width,
+    jint height,
+    jint maxImages,
+    jint sensorOrientation,
+    jboolean mirror,
+    jint targetSize,
+    jint dataType,
+    jfloat quantScale,
+    jint zeroPoint,
+    jint layout
+) {
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    const std::shared_ptr<ImageReaderIngest> ingest = startActiveIngest(
+        width, height, maxImages, sensorOrientation, mirror == JNI_TRUE, targetSize, format);
+    if (!ingest) {
+        LOGE("Error: no se pudo crear la ingesta nativa");
+        return nullptr;
+    }
+    return ANativeWindow_toSurface(env, ingest->window());
+}
+
+/**
+ * Suelta la ingesta nativa (se destruye cuando Dart libera su referencia).
+ * Llamar después de cerrar la sesión de captura.
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_stopIngest(
+    JNIEnv* env,
+    jclass clazz
+) {
+    stopActiveIngest();
+}
+
+/**
+ * Cambia rotación y espejo de la ingesta activa.
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_setIngestOrientation(
+    JNIEnv* env,
+    jclass clazz,
+    jint sensorOrientation,
+    jboolean mirror
+) {
+    const std::shared_ptr<ImageReaderIngest> ingest = activeIngest();
+    if (ingest) ingest->setOrientation(sensorOrientation, mirror == JNI_TRUE);
+}
+
+/**
+ * Verifica si la CPU tiene NEON (detectado en tiempo de ejecución).
  */
 JNIEXPORT jboolean JNICALL
 Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_isNeonSupported(
     JNIEnv* env,
     jclass clazz
 ) {
-#if USE_NEON
-    return JNI_TRUE;
-#else
-    return JNI_FALSE;
-#endif
+    return (cpuFeatures() & kCpuNeon) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Nombre del kernel de conversión instalado ("neon", "avx2", "sse4.1",
+ * "scalar"), para atribuir tiempos de frame al camino ISA.
+ */
+JNIEXPORT jstring JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getKernelName(
+    JNIEnv* env,
+    jclass clazz
+) {
+    return env->NewStringUTF(yuvKernelName());
+}
+
+/**
+ * Extensiones SIMD detectadas, separadas por espacios.
+ */
+JNIEXPORT jstring JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_getCpuFeatures(
+    JNIEnv* env,
+    jclass clazz
+) {
+    return env->NewStringUTF(cpuFeatureString(cpuFeatures()).c_str());
+}
+
+/**
+ * Registra el AssetManager de la aplicación para mapear assets sin copiarlos
+ * (índice nutricional). Se llama una vez al configurar el engine, antes de
+ * que Dart abra el índice; la referencia global vive lo que el proceso.
+ *
+ * @param assetManager AssetManager del applicationContext
+ */
+JNIEXPORT void JNICALL
+Java_edu_epn_nutrivision_nutrivision_1aiepn_1mobile_NativeImageProcessor_registerAssetManager(
+    JNIEnv* env,
+    jclass clazz,
+    jobject assetManager
+) {
+    static std::once_flag registered;
+    std::call_once(registered, [&] {
+        jobject globalRef = env->NewGlobalRef(assetManager);
+        NutritionIndex::setAssetManager(AAssetManager_fromJava(env, globalRef));
+    });
 }
 
 } // extern "C"
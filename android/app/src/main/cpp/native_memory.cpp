@@ -0,0 +1,197 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            native_memory.cpp                                  ║
+// ║              Reservas de memoria nativa alineada para NutriVision             ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "native_memory.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "native_stats.h"
+
+namespace {
+
+/**
+ * Cabecera escondida antes de cada bloque: alignedFree necesita el tamaño y
+ * la arena para descontarlos. Ocupa una alineación completa para que el
+ * puntero entregado siga alineado.
+ */
+struct BlockHeader {
+    size_t bytes;
+    int arena;
+};
+
+static_assert(sizeof(BlockHeader) <= kNativeBufferAlignment,
+              "La cabecera cabe en una alineación");
+
+struct ArenaCounters {
+    std::atomic<int64_t> current{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<int64_t> allocations{0};
+};
+
+struct MemoryCounters {
+    std::atomic<int64_t> current{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> frees{0};
+    std::atomic<int64_t> rejected{0};
+    std::atomic<int64_t> budget{-1};  // -1: aún sin calcular el valor por defecto
+    ArenaCounters arenas[static_cast<int>(MemoryArena::Count)];
+};
+
+MemoryCounters& memoryCounters() {
+    static MemoryCounters instance;
+    return instance;
+}
+
+/// Fracción de la RAM física del presupuesto por defecto: en un equipo de
+/// 3 GB deja ~384 MB, holgado para el pipeline y lejos del lowmemorykiller.
+constexpr int64_t kDefaultBudgetDivisor = 8;
+
+int64_t defaultBudget() {
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || pageSize <= 0) return 0;
+    return static_cast<int64_t>(pages) * pageSize / kDefaultBudgetDivisor;
+}
+
+int64_t currentBudget() {
+    auto& budget = memoryCounters().budget;
+    int64_t value = budget.load(std::memory_order_relaxed);
+    if (value < 0) {
+        // Si otro hilo ya fijó un valor, se respeta el suyo
+        int64_t expected = -1;
+        const int64_t computed = defaultBudget();
+        value = budget.compare_exchange_strong(expected, computed, std::memory_order_relaxed)
+            ? computed
+            : expected;
+    }
+    return value;
+}
+
+void updatePeak(std::atomic<int64_t>& peak, int64_t value) {
+    int64_t previous = peak.load(std::memory_order_relaxed);
+    while (value > previous &&
+           !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+/** Suma bytes a los vivos si caben en el presupuesto. */
+bool reserveBytes(int64_t bytes, MemoryBudget policy) {
+    auto& all = memoryCounters();
+    const int64_t budget = policy == MemoryBudget::Enforce ? currentBudget() : 0;
+
+    int64_t current = all.current.load(std::memory_order_relaxed);
+    do {
+        if (budget > 0 && current + bytes > budget) {
+            all.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!all.current.compare_exchange_weak(current, current + bytes,
+                                                std::memory_order_relaxed));
+    updatePeak(all.peak, current + bytes);
+    return true;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESERVAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void* alignedAlloc(size_t bytes, MemoryArena arena, MemoryBudget budget) {
+    if (bytes == 0 || bytes > SIZE_MAX - kNativeBufferAlignment) return nullptr;
+    const auto tracked = static_cast<int64_t>(bytes);
+    if (!reserveBytes(tracked, budget)) return nullptr;
+
+    auto& all = memoryCounters();
+    void* block = nullptr;
+    // posix_memalign: disponible desde API 16 (aligned_alloc requiere API 28)
+    if (posix_memalign(&block, kNativeBufferAlignment, bytes + kNativeBufferAlignment) != 0) {
+        all.current.fetch_sub(tracked, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto* header = static_cast<BlockHeader*>(block);
+    header->bytes = bytes;
+    header->arena = static_cast<int>(arena);
+
+    ArenaCounters& counters = all.arenas[header->arena];
+    updatePeak(counters.peak,
+               counters.current.fetch_add(tracked, std::memory_order_relaxed) + tracked);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    all.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    recordAllocation(bytes);
+    return static_cast<uint8_t*>(block) + kNativeBufferAlignment;
+}
+
+void alignedFree(void* ptr) {
+    if (!ptr) return;
+    void* block = static_cast<uint8_t*>(ptr) - kNativeBufferAlignment;
+    const auto* header = static_cast<const BlockHeader*>(block);
+    const auto tracked = static_cast<int64_t>(header->bytes);
+
+    auto& all = memoryCounters();
+    all.arenas[header->arena].current.fetch_sub(tracked, std::memory_order_relaxed);
+    all.current.fetch_sub(tracked, std::memory_order_relaxed);
+    all.frees.fetch_add(1, std::memory_order_relaxed);
+    free(block);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PRESUPUESTO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int64_t setMemoryBudget(int64_t bytes) {
+    const int64_t value = bytes < 0 ? defaultBudget() : bytes;
+    memoryCounters().budget.store(value, std::memory_order_relaxed);
+    return value;
+}
+
+int64_t memoryBudget() {
+    return currentBudget();
+}
+
+size_t memoryHeadroom() {
+    const int64_t budget = currentBudget();
+    if (budget <= 0) return SIZE_MAX;
+    const int64_t current = memoryCounters().current.load(std::memory_order_relaxed);
+    return current >= budget ? 0 : static_cast<size_t>(budget - current);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SNAPSHOT
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int writeMemoryStats(int64_t* out, int capacity) {
+    if (!out || capacity < kMemoryStatsSize) return -1;
+
+    const auto& all = memoryCounters();
+    int64_t* cursor = out;
+    *cursor++ = all.current.load(std::memory_order_relaxed);
+    *cursor++ = all.peak.load(std::memory_order_relaxed);
+    *cursor++ = all.allocations.load(std::memory_order_relaxed);
+    *cursor++ = all.frees.load(std::memory_order_relaxed);
+    *cursor++ = all.rejected.load(std::memory_order_relaxed);
+    *cursor++ = currentBudget();
+    for (const auto& arena : all.arenas) {
+        *cursor++ = arena.current.load(std::memory_order_relaxed);
+        *cursor++ = arena.peak.load(std::memory_order_relaxed);
+        *cursor++ = arena.allocations.load(std::memory_order_relaxed);
+    }
+    return kMemoryStatsSize;
+}
+
+void resetMemoryPeaks() {
+    auto& all = memoryCounters();
+    all.peak.store(all.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (auto& arena : all.arenas) {
+        arena.peak.store(arena.current.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    }
+}
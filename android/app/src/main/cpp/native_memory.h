@@ -0,0 +1,162 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             native_memory.h                                   ║
+// ║              Reservas de memoria nativa alineada para NutriVision             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Punto único de reserva para los buffers de la biblioteca, contabilizado      ║
+// ║  por arena (bytes vivos, pico, reservas) y limitado por un presupuesto:       ║
+// ║  pasado el límite la reserva falla y el llamador degrada su modo.             ║
+// ║  Alineación de 64 bytes (línea de caché) para cargas/almacenes SIMD.          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef NATIVE_MEMORY_H
+#define NATIVE_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+/** Alineación de todos los buffers de frames y tensores. */
+constexpr size_t kNativeBufferAlignment = 64;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ARENAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Dominios de contabilidad. El orden es parte del formato de
+ * writeMemoryStats (NativeMemoryStats.arenaNames en performance_metrics.dart).
+ */
+enum class MemoryArena : int {
+    Frames = 0,  // Slots RGB de FrameBufferPool y copias de planos/entradas
+    Tensors,     // Tensores de FrameQueue, StillBatch y VideoDecoder
+    Decode,      // RGBA de AImageDecoder
+    Tracker,     // Pistas de BoxTracker y su scratch de asociación
+    Scratch,     // Tablas y scratch por hilo de los kernels (taps, NMS)
+    Ffi,         // Buffers reservados desde Dart con nv_alloc
+    Other,       // Resto (copia del índice nutricional)
+    Count,
+};
+
+/**
+ * Política de presupuesto de una reserva. Ignore es para estado que no
+ * puede degradarse (contenedores STL): se contabiliza pero nunca se rechaza.
+ */
+enum class MemoryBudget { Enforce, Ignore };
+
+/// Valores globales: bytes vivos, pico, reservas, liberaciones, rechazadas, presupuesto.
+constexpr int kMemoryGlobalFields = 6;
+
+/// Valores por arena: bytes vivos, pico, reservas.
+constexpr int kMemoryArenaFields = 3;
+
+/// Longitud de writeMemoryStats en int64.
+constexpr int kMemoryStatsSize =
+    kMemoryGlobalFields + static_cast<int>(MemoryArena::Count) * kMemoryArenaFields;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESERVAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Reserva memoria alineada a kNativeBufferAlignment.
+ *
+ * Con MemoryBudget::Enforce falla si los bytes vivos superarían el
+ * presupuesto (se cuenta como rechazada).
+ * @return Puntero o nullptr si falla
+ */
+void* alignedAlloc(size_t bytes, MemoryArena arena = MemoryArena::Other,
+                   MemoryBudget budget = MemoryBudget::Enforce);
+
+/**
+ * @brief Libera memoria reservada con alignedAlloc.
+ */
+void alignedFree(void* ptr);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PRESUPUESTO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Fija el presupuesto de bytes vivos.
+ *
+ * @param bytes > 0 fija el límite, 0 lo quita y < 0 restaura el valor por
+ *              defecto (1/8 de la RAM física)
+ * @return Presupuesto vigente (0 = sin límite)
+ */
+int64_t setMemoryBudget(int64_t bytes);
+
+/** Presupuesto vigente en bytes (0 = sin límite). */
+int64_t memoryBudget();
+
+/**
+ * @brief Bytes que aún caben en el presupuesto, o SIZE_MAX sin límite.
+ *
+ * Orientativo (otra reserva concurrente puede consumirlos): sirve para
+ * elegir un modo reducido antes de reservar.
+ */
+size_t memoryHeadroom();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SNAPSHOT
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Copia los contadores en `out`.
+ *
+ * Formato: kMemoryGlobalFields valores globales y después, por arena (en
+ * orden de MemoryArena), kMemoryArenaFields valores.
+ *
+ * @return Valores escritos, o -1 si capacity < kMemoryStatsSize
+ */
+int writeMemoryStats(int64_t* out, int capacity);
+
+/**
+ * @brief Lleva los picos a los bytes vivos actuales (inicio de una medición).
+ */
+void resetMemoryPeaks();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONTENEDORES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Allocator STL que reserva con alignedAlloc en la arena `Arena`.
+ *
+ * Las reservas se contabilizan pero no se rechazan por presupuesto; si el
+ * sistema no tiene memoria aborta, igual que std::allocator sin excepciones.
+ */
+template <typename T, MemoryArena Arena>
+struct TrackedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Arena>;
+    };
+
+    TrackedAllocator() = default;
+
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Arena>&) {}
+
+    T* allocate(size_t n) {
+        void* ptr = alignedAlloc(n * sizeof(T), Arena, MemoryBudget::Ignore);
+        if (!ptr) std::abort();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t) { alignedFree(ptr); }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Arena>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Arena>&) const { return false; }
+};
+
+/** std::vector contabilizado en una arena. */
+template <typename T, MemoryArena Arena>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Arena>>;
+
+#endif // NATIVE_MEMORY_H
@@ -0,0 +1,116 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             native_stats.cpp                                  ║
+// ║              Tiempos por etapa y contadores de la biblioteca nativa           ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "native_stats.h"
+
+#include <atomic>
+#include <ctime>
+
+namespace {
+
+struct StageCounters {
+    std::atomic<int64_t> calls{0};
+    std::atomic<int64_t> totalNs{0};
+    std::atomic<int64_t> lastNs{0};
+    std::atomic<int64_t> maxNs{0};
+    std::atomic<int64_t> bytes{0};
+};
+
+struct Counters {
+    StageCounters stages[static_cast<int>(NativeStage::Count)];
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> allocatedBytes{0};
+};
+
+Counters& counters() {
+    static Counters instance;
+    return instance;
+}
+
+constexpr const char* kStageTraceNames[] = {
+    "nv:plane_access",
+    "nv:convert",
+    "nv:resize",
+    "nv:normalize",
+    "nv:decode",
+    "nv:nms",
+    "nv:copy_out",
+    "nv:image_decode",
+    "nv:motion",
+};
+
+static_assert(sizeof(kStageTraceNames) / sizeof(kStageTraceNames[0]) ==
+                  static_cast<size_t>(NativeStage::Count),
+              "Un nombre de traza por etapa");
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGISTRO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+const char* nativeStageTraceName(NativeStage stage) {
+    return kStageTraceNames[static_cast<int>(stage)];
+}
+
+int64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+void recordStage(NativeStage stage, int64_t elapsedNs, int64_t bytes) {
+    StageCounters& entry = counters().stages[static_cast<int>(stage)];
+    entry.calls.fetch_add(1, std::memory_order_relaxed);
+    entry.totalNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+    entry.lastNs.store(elapsedNs, std::memory_order_relaxed);
+    entry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    int64_t previous = entry.maxNs.load(std::memory_order_relaxed);
+    while (elapsedNs > previous &&
+           !entry.maxNs.compare_exchange_weak(previous, elapsedNs,
+                                              std::memory_order_relaxed)) {
+    }
+}
+
+void recordAllocation(size_t bytes) {
+    counters().allocations.fetch_add(1, std::memory_order_relaxed);
+    counters().allocatedBytes.fetch_add(static_cast<int64_t>(bytes),
+                                        std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SNAPSHOT
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int writeStatsSnapshot(int64_t* out, int capacity) {
+    if (!out || capacity < kStatsSnapshotSize) return -1;
+
+    const Counters& all = counters();
+    int64_t* cursor = out;
+    for (const StageCounters& entry : all.stages) {
+        *cursor++ = entry.calls.load(std::memory_order_relaxed);
+        *cursor++ = entry.totalNs.load(std::memory_order_relaxed);
+        *cursor++ = entry.lastNs.load(std::memory_order_relaxed);
+        *cursor++ = entry.maxNs.load(std::memory_order_relaxed);
+        *cursor++ = entry.bytes.load(std::memory_order_relaxed);
+    }
+    *cursor++ = all.allocations.load(std::memory_order_relaxed);
+    *cursor++ = all.allocatedBytes.load(std::memory_order_relaxed);
+    return kStatsSnapshotSize;
+}
+
+void resetStats() {
+    Counters& all = counters();
+    for (StageCounters& entry : all.stages) {
+        entry.calls.store(0, std::memory_order_relaxed);
+        entry.totalNs.store(0, std::memory_order_relaxed);
+        entry.lastNs.store(0, std::memory_order_relaxed);
+        entry.maxNs.store(0, std::memory_order_relaxed);
+        entry.bytes.store(0, std::memory_order_relaxed);
+    }
+    all.allocations.store(0, std::memory_order_relaxed);
+    all.allocatedBytes.store(0, std::memory_order_relaxed);
+}
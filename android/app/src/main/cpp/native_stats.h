@@ -0,0 +1,128 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              native_stats.h                                   ║
+// ║              Tiempos por etapa y contadores de la biblioteca nativa           ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Cada etapa acumula llamadas, nanosegundos (CLOCK_MONOTONIC) y bytes con      ║
+// ║  atómicos relajados: registrar cuesta dos lecturas de reloj y sin locks.      ║
+// ║  El snapshot es un array plano de int64 que Dart lee sin copias.              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef NATIVE_STATS_H
+#define NATIVE_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "native_trace.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ETAPAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Etapas medidas. El orden es parte del formato del snapshot
+ * (NativeStatsSnapshot.stageNames en performance_metrics.dart).
+ */
+enum class NativeStage : int {
+    PlaneAccess = 0,  // GetDirectBufferAddress de los planos (JNI)
+    Convert,          // YUV → RGB888 a resolución completa
+    Resize,           // YUV → RGB888 muestreado a la resolución de destino
+    Normalize,        // YUV → tensor float (muestreo + letterbox + normalización)
+    Decode,           // Argmax por clase y filtro de confianza de YOLO
+    Nms,              // Top-K y NMS por clase
+    CopyOut,          // Copias de salida a arrays Java (API JNI legacy)
+    ImageDecode,      // JPEG/PNG → RGBA con AImageDecoder (imágenes fijas)
+    MotionScore,      // Miniatura de luma + SAD contra la referencia (salto de frames)
+    Count,
+};
+
+/// Valores por etapa: llamadas, ns totales, ns de la última, ns máximo, bytes.
+constexpr int kStageStatFields = 5;
+
+/// Valores globales tras las etapas: reservas y bytes reservados.
+constexpr int kGlobalStatFields = 2;
+
+/// Longitud del snapshot en int64.
+constexpr int kStatsSnapshotSize =
+    static_cast<int>(NativeStage::Count) * kStageStatFields + kGlobalStatFields;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGISTRO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Nombre de la sección ATrace de una etapa ("nv:convert", ...).
+ */
+const char* nativeStageTraceName(NativeStage stage);
+
+/**
+ * @brief Reloj CLOCK_MONOTONIC en nanosegundos.
+ */
+int64_t monotonicNs();
+
+/**
+ * @brief Acumula una ejecución de una etapa.
+ * @param bytes Bytes tocados (leídos + escritos) por la etapa
+ */
+void recordStage(NativeStage stage, int64_t elapsedNs, int64_t bytes);
+
+/**
+ * @brief Acumula una reserva de memoria nativa (alignedAlloc).
+ */
+void recordAllocation(size_t bytes);
+
+/**
+ * @brief Mide el ámbito actual como una ejecución de `stage`.
+ *
+ * Si la traza está activa abre además una sección ATrace con el nombre de
+ * la etapa durante el mismo ámbito. Debe usarse solo en el hilo que llama al kernel (fuera de las bandas del
+ * pool) para no contar varias veces el mismo frame.
+ */
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(NativeStage stage, int64_t bytes = 0)
+        : stage_(stage), bytes_(bytes), traced_(traceActive()) {
+        if (traced_) traceBegin(nativeStageTraceName(stage_));
+        start_ = monotonicNs();
+    }
+
+    ~ScopedStageTimer() {
+        recordStage(stage_, monotonicNs() - start_, bytes_);
+        if (traced_) traceEnd();
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+    /// Fija los bytes cuando solo se conocen al final de la etapa.
+    void setBytes(int64_t bytes) { bytes_ = bytes; }
+
+private:
+    NativeStage stage_;
+    int64_t bytes_;
+    bool traced_;
+    int64_t start_ = 0;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SNAPSHOT
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Copia los contadores acumulados en `out`.
+ *
+ * Formato: por cada etapa (en orden de NativeStage) kStageStatFields valores
+ * y después las reservas y bytes reservados. Cada valor se lee de forma
+ * atómica, pero el conjunto no es una foto consistente si hay kernels en
+ * curso (suficiente para telemetría).
+ *
+ * @return Valores escritos, o -1 si capacity < kStatsSnapshotSize
+ */
+int writeStatsSnapshot(int64_t* out, int capacity);
+
+/**
+ * @brief Pone a cero todos los contadores.
+ */
+void resetStats();
+
+#endif // NATIVE_STATS_H
@@ -0,0 +1,90 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             native_trace.cpp                                  ║
+// ║              Secciones ATrace de la biblioteca nativa (Perfetto/systrace)     ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  ATrace_beginSection/endSection/isEnabled existen desde API 23 (minSdk 26);   ║
+// ║  ATrace_setCounter es API 29 y se resuelve con dlsym.                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "native_trace.h"
+
+#if defined(__ANDROID__)
+#include <android/trace.h>
+#include <dlfcn.h>
+#endif
+
+namespace trace_detail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+std::atomic<int64_t> frameNumber{0};
+
+#if defined(__ANDROID__)
+using SetCounterFn = void (*)(const char* name, int64_t value);
+
+SetCounterFn setCounterFn() {
+    static const SetCounterFn fn = reinterpret_cast<SetCounterFn>(
+        dlsym(RTLD_DEFAULT, "ATrace_setCounter"));
+    return fn;
+}
+#endif
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INTERRUPTOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void setTraceEnabled(bool enabled) {
+#if defined(__ANDROID__)
+    // Resolver el contador antes del primer frame trazado
+    if (enabled) setCounterFn();
+#endif
+    trace_detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool traceCapturing() {
+#if defined(__ANDROID__)
+    return ATrace_isEnabled();
+#else
+    return false;
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// EVENTOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void traceBegin(const char* name) {
+#if defined(__ANDROID__)
+    ATrace_beginSection(name);
+#else
+    (void)name;
+#endif
+}
+
+void traceEnd() {
+#if defined(__ANDROID__)
+    ATrace_endSection();
+#endif
+}
+
+void traceCounter(const char* name, int64_t value) {
+#if defined(__ANDROID__)
+    if (const SetCounterFn fn = setCounterFn()) fn(name, value);
+#else
+    (void)name;
+    (void)value;
+#endif
+}
+
+void traceFrame(int width, int height) {
+    const int64_t frame = frameNumber.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!traceActive()) return;
+
+    traceCounter("nv.frame", frame);
+    traceCounter("nv.width", width);
+    traceCounter("nv.height", height);
+}
@@ -0,0 +1,74 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              native_trace.h                                   ║
+// ║              Secciones ATrace de la biblioteca nativa (Perfetto/systrace)     ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Desactivado por defecto: con el interruptor apagado cada punto cuesta una    ║
+// ║  carga atómica relajada. Activo solo si además hay una captura en curso.      ║
+// ║  Fuera de Android (benchmarks en host) todas las llamadas son no-op.          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef NATIVE_TRACE_H
+#define NATIVE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INTERRUPTOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace trace_detail {
+extern std::atomic<bool> enabled;
+}
+
+/**
+ * @brief Activa o desactiva la emisión de secciones y contadores.
+ */
+void setTraceEnabled(bool enabled);
+
+/**
+ * @brief Interruptor de la app (independiente de si hay una captura activa).
+ */
+inline bool traceEnabled() {
+    return trace_detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief true si el interruptor está encendido y el sistema está trazando.
+ */
+bool traceCapturing();
+
+/**
+ * @brief Comprobación barata para los puntos de traza.
+ */
+inline bool traceActive() {
+    return traceEnabled() && traceCapturing();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// EVENTOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Abre una sección en el hilo actual (ATrace_beginSection).
+ *        Llamar solo si traceActive(); cerrar en el mismo hilo.
+ */
+void traceBegin(const char* name);
+
+/**
+ * @brief Cierra la última sección abierta en el hilo actual.
+ */
+void traceEnd();
+
+/**
+ * @brief Publica un contador (ATrace_setCounter, API 29+; no-op antes).
+ */
+void traceCounter(const char* name, int64_t value);
+
+/**
+ * @brief Marca la entrada de un frame en un kernel: incrementa el número de
+ *        frame nativo y, si se traza, publica nv.frame, nv.width y nv.height.
+ */
+void traceFrame(int width, int height);
+
+#endif // NATIVE_TRACE_H
@@ -0,0 +1,272 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           nutrition_index.cpp                                 ║
+// ║          Índice nutricional binario mapeado en memoria (mmap)                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "nutrition_index.h"
+
+#include <android/asset_manager.h>
+#include <android/log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include "native_memory.h"
+
+#define LOG_TAG "NutriVisionIndex"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+std::atomic<AAssetManager*> gAssetManager{nullptr};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// VALIDACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool sectionFits(uint32_t offset, uint64_t count, size_t elementSize, size_t fileSize) {
+    if (offset % 4 != 0) return false;
+    return static_cast<uint64_t>(offset) + count * elementSize <= fileSize;
+}
+
+bool stringFits(const NutritionStringRef& ref, uint32_t stringsSize) {
+    return static_cast<uint64_t>(ref.offset) + ref.length <= stringsSize;
+}
+
+bool rangeFits(uint32_t first, uint32_t count, uint32_t total) {
+    return static_cast<uint64_t>(first) + count <= total;
+}
+
+/// Copia la región a heap alineado (el índice exige alineación de 4 bytes).
+void* copyToHeap(const void* source, size_t size) {
+    void* copy = alignedAlloc(size, MemoryArena::Other);
+    if (copy) std::memcpy(copy, source, size);
+    return copy;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// APERTURA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void NutritionIndex::setAssetManager(AAssetManager* assets) {
+    gAssetManager.store(assets, std::memory_order_release);
+}
+
+NutritionIndex* NutritionIndex::open(const char* name) {
+    if (!name) return nullptr;
+
+    AAssetManager* assets = gAssetManager.load(std::memory_order_acquire);
+    if (!assets) return openFile(name);
+
+    AAsset* asset = AAssetManager_open(assets, name, AASSET_MODE_RANDOM);
+    if (!asset) {
+        LOGE("Asset no encontrado: %s", name);
+        return nullptr;
+    }
+
+    // Asset sin comprimir (noCompress "nvni"): mmap directo sobre el APK
+    off64_t start = 0;
+    off64_t length = 0;
+    NutritionIndex* index = nullptr;
+    const int fd = AAsset_openFileDescriptor64(asset, &start, &length);
+    if (fd >= 0) {
+        index = mapDescriptor(fd, start, length);
+        close(fd);
+    } else {
+        // Comprimido: se descomprime una vez a heap
+        const off64_t size = AAsset_getLength64(asset);
+        const void* buffer = size > 0 ? AAsset_getBuffer(asset) : nullptr;
+        void* owned = buffer ? copyToHeap(buffer, static_cast<size_t>(size)) : nullptr;
+        if (owned) {
+            index = adopt(static_cast<const uint8_t*>(owned), static_cast<size_t>(size),
+                          nullptr, 0, owned);
+        }
+    }
+    AAsset_close(asset);
+
+    if (!index) LOGE("Índice nutricional no válido: %s", name);
+    return index;
+}
+
+NutritionIndex* NutritionIndex::openFile(const char* path) {
+    if (!path) return nullptr;
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+
+    struct stat info{};
+    NutritionIndex* index = nullptr;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        index = mapDescriptor(fd, 0, info.st_size);
+    }
+    close(fd);
+    return index;
+}
+
+NutritionIndex* NutritionIndex::mapDescriptor(int fd, int64_t offset, int64_t length) {
+    if (offset < 0 || length < static_cast<int64_t>(sizeof(NutritionIndexHeader))) {
+        return nullptr;
+    }
+
+    // mmap exige un offset múltiplo de página: se mapea desde la página que
+    // contiene el inicio del asset y se desplaza el puntero
+    const int64_t pageSize = sysconf(_SC_PAGESIZE);
+    const int64_t alignedOffset = offset - offset % pageSize;
+    const size_t delta = static_cast<size_t>(offset - alignedOffset);
+    const size_t mappingSize = static_cast<size_t>(length) + delta;
+
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd,
+                         static_cast<off_t>(alignedOffset));
+    if (mapping == MAP_FAILED) return nullptr;
+
+    const uint8_t* data = static_cast<const uint8_t*>(mapping) + delta;
+    const size_t size = static_cast<size_t>(length);
+    if (reinterpret_cast<uintptr_t>(data) % 4 == 0) {
+        return adopt(data, size, mapping, mappingSize, nullptr);
+    }
+
+    // zipalign alinea los assets sin comprimir a 4 bytes; por si acaso
+    void* owned = copyToHeap(data, size);
+    munmap(mapping, mappingSize);
+    if (!owned) return nullptr;
+    return adopt(static_cast<const uint8_t*>(owned), size, nullptr, 0, owned);
+}
+
+NutritionIndex* NutritionIndex::adopt(const uint8_t* data, size_t size, void* mapping,
+                                      size_t mappingSize, void* owned) {
+    NutritionIndex* index = nullptr;
+    if (validate(data, size)) {
+        index = new (std::nothrow) NutritionIndex(data, size, mapping, mappingSize, owned);
+    }
+    if (!index) {
+        if (mapping) munmap(mapping, mappingSize);
+        alignedFree(owned);
+    }
+    return index;
+}
+
+bool NutritionIndex::validate(const uint8_t* data, size_t size) {
+    if (size < sizeof(NutritionIndexHeader)) return false;
+
+    const auto* header = reinterpret_cast<const NutritionIndexHeader*>(data);
+    if (header->magic != kNutritionIndexMagic || header->version != kNutritionIndexVersion ||
+        header->fileSize != size) {
+        return false;
+    }
+
+    if (!sectionFits(header->rowsOffset, header->classCount, sizeof(NutritionRow), size) ||
+        !sectionFits(header->labelOrderOffset, header->classCount, sizeof(uint32_t), size) ||
+        !sectionFits(header->portionsOffset, header->portionCount, sizeof(NutritionPortion),
+                     size) ||
+        !sectionFits(header->componentsOffset, header->componentCount,
+                     sizeof(NutritionComponent), size) ||
+        !sectionFits(header->stringsOffset, header->stringsSize, 1, size)) {
+        return false;
+    }
+
+    const uint32_t stringsSize = header->stringsSize;
+    if (!stringFits(header->schemaVersion, stringsSize) ||
+        !stringFits(header->source, stringsSize) || !stringFits(header->apiUrl, stringsSize) ||
+        !stringFits(header->generatedAt, stringsSize)) {
+        return false;
+    }
+
+    const auto* rows = reinterpret_cast<const NutritionRow*>(data + header->rowsOffset);
+    for (uint32_t i = 0; i < header->classCount; i++) {
+        const NutritionRow& row = rows[i];
+        if (!rangeFits(row.portionFirst, row.portionCount, header->portionCount) ||
+            !rangeFits(row.componentFirst, row.componentCount, header->componentCount) ||
+            !stringFits(row.label, stringsSize) || !stringFits(row.description, stringsSize)) {
+            return false;
+        }
+    }
+
+    const auto* order = reinterpret_cast<const uint32_t*>(data + header->labelOrderOffset);
+    for (uint32_t i = 0; i < header->classCount; i++) {
+        if (order[i] >= header->classCount) return false;
+    }
+
+    const auto* portions =
+        reinterpret_cast<const NutritionPortion*>(data + header->portionsOffset);
+    for (uint32_t i = 0; i < header->portionCount; i++) {
+        if (!stringFits(portions[i].name, stringsSize) ||
+            !stringFits(portions[i].description, stringsSize)) {
+            return false;
+        }
+    }
+
+    const auto* components =
+        reinterpret_cast<const NutritionComponent*>(data + header->componentsOffset);
+    for (uint32_t i = 0; i < header->componentCount; i++) {
+        if (!stringFits(components[i].label, stringsSize)) return false;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSULTAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NutritionIndex::NutritionIndex(const uint8_t* data, size_t size, void* mapping,
+                               size_t mappingSize, void* owned)
+    : data_(data), size_(size), mapping_(mapping), mappingSize_(mappingSize), owned_(owned) {
+    header_ = reinterpret_cast<const NutritionIndexHeader*>(data_);
+    rows_ = reinterpret_cast<const NutritionRow*>(data_ + header_->rowsOffset);
+    labelOrder_ = reinterpret_cast<const uint32_t*>(data_ + header_->labelOrderOffset);
+    portions_ = reinterpret_cast<const NutritionPortion*>(data_ + header_->portionsOffset);
+    components_ =
+        reinterpret_cast<const NutritionComponent*>(data_ + header_->componentsOffset);
+    strings_ = reinterpret_cast<const char*>(data_ + header_->stringsOffset);
+}
+
+NutritionIndex::~NutritionIndex() {
+    if (mapping_) munmap(mapping_, mappingSize_);
+    alignedFree(owned_);
+}
+
+const NutritionRow* NutritionIndex::row(int classId) const {
+    if (classId < 0 || classId >= classCount()) return nullptr;
+    return rows_ + classId;
+}
+
+const NutritionPortion* NutritionIndex::portion(int index) const {
+    if (index < 0 || static_cast<uint32_t>(index) >= header_->portionCount) return nullptr;
+    return portions_ + index;
+}
+
+const NutritionComponent* NutritionIndex::component(int index) const {
+    if (index < 0 || static_cast<uint32_t>(index) >= header_->componentCount) return nullptr;
+    return components_ + index;
+}
+
+int NutritionIndex::find(const char* label, size_t length) const {
+    if (!label) return -1;
+
+    // Orden por bytes (memcmp y luego longitud), el mismo del generador
+    int low = 0;
+    int high = classCount() - 1;
+    while (low <= high) {
+        const int mid = low + (high - low) / 2;
+        const uint32_t classId = labelOrder_[mid];
+        const NutritionStringRef& ref = rows_[classId].label;
+
+        const size_t common = ref.length < length ? ref.length : length;
+        int cmp = std::memcmp(strings_ + ref.offset, label, common);
+        if (cmp == 0) cmp = ref.length < length ? -1 : (ref.length > length ? 1 : 0);
+
+        if (cmp == 0) return static_cast<int>(classId);
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
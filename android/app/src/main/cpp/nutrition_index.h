@@ -0,0 +1,194 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            nutrition_index.h                                  ║
+// ║          Índice nutricional binario mapeado en memoria (mmap)                 ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Tabla precalculada en el build (nutrition_index.gradle.kts) con filas de     ║
+// ║  layout fijo por classId: consulta O(1) sin parsear JSON al arrancar.         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef NUTRITION_INDEX_H
+#define NUTRITION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct AAssetManager;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FORMATO
+// ═══════════════════════════════════════════════════════════════════════════════
+//
+// Little-endian, secciones alineadas a 4 bytes:
+//
+//   NutritionIndexHeader
+//   NutritionRow[classCount]         fila i = classId i de labels.txt
+//   uint32_t[classCount]             classIds ordenados por etiqueta (bytes)
+//   NutritionPortion[portionCount]
+//   NutritionComponent[componentCount]
+//   char[stringsSize]                UTF-8 sin terminador
+//
+// Los offsets del header son absolutos; los de NutritionStringRef son
+// relativos a la sección de strings. Cualquier cambio de layout sube
+// kNutritionIndexVersion (el generador y los structs de Dart lo replican).
+
+constexpr uint32_t kNutritionIndexMagic = 0x494E564E;  // "NVNI"
+constexpr uint32_t kNutritionIndexVersion = 1;
+
+/// energy_kcal, protein_g, fat_g, carbohydrates_g, fiber_g, sugars_g.
+constexpr int kNutrientCount = 6;
+
+/// Tipos de fila (NutritionRow::kind).
+constexpr uint8_t kNutritionKindIngredient = 0;
+constexpr uint8_t kNutritionKindDish = 1;
+constexpr uint8_t kNutritionKindMissing = 2;  // Clase sin entrada en nutrition_fdc.json
+
+/// Estados de fila, mismo orden que NutritionStatus de Dart.
+constexpr uint8_t kNutritionStatusFound = 0;
+constexpr uint8_t kNutritionStatusLowScore = 1;
+constexpr uint8_t kNutritionStatusNotFound = 2;
+
+/// Componente que el generador no encontró en la base (missing_components).
+constexpr uint32_t kComponentFlagMissing = 1u << 0;
+
+struct NutritionStringRef {
+    uint32_t offset;
+    uint32_t length;  // 0 = ausente
+};
+
+struct NutritionIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t classCount;
+    uint32_t rowsOffset;
+    uint32_t labelOrderOffset;
+    uint32_t portionCount;
+    uint32_t portionsOffset;
+    uint32_t componentCount;
+    uint32_t componentsOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    NutritionStringRef schemaVersion;
+    NutritionStringRef source;
+    NutritionStringRef apiUrl;
+    NutritionStringRef generatedAt;
+};
+
+struct NutritionRow {
+    float nutrients[kNutrientCount];  // Por 100 g
+    float matchScore;                 // 0–100 (platos: 100)
+    int32_t fdcId;                    // -1 si no hay
+    uint8_t kind;
+    uint8_t status;
+    uint16_t portionCount;
+    uint16_t componentCount;
+    uint16_t reserved;
+    uint32_t portionFirst;
+    uint32_t componentFirst;
+    NutritionStringRef label;
+    NutritionStringRef description;   // fdc_description
+};
+
+struct NutritionPortion {
+    float grams;
+    NutritionStringRef name;
+    NutritionStringRef description;
+};
+
+struct NutritionComponent {
+    NutritionStringRef label;
+    float percent;   // NaN si solo figura en missing_components
+    uint32_t flags;
+};
+
+static_assert(sizeof(NutritionIndexHeader) == 80, "layout del header");
+static_assert(sizeof(NutritionRow) == 64, "layout de NutritionRow");
+static_assert(sizeof(NutritionPortion) == 20, "layout de NutritionPortion");
+static_assert(sizeof(NutritionComponent) == 16, "layout de NutritionComponent");
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ÍNDICE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Vista de solo lectura sobre un índice nutricional.
+ *
+ * open() mapea el archivo (o el asset sin comprimir dentro del APK) con
+ * mmap: las páginas se cargan al tocarlas y las comparte el page cache, así
+ * que abrir cuesta unas syscalls y casi nada de heap. Toda la estructura se
+ * valida una vez al abrir; después los accesores solo indexan.
+ *
+ * Inmutable tras open(): seguro de leer desde cualquier hilo.
+ */
+class NutritionIndex {
+public:
+    /**
+     * @brief Registra el AssetManager de la app (desde JNI, antes de Dart).
+     *
+     * Con un AssetManager registrado, open() interpreta el nombre como un
+     * asset del APK; sin él, como una ruta del sistema de archivos.
+     */
+    static void setAssetManager(AAssetManager* assets);
+
+    /**
+     * @brief Abre y valida un índice.
+     * @param name Asset del APK (p. ej. "flutter_assets/assets/data/...") o ruta
+     * @return Índice, o nullptr si no existe o no es válido
+     */
+    static NutritionIndex* open(const char* name);
+
+    /** @brief Abre y valida un índice desde una ruta del sistema de archivos. */
+    static NutritionIndex* openFile(const char* path);
+
+    ~NutritionIndex();
+
+    NutritionIndex(const NutritionIndex&) = delete;
+    NutritionIndex& operator=(const NutritionIndex&) = delete;
+
+    const NutritionIndexHeader& header() const { return *header_; }
+    int classCount() const { return static_cast<int>(header_->classCount); }
+
+    /** @return Fila del classId, o nullptr si está fuera de rango */
+    const NutritionRow* row(int classId) const;
+
+    /** @return Porción por índice global (NutritionRow::portionFirst + i) */
+    const NutritionPortion* portion(int index) const;
+
+    /** @return Componente por índice global (NutritionRow::componentFirst + i) */
+    const NutritionComponent* component(int index) const;
+
+    /** Base de la sección de strings (sin terminadores). */
+    const char* strings() const { return strings_; }
+
+    /**
+     * @brief Busca el classId de una etiqueta (UTF-8 exacto) por búsqueda
+     *        binaria sobre la tabla ordenada.
+     * @return classId o -1 si no existe
+     */
+    int find(const char* label, size_t length) const;
+
+private:
+    NutritionIndex(const uint8_t* data, size_t size, void* mapping, size_t mappingSize,
+                   void* owned);
+
+    /// Valida y adopta la región; la libera si no es un índice válido.
+    static NutritionIndex* adopt(const uint8_t* data, size_t size, void* mapping,
+                                 size_t mappingSize, void* owned);
+    static NutritionIndex* mapDescriptor(int fd, int64_t offset, int64_t length);
+    static bool validate(const uint8_t* data, size_t size);
+
+    const uint8_t* data_;
+    size_t size_;
+    void* mapping_;        // Región de mmap (nullptr si se copió al heap)
+    size_t mappingSize_;
+    void* owned_;          // Copia en heap (asset comprimido o desalineado)
+
+    const NutritionIndexHeader* header_;
+    const NutritionRow* rows_;
+    const uint32_t* labelOrder_;
+    const NutritionPortion* portions_;
+    const NutritionComponent* components_;
+    const char* strings_;
+};
+
+#endif // NUTRITION_INDEX_H
@@ -0,0 +1,821 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           nutrivision_ffi.cpp                                 ║
+// ║              API C exportada para dart:ffi (sin MethodChannel)                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Envoltorios finos sobre los kernels de conversión y preprocesado.            ║
+// ║  Pensados para llamadas leaf: sin JNI, sin locks, sin reservas de memoria.    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "nutrivision_ffi.h"
+
+#include <algorithm>
+#include <new>
+
+#include "box_tracker.h"
+#include "cpu_features.h"
+#include "frame_buffer_pool.h"
+#include "frame_queue.h"
+#include "gles_preprocess.h"
+#include "gpu_delegate.h"
+#include "image_decoder.h"
+#include "image_reader_ingest.h"
+#include "luma_motion.h"
+#include "native_memory.h"
+#include "native_stats.h"
+#include "native_trace.h"
+#include "nutrition_index.h"
+#include "still_batch.h"
+#include "thread_pool.h"
+#include "video_decoder.h"
+#include "yolo_decoder.h"
+#include "yuv_preprocess.h"
+#include "yuv_to_rgb.h"
+
+namespace {
+
+bool validFrame(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                int32_t width, int32_t height) {
+    return y && u && v && width > 0 && height > 0;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEMORIA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_alloc(intptr_t bytes) {
+    if (bytes <= 0) return nullptr;
+    return alignedAlloc(static_cast<size_t>(bytes), MemoryArena::Ffi);
+}
+
+NV_EXPORT void nv_free(void* ptr) {
+    alignedFree(ptr);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POOL DE BUFFERS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_pool_create(int32_t slotCount) {
+    return new (std::nothrow) FrameBufferPool(slotCount);
+}
+
+NV_EXPORT void nv_pool_destroy(void* pool) {
+    delete static_cast<FrameBufferPool*>(pool);
+}
+
+NV_EXPORT int32_t nv_pool_acquire(void* pool, int32_t width, int32_t height,
+                                  int32_t format) {
+    if (!pool) return -1;
+    return static_cast<FrameBufferPool*>(pool)->acquire(
+        width, height, static_cast<BufferFormat>(format));
+}
+
+NV_EXPORT uint8_t* nv_pool_slot_data(void* pool, int32_t slot) {
+    if (!pool) return nullptr;
+    return static_cast<FrameBufferPool*>(pool)->slotData(slot);
+}
+
+NV_EXPORT intptr_t nv_pool_slot_bytes(void* pool) {
+    if (!pool) return 0;
+    return static_cast<intptr_t>(static_cast<FrameBufferPool*>(pool)->slotBytes());
+}
+
+NV_EXPORT int64_t nv_pool_generation(void* pool) {
+    if (!pool) return 0;
+    return static_cast<int64_t>(static_cast<FrameBufferPool*>(pool)->generation());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror
+) {
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) || !rgbOut) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    convertYuv420ToRgb(yPlane, uPlane, vPlane, rgbOut,
+                       width, height, yRowStride, uvRowStride, uvPixelStride,
+                       sensorOrientation, mirror);
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb_scaled(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t dstWidth,
+    int32_t dstHeight
+) {
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) || !rgbOut ||
+        dstWidth <= 0 || dstHeight <= 0) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    convertYuv420ToRgbScaled(yPlane, uPlane, vPlane,
+                             width, height, yRowStride, uvRowStride, uvPixelStride,
+                             sensorOrientation, mirror, dstWidth, dstHeight, rgbOut);
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t targetSize,
+    float* tensorOut,
+    double* letterboxOut
+) {
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) ||
+        !tensorOut || !letterboxOut || targetSize <= 0) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    const LetterboxParams params = preprocessYuv420ToTensor(
+        yPlane, uPlane, vPlane,
+        width, height, yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror, targetSize, tensorOut);
+
+    letterboxOut[0] = params.scale;
+    letterboxOut[1] = params.padLeft;
+    letterboxOut[2] = params.padTop;
+    letterboxOut[3] = params.newWidth;
+    letterboxOut[4] = params.newHeight;
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor_typed(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t targetSize,
+    int32_t dataType,
+    float quantScale,
+    int32_t zeroPoint,
+    int32_t layout,
+    void* tensorOut,
+    double* letterboxOut
+) {
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) ||
+        !tensorOut || !letterboxOut || targetSize <= 0 || !validTensorFormat(format)) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    const LetterboxParams params = preprocessYuv420ToTensorAs(
+        yPlane, uPlane, vPlane,
+        width, height, yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror, targetSize, format, tensorOut);
+
+    letterboxOut[0] = params.scale;
+    letterboxOut[1] = params.padLeft;
+    letterboxOut[2] = params.padTop;
+    letterboxOut[3] = params.newWidth;
+    letterboxOut[4] = params.newHeight;
+    return NV_OK;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGIÓN DE INTERÉS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb_roi(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t cropX,
+    int32_t cropY,
+    int32_t cropWidth,
+    int32_t cropHeight,
+    int32_t dstWidth,
+    int32_t dstHeight
+) {
+    Yuv420Region region{};
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) || !rgbOut ||
+        !cropYuv420(yPlane, uPlane, vPlane, width, height,
+                    yRowStride, uvRowStride, uvPixelStride,
+                    CropRect{cropX, cropY, cropWidth, cropHeight}, region)) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (dstWidth > 0 && dstHeight > 0) {
+        convertYuv420ToRgbScaled(region.y, region.u, region.v,
+                                 region.rect.width, region.rect.height,
+                                 yRowStride, uvRowStride, uvPixelStride,
+                                 sensorOrientation, mirror, dstWidth, dstHeight, rgbOut);
+    } else {
+        convertYuv420ToRgb(region.y, region.u, region.v, rgbOut,
+                           region.rect.width, region.rect.height,
+                           yRowStride, uvRowStride, uvPixelStride,
+                           sensorOrientation, mirror);
+    }
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor_roi(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t cropX,
+    int32_t cropY,
+    int32_t cropWidth,
+    int32_t cropHeight,
+    int32_t targetSize,
+    int32_t dataType,
+    float quantScale,
+    int32_t zeroPoint,
+    int32_t layout,
+    void* tensorOut,
+    double* letterboxOut
+) {
+    Yuv420Region region{};
+    if (!validFrame(yPlane, uPlane, vPlane, width, height) ||
+        !cropYuv420(yPlane, uPlane, vPlane, width, height,
+                    yRowStride, uvRowStride, uvPixelStride,
+                    CropRect{cropX, cropY, cropWidth, cropHeight}, region)) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    return nv_preprocess_yuv420_to_tensor_typed(
+        region.y, region.u, region.v, region.rect.width, region.rect.height,
+        yRowStride, uvRowStride, uvPixelStride, sensorOrientation, mirror,
+        targetSize, dataType, quantScale, zeroPoint, layout, tensorOut, letterboxOut);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COLA DE FRAMES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_frame_queue_create(int32_t slotCount, int32_t targetSize,
+                                      int32_t dataType, float quantScale,
+                                      int32_t zeroPoint, int32_t layout) {
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    if (targetSize <= 0 || !validTensorFormat(format)) return nullptr;
+    auto* queue = new (std::nothrow) FrameQueue(slotCount, targetSize, format);
+    if (queue && !queue->valid()) {
+        delete queue;
+        return nullptr;
+    }
+    return queue;
+}
+
+NV_EXPORT void nv_frame_queue_destroy(void* queue) {
+    delete static_cast<FrameQueue*>(queue);
+}
+
+NV_EXPORT int64_t nv_frame_queue_submit(
+    void* queue,
+    const uint8_t* yPlane,
+    intptr_t yLength,
+    const uint8_t* uPlane,
+    intptr_t uLength,
+    const uint8_t* vPlane,
+    intptr_t vLength,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror
+) {
+    if (!queue || !validFrame(yPlane, uPlane, vPlane, width, height) ||
+        yLength <= 0 || uLength <= 0 || vLength <= 0) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    return static_cast<FrameQueue*>(queue)->submit(
+        yPlane, static_cast<size_t>(yLength),
+        uPlane, static_cast<size_t>(uLength),
+        vPlane, static_cast<size_t>(vLength),
+        width, height, yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror);
+}
+
+NV_EXPORT int32_t nv_frame_queue_acquire(void* queue, double* infoOut) {
+    if (!queue || !infoOut) return NV_ERROR_INVALID_ARGUMENT;
+
+    QueuedFrameInfo info{};
+    const int slot = static_cast<FrameQueue*>(queue)->acquireLatest(&info);
+    if (slot < 0) return -1;
+
+    infoOut[0] = static_cast<double>(info.frameId);
+    infoOut[1] = info.letterbox.scale;
+    infoOut[2] = info.letterbox.padLeft;
+    infoOut[3] = info.letterbox.padTop;
+    infoOut[4] = info.letterbox.newWidth;
+    infoOut[5] = info.letterbox.newHeight;
+    infoOut[6] = info.imageWidth;
+    infoOut[7] = info.imageHeight;
+    infoOut[8] = static_cast<double>(info.latencyNs);
+    return slot;
+}
+
+NV_EXPORT void* nv_frame_queue_tensor(void* queue, int32_t slot) {
+    if (!queue) return nullptr;
+    return static_cast<FrameQueue*>(queue)->tensor(slot);
+}
+
+NV_EXPORT int32_t nv_frame_queue_release(void* queue, int32_t slot) {
+    if (!queue || !static_cast<FrameQueue*>(queue)->release(slot)) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_frame_queue_stats(void* queue, int64_t* out, int32_t capacity) {
+    if (!queue || !out || capacity < NV_FRAME_QUEUE_STATS_SIZE) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    const FrameQueueStats stats = static_cast<FrameQueue*>(queue)->stats();
+    out[0] = stats.submitted;
+    out[1] = stats.converted;
+    out[2] = stats.dropped;
+    out[3] = stats.stale;
+    return NV_FRAME_QUEUE_STATS_SIZE;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// LOTE DE IMÁGENES FIJAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_still_batch_create(int32_t capacity, int32_t targetSize,
+                                      int32_t dataType, float quantScale,
+                                      int32_t zeroPoint, int32_t layout) {
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    if (capacity <= 0 || capacity > StillBatch::kMaxImages || targetSize <= 0 ||
+        !validTensorFormat(format)) {
+        return nullptr;
+    }
+    auto* batch = new (std::nothrow) StillBatch(capacity, targetSize, format);
+    if (batch && !batch->valid()) {
+        delete batch;
+        return nullptr;
+    }
+    return batch;
+}
+
+NV_EXPORT void nv_still_batch_destroy(void* batch) {
+    delete static_cast<StillBatch*>(batch);
+}
+
+NV_EXPORT int32_t nv_image_decoder_available() {
+    return imageDecoderAvailable() ? 1 : 0;
+}
+
+NV_EXPORT int32_t nv_still_batch_add_encoded(void* batch, const uint8_t* data,
+                                             intptr_t length) {
+    if (!batch || !data || length <= 0) return NV_ERROR_INVALID_ARGUMENT;
+    return static_cast<StillBatch*>(batch)->addEncoded(data, static_cast<size_t>(length));
+}
+
+NV_EXPORT int32_t nv_still_batch_add_pixels(void* batch, const uint8_t* pixels,
+                                            int32_t width, int32_t height,
+                                            int32_t rowStride, int32_t pixelFormat) {
+    const auto format = static_cast<RgbPixelFormat>(pixelFormat);
+    if (!batch || !pixels || rgbPixelBytes(format) == 0) return NV_ERROR_INVALID_ARGUMENT;
+    return static_cast<StillBatch*>(batch)->addPixels(pixels, width, height, rowStride, format);
+}
+
+NV_EXPORT int32_t nv_still_batch_poll(void* batch, int32_t index, double* infoOut) {
+    if (!batch || !infoOut) return NV_ERROR_INVALID_ARGUMENT;
+
+    StillImageInfo info{};
+    switch (static_cast<StillBatch*>(batch)->poll(index, &info)) {
+        case StillState::Pending:
+            return NV_STILL_PENDING;
+        case StillState::Failed:
+            return NV_STILL_FAILED;
+        case StillState::Ready:
+            break;
+    }
+
+    infoOut[0] = info.letterbox.scale;
+    infoOut[1] = info.letterbox.padLeft;
+    infoOut[2] = info.letterbox.padTop;
+    infoOut[3] = info.letterbox.newWidth;
+    infoOut[4] = info.letterbox.newHeight;
+    infoOut[5] = info.imageWidth;
+    infoOut[6] = info.imageHeight;
+    infoOut[7] = static_cast<double>(info.latencyNs);
+    return NV_STILL_READY;
+}
+
+NV_EXPORT void* nv_still_batch_tensor(void* batch, int32_t index) {
+    if (!batch) return nullptr;
+    return static_cast<StillBatch*>(batch)->tensor(index);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INGESTA DE CÁMARA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_ingest_acquire() {
+    std::shared_ptr<ImageReaderIngest> ingest = activeIngest();
+    if (!ingest) return nullptr;
+    return new (std::nothrow) std::shared_ptr<ImageReaderIngest>(std::move(ingest));
+}
+
+NV_EXPORT void* nv_ingest_queue(void* ingest) {
+    if (!ingest) return nullptr;
+    return &(*static_cast<std::shared_ptr<ImageReaderIngest>*>(ingest))->queue();
+}
+
+NV_EXPORT int64_t nv_ingest_received_frames(void* ingest) {
+    if (!ingest) return -1;
+    return (*static_cast<std::shared_ptr<ImageReaderIngest>*>(ingest))->receivedFrames();
+}
+
+NV_EXPORT void nv_ingest_release(void* ingest) {
+    delete static_cast<std::shared_ptr<ImageReaderIngest>*>(ingest);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ANÁLISIS DE VIDEO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_video_open(const char* path, int32_t sampleEvery, int32_t queueDepth,
+                              int32_t targetSize, int32_t dataType, float quantScale,
+                              int32_t zeroPoint, int32_t layout) {
+    const TensorOutputFormat format{static_cast<TensorDataType>(dataType), quantScale, zeroPoint,
+                                    static_cast<TensorLayout>(layout)};
+    if (!path || sampleEvery <= 0 || queueDepth > VideoDecoder::kMaxSlots ||
+        targetSize <= 0 || !validTensorFormat(format)) {
+        return nullptr;
+    }
+    return VideoDecoder::open(path, sampleEvery, queueDepth, targetSize, format).release();
+}
+
+NV_EXPORT void nv_video_close(void* video) {
+    delete static_cast<VideoDecoder*>(video);
+}
+
+NV_EXPORT int32_t nv_video_acquire(void* video, double* infoOut) {
+    if (!video || !infoOut) return NV_ERROR_INVALID_ARGUMENT;
+
+    VideoFrameInfo info{};
+    const int slot = static_cast<VideoDecoder*>(video)->acquire(&info);
+    if (slot < 0) return -1;
+
+    infoOut[0] = static_cast<double>(info.frameIndex);
+    infoOut[1] = static_cast<double>(info.presentationTimeUs);
+    infoOut[2] = info.letterbox.scale;
+    infoOut[3] = info.letterbox.padLeft;
+    infoOut[4] = info.letterbox.padTop;
+    infoOut[5] = info.letterbox.newWidth;
+    infoOut[6] = info.letterbox.newHeight;
+    infoOut[7] = info.imageWidth;
+    infoOut[8] = info.imageHeight;
+    infoOut[9] = static_cast<double>(info.latencyNs);
+    return slot;
+}
+
+NV_EXPORT void* nv_video_tensor(void* video, int32_t slot) {
+    if (!video) return nullptr;
+    return static_cast<VideoDecoder*>(video)->tensor(slot);
+}
+
+NV_EXPORT int32_t nv_video_release(void* video, int32_t slot) {
+    if (!video || !static_cast<VideoDecoder*>(video)->release(slot)) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_video_state(void* video) {
+    if (!video) return NV_ERROR_INVALID_ARGUMENT;
+    switch (static_cast<VideoDecoder*>(video)->state()) {
+        case VideoState::Decoding:
+            return NV_VIDEO_DECODING;
+        case VideoState::Ended:
+            return NV_VIDEO_ENDED;
+        case VideoState::Failed:
+            break;
+    }
+    return NV_VIDEO_FAILED;
+}
+
+NV_EXPORT int32_t nv_video_stats(void* video, int64_t* out, int32_t capacity) {
+    if (!video || !out || capacity < NV_VIDEO_STATS_SIZE) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    const VideoDecoderStats stats = static_cast<VideoDecoder*>(video)->stats();
+    out[0] = stats.decoded;
+    out[1] = stats.sampled;
+    out[2] = stats.durationUs;
+    return NV_VIDEO_STATS_SIZE;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CAMBIO DE ESCENA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_motion_create() {
+    return new (std::nothrow) LumaMotionDetector();
+}
+
+NV_EXPORT void nv_motion_destroy(void* motion) {
+    delete static_cast<LumaMotionDetector*>(motion);
+}
+
+NV_EXPORT float nv_motion_score(void* motion, const uint8_t* yPlane, intptr_t yLength,
+                                int32_t width, int32_t height, int32_t yRowStride) {
+    if (!motion || yLength <= 0) return static_cast<float>(NV_ERROR_INVALID_ARGUMENT);
+    return static_cast<LumaMotionDetector*>(motion)->score(
+        yPlane, static_cast<size_t>(yLength), width, height, yRowStride);
+}
+
+NV_EXPORT int32_t nv_motion_commit(void* motion) {
+    if (!motion || !static_cast<LumaMotionDetector*>(motion)->commitReference()) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+    return NV_OK;
+}
+
+NV_EXPORT void nv_motion_reset(void* motion) {
+    if (motion) static_cast<LumaMotionDetector*>(motion)->reset();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POSTPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_decode_yolo_output(
+    const float* output,
+    int32_t numClasses,
+    int32_t numPredictions,
+    int32_t inputSize,
+    float confidenceThreshold,
+    float iouThreshold,
+    double scale,
+    int32_t padLeft,
+    int32_t padTop,
+    int32_t imageWidth,
+    int32_t imageHeight,
+    float* detectionsOut,
+    int32_t maxDetections
+) {
+    if (!output || !detectionsOut || numClasses <= 0 || numPredictions <= 0 ||
+        maxDetections <= 0 || scale <= 0.0) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+
+    YoloDecodeParams params{};
+    params.numClasses = numClasses;
+    params.numPredictions = numPredictions;
+    params.inputSize = inputSize;
+    params.confidenceThreshold = confidenceThreshold;
+    params.iouThreshold = iouThreshold;
+    params.scale = scale;
+    params.padLeft = padLeft;
+    params.padTop = padTop;
+    params.imageWidth = imageWidth;
+    params.imageHeight = imageHeight;
+
+    return decodeYoloOutput(output, params, detectionsOut, maxDetections);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SEGUIMIENTO DE CAJAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_tracker_create(float iouThreshold, int32_t maxMisses) {
+    if (!(iouThreshold > 0.0f && iouThreshold <= 1.0f) || maxMisses < 0) return nullptr;
+
+    TrackerParams params;
+    params.iouThreshold = iouThreshold;
+    params.maxMisses = maxMisses;
+    params.maxVisibleMisses = std::min(params.maxVisibleMisses, maxMisses);
+    return new (std::nothrow) BoxTracker(params);
+}
+
+NV_EXPORT void nv_tracker_destroy(void* tracker) {
+    delete static_cast<BoxTracker*>(tracker);
+}
+
+NV_EXPORT int32_t nv_tracker_update(void* tracker, const float* detections, int32_t count,
+                                    int64_t timestampNs) {
+    if (!tracker || count < 0 || (count > 0 && !detections)) return NV_ERROR_INVALID_ARGUMENT;
+    return static_cast<BoxTracker*>(tracker)->update(detections, count, timestampNs);
+}
+
+NV_EXPORT int32_t nv_tracker_predict(void* tracker, int64_t timestampNs, float* tracksOut,
+                                     int32_t maxTracks) {
+    if (!tracker || !tracksOut || maxTracks <= 0) return NV_ERROR_INVALID_ARGUMENT;
+    return static_cast<BoxTracker*>(tracker)->predict(timestampNs, tracksOut, maxTracks);
+}
+
+NV_EXPORT void nv_tracker_reset(void* tracker) {
+    if (tracker) static_cast<BoxTracker*>(tracker)->reset();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ÍNDICE NUTRICIONAL
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_nutrition_open(const char* name) {
+    return NutritionIndex::open(name);
+}
+
+NV_EXPORT void nv_nutrition_close(void* index) {
+    delete static_cast<NutritionIndex*>(index);
+}
+
+NV_EXPORT const void* nv_nutrition_header(void* index) {
+    return index ? &static_cast<NutritionIndex*>(index)->header() : nullptr;
+}
+
+NV_EXPORT const void* nv_nutrition_row(void* index, int32_t classId) {
+    return index ? static_cast<NutritionIndex*>(index)->row(classId) : nullptr;
+}
+
+NV_EXPORT const void* nv_nutrition_portion(void* index, int32_t portionIndex) {
+    return index ? static_cast<NutritionIndex*>(index)->portion(portionIndex) : nullptr;
+}
+
+NV_EXPORT const void* nv_nutrition_component(void* index, int32_t componentIndex) {
+    return index ? static_cast<NutritionIndex*>(index)->component(componentIndex) : nullptr;
+}
+
+NV_EXPORT const uint8_t* nv_nutrition_strings(void* index) {
+    if (!index) return nullptr;
+    return reinterpret_cast<const uint8_t*>(static_cast<NutritionIndex*>(index)->strings());
+}
+
+NV_EXPORT int32_t nv_nutrition_find(void* index, const uint8_t* label, int32_t length) {
+    if (!index || !label || length < 0) return NV_ERROR_INVALID_ARGUMENT;
+    const int classId = static_cast<NutritionIndex*>(index)->find(
+        reinterpret_cast<const char*>(label), static_cast<size_t>(length));
+    return classId >= 0 ? classId : NV_ERROR_INVALID_ARGUMENT;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// GPU DELEGATE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void* nv_gpu_delegate_create(const char* serializationDir, const char* modelToken,
+                                       int32_t precisionLossAllowed) {
+    return SerializedGpuDelegate::create(serializationDir, modelToken, precisionLossAllowed != 0);
+}
+
+NV_EXPORT void* nv_gpu_delegate_get(void* handle) {
+    return handle ? static_cast<SerializedGpuDelegate*>(handle)->delegate() : nullptr;
+}
+
+NV_EXPORT void nv_gpu_delegate_destroy(void* handle) {
+    delete static_cast<SerializedGpuDelegate*>(handle);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// HILOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_set_worker_count(int32_t count) {
+    return ThreadPool::shared().setThreadCount(count);
+}
+
+NV_EXPORT int32_t nv_get_worker_count() {
+    return ThreadPool::shared().threadCount();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// BACKEND DE PREPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_set_preprocess_backend(int32_t backend) {
+    if (backend != NV_PREPROCESS_BACKEND_CPU && backend != NV_PREPROCESS_BACKEND_GPU) {
+        return NV_ERROR_INVALID_ARGUMENT;
+    }
+    setPreprocessBackend(static_cast<PreprocessBackend>(backend));
+    return NV_OK;
+}
+
+NV_EXPORT int32_t nv_get_preprocess_backend() {
+    return static_cast<int32_t>(preprocessBackend());
+}
+
+NV_EXPORT const char* nv_preprocess_backend_name() {
+    return preprocessBackendName();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ESTADÍSTICAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_stats_size() {
+    return kStatsSnapshotSize;
+}
+
+NV_EXPORT int32_t nv_stats_snapshot(int64_t* out, int32_t capacity) {
+    return writeStatsSnapshot(out, capacity) < 0 ? NV_ERROR_INVALID_ARGUMENT
+                                                 : kStatsSnapshotSize;
+}
+
+NV_EXPORT void nv_stats_reset() {
+    resetStats();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEMORIA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_memory_stats_size() {
+    return kMemoryStatsSize;
+}
+
+NV_EXPORT int32_t nv_memory_stats(int64_t* out, int32_t capacity) {
+    return writeMemoryStats(out, capacity) < 0 ? NV_ERROR_INVALID_ARGUMENT
+                                               : kMemoryStatsSize;
+}
+
+NV_EXPORT void nv_memory_reset_peaks() {
+    resetMemoryPeaks();
+}
+
+NV_EXPORT int64_t nv_memory_set_budget(int64_t bytes) {
+    return setMemoryBudget(bytes);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TRAZAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT void nv_set_trace_enabled(int32_t enabled) {
+    setTraceEnabled(enabled != 0);
+}
+
+NV_EXPORT int32_t nv_is_trace_enabled() {
+    return traceEnabled() ? 1 : 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CAPACIDADES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+NV_EXPORT int32_t nv_is_neon_supported() {
+    return (cpuFeatures() & kCpuNeon) ? 1 : 0;
+}
+
+NV_EXPORT const char* nv_kernel_name() {
+    return yuvKernelName();
+}
+
+NV_EXPORT uint32_t nv_cpu_features() {
+    return cpuFeatures();
+}
@@ -0,0 +1,885 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            nutrivision_ffi.h                                  ║
+// ║              API C exportada para dart:ffi (sin MethodChannel)                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Símbolos `nv_*` de libnutrivision_native.so consumidos directamente desde    ║
+// ║  Dart. Los planos de cámara llegan como punteros (llamadas leaf), sin copias  ║
+// ║  de marshalling ni ByteBuffers intermedios.                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef NUTRIVISION_FFI_H
+#define NUTRIVISION_FFI_H
+
+#include <cstdint>
+
+#define NV_EXPORT extern "C" __attribute__((visibility("default"))) __attribute__((used))
+
+// Códigos de retorno
+#define NV_OK 0
+#define NV_ERROR_INVALID_ARGUMENT (-1)
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEMORIA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Reserva memoria nativa alineada a 64 bytes.
+ *
+ * Dart la envuelve con `asTypedList` para leer el resultado sin copias.
+ * @return Puntero o nullptr si falla
+ */
+NV_EXPORT void* nv_alloc(intptr_t bytes);
+
+/**
+ * @brief Libera memoria reservada con nv_alloc.
+ */
+NV_EXPORT void nv_free(void* ptr);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POOL DE BUFFERS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Formatos de buffer (mismos valores que BufferFormat)
+#define NV_BUFFER_FORMAT_RGB888 0
+#define NV_BUFFER_FORMAT_TENSOR_F32 1
+#define NV_BUFFER_FORMAT_TENSOR_F16 2
+#define NV_BUFFER_FORMAT_TENSOR_Q8 3
+
+/**
+ * @brief Crea un anillo de buffers de salida reutilizables.
+ * @return Handle opaco del pool, o nullptr si falla
+ */
+NV_EXPORT void* nv_pool_create(int32_t slotCount);
+
+/**
+ * @brief Destruye el pool y libera todos sus buffers.
+ */
+NV_EXPORT void nv_pool_destroy(void* pool);
+
+/**
+ * @brief Entrega el siguiente slot para (width, height, format).
+ *
+ * Solo realoca si cambian las dimensiones o el formato.
+ * @return Índice del slot, o -1 si falla
+ */
+NV_EXPORT int32_t nv_pool_acquire(void* pool, int32_t width, int32_t height,
+                                  int32_t format);
+
+/**
+ * @brief Puntero a los datos de un slot.
+ */
+NV_EXPORT uint8_t* nv_pool_slot_data(void* pool, int32_t slot);
+
+/**
+ * @brief Tamaño en bytes de cada slot.
+ */
+NV_EXPORT intptr_t nv_pool_slot_bytes(void* pool);
+
+/**
+ * @brief Generación del pool (se incrementa al realocar).
+ */
+NV_EXPORT int64_t nv_pool_generation(void* pool);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Convierte YUV420 a RGB888 en un buffer provisto por el llamador.
+ *
+ * Rota (0/90/180/270) y espeja en la misma pasada; con 90/270 la salida
+ * mide height × width.
+ *
+ * @param rgbOut Buffer de salida (width * height * 3 bytes)
+ * @return NV_OK o código de error
+ */
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror
+);
+
+/**
+ * @brief Convierte YUV420 a RGB888 muestreando directamente a
+ *        dstWidth × dstHeight (dimensiones de la imagen ya rotada).
+ *
+ * Pensado para detección en vivo: el costo depende del tamaño de salida, no
+ * del sensor.
+ *
+ * @param rgbOut Buffer de salida (dstWidth * dstHeight * 3 bytes)
+ * @return NV_OK o código de error
+ */
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb_scaled(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t dstWidth,
+    int32_t dstHeight
+);
+
+// Tipos de elemento del tensor (mismos valores que TensorDataType)
+#define NV_TENSOR_TYPE_F32 0
+#define NV_TENSOR_TYPE_F16 1
+#define NV_TENSOR_TYPE_UINT8 2
+#define NV_TENSOR_TYPE_INT8 3
+
+// Disposiciones del tensor (mismos valores que TensorLayout)
+#define NV_TENSOR_LAYOUT_NHWC 0
+#define NV_TENSOR_LAYOUT_NCHW 1
+
+/**
+ * @brief Preprocesa YUV420 directamente al tensor de entrada YOLO.
+ *
+ * @param tensorOut    Buffer de salida (targetSize² * 3 floats)
+ * @param letterboxOut Salida [scale, padLeft, padTop, newWidth, newHeight]
+ * @return NV_OK o código de error
+ */
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t targetSize,
+    float* tensorOut,
+    double* letterboxOut
+);
+
+/**
+ * @brief Igual que nv_preprocess_yuv420_to_tensor, escribiendo el tensor en
+ *        el tipo (NV_TENSOR_TYPE_*) y la disposición (NV_TENSOR_LAYOUT_*) del
+ *        modelo.
+ *
+ * Con UINT8/INT8 aplica la cuantización del tensor de entrada del modelo:
+ * round((pixel / 255) / quantScale) + zeroPoint, saturado al rango del tipo.
+ *
+ * @param tensorOut Buffer de salida (targetSize² * 3 elementos del tipo)
+ * @return NV_OK o código de error (tipo o disposición inexistente, o
+ *         quantScale <= 0)
+ */
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor_typed(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t targetSize,
+    int32_t dataType,
+    float quantScale,
+    int32_t zeroPoint,
+    int32_t layout,
+    void* tensorOut,
+    double* letterboxOut
+);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGIÓN DE INTERÉS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Convierte solo la región crop* (coordenadas del sensor) de un frame
+ *        YUV420 a RGB888, rotada y espejada.
+ *
+ * La región se ajusta al frame con origen par (clampCropRect) y solo se
+ * leen sus filas y columnas. Con dstWidth/dstHeight <= 0 la salida es la
+ * región a resolución completa (rotada); si no, se muestrea a ese tamaño.
+ *
+ * @param rgbOut Buffer de salida (región rotada, o dstWidth * dstHeight * 3)
+ * @return NV_OK o código de error (también si la región queda vacía)
+ */
+NV_EXPORT int32_t nv_convert_yuv420_to_rgb_roi(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOut,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t cropX,
+    int32_t cropY,
+    int32_t cropWidth,
+    int32_t cropHeight,
+    int32_t dstWidth,
+    int32_t dstHeight
+);
+
+/**
+ * @brief nv_preprocess_yuv420_to_tensor_typed sobre la región crop* del
+ *        frame: el letterbox se calcula para la región rotada.
+ *
+ * @return NV_OK o código de error (también si la región queda vacía)
+ */
+NV_EXPORT int32_t nv_preprocess_yuv420_to_tensor_roi(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror,
+    int32_t cropX,
+    int32_t cropY,
+    int32_t cropWidth,
+    int32_t cropHeight,
+    int32_t targetSize,
+    int32_t dataType,
+    float quantScale,
+    int32_t zeroPoint,
+    int32_t layout,
+    void* tensorOut,
+    double* letterboxOut
+);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COLA DE FRAMES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Valores escritos por nv_frame_queue_acquire en infoOut.
+#define NV_FRAME_INFO_SIZE 9
+
+/// Valores escritos por nv_frame_queue_stats.
+#define NV_FRAME_QUEUE_STATS_SIZE 4
+
+/**
+ * @brief Crea una cola de 2–3 slots con un hilo propio que genera el tensor
+ *        YOLO (targetSize² * 3 elementos de dataType) de cada frame encolado.
+ *
+ * dataType, quantScale, zeroPoint y layout como en
+ * nv_preprocess_yuv420_to_tensor_typed.
+ * @return Handle opaco de la cola, o nullptr si falla
+ */
+NV_EXPORT void* nv_frame_queue_create(int32_t slotCount, int32_t targetSize,
+                                      int32_t dataType, float quantScale,
+                                      int32_t zeroPoint, int32_t layout);
+
+/**
+ * @brief Detiene el hilo y libera la cola. Invalida los tensores entregados.
+ */
+NV_EXPORT void nv_frame_queue_destroy(void* queue);
+
+/**
+ * @brief Copia los planos de un frame y lo encola para preprocesar.
+ *
+ * No espera a la conversión. Si la cola está llena reemplaza el frame más
+ * antiguo que aún no se entregó. Si la copia no cabe en el presupuesto de
+ * memoria preprocesa en el hilo llamador. Apta para llamadas leaf.
+ *
+ * @return Id del frame (>= 0), o -1 si se descartó o es inválido
+ */
+NV_EXPORT int64_t nv_frame_queue_submit(
+    void* queue,
+    const uint8_t* yPlane,
+    intptr_t yLength,
+    const uint8_t* uPlane,
+    intptr_t uLength,
+    const uint8_t* vPlane,
+    intptr_t vLength,
+    int32_t width,
+    int32_t height,
+    int32_t yRowStride,
+    int32_t uvRowStride,
+    int32_t uvPixelStride,
+    int32_t sensorOrientation,
+    bool mirror
+);
+
+/**
+ * @brief Entrega el tensor listo más reciente y descarta los anteriores.
+ *
+ * @param infoOut Salida [frameId, scale, padLeft, padTop, newWidth,
+ *                newHeight, imageWidth, imageHeight, latencyNs]
+ * @return Slot entregado (liberar con nv_frame_queue_release), o -1 si aún
+ *         no hay ninguno listo
+ */
+NV_EXPORT int32_t nv_frame_queue_acquire(void* queue, double* infoOut);
+
+/**
+ * @brief Tensor de un slot. El puntero es fijo durante la vida de la cola.
+ */
+NV_EXPORT void* nv_frame_queue_tensor(void* queue, int32_t slot);
+
+/**
+ * @brief Devuelve a la cola un slot entregado por nv_frame_queue_acquire.
+ * @return NV_OK o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_frame_queue_release(void* queue, int32_t slot);
+
+/**
+ * @brief Contadores [encolados, convertidos, descartados, viejos].
+ * @return Valores escritos, o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_frame_queue_stats(void* queue, int64_t* out, int32_t capacity);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// LOTE DE IMÁGENES FIJAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Formatos de píxel de nv_still_batch_add_pixels (RgbPixelFormat).
+#define NV_PIXEL_FORMAT_RGBA8888 0
+#define NV_PIXEL_FORMAT_RGB888 1
+
+/// Estados de nv_still_batch_poll.
+#define NV_STILL_PENDING 0
+#define NV_STILL_READY 1
+#define NV_STILL_FAILED 2
+
+/// Valores escritos por nv_still_batch_poll en infoOut.
+#define NV_STILL_INFO_SIZE 8
+
+/**
+ * @brief Crea un lote de hasta capacity imágenes (máximo 16) con un buffer
+ *        contiguo de capacity tensores y un hilo que los genera en orden.
+ *
+ * dataType, quantScale, zeroPoint y layout como en
+ * nv_preprocess_yuv420_to_tensor_typed.
+ * @return Handle opaco del lote, o nullptr si falla
+ */
+NV_EXPORT void* nv_still_batch_create(int32_t capacity, int32_t targetSize,
+                                      int32_t dataType, float quantScale,
+                                      int32_t zeroPoint, int32_t layout);
+
+/**
+ * @brief Detiene el hilo y libera el lote. Invalida los tensores.
+ */
+NV_EXPORT void nv_still_batch_destroy(void* batch);
+
+/**
+ * @brief 1 si AImageDecoder está disponible (Android 11+) y
+ *        nv_still_batch_add_encoded puede decodificar.
+ */
+NV_EXPORT int32_t nv_image_decoder_available();
+
+/**
+ * @brief Copia un archivo JPEG/PNG/WebP y lo agrega al lote para decodificar.
+ *
+ * No espera a la decodificación. Apta para llamadas leaf.
+ * @return Índice en el lote, o -1 si está lleno o es inválido
+ */
+NV_EXPORT int32_t nv_still_batch_add_encoded(void* batch, const uint8_t* data,
+                                             intptr_t length);
+
+/**
+ * @brief Copia una imagen ya decodificada y la agrega al lote.
+ *
+ * @param pixelFormat NV_PIXEL_FORMAT_*
+ * @param rowStride   Bytes entre filas
+ * @return Índice en el lote, o -1 si está lleno o es inválido
+ */
+NV_EXPORT int32_t nv_still_batch_add_pixels(void* batch, const uint8_t* pixels,
+                                            int32_t width, int32_t height,
+                                            int32_t rowStride, int32_t pixelFormat);
+
+/**
+ * @brief Estado de una imagen del lote, sin esperar.
+ *
+ * @param infoOut Salida si está lista: [scale, padLeft, padTop, newWidth,
+ *                newHeight, imageWidth, imageHeight, latencyNs]
+ * @return NV_STILL_PENDING, NV_STILL_READY, NV_STILL_FAILED (no se pudo
+ *         decodificar o índice inválido) o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_still_batch_poll(void* batch, int32_t index, double* infoOut);
+
+/**
+ * @brief Tensor de la imagen index: bytes [index * tensorBytes, (index + 1)
+ *        * tensorBytes) del buffer contiguo. Fijo durante la vida del lote.
+ */
+NV_EXPORT void* nv_still_batch_tensor(void* batch, int32_t index);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// INGESTA DE CÁMARA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Referencia a la ingesta AImageReader activa (creada desde Kotlin).
+ *
+ * Mantiene viva la ingesta aunque Kotlin la detenga o la reemplace: se
+ * destruye al liberar la última referencia con nv_ingest_release.
+ *
+ * @return Handle de la referencia, o nullptr si no hay ingesta activa
+ */
+NV_EXPORT void* nv_ingest_acquire();
+
+/**
+ * @brief Cola de tensores de la ingesta, usable con
+ *        nv_frame_queue_acquire/tensor/release/stats.
+ *
+ * No destruir con nv_frame_queue_destroy: pertenece a la ingesta y es
+ * válida hasta nv_ingest_release.
+ *
+ * @param ingest Handle de nv_ingest_acquire
+ */
+NV_EXPORT void* nv_ingest_queue(void* ingest);
+
+/**
+ * @brief Imágenes recibidas por la ingesta (incluidas las descartadas), o
+ *        -1 si ingest es nulo.
+ */
+NV_EXPORT int64_t nv_ingest_received_frames(void* ingest);
+
+/**
+ * @brief Libera la referencia de nv_ingest_acquire. Los tensores entregados
+ *        por su cola dejan de ser válidos.
+ */
+NV_EXPORT void nv_ingest_release(void* ingest);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ANÁLISIS DE VIDEO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Estados de nv_video_state (VideoState).
+#define NV_VIDEO_DECODING 0
+#define NV_VIDEO_ENDED 1
+#define NV_VIDEO_FAILED 2
+
+/// Valores escritos por nv_video_acquire en infoOut.
+#define NV_VIDEO_INFO_SIZE 10
+
+/// Valores escritos por nv_video_stats.
+#define NV_VIDEO_STATS_SIZE 3
+
+/**
+ * @brief Abre un archivo de video y arranca un hilo que lo decodifica con
+ *        AMediaCodec y genera el tensor de 1 de cada sampleEvery frames.
+ *
+ * Los tensores se generan desde los buffers del códec, sin copiar planos. Con
+ * los queueDepth slots (1–4) ocupados el hilo deja de decodificar hasta que
+ * se libere alguno. dataType, quantScale, zeroPoint y layout como en
+ * nv_preprocess_yuv420_to_tensor_typed. Abre el archivo y el códec: no
+ * llamar como leaf.
+ *
+ * @param path Ruta UTF-8 terminada en '\0'
+ * @return Handle opaco, o nullptr si el archivo no tiene una pista de video
+ *         decodificable
+ */
+NV_EXPORT void* nv_video_open(const char* path, int32_t sampleEvery, int32_t queueDepth,
+                              int32_t targetSize, int32_t dataType, float quantScale,
+                              int32_t zeroPoint, int32_t layout);
+
+/**
+ * @brief Detiene el hilo, libera el códec y los tensores.
+ */
+NV_EXPORT void nv_video_close(void* video);
+
+/**
+ * @brief Entrega el frame listo más antiguo (en orden de video), sin esperar.
+ *
+ * @param infoOut Salida [frameIndex, presentationTimeUs, scale, padLeft,
+ *                padTop, newWidth, newHeight, imageWidth, imageHeight,
+ *                latencyNs]
+ * @return Slot entregado (liberar con nv_video_release), o -1 si aún no hay
+ *         ninguno listo
+ */
+NV_EXPORT int32_t nv_video_acquire(void* video, double* infoOut);
+
+/**
+ * @brief Tensor de un slot. El puntero es fijo durante la vida del video.
+ */
+NV_EXPORT void* nv_video_tensor(void* video, int32_t slot);
+
+/**
+ * @brief Devuelve un slot entregado por nv_video_acquire.
+ * @return NV_OK o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_video_release(void* video, int32_t slot);
+
+/**
+ * @brief NV_VIDEO_DECODING mientras queden frames por entregar;
+ *        NV_VIDEO_ENDED o NV_VIDEO_FAILED cuando ya no habrá más.
+ */
+NV_EXPORT int32_t nv_video_state(void* video);
+
+/**
+ * @brief Contadores [decodificados, muestreados, durationUs].
+ * @return Valores escritos, o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_video_stats(void* video, int64_t* out, int32_t capacity);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CAMBIO DE ESCENA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Puntaje de nv_motion_score sin referencia (LumaMotionDetector::kNoReference).
+#define NV_MOTION_NO_REFERENCE 255.0f
+
+/**
+ * @brief Crea un detector de cambios de escena sobre el plano Y.
+ * @return Handle opaco, o nullptr si falla
+ */
+NV_EXPORT void* nv_motion_create();
+
+/**
+ * @brief Libera el detector.
+ */
+NV_EXPORT void nv_motion_destroy(void* motion);
+
+/**
+ * @brief Reduce el plano Y a una miniatura 64×48 y la compara (SAD) con la
+ *        referencia.
+ *
+ * El puntaje es la diferencia absoluta media, en niveles de luma, de la peor
+ * de 4×4 regiones. Cuesta unas decenas de microsegundos a cualquier
+ * resolución: apta para llamadas leaf en cada frame.
+ *
+ * @return Puntaje 0–255, NV_MOTION_NO_REFERENCE si aún no hay referencia, o
+ *         un valor negativo si los parámetros no son válidos
+ */
+NV_EXPORT float nv_motion_score(void* motion, const uint8_t* yPlane, intptr_t yLength,
+                                int32_t width, int32_t height, int32_t yRowStride);
+
+/**
+ * @brief Fija como referencia la miniatura del último nv_motion_score (el
+ *        frame que se infirió).
+ * @return NV_OK o NV_ERROR_INVALID_ARGUMENT si aún no hay miniatura
+ */
+NV_EXPORT int32_t nv_motion_commit(void* motion);
+
+/**
+ * @brief Descarta la referencia: el siguiente puntaje es NV_MOTION_NO_REFERENCE.
+ */
+NV_EXPORT void nv_motion_reset(void* motion);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POSTPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Decodifica la salida YOLO [1, 4 + numClasses, numPredictions] y aplica NMS.
+ *
+ * Las cajas se devuelven en espacio de la imagen original (letterbox deshecho
+ * y recortadas), ordenadas por score descendente.
+ *
+ * @param output        Tensor de salida float32 del intérprete
+ * @param scale         Escala del letterbox
+ * @param padLeft       Padding izquierdo del letterbox
+ * @param padTop        Padding superior del letterbox
+ * @param detectionsOut Salida [maxDetections][x1, y1, x2, y2, score, classId]
+ * @param maxDetections Capacidad de detectionsOut
+ * @return Número de detecciones (>= 0) o código de error
+ */
+NV_EXPORT int32_t nv_decode_yolo_output(
+    const float* output,
+    int32_t numClasses,
+    int32_t numPredictions,
+    int32_t inputSize,
+    float confidenceThreshold,
+    float iouThreshold,
+    double scale,
+    int32_t padLeft,
+    int32_t padTop,
+    int32_t imageWidth,
+    int32_t imageHeight,
+    float* detectionsOut,
+    int32_t maxDetections
+);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// SEGUIMIENTO DE CAJAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Floats por pista de nv_tracker_predict: x1, y1, x2, y2, score, classId,
+/// trackId (exacto hasta 2²⁴ pistas).
+#define NV_TRACK_STRIDE 7
+
+/**
+ * @brief Crea un tracker IoU + Kalman para las detecciones de
+ *        nv_decode_yolo_output.
+ *
+ * @param iouThreshold IoU mínimo entre la caja predicha y la detección
+ * @param maxMisses    Inferencias sin asociar antes de eliminar una pista
+ * @return Handle opaco, o nullptr si los parámetros no son válidos
+ */
+NV_EXPORT void* nv_tracker_create(float iouThreshold, int32_t maxMisses);
+
+/**
+ * @brief Libera el tracker.
+ */
+NV_EXPORT void nv_tracker_destroy(void* tracker);
+
+/**
+ * @brief Asocia las detecciones de una inferencia con las pistas.
+ *
+ * @param detections  [count][x1, y1, x2, y2, score, classId], el formato de
+ *                    nv_decode_yolo_output
+ * @param timestampNs Instante del frame inferido (reloj monótono del llamador)
+ * @return Pistas visibles, o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_tracker_update(void* tracker, const float* detections, int32_t count,
+                                    int64_t timestampNs);
+
+/**
+ * @brief Extrapola las pistas visibles a timestampNs sin modificarlas.
+ *
+ * Pensada para cada frame de cámara entre inferencias; apta para llamadas
+ * leaf.
+ *
+ * @param tracksOut Salida [maxTracks][NV_TRACK_STRIDE]
+ * @return Pistas escritas, o NV_ERROR_INVALID_ARGUMENT
+ */
+NV_EXPORT int32_t nv_tracker_predict(void* tracker, int64_t timestampNs, float* tracksOut,
+                                     int32_t maxTracks);
+
+/**
+ * @brief Elimina todas las pistas.
+ */
+NV_EXPORT void nv_tracker_reset(void* tracker);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ÍNDICE NUTRICIONAL
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Mapea el índice nutricional generado en el build (.nvni).
+ *
+ * Con el AssetManager registrado desde JNI, name es un asset del APK
+ * ("flutter_assets/assets/data/nutrition_index.nvni"); si no, una ruta.
+ * Abrir cuesta unas syscalls: la estructura se valida una vez y después
+ * las consultas solo indexan la región mapeada.
+ *
+ * @param name Nombre terminado en '\0'
+ * @return Handle opaco, o nullptr si no existe o no es válido
+ */
+NV_EXPORT void* nv_nutrition_open(const char* name);
+
+/**
+ * @brief Desmapea el índice (invalida los punteros devueltos).
+ */
+NV_EXPORT void nv_nutrition_close(void* index);
+
+/**
+ * @brief Header del índice (NutritionIndexHeader de nutrition_index.h).
+ */
+NV_EXPORT const void* nv_nutrition_header(void* index);
+
+/**
+ * @brief Fila de un classId de labels.txt (NutritionRow), en O(1).
+ * @return Puntero a la región mapeada, o nullptr si está fuera de rango
+ */
+NV_EXPORT const void* nv_nutrition_row(void* index, int32_t classId);
+
+/**
+ * @brief Porción por índice global (NutritionPortion).
+ */
+NV_EXPORT const void* nv_nutrition_portion(void* index, int32_t portionIndex);
+
+/**
+ * @brief Componente de plato por índice global (NutritionComponent).
+ */
+NV_EXPORT const void* nv_nutrition_component(void* index, int32_t componentIndex);
+
+/**
+ * @brief Base de la sección de strings (UTF-8 sin terminadores).
+ */
+NV_EXPORT const uint8_t* nv_nutrition_strings(void* index);
+
+/**
+ * @brief classId de una etiqueta (UTF-8 exacto), por búsqueda binaria.
+ * @return classId, o NV_ERROR_INVALID_ARGUMENT si no existe
+ */
+NV_EXPORT int32_t nv_nutrition_find(void* index, const uint8_t* label, int32_t length);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// GPU DELEGATE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Crea un GPU delegate de TFLite que serializa los kernels compilados.
+ *
+ * La primera vez compila y escribe la caché en serializationDir; las
+ * siguientes con el mismo modelToken la cargan. Llamar en el hilo que creará
+ * el intérprete (el delegate no es thread-safe).
+ *
+ * @param serializationDir Directorio existente, terminado en '\0'
+ * @param modelToken Identificador del modelo (MD5), terminado en '\0'
+ * @param precisionLossAllowed != 0 permite FP16
+ * @return Handle opaco, o nullptr si el GPU delegate no está disponible
+ */
+NV_EXPORT void* nv_gpu_delegate_create(const char* serializationDir, const char* modelToken,
+                                       int32_t precisionLossAllowed);
+
+/**
+ * @brief TfLiteDelegate* del handle, para TfLiteInterpreterOptionsAddDelegate.
+ */
+NV_EXPORT void* nv_gpu_delegate_get(void* handle);
+
+/**
+ * @brief Destruye el delegate (después de cerrar el intérprete que lo usa).
+ */
+NV_EXPORT void nv_gpu_delegate_destroy(void* handle);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// HILOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Fija el número de hilos de los kernels por bandas (incluido el
+ *        llamador). <= 0 restaura el valor por defecto (núcleos grandes).
+ * @return Número de hilos efectivo
+ */
+NV_EXPORT int32_t nv_set_worker_count(int32_t count);
+
+/**
+ * @brief Número de hilos actual de los kernels por bandas.
+ */
+NV_EXPORT int32_t nv_get_worker_count();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// BACKEND DE PREPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Backends de nv_set_preprocess_backend (enum PreprocessBackend)
+#define NV_PREPROCESS_BACKEND_CPU 0
+#define NV_PREPROCESS_BACKEND_GPU 1
+
+/**
+ * @brief Elige dónde se genera el tensor YOLO en todas las rutas (llamadas
+ *        directas, cola de frames e ingesta). Con GPU, cada frame que no se
+ *        pueda ejecutar en el compute shader GLES 3.1 usa el kernel CPU.
+ * @return NV_OK, o NV_ERROR_INVALID_ARGUMENT si el backend no existe
+ */
+NV_EXPORT int32_t nv_set_preprocess_backend(int32_t backend);
+
+/**
+ * @brief Backend pedido (NV_PREPROCESS_BACKEND_*).
+ */
+NV_EXPORT int32_t nv_get_preprocess_backend();
+
+/**
+ * @brief Backend que generó el último tensor: "gles31" o "cpu" (cadena
+ *        estática).
+ */
+NV_EXPORT const char* nv_preprocess_backend_name();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ESTADÍSTICAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Longitud en int64 del snapshot de estadísticas.
+ */
+NV_EXPORT int32_t nv_stats_size();
+
+/**
+ * @brief Copia tiempos por etapa (CLOCK_MONOTONIC) y contadores acumulados.
+ *
+ * Por etapa (plane_access, convert, resize, normalize, decode, nms,
+ * copy_out): llamadas, ns totales, ns de la última, ns máximo y bytes
+ * tocados; al final reservas y bytes reservados. Apta para llamadas leaf.
+ *
+ * @return Valores escritos, o NV_ERROR_INVALID_ARGUMENT si capacity < nv_stats_size()
+ */
+NV_EXPORT int32_t nv_stats_snapshot(int64_t* out, int32_t capacity);
+
+/**
+ * @brief Pone a cero las estadísticas.
+ */
+NV_EXPORT void nv_stats_reset();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MEMORIA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Longitud en int64 del snapshot de memoria.
+ */
+NV_EXPORT int32_t nv_memory_stats_size();
+
+/**
+ * @brief Copia la contabilidad de memoria nativa.
+ *
+ * Globales: bytes vivos, pico, reservas, liberaciones, reservas rechazadas
+ * por presupuesto y presupuesto (0 = sin límite). Después, por arena
+ * (frames, tensors, decode, tracker, scratch, ffi, other): bytes vivos,
+ * pico y reservas. Apta para llamadas leaf.
+ *
+ * @return Valores escritos, o NV_ERROR_INVALID_ARGUMENT si capacity < nv_memory_stats_size()
+ */
+NV_EXPORT int32_t nv_memory_stats(int64_t* out, int32_t capacity);
+
+/**
+ * @brief Lleva los picos a los bytes vivos actuales.
+ */
+NV_EXPORT void nv_memory_reset_peaks();
+
+/**
+ * @brief Fija el presupuesto de bytes vivos de la biblioteca.
+ *
+ * Pasado el límite las reservas fallan y el pipeline degrada: la cola
+ * preprocesa sin copiar los planos, con menos slots, y las imágenes se
+ * decodifican más submuestreadas.
+ *
+ * @param bytes > 0 fija el límite, 0 lo quita y < 0 restaura el valor por
+ *              defecto (1/8 de la RAM física)
+ * @return Presupuesto vigente (0 = sin límite)
+ */
+NV_EXPORT int64_t nv_memory_set_budget(int64_t bytes);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TRAZAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Activa (1) o desactiva (0) las secciones ATrace por etapa y los
+ *        contadores nv.frame/nv.width/nv.height. Solo se emiten mientras hay
+ *        una captura de Perfetto/systrace en curso.
+ */
+NV_EXPORT void nv_set_trace_enabled(int32_t enabled);
+
+/**
+ * @brief Estado del interruptor de trazas.
+ */
+NV_EXPORT int32_t nv_is_trace_enabled();
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CAPACIDADES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Indica si la CPU tiene NEON (detectado en tiempo de ejecución).
+ */
+NV_EXPORT int32_t nv_is_neon_supported();
+
+/**
+ * @brief Nombre del kernel de conversión instalado ("neon", "avx2",
+ *        "sse4.1", "scalar"). Cadena estática, no liberar.
+ */
+NV_EXPORT const char* nv_kernel_name();
+
+/**
+ * @brief Extensiones SIMD detectadas como máscara de bits (CpuFeature).
+ */
+NV_EXPORT uint32_t nv_cpu_features();
+
+#endif // NUTRIVISION_FFI_H
@@ -0,0 +1,178 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             still_batch.cpp                                   ║
+// ║          Lote de imágenes fijas → tensores letterbox contiguos [N, ...]       ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "still_batch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "image_decoder.h"
+#include "native_memory.h"
+#include "native_stats.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CICLO DE VIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+StillBatch::StillBatch(int capacity, int targetSize, const TensorOutputFormat& format)
+    : targetSize_(targetSize),
+      format_(format),
+      entries_(std::min(std::max(capacity, 1), kMaxImages)) {
+    if (capacity <= 0 || targetSize <= 0 || !validTensorFormat(format)) return;
+
+    tensorBytes_ = static_cast<size_t>(targetSize) * targetSize * 3 *
+                   tensorElementBytes(format.dataType);
+    tensors_ = static_cast<uint8_t*>(
+        alignedAlloc(tensorBytes_ * entries_.size(), MemoryArena::Tensors));
+    if (tensors_ == nullptr) return;
+
+    valid_ = true;
+    worker_ = std::thread(&StillBatch::workerLoop, this);
+}
+
+StillBatch::~StillBatch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    added_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    for (auto& entry : entries_) {
+        alignedFree(entry.data);
+    }
+    alignedFree(tensors_);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PRODUCTOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int StillBatch::addEncoded(const uint8_t* data, size_t length) {
+    if (!data || length == 0) return -1;
+    return append(data, length, true, 0, 0, 0, RgbPixelFormat::Rgba8888);
+}
+
+int StillBatch::addPixels(const uint8_t* pixels, int width, int height, int rowStride,
+                          RgbPixelFormat pixelFormat) {
+    const size_t pixelBytes = rgbPixelBytes(pixelFormat);
+    if (!pixels || width <= 0 || height <= 0 || pixelBytes == 0 ||
+        static_cast<size_t>(rowStride) < width * pixelBytes) {
+        return -1;
+    }
+    // La última fila solo necesita width píxeles
+    const size_t length = static_cast<size_t>(rowStride) * (height - 1) + width * pixelBytes;
+    return append(pixels, length, false, width, height, rowStride, pixelFormat);
+}
+
+int StillBatch::append(const uint8_t* data, size_t length, bool encoded, int width,
+                       int height, int rowStride, RgbPixelFormat pixelFormat) {
+    if (!valid_) return -1;
+
+    // Un solo productor (Dart): count_ solo lo cambia este método
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index = count_;
+    }
+    if (index >= capacity()) return -1;
+
+    // El hilo no lee la entrada index hasta que count_ la incluya
+    Entry& entry = entries_[index];
+    entry.data = static_cast<uint8_t*>(alignedAlloc(length, MemoryArena::Frames));
+    if (entry.data == nullptr) return -1;
+    {
+        ScopedStageTimer timer(NativeStage::PlaneAccess, static_cast<int64_t>(length) * 2);
+        std::memcpy(entry.data, data, length);
+    }
+    entry.length = length;
+    entry.encoded = encoded;
+    entry.width = width;
+    entry.height = height;
+    entry.rowStride = rowStride;
+    entry.pixelFormat = pixelFormat;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry.submitNs = monotonicNs();
+        count_ = index + 1;
+    }
+    added_.notify_one();
+    return index;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// HILO DE PREPROCESADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void StillBatch::workerLoop() {
+    // Buffer RGBA de decodificación: se reutiliza entre las imágenes del lote
+    DecodedImage decoded;
+
+    int next = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        added_.wait(lock, [this, next] { return stop_ || next < count_; });
+        if (stop_) return;
+
+        Entry& entry = entries_[next];
+        void* tensorOut = tensors_ + static_cast<size_t>(next) * tensorBytes_;
+        lock.unlock();
+
+        bool ok = true;
+        if (entry.encoded) {
+            // Decodificación reducida (ya orientada): el letterbox se calcula
+            // con las dimensiones completas para que las cajas queden en
+            // coordenadas de la imagen original
+            ok = decodeImageRgba(entry.data, entry.length, targetSize_, decoded);
+            if (ok) {
+                entry.width = decoded.sourceWidth;
+                entry.height = decoded.sourceHeight;
+                entry.letterbox = preprocessRgbToTensorAs(
+                    decoded.pixels, decoded.width, decoded.height, decoded.rowStride,
+                    RgbPixelFormat::Rgba8888, 0, false, targetSize_, format_, tensorOut,
+                    decoded.sourceWidth, decoded.sourceHeight);
+            }
+        } else {
+            entry.letterbox = preprocessRgbToTensorAs(
+                entry.data, entry.width, entry.height, entry.rowStride,
+                entry.pixelFormat, 0, false, targetSize_, format_, tensorOut);
+        }
+
+        // La copia de entrada ya no hace falta
+        alignedFree(entry.data);
+        entry.data = nullptr;
+
+        lock.lock();
+        entry.readyNs = monotonicNs();
+        entry.state = ok ? StillState::Ready : StillState::Failed;
+        next++;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSUMIDOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+StillState StillBatch::poll(int index, StillImageInfo* info) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!valid_ || index < 0 || index >= count_) return StillState::Failed;
+
+    const Entry& entry = entries_[index];
+    if (entry.state == StillState::Ready && info) {
+        info->letterbox = entry.letterbox;
+        info->imageWidth = entry.width;
+        info->imageHeight = entry.height;
+        info->latencyNs = entry.readyNs - entry.submitNs;
+    }
+    return entry.state;
+}
+
+void* StillBatch::tensor(int index) const {
+    if (!valid_ || index < 0 || index >= capacity()) return nullptr;
+    return tensors_ + static_cast<size_t>(index) * tensorBytes_;
+}
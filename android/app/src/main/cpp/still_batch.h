@@ -0,0 +1,143 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              still_batch.h                                    ║
+// ║          Lote de imágenes fijas → tensores letterbox contiguos [N, ...]       ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Un hilo propio decodifica (AImageDecoder) y aplica el letterbox de cada      ║
+// ║  imagen en orden, mientras Dart infiere las que ya están listas.              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef STILL_BATCH_H
+#define STILL_BATCH_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "yuv_preprocess.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Estado de una imagen del lote.
+ */
+enum class StillState { Pending, Ready, Failed };
+
+/**
+ * @brief Metadatos del tensor de una imagen lista.
+ */
+struct StillImageInfo {
+    LetterboxParams letterbox;
+    int imageWidth;   // Dimensiones completas de la imagen (ya orientada)
+    int imageHeight;
+    int64_t latencyNs;  // Desde que se agregó hasta que el tensor quedó listo
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// LOTE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Lote de hasta `capacity` imágenes con un único buffer de tensores.
+ *
+ * El tensor de la imagen i ocupa los bytes [i * tensorBytes(),
+ * (i + 1) * tensorBytes()) de tensorData(): el conjunto es el tensor
+ * [N, targetSize, targetSize, 3] (o [N, 3, targetSize, targetSize] en NCHW)
+ * en el formato del lote.
+ *
+ * addEncoded/addPixels copian la entrada y retornan de inmediato; el hilo del
+ * lote procesa las imágenes en el orden en que llegaron y reparte el
+ * letterbox de cada una en el pool de hilos. El tensor de una imagen no
+ * cambia una vez que poll() la reporta lista, así que se puede inferir
+ * mientras se preparan las siguientes.
+ */
+class StillBatch {
+public:
+    /// Imágenes máximas por lote (el buffer float32 de 640² ocupa ~4.7 MB por imagen).
+    static constexpr int kMaxImages = 16;
+
+    StillBatch(int capacity, int targetSize,
+               const TensorOutputFormat& format = TensorOutputFormat{});
+    ~StillBatch();
+
+    StillBatch(const StillBatch&) = delete;
+    StillBatch& operator=(const StillBatch&) = delete;
+
+    /** false si los parámetros no son válidos o falló la reserva del buffer. */
+    bool valid() const { return valid_; }
+
+    /**
+     * @brief Agrega una imagen codificada (JPEG, PNG, WebP...) para decodificar
+     *        con AImageDecoder.
+     * @return Índice de la imagen en el lote, o -1 si está lleno o es inválida
+     */
+    int addEncoded(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Agrega una imagen ya decodificada.
+     * @param rowStride Bytes entre filas (>= width * rgbPixelBytes)
+     * @return Índice de la imagen en el lote, o -1 si está lleno o es inválida
+     */
+    int addPixels(const uint8_t* pixels, int width, int height, int rowStride,
+                  RgbPixelFormat pixelFormat);
+
+    /**
+     * @brief Estado de una imagen; si está lista y info no es nullptr, copia
+     *        sus metadatos. Índices fuera del lote se reportan Failed.
+     */
+    StillState poll(int index, StillImageInfo* info) const;
+
+    /** Tensor de la imagen index, o nullptr si el índice no es válido. */
+    void* tensor(int index) const;
+
+    /** Inicio del buffer contiguo de capacity() tensores. */
+    void* tensorData() const { return tensors_; }
+
+    /** Bytes del tensor de una imagen (targetSize² * 3 elementos del formato). */
+    size_t tensorBytes() const { return tensorBytes_; }
+
+    int capacity() const { return static_cast<int>(entries_.size()); }
+    int targetSize() const { return targetSize_; }
+    const TensorOutputFormat& format() const { return format_; }
+
+private:
+    struct Entry {
+        StillState state = StillState::Pending;
+        int64_t submitNs = 0;
+        int64_t readyNs = 0;
+
+        // Copia de la entrada: archivo codificado o píxeles
+        uint8_t* data = nullptr;
+        size_t length = 0;
+        bool encoded = false;
+        int width = 0;
+        int height = 0;
+        int rowStride = 0;
+        RgbPixelFormat pixelFormat = RgbPixelFormat::Rgba8888;
+
+        LetterboxParams letterbox{};
+    };
+
+    int append(const uint8_t* data, size_t length, bool encoded, int width,
+               int height, int rowStride, RgbPixelFormat pixelFormat);
+    void workerLoop();
+
+    const int targetSize_;
+    const TensorOutputFormat format_;
+    bool valid_ = false;
+    size_t tensorBytes_ = 0;
+    uint8_t* tensors_ = nullptr;
+    std::vector<Entry> entries_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable added_;
+    std::thread worker_;
+    bool stop_ = false;
+    int count_ = 0;  // Imágenes agregadas (el hilo procesa [0, count_))
+};
+
+#endif // STILL_BATCH_H
@@ -0,0 +1,696 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          kernel_golden_test.cpp                               ║
+// ║          Pruebas golden de todas las variantes de los kernels YUV420          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Compara cada variante (SIMD directa, reparto en hilos, reducción, tensor     ║
+// ║  fusionado, tipos de tensor y GPU) con convertYuv420ToRgbScalar sobre         ║
+// ║  planos aleatorios: anchos/altos impares, rowStride con relleno y             ║
+// ║  pixelStride 1 y 2. Los planos miden lo justo: un sanitizer detecta lecturas  ║
+// ║  fuera de rango. También registra el rendimiento de cada variante.            ║
+// ║  Uso: nutrivision_kernel_test [--cases=N] [--seed=N] [--iterations=N]         ║
+// ║       [--baseline=previo.jsonl]                                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
+#include "gles_preprocess.h"
+#include "thread_pool.h"
+#include "yuv_preprocess.h"
+#include "yuv_to_rgb.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONFIGURACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Lado del tensor de entrada del modelo (yolo_service.dart), para el
+/// rendimiento.
+constexpr int kModelInputSize = 640;
+
+/// Lado del tensor en los casos golden: mismo código que a 640 con un
+/// tensor 25× más chico, para que la suite siga siendo rápida con sanitizers.
+constexpr int kGoldenTensorSize = 128;
+
+/// Gris del letterbox (yuv_preprocess.cpp, img.copyResize de Ultralytics).
+constexpr int kPadValue = 114;
+
+/**
+ * Tolerancias frente a la referencia, en niveles de 8 bits.
+ *
+ * Los kernels directos y la reducción comparten la aritmética Q8 con el
+ * escalar: a escala 1 la salida es idéntica. El tensor fusionado usa el
+ * muestreo de la reducción y solo redondea al normalizar; el shader GLES
+ * calcula en float.
+ */
+constexpr int kExactTolerance = 0;
+constexpr int kTensorTolerance = 1;
+constexpr int kGpuTolerance = 2;
+
+/// Margen tolerado sobre el MB/s de --baseline.
+constexpr double kRegressionFactor = 1.2;
+
+struct Options {
+    int cases = 150;
+    uint32_t seed = 20240611;
+    int iterations = 20;
+    std::string baselinePath;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FRAMES ALEATORIOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Generador determinista: mismos casos en todas las ejecuciones y SoCs.
+ */
+struct Lcg {
+    uint32_t state;
+
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    int range(int low, int high) { return low + static_cast<int>(next() % (high - low + 1)); }
+};
+
+/**
+ * Frame YUV420 con planos del tamaño mínimo que exigen sus strides. En NV21
+ * U y V son vistas del mismo buffer entrelazado (V primero), como los
+ * planos de ImageProxy.
+ */
+struct Frame {
+    int width;
+    int height;
+    int yRowStride;
+    int uvRowStride;
+    int uvPixelStride;
+    std::unique_ptr<uint8_t[]> yData;
+    std::unique_ptr<uint8_t[]> uData;
+    std::unique_ptr<uint8_t[]> vData;
+    const uint8_t* y;
+    const uint8_t* u;
+    const uint8_t* v;
+
+    double inputBytes() const { return width * static_cast<double>(height) * 1.5; }
+};
+
+std::unique_ptr<uint8_t[]> randomBytes(size_t count, Lcg& rng) {
+    std::unique_ptr<uint8_t[]> data(new uint8_t[count]);
+    for (size_t i = 0; i < count; i++) data[i] = static_cast<uint8_t>(rng.next());
+    return data;
+}
+
+Frame makeFrame(int width, int height, int padding, int uvPixelStride, Lcg& rng) {
+    Frame frame{};
+    frame.width = width;
+    frame.height = height;
+    frame.uvPixelStride = uvPixelStride;
+
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    frame.yRowStride = width + padding;
+    frame.uvRowStride = uvPixelStride == 2 ? chromaWidth * 2 + padding
+                                           : chromaWidth + padding / 2;
+
+    const size_t yBytes = static_cast<size_t>(frame.yRowStride) * (height - 1) + width;
+    const size_t uvBytes = static_cast<size_t>(frame.uvRowStride) * (chromaHeight - 1) +
+                           static_cast<size_t>(chromaWidth - 1) * uvPixelStride + 1;
+    frame.yData = randomBytes(yBytes, rng);
+    frame.y = frame.yData.get();
+
+    if (uvPixelStride == 2) {
+        frame.vData = randomBytes(uvBytes + 1, rng);
+        frame.v = frame.vData.get();
+        frame.u = frame.vData.get() + 1;
+    } else {
+        frame.uData = randomBytes(uvBytes, rng);
+        frame.vData = randomBytes(uvBytes, rng);
+        frame.u = frame.uData.get();
+        frame.v = frame.vData.get();
+    }
+    return frame;
+}
+
+/**
+ * Caso golden: geometría del frame y orientación de salida.
+ */
+struct GoldenCase {
+    int width;
+    int height;
+    int padding;
+    int uvPixelStride;
+    int rotation;
+    bool mirror;
+};
+
+/**
+ * Bordes fijos (1 píxel, impares, justo antes y después de un bloque SIMD de
+ * 16/32 píxeles) seguidos de casos aleatorios.
+ */
+std::vector<GoldenCase> goldenCases(const Options& options) {
+    std::vector<GoldenCase> cases;
+    constexpr int kEdgeSizes[][2] = {
+        {1, 1}, {2, 2}, {3, 5}, {15, 17}, {16, 16}, {17, 15}, {31, 33},
+        {32, 32}, {33, 31}, {47, 9}, {65, 63}, {641, 479},
+    };
+    constexpr int kRotations[] = {0, 90, 180, 270};
+
+    for (const auto& size : kEdgeSizes) {
+        for (int uvPixelStride = 1; uvPixelStride <= 2; uvPixelStride++) {
+            for (int rotation : kRotations) {
+                cases.push_back({size[0], size[1], 0, uvPixelStride, rotation, false});
+                cases.push_back({size[0], size[1], 13, uvPixelStride, rotation, true});
+            }
+        }
+    }
+
+    Lcg rng{options.seed};
+    for (int i = 0; i < options.cases; i++) {
+        GoldenCase random{};
+        random.width = rng.range(1, 400);
+        random.height = rng.range(1, 300);
+        random.padding = rng.next() % 3 == 0 ? 0 : rng.range(1, 96);
+        random.uvPixelStride = rng.range(1, 2);
+        random.rotation = kRotations[rng.next() % 4];
+        random.mirror = rng.next() % 2 == 0;
+        cases.push_back(random);
+    }
+    return cases;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// COMPARACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Diferencias acumuladas de una variante frente a la referencia.
+ */
+struct Comparison {
+    const char* variant;
+    int tolerance;
+    int cases = 0;
+    int failures = 0;
+    int maxDiff = 0;
+    double sumDiff = 0.0;
+    size_t samples = 0;
+};
+
+void describe(const GoldenCase& golden, char* buffer, size_t size) {
+    std::snprintf(buffer, size, "%dx%d pad %d pixelStride %d rot %d%s",
+                  golden.width, golden.height, golden.padding, golden.uvPixelStride,
+                  golden.rotation, golden.mirror ? " mirror" : "");
+}
+
+/**
+ * Compara count muestras (niveles de 8 bits) y registra el caso.
+ */
+void compare(Comparison& comparison, const GoldenCase& golden,
+             const std::function<int(size_t)>& expected,
+             const std::function<int(size_t)>& actual, size_t count) {
+    int caseMax = 0;
+    size_t firstIndex = 0;
+    double caseSum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        const int diff = std::abs(expected(i) - actual(i));
+        if (diff > caseMax) {
+            caseMax = diff;
+            firstIndex = i;
+        }
+        caseSum += diff;
+    }
+
+    comparison.cases++;
+    comparison.maxDiff = std::max(comparison.maxDiff, caseMax);
+    comparison.sumDiff += caseSum;
+    comparison.samples += count;
+
+    if (caseMax > comparison.tolerance) {
+        if (comparison.failures++ < 5) {
+            char text[96];
+            describe(golden, text, sizeof(text));
+            std::fprintf(stderr,
+                         "FALLA %s [%s]: muestra %zu esperado %d obtenido %d "
+                         "(media %.2f)\n",
+                         comparison.variant, text, firstIndex, expected(firstIndex),
+                         actual(firstIndex), caseSum / static_cast<double>(count));
+        }
+    }
+}
+
+void printComparison(const Comparison& comparison) {
+    const double mean = comparison.samples
+        ? comparison.sumDiff / static_cast<double>(comparison.samples)
+        : 0.0;
+    std::printf(
+        "{\"type\":\"golden\",\"variant\":\"%s\",\"cases\":%d,\"failures\":%d,"
+        "\"max_diff\":%d,\"mean_diff\":%.4f,\"tolerance\":%d}\n",
+        comparison.variant, comparison.cases, comparison.failures,
+        comparison.maxDiff, mean, comparison.tolerance);
+    std::fflush(stdout);
+}
+
+/// Nivel de 8 bits de un valor normalizado [0, 1].
+int level(float value) { return static_cast<int>(std::lround(value * 255.0f)); }
+
+/**
+ * Bits binary16 de un valor en [0, 1], por un camino independiente de
+ * floatToHalf: múltiplo más cercano del cuanto de su exponente, con empate
+ * al par (modo de redondeo por defecto de nearbyint).
+ */
+int halfBits(float value) {
+    if (value <= 0.0f) return 0;
+    int exponent = 0;
+    std::frexp(value, &exponent);
+    // value = 1.m × 2^e con e = exponent - 1; por debajo de 2^-14, subnormal
+    const int e = std::max(exponent - 1, -14);
+    const double quantum = std::ldexp(1.0, e - 10);
+    const int q = static_cast<int>(std::nearbyint(value / quantum));
+    // Un q de 2048 sube al exponente siguiente sin tratarlo aparte
+    return e == -14 && q < 1024 ? q : ((e + 15) << 10) + q - 1024;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// VARIANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+using ConvertFn = void (*)(
+    const uint8_t*, const uint8_t*, const uint8_t*, uint8_t*,
+    int, int, int, int, int, int, bool);
+
+struct DirectKernel {
+    const char* name;
+    ConvertFn fn;
+};
+
+/**
+ * Versiones de conversión directas (un hilo), solo las que la CPU soporta.
+ */
+std::vector<DirectKernel> directKernels() {
+    std::vector<DirectKernel> kernels;
+    const uint32_t features = cpuFeatures();
+    (void)features;
+
+#if defined(__aarch64__) || defined(__arm__)
+    if (features & kCpuNeon) kernels.push_back({"convert_neon", convertYuv420ToRgbNeon});
+#endif
+#if defined(__x86_64__)
+    if (features & kCpuSse41) kernels.push_back({"convert_sse41", convertYuv420ToRgbSse41});
+    if (features & kCpuAvx2) kernels.push_back({"convert_avx2", convertYuv420ToRgbAvx2});
+#endif
+    return kernels;
+}
+
+/// Hilos con los que se prueba el reparto en bandas de convertYuv420ToRgb.
+constexpr int kThreadCounts[] = {1, 2, 3, 4};
+
+/**
+ * Resultados de la suite: una comparación por variante, en orden estable.
+ */
+struct GoldenSuite {
+    std::vector<Comparison> comparisons;
+
+    Comparison& get(const char* variant, int tolerance) {
+        for (Comparison& comparison : comparisons) {
+            if (std::strcmp(comparison.variant, variant) == 0) return comparison;
+        }
+        comparisons.push_back({variant, tolerance});
+        return comparisons.back();
+    }
+};
+
+/// Nombres estables (las comparaciones guardan el puntero).
+constexpr const char* kThreadVariantNames[] = {
+    "convert_threads_1", "convert_threads_2", "convert_threads_3", "convert_threads_4",
+};
+
+void runConvertVariants(GoldenSuite& suite, const GoldenCase& golden, const Frame& frame,
+                        const std::vector<uint8_t>& reference) {
+    const size_t bytes = reference.size();
+    std::vector<uint8_t> rgb(bytes);
+    const auto expected = [&](size_t i) { return static_cast<int>(reference[i]); };
+    const auto actual = [&](size_t i) { return static_cast<int>(rgb[i]); };
+
+    for (const DirectKernel& kernel : directKernels()) {
+        std::fill(rgb.begin(), rgb.end(), 0xA5);
+        kernel.fn(frame.y, frame.u, frame.v, rgb.data(), frame.width, frame.height,
+                  frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                  golden.rotation, golden.mirror);
+        compare(suite.get(kernel.name, kExactTolerance), golden, expected, actual, bytes);
+    }
+
+    // Kernel instalado repartido en bandas: los bordes de banda no se notan
+    for (size_t t = 0; t < sizeof(kThreadCounts) / sizeof(kThreadCounts[0]); t++) {
+        ThreadPool::shared().setThreadCount(kThreadCounts[t]);
+        std::fill(rgb.begin(), rgb.end(), 0xA5);
+        convertYuv420ToRgb(frame.y, frame.u, frame.v, rgb.data(), frame.width, frame.height,
+                           frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                           golden.rotation, golden.mirror);
+        compare(suite.get(kThreadVariantNames[t], kExactTolerance), golden,
+                expected, actual, bytes);
+    }
+    ThreadPool::shared().setThreadCount(0);
+}
+
+void runScaledVariant(GoldenSuite& suite, const GoldenCase& golden, const Frame& frame,
+                      const std::vector<uint8_t>& reference) {
+    // A la resolución de salida completa la reducción es un remuestreo 1:1
+    const bool rotated = golden.rotation == 90 || golden.rotation == 270;
+    const int dstWidth = rotated ? frame.height : frame.width;
+    const int dstHeight = rotated ? frame.width : frame.height;
+
+    std::vector<uint8_t> rgb(reference.size(), 0xA5);
+    convertYuv420ToRgbScaled(frame.y, frame.u, frame.v, frame.width, frame.height,
+                             frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                             golden.rotation, golden.mirror, dstWidth, dstHeight,
+                             rgb.data());
+    compare(suite.get("convert_scaled", kExactTolerance), golden,
+            [&](size_t i) { return static_cast<int>(reference[i]); },
+            [&](size_t i) { return static_cast<int>(rgb[i]); }, reference.size());
+}
+
+/**
+ * Tensor fusionado frente a la reducción a la zona útil más el letterbox:
+ * la documentación de convertYuv420ToRgbScaled garantiza el mismo muestreo.
+ */
+void runTensorVariants(GoldenSuite& suite, const GoldenCase& golden, const Frame& frame) {
+    const bool rotated = golden.rotation == 90 || golden.rotation == 270;
+    const int rotatedWidth = rotated ? frame.height : frame.width;
+    const int rotatedHeight = rotated ? frame.width : frame.height;
+    const LetterboxParams letterbox =
+        computeLetterbox(rotatedWidth, rotatedHeight, kGoldenTensorSize);
+    if (letterbox.newWidth <= 0 || letterbox.newHeight <= 0) return;
+
+    std::vector<uint8_t> scaled(static_cast<size_t>(letterbox.newWidth) *
+                                letterbox.newHeight * 3);
+    convertYuv420ToRgbScaled(frame.y, frame.u, frame.v, frame.width, frame.height,
+                             frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                             golden.rotation, golden.mirror, letterbox.newWidth,
+                             letterbox.newHeight, scaled.data());
+
+    // Tensor NHWC esperado en niveles de 8 bits (padding 114)
+    const size_t pixels = static_cast<size_t>(kGoldenTensorSize) * kGoldenTensorSize;
+    std::vector<uint8_t> expected(pixels * 3, kPadValue);
+    for (int y = 0; y < letterbox.newHeight; y++) {
+        for (int x = 0; x < letterbox.newWidth; x++) {
+            const size_t src = (static_cast<size_t>(y) * letterbox.newWidth + x) * 3;
+            const size_t dst = (static_cast<size_t>(y + letterbox.padTop) * kGoldenTensorSize +
+                                x + letterbox.padLeft) * 3;
+            std::memcpy(&expected[dst], &scaled[src], 3);
+        }
+    }
+    const auto expectedLevel = [&](size_t i) { return static_cast<int>(expected[i]); };
+
+    std::vector<float> tensor(pixels * 3);
+    preprocessYuv420ToTensor(frame.y, frame.u, frame.v, frame.width, frame.height,
+                             frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                             golden.rotation, golden.mirror, kGoldenTensorSize,
+                             tensor.data());
+    compare(suite.get("tensor_float32", kTensorTolerance), golden, expectedLevel,
+            [&](size_t i) { return level(tensor[i]); }, tensor.size());
+
+    // Tipos cuantizados: la escala de 1/255 deja un nivel por unidad
+    struct QuantizedFormat {
+        const char* name;
+        TensorOutputFormat format;
+    };
+    const QuantizedFormat formats[] = {
+        {"tensor_nchw", {TensorDataType::Float32, 1.0f, 0, TensorLayout::Nchw}},
+        {"tensor_uint8", {TensorDataType::Uint8, 1.0f / 255.0f, 0, TensorLayout::Nhwc}},
+        {"tensor_int8", {TensorDataType::Int8, 1.0f / 255.0f, -128, TensorLayout::Nhwc}},
+    };
+    std::vector<uint8_t> typed(pixels * 3 * sizeof(float));
+    for (const QuantizedFormat& entry : formats) {
+        preprocessYuv420ToTensorAs(frame.y, frame.u, frame.v, frame.width, frame.height,
+                                   frame.yRowStride, frame.uvRowStride,
+                                   frame.uvPixelStride, golden.rotation, golden.mirror,
+                                   kGoldenTensorSize, entry.format, typed.data());
+
+        std::function<int(size_t)> actual;
+        if (entry.format.dataType == TensorDataType::Uint8) {
+            actual = [&](size_t i) { return static_cast<int>(typed[i]); };
+        } else if (entry.format.dataType == TensorDataType::Int8) {
+            actual = [&](size_t i) {
+                return static_cast<int>(static_cast<int8_t>(typed[i])) + 128;
+            };
+        } else {
+            // NCHW: índice NHWC i = p * 3 + c → c * pixels + p
+            const float* planar = reinterpret_cast<const float*>(typed.data());
+            actual = [planar, pixels](size_t i) {
+                return level(planar[(i % 3) * pixels + i / 3]);
+            };
+        }
+        compare(suite.get(entry.name, kTensorTolerance), golden, expectedLevel, actual,
+                pixels * 3);
+    }
+
+    // Float16: mismo muestreo que float32, así que cada elemento debe ser
+    // exactamente el binary16 del valor float32
+    const TensorOutputFormat halfFormat{TensorDataType::Float16, 1.0f, 0, TensorLayout::Nhwc};
+    preprocessYuv420ToTensorAs(frame.y, frame.u, frame.v, frame.width, frame.height,
+                               frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                               golden.rotation, golden.mirror, kGoldenTensorSize,
+                               halfFormat, typed.data());
+    const uint16_t* half = reinterpret_cast<const uint16_t*>(typed.data());
+    compare(suite.get("tensor_float16", kExactTolerance), golden,
+            [&](size_t i) { return halfBits(tensor[i]); },
+            [half](size_t i) { return static_cast<int>(half[i]); }, pixels * 3);
+
+    // Compute shader GLES 3.1: solo si hay contexto (dispositivo); si no, el
+    // preprocesado cae al CPU y la variante no se registra
+    setPreprocessBackend(PreprocessBackend::Gpu);
+    std::vector<float> gpuTensor(pixels * 3);
+    preprocessYuv420ToTensor(frame.y, frame.u, frame.v, frame.width, frame.height,
+                             frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                             golden.rotation, golden.mirror, kGoldenTensorSize,
+                             gpuTensor.data());
+    const bool usedGpu = std::strcmp(preprocessBackendName(), "cpu") != 0;
+    setPreprocessBackend(PreprocessBackend::Cpu);
+    if (usedGpu) {
+        compare(suite.get("tensor_gles31", kGpuTolerance), golden, expectedLevel,
+                [&](size_t i) { return level(gpuTensor[i]); }, gpuTensor.size());
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RENDIMIENTO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int64_t nowNs() {
+    // steady_clock es CLOCK_MONOTONIC en bionic y glibc
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t medianNs(int iterations, const std::function<void()>& body) {
+    body();
+    std::vector<int64_t> samples(std::max(iterations, 1));
+    for (int64_t& sample : samples) {
+        const int64_t start = nowNs();
+        body();
+        sample = nowNs() - start;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+struct Throughput {
+    std::string variant;
+    double megabytesPerSecond;
+};
+
+/**
+ * MB/s de entrada YUV de cada variante sobre un frame 1280×720 NV21 con
+ * relleno, rotado 90° (el caso habitual en vivo).
+ */
+std::vector<Throughput> measureThroughput(const Options& options) {
+    Lcg rng{options.seed};
+    const Frame frame = makeFrame(1280, 720, 64, 2, rng);
+    constexpr int kRotation = 90;
+    std::vector<uint8_t> rgb(static_cast<size_t>(frame.width) * frame.height * 3);
+    std::vector<float> tensor(static_cast<size_t>(kModelInputSize) * kModelInputSize * 3);
+    std::vector<uint16_t> halfTensor(tensor.size());
+
+    std::vector<Throughput> results;
+    const auto record = [&](const std::string& variant, const std::function<void()>& body) {
+        const double seconds = static_cast<double>(medianNs(options.iterations, body)) * 1e-9;
+        const double megabytesPerSecond = seconds > 0 ? frame.inputBytes() / seconds / 1e6 : 0.0;
+        results.push_back({variant, megabytesPerSecond});
+        std::printf(
+            "{\"type\":\"throughput\",\"variant\":\"%s\",\"width\":%d,\"height\":%d,"
+            "\"rotation\":%d,\"mb_per_s\":%.1f}\n",
+            variant.c_str(), frame.width, frame.height, kRotation, megabytesPerSecond);
+        std::fflush(stdout);
+    };
+
+    const auto convertWith = [&](ConvertFn fn) {
+        return [&, fn] {
+            fn(frame.y, frame.u, frame.v, rgb.data(), frame.width, frame.height,
+               frame.yRowStride, frame.uvRowStride, frame.uvPixelStride, kRotation, false);
+        };
+    };
+
+    record("convert_scalar", convertWith(convertYuv420ToRgbScalar));
+    for (const DirectKernel& kernel : directKernels()) {
+        record(kernel.name, convertWith(kernel.fn));
+    }
+    for (size_t t = 0; t < sizeof(kThreadCounts) / sizeof(kThreadCounts[0]); t++) {
+        ThreadPool::shared().setThreadCount(kThreadCounts[t]);
+        record(kThreadVariantNames[t], convertWith(convertYuv420ToRgb));
+    }
+    ThreadPool::shared().setThreadCount(0);
+
+    const LetterboxParams letterbox =
+        computeLetterbox(frame.height, frame.width, kModelInputSize);
+    record("convert_scaled", [&] {
+        convertYuv420ToRgbScaled(frame.y, frame.u, frame.v, frame.width, frame.height,
+                                 frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                                 kRotation, false, letterbox.newWidth, letterbox.newHeight,
+                                 rgb.data());
+    });
+    record("tensor_float32", [&] {
+        preprocessYuv420ToTensor(frame.y, frame.u, frame.v, frame.width, frame.height,
+                                 frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                                 kRotation, false, kModelInputSize, tensor.data());
+    });
+    const TensorOutputFormat halfFormat{TensorDataType::Float16, 1.0f, 0, TensorLayout::Nhwc};
+    record("tensor_float16", [&] {
+        preprocessYuv420ToTensorAs(frame.y, frame.u, frame.v, frame.width, frame.height,
+                                   frame.yRowStride, frame.uvRowStride, frame.uvPixelStride,
+                                   kRotation, false, kModelInputSize, halfFormat,
+                                   halfTensor.data());
+    });
+    return results;
+}
+
+/**
+ * Variantes cuyo MB/s cae por debajo de la línea base / kRegressionFactor.
+ */
+int countRegressions(const std::vector<Throughput>& results, const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", path.c_str());
+        return -1;
+    }
+
+    int regressions = 0;
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        if (!std::strstr(line, "\"type\":\"throughput\"")) continue;
+        const char* rate = std::strstr(line, "\"mb_per_s\":");
+        if (!rate) continue;
+        const double before = std::strtod(rate + std::strlen("\"mb_per_s\":"), nullptr);
+
+        for (const Throughput& result : results) {
+            const std::string key = "\"variant\":\"" + result.variant + "\"";
+            if (!std::strstr(line, key.c_str()) || before <= 0) continue;
+            if (result.megabytesPerSecond * kRegressionFactor < before) {
+                std::fprintf(stderr, "Regresión en %s: %.1f MB/s → %.1f MB/s\n",
+                             result.variant.c_str(), before, result.megabytesPerSecond);
+                regressions++;
+            }
+        }
+    }
+    std::fclose(file);
+    return regressions;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ARGUMENTOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool parseArgument(const char* argument, const char* name, const char** value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(argument, name, length) != 0 || argument[length] != '=') return false;
+    *value = argument + length + 1;
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* value = nullptr;
+        if (parseArgument(argv[i], "--cases", &value)) {
+            options.cases = std::max(std::atoi(value), 0);
+        } else if (parseArgument(argv[i], "--seed", &value)) {
+            options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (parseArgument(argv[i], "--iterations", &value)) {
+            options.iterations = std::max(std::atoi(value), 0);
+        } else if (parseArgument(argv[i], "--baseline", &value)) {
+            options.baselinePath = value;
+        } else {
+            std::fprintf(stderr,
+                         "Uso: %s [--cases=N] [--seed=N] [--iterations=N] "
+                         "[--baseline=previo.jsonl]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Código de salida: 0 todo correcto, 1 alguna variante fuera de tolerancia,
+ * 2 regresión de rendimiento frente a --baseline.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::printf(
+        "{\"type\":\"meta\",\"kernel\":\"%s\",\"cpu_features\":\"%s\","
+        "\"threads\":%d,\"seed\":%u,\"cases\":%d}\n",
+        yuvKernelName(), cpuFeatureString(cpuFeatures()).c_str(),
+        ThreadPool::shared().threadCount(), options.seed, options.cases);
+
+    GoldenSuite suite;
+    Lcg rng{options.seed ^ 0x9E3779B9u};
+    for (const GoldenCase& golden : goldenCases(options)) {
+        const Frame frame =
+            makeFrame(golden.width, golden.height, golden.padding, golden.uvPixelStride, rng);
+
+        std::vector<uint8_t> reference(static_cast<size_t>(frame.width) * frame.height * 3);
+        convertYuv420ToRgbScalar(frame.y, frame.u, frame.v, reference.data(),
+                                 frame.width, frame.height, frame.yRowStride,
+                                 frame.uvRowStride, frame.uvPixelStride,
+                                 golden.rotation, golden.mirror);
+
+        runConvertVariants(suite, golden, frame, reference);
+        runScaledVariant(suite, golden, frame, reference);
+        runTensorVariants(suite, golden, frame);
+    }
+
+    int failures = 0;
+    for (const Comparison& comparison : suite.comparisons) {
+        printComparison(comparison);
+        failures += comparison.failures;
+    }
+    if (failures > 0) {
+        std::fprintf(stderr, "%d casos fuera de tolerancia\n", failures);
+        return 1;
+    }
+
+    if (options.iterations == 0) return 0;
+    const std::vector<Throughput> results = measureThroughput(options);
+    if (options.baselinePath.empty()) return 0;
+
+    const int regressions = countRegressions(results, options.baselinePath);
+    if (regressions < 0) return 1;
+    return regressions > 0 ? 2 : 0;
+}
@@ -0,0 +1,233 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              thread_pool.cpp                                  ║
+// ║              Pool persistente de hilos para kernels por bandas                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Los núcleos grandes se detectan por cpuinfo_max_freq; los trabajadores se    ║
+// ║  fijan a ellos con sched_setaffinity. El llamador nunca se fija.              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TOPOLOGÍA DE CPU
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Frecuencia máxima de una CPU en kHz, o 0 si no se puede leer.
+ */
+long cpuMaxFrequency(int cpu) {
+    char path[96];
+    std::snprintf(path, sizeof(path),
+                  "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+
+    FILE* file = std::fopen(path, "r");
+    if (!file) return 0;
+
+    long frequency = 0;
+    if (std::fscanf(file, "%ld", &frequency) != 1) frequency = 0;
+    std::fclose(file);
+    return frequency;
+}
+
+/**
+ * Núcleos con frecuencia máxima superior a la del clúster más lento.
+ *
+ * En big.LITTLE (o prime + big + little) son los núcleos de rendimiento. Vacío
+ * si el SoC es homogéneo o sysfs no es legible: en ese caso no se fija nada.
+ */
+std::vector<int> detectBigCores() {
+    const int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    std::vector<long> frequencies(std::max(cpuCount, 0));
+    for (int cpu = 0; cpu < cpuCount; cpu++) {
+        frequencies[cpu] = cpuMaxFrequency(cpu);
+        if (frequencies[cpu] <= 0) return {};
+    }
+    if (frequencies.empty()) return {};
+
+    const long slowest = *std::min_element(frequencies.begin(), frequencies.end());
+    std::vector<int> bigCores;
+    for (int cpu = 0; cpu < cpuCount; cpu++) {
+        if (frequencies[cpu] > slowest) bigCores.push_back(cpu);
+    }
+    return bigCores;
+}
+
+const std::vector<int>& bigCores() {
+    static const std::vector<int> cores = detectBigCores();
+    return cores;
+}
+
+/**
+ * Fija el hilo actual a los núcleos indicados (best effort).
+ */
+void pinCurrentThread(const std::vector<int>& cores) {
+#if defined(__linux__)
+    if (cores.empty()) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cores) {
+        CPU_SET(cpu, &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)cores;
+#endif
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CICLO DE VIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+ThreadPool& ThreadPool::shared() {
+    // Se filtra a propósito: evita destruir hilos durante la salida del proceso
+    static ThreadPool* pool = new ThreadPool(defaultThreadCount());
+    return *pool;
+}
+
+int ThreadPool::defaultThreadCount() {
+    const int big = static_cast<int>(bigCores().size());
+    const int all = static_cast<int>(std::thread::hardware_concurrency());
+    const int count = big > 0 ? big : all;
+    return std::min(std::max(count, 1), kMaxThreads);
+}
+
+ThreadPool::ThreadPool(int threadCount) : bigCores_(bigCores()) {
+    setThreadCount(threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    stopWorkers();
+}
+
+int ThreadPool::setThreadCount(int threadCount) {
+    const int count = threadCount <= 0
+        ? defaultThreadCount()
+        : std::min(threadCount, kMaxThreads);
+
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    if (count == this->threadCount() && static_cast<int>(workers_.size()) == count - 1) {
+        return count;
+    }
+
+    stopWorkers();
+    startWorkers(count - 1);
+    threadCount_.store(count, std::memory_order_relaxed);
+    return count;
+}
+
+void ThreadPool::startWorkers(int workerCount) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+    }
+    workers_.reserve(workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+void ThreadPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// EJECUCIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void ThreadPool::run(int count, int alignment, BandFn fn, void* context) {
+    if (count <= 0) return;
+    alignment = std::max(alignment, 1);
+
+    // Bandas de al menos `alignment` elementos, una por hilo como máximo
+    const int maxBands = std::max(count / alignment, 1);
+    int bandCount = std::min(threadCount(), maxBands);
+    if (bandCount <= 1) {
+        fn(context, 0, count);
+        return;
+    }
+
+    // Pool ocupado por otro hilo o llamada anidada: ejecutar en línea
+    std::unique_lock<std::mutex> runLock(runMutex_, std::try_to_lock);
+    if (!runLock.owns_lock() || workers_.empty()) {
+        fn(context, 0, count);
+        return;
+    }
+
+    const int perBand = (count + bandCount - 1) / bandCount;
+    const int bandSize = (perBand + alignment - 1) / alignment * alignment;
+    bandCount = (count + bandSize - 1) / bandSize;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = fn;
+        context_ = context;
+        count_ = count;
+        bandSize_ = bandSize;
+        bandCount_ = bandCount;
+        nextBand_.store(0, std::memory_order_relaxed);
+    }
+    wake_.notify_all();
+
+    executeBands();
+
+    // Los trabajadores que tomaron el trabajo deben salir antes de que el
+    // siguiente reinicie el contador de bandas
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+}
+
+void ThreadPool::executeBands() {
+    for (;;) {
+        const int band = nextBand_.fetch_add(1, std::memory_order_relaxed);
+        if (band >= bandCount_) return;
+
+        const int begin = band * bandSize_;
+        const int end = std::min(begin + bandSize_, count_);
+        fn_(context_, begin, end);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    pinCurrentThread(bigCores_);
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] {
+                return stop_ ||
+                       nextBand_.load(std::memory_order_relaxed) < bandCount_;
+            });
+            if (stop_) return;
+            active_++;
+        }
+
+        executeBands();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) done_.notify_one();
+        }
+    }
+}
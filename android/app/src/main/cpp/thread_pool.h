@@ -0,0 +1,105 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                               thread_pool.h                                   ║
+// ║              Pool persistente de hilos para kernels por bandas                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Hilos creados una vez (al cargar la biblioteca) y fijados a los núcleos      ║
+// ║  grandes cuando el SoC es heterogéneo. Reparte filas en bandas alineadas.     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// POOL DE HILOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Pool de hilos para dividir un frame en bandas horizontales.
+ *
+ * El hilo llamador participa como un trabajador más y espera a que terminen
+ * todas las bandas, así que `parallelFor` es síncrono y puede usarse desde
+ * JNI o desde llamadas FFI leaf. Un solo trabajo a la vez: si el pool está
+ * ocupado (otro hilo o una llamada anidada) el trabajo se ejecuta completo en
+ * el hilo llamador.
+ */
+class ThreadPool {
+public:
+    /// Hilos máximos (incluido el llamador).
+    static constexpr int kMaxThreads = 8;
+
+    /// Pool compartido, creado en el primer uso (JNI_OnLoad lo fuerza).
+    static ThreadPool& shared();
+
+    /// Hilos por defecto: núcleos grandes, o todos si el SoC es homogéneo.
+    static int defaultThreadCount();
+
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Hilos que participan en cada trabajo, incluido el llamador.
+    int threadCount() const { return threadCount_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Cambia el número de hilos (1..kMaxThreads; <= 0 restaura el
+     *        valor por defecto). Espera a que termine el trabajo en curso.
+     * @return Número de hilos efectivo
+     */
+    int setThreadCount(int threadCount);
+
+    /**
+     * @brief Ejecuta body(begin, end) sobre [0, count) repartido en bandas.
+     *
+     * Los límites de cada banda son múltiplos de `alignment` (salvo el final
+     * del rango) y cada banda tiene al menos `alignment` elementos.
+     */
+    template <typename Body>
+    void parallelFor(int count, int alignment, Body&& body) {
+        using BodyType = std::remove_reference_t<Body>;
+        run(count, alignment,
+            [](void* context, int begin, int end) {
+                (*static_cast<BodyType*>(context))(begin, end);
+            },
+            const_cast<void*>(static_cast<const void*>(&body)));
+    }
+
+private:
+    using BandFn = void (*)(void* context, int begin, int end);
+
+    void run(int count, int alignment, BandFn fn, void* context);
+    void executeBands();
+    void workerLoop();
+    void startWorkers(int workerCount);
+    void stopWorkers();
+
+    std::atomic<int> threadCount_{1};
+    std::vector<std::thread> workers_;
+    std::vector<int> bigCores_;
+
+    // Serializa trabajos y cambios de tamaño
+    std::mutex runMutex_;
+
+    // Estado del trabajo actual (protegido por mutex_)
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    BandFn fn_ = nullptr;
+    void* context_ = nullptr;
+    int count_ = 0;
+    int bandSize_ = 0;
+    int bandCount_ = 0;
+    int active_ = 0;
+    bool stop_ = false;
+    std::atomic<int> nextBand_{0};
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,517 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            video_decoder.cpp                                  ║
+// ║          Análisis de video: AMediaExtractor + AMediaCodec → tensores YOLO     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "video_decoder.h"
+
+#include <android/log.h>
+#include <fcntl.h>
+#include <media/NdkMediaCodec.h>
+#include <media/NdkMediaExtractor.h>
+#include <media/NdkMediaFormat.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "native_memory.h"
+#include "native_stats.h"
+#include "yuv_to_rgb.h"
+
+#define LOG_TAG "NutriVisionVideo"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+// Formatos de color de MediaCodecInfo.CodecCapabilities
+constexpr int32_t kColorFormatYuv420Planar = 19;
+constexpr int32_t kColorFormatYuv420SemiPlanar = 21;
+constexpr int32_t kColorFormatYuv420Flexible = 0x7F420888;
+constexpr int32_t kColorFormatQcomSemiPlanar32m = 0x7FA30C04;
+
+// Las claves de stride, slice-height, recorte y rotación solo tienen
+// constante AMEDIAFORMAT_KEY_* desde API 28; el nombre es el mismo
+constexpr const char* kKeyStride = "stride";
+constexpr const char* kKeySliceHeight = "slice-height";
+constexpr const char* kKeyRotation = "rotation-degrees";
+
+// Espera máxima de cada dequeue: acota lo que tarda el hilo en ver stop_
+constexpr int64_t kDequeueTimeoutUs = 10000;
+
+int32_t formatInt(AMediaFormat* format, const char* key, int32_t fallback) {
+    int32_t value = 0;
+    return AMediaFormat_getInt32(format, key, &value) ? value : fallback;
+}
+
+/**
+ * Copia de MediaImage2 (media/hardware/VideoAPI.h), el contenido de la clave
+ * "image-data": offset e incrementos de cada plano dentro del buffer.
+ */
+struct MediaImage2 {
+    enum Type : uint32_t { kTypeYuv = 1 };
+    enum Plane : uint32_t { kY = 0, kU = 1, kV = 2, kMaxPlanes = 4 };
+
+    struct PlaneInfo {
+        uint32_t offset;
+        int32_t colInc;
+        int32_t rowInc;
+        uint32_t horizSubsampling;
+        uint32_t vertSubsampling;
+    };
+
+    uint32_t type;
+    uint32_t numPlanes;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bitDepth;
+    uint32_t bitDepthAllocated;
+    PlaneInfo planes[kMaxPlanes];
+};
+static_assert(sizeof(MediaImage2) == 104, "MediaImage2 no coincide con VideoAPI.h");
+
+constexpr const char* kKeyImageData = "image-data";
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CICLO DE VIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+std::unique_ptr<VideoDecoder> VideoDecoder::open(
+    const char* path, int sampleEvery, int queueDepth, int targetSize,
+    const TensorOutputFormat& format
+) {
+    if (!path || sampleEvery <= 0 || targetSize <= 0 || !validTensorFormat(format)) {
+        return nullptr;
+    }
+    if (queueDepth <= 0) queueDepth = kDefaultSlots;
+    queueDepth = std::min(queueDepth, kMaxSlots);
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE("No se pudo abrir %s", path);
+        return nullptr;
+    }
+    struct stat info{};
+    AMediaExtractor* extractor = AMediaExtractor_new();
+    // El extractor duplica el descriptor: se puede cerrar enseguida
+    media_status_t status = fstat(fd, &info) == 0 && extractor
+        ? AMediaExtractor_setDataSourceFd(extractor, fd, 0, info.st_size)
+        : AMEDIA_ERROR_UNKNOWN;
+    ::close(fd);
+    if (status != AMEDIA_OK) {
+        LOGE("AMediaExtractor_setDataSourceFd falló: %d", status);
+        if (extractor) AMediaExtractor_delete(extractor);
+        return nullptr;
+    }
+
+    // Primera pista de video
+    AMediaCodec* codec = nullptr;
+    int rotation = 0;
+    int64_t durationUs = 0;
+    const size_t trackCount = AMediaExtractor_getTrackCount(extractor);
+    for (size_t track = 0; track < trackCount && !codec; ++track) {
+        AMediaFormat* trackFormat = AMediaExtractor_getTrackFormat(extractor, track);
+        const char* mime = nullptr;
+        if (!AMediaFormat_getString(trackFormat, AMEDIAFORMAT_KEY_MIME, &mime) || !mime ||
+            std::strncmp(mime, "video/", 6) != 0) {
+            AMediaFormat_delete(trackFormat);
+            continue;
+        }
+
+        codec = AMediaCodec_createDecoderByType(mime);
+        if (codec) {
+            AMediaFormat_setInt32(trackFormat, AMEDIAFORMAT_KEY_COLOR_FORMAT,
+                                  kColorFormatYuv420Flexible);
+            status = AMediaCodec_configure(codec, trackFormat, nullptr, nullptr, 0);
+            if (status == AMEDIA_OK) status = AMediaCodec_start(codec);
+            if (status != AMEDIA_OK) {
+                LOGE("No se pudo iniciar el decodificador %s: %d", mime, status);
+                AMediaCodec_delete(codec);
+                codec = nullptr;
+            } else {
+                AMediaExtractor_selectTrack(extractor, track);
+                rotation = formatInt(trackFormat, kKeyRotation, 0);
+                if (!AMediaFormat_getInt64(trackFormat, AMEDIAFORMAT_KEY_DURATION,
+                                           &durationUs)) {
+                    durationUs = 0;
+                }
+                LOGD("Decodificando %s (pista %zu, rotación %d)", mime, track, rotation);
+            }
+        }
+        AMediaFormat_delete(trackFormat);
+    }
+    if (!codec) {
+        LOGE("Sin pista de video decodificable en %s", path);
+        AMediaExtractor_delete(extractor);
+        return nullptr;
+    }
+
+    std::unique_ptr<VideoDecoder> decoder(new (std::nothrow) VideoDecoder(
+        extractor, codec, sampleEvery, queueDepth, targetSize, format, rotation, durationUs));
+    if (!decoder) {
+        AMediaCodec_stop(codec);
+        AMediaCodec_delete(codec);
+        AMediaExtractor_delete(extractor);
+        return nullptr;
+    }
+    if (!decoder->valid_) return nullptr;
+
+    decoder->worker_ = std::thread(&VideoDecoder::decodeLoop, decoder.get());
+    return decoder;
+}
+
+VideoDecoder::VideoDecoder(AMediaExtractor* extractor, AMediaCodec* codec, int sampleEvery,
+                           int queueDepth, int targetSize, const TensorOutputFormat& format,
+                           int rotation, int64_t durationUs)
+    : extractor_(extractor),
+      codec_(codec),
+      sampleEvery_(sampleEvery),
+      targetSize_(targetSize),
+      format_(format),
+      rotation_(((rotation % 360) + 360) % 360),
+      slots_(queueDepth) {
+    tensorBytes_ = static_cast<size_t>(targetSize) * targetSize * 3 *
+                   tensorElementBytes(format.dataType);
+    for (size_t i = 0; i < slots_.size(); i++) {
+        slots_[i].tensor = alignedAlloc(tensorBytes_, MemoryArena::Tensors);
+        if (slots_[i].tensor != nullptr) continue;
+        if (i == 0) return;
+        // Sin presupuesto para más slots: menos decodificación por delante
+        slots_.resize(i);
+        break;
+    }
+    stats_.durationUs = durationUs;
+    valid_ = true;
+}
+
+VideoDecoder::~VideoDecoder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    released_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    AMediaCodec_stop(codec_);
+    AMediaCodec_delete(codec_);
+    AMediaExtractor_delete(extractor_);
+    for (auto& slot : slots_) {
+        alignedFree(slot.tensor);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// HILO DE DECODIFICACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void VideoDecoder::decodeLoop() {
+    int64_t frameIndex = 0;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_) return;
+        }
+
+        if (!inputDone_ && !feedInput()) {
+            finish(VideoState::Failed);
+            return;
+        }
+
+        AMediaCodecBufferInfo bufferInfo{};
+        const ssize_t index =
+            AMediaCodec_dequeueOutputBuffer(codec_, &bufferInfo, kDequeueTimeoutUs);
+        if (index == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED) {
+            AMediaFormat* outputFormat = AMediaCodec_getOutputFormat(codec_);
+            const bool ok = readOutputFormat(outputFormat);
+            AMediaFormat_delete(outputFormat);
+            if (!ok) {
+                finish(VideoState::Failed);
+                return;
+            }
+            continue;
+        }
+        if (index == AMEDIACODEC_INFO_TRY_AGAIN_LATER ||
+            index == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED) {
+            continue;
+        }
+        if (index < 0) {
+            LOGE("AMediaCodec_dequeueOutputBuffer falló: %zd", index);
+            finish(VideoState::Failed);
+            return;
+        }
+
+        bool ok = true;
+        if (bufferInfo.size > 0) {
+            // Algunos códecs no anuncian el formato antes del primer buffer
+            if (layout_.width == 0) {
+                AMediaFormat* outputFormat = AMediaCodec_getOutputFormat(codec_);
+                ok = readOutputFormat(outputFormat);
+                AMediaFormat_delete(outputFormat);
+            }
+
+            if (ok && frameIndex % sampleEvery_ == 0) {
+                size_t capacity = 0;
+                const uint8_t* data = AMediaCodec_getOutputBuffer(codec_, index, &capacity);
+                ok = data != nullptr && bufferInfo.offset >= 0 &&
+                     static_cast<size_t>(bufferInfo.offset) + bufferInfo.size <= capacity &&
+                     convertOutput(data + bufferInfo.offset,
+                                   static_cast<size_t>(bufferInfo.size), frameIndex,
+                                   bufferInfo.presentationTimeUs);
+            }
+            frameIndex++;
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.decoded = frameIndex;
+        }
+        AMediaCodec_releaseOutputBuffer(codec_, index, false);
+
+        if (!ok) {
+            finish(VideoState::Failed);
+            return;
+        }
+        if (bufferInfo.flags & AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM) {
+            LOGD("Fin del video: %lld frames decodificados",
+                 static_cast<long long>(frameIndex));
+            finish(VideoState::Ended);
+            return;
+        }
+    }
+}
+
+bool VideoDecoder::feedInput() {
+    const ssize_t index = AMediaCodec_dequeueInputBuffer(codec_, 0);
+    if (index < 0) return true;  // Sin buffers libres: el códec va por delante
+
+    size_t capacity = 0;
+    uint8_t* buffer = AMediaCodec_getInputBuffer(codec_, index, &capacity);
+    if (!buffer) return false;
+
+    const ssize_t size = AMediaExtractor_readSampleData(extractor_, buffer, capacity);
+    if (size < 0) {
+        inputDone_ = true;
+        return AMediaCodec_queueInputBuffer(codec_, index, 0, 0, 0,
+                                            AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM) == AMEDIA_OK;
+    }
+
+    const int64_t timeUs = AMediaExtractor_getSampleTime(extractor_);
+    const media_status_t status =
+        AMediaCodec_queueInputBuffer(codec_, index, 0, static_cast<size_t>(size), timeUs, 0);
+    AMediaExtractor_advance(extractor_);
+    return status == AMEDIA_OK;
+}
+
+bool VideoDecoder::readOutputFormat(AMediaFormat* format) {
+    if (!format) return false;
+
+    const int32_t colorFormat = formatInt(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, 0);
+    const int32_t width = formatInt(format, AMEDIAFORMAT_KEY_WIDTH, 0);
+    const int32_t height = formatInt(format, AMEDIAFORMAT_KEY_HEIGHT, 0);
+
+    OutputLayout layout;
+    void* imageData = nullptr;
+    size_t imageDataSize = 0;
+    if (AMediaFormat_getBuffer(format, kKeyImageData, &imageData, &imageDataSize) &&
+        imageData && imageDataSize >= sizeof(MediaImage2)) {
+        // Layout explícito (Codec2 lo publica también para Flexible)
+        MediaImage2 image;
+        std::memcpy(&image, imageData, sizeof(image));
+        const MediaImage2::PlaneInfo& y = image.planes[MediaImage2::kY];
+        const MediaImage2::PlaneInfo& u = image.planes[MediaImage2::kU];
+        const MediaImage2::PlaneInfo& v = image.planes[MediaImage2::kV];
+        if (image.type != MediaImage2::kTypeYuv || image.numPlanes != 3 ||
+            image.bitDepth != 8 || image.bitDepthAllocated != 8 ||
+            y.colInc != 1 || y.rowInc <= 0 ||
+            y.horizSubsampling != 1 || y.vertSubsampling != 1 ||
+            u.horizSubsampling != 2 || u.vertSubsampling != 2 ||
+            v.horizSubsampling != 2 || v.vertSubsampling != 2 ||
+            u.colInc != v.colInc || u.rowInc != v.rowInc ||
+            (u.colInc != 1 && u.colInc != 2) || u.rowInc <= 0) {
+            LOGE("image-data no es YUV420 de 8 bits (tipo %u, %u planos)",
+                 image.type, image.numPlanes);
+            return false;
+        }
+        layout.yOffset = y.offset;
+        layout.uOffset = u.offset;
+        layout.vOffset = v.offset;
+        layout.yRowStride = y.rowInc;
+        layout.uvRowStride = u.rowInc;
+        layout.uvPixelStride = u.colInc;
+    } else {
+        const int32_t stride = std::max(formatInt(format, kKeyStride, width), width);
+        const int32_t sliceHeight = std::max(formatInt(format, kKeySliceHeight, height), height);
+        const size_t lumaBytes = static_cast<size_t>(stride) * sliceHeight;
+        layout.yRowStride = stride;
+        layout.yOffset = 0;
+        switch (colorFormat) {
+            case kColorFormatYuv420SemiPlanar:
+            case kColorFormatQcomSemiPlanar32m:
+                // NV12: U y V intercalados tras el plano Y
+                layout.uvRowStride = stride;
+                layout.uvPixelStride = 2;
+                layout.uOffset = lumaBytes;
+                layout.vOffset = lumaBytes + 1;
+                break;
+            case kColorFormatYuv420Planar:
+                // I420: planos U y V completos con la mitad del stride y del slice
+                layout.uvRowStride = (stride + 1) / 2;
+                layout.uvPixelStride = 1;
+                layout.uOffset = lumaBytes;
+                layout.vOffset = lumaBytes +
+                    static_cast<size_t>(layout.uvRowStride) * ((sliceHeight + 1) / 2);
+                break;
+            case kColorFormatYuv420Flexible:
+                // Sin image-data no se sabe si es I420 o NV12
+                LOGE("Salida YUV420Flexible sin image-data: layout desconocido");
+                return false;
+            default:
+                LOGE("Formato de color no soportado: 0x%x", colorFormat);
+                return false;
+        }
+    }
+
+    // Recorte inclusivo; sin él, el frame completo. El origen se redondea a
+    // par (clampCropRect) para que luma y croma empiecen en la misma muestra
+    const int32_t cropLeft = formatInt(format, "crop-left", 0);
+    const int32_t cropTop = formatInt(format, "crop-top", 0);
+    const int32_t cropRight = formatInt(format, "crop-right", width - 1);
+    const int32_t cropBottom = formatInt(format, "crop-bottom", height - 1);
+    const CropRect crop = clampCropRect(
+        CropRect{cropLeft, cropTop, cropRight - cropLeft + 1, cropBottom - cropTop + 1},
+        width, height);
+    layout.cropLeft = crop.x;
+    layout.cropTop = crop.y;
+    layout.width = crop.width;
+    layout.height = crop.height;
+
+    // Cada fila recortada cabe en su stride (el tamaño del buffer se
+    // verifica por frame en convertOutput)
+    const int chromaEnd = (layout.cropLeft / 2 + (layout.width + 1) / 2 - 1) *
+                              layout.uvPixelStride + 1;
+    if (layout.width <= 0 || layout.height <= 0 ||
+        layout.cropLeft + layout.width > layout.yRowStride ||
+        chromaEnd > layout.uvRowStride) {
+        LOGE("Formato de salida inválido: %dx%d, stride %d/%d",
+             width, height, layout.yRowStride, layout.uvRowStride);
+        return false;
+    }
+
+    LOGD("Salida %dx%d, stride %d, croma stride %d paso %d", layout.width, layout.height,
+         layout.yRowStride, layout.uvRowStride, layout.uvPixelStride);
+    layout_ = layout;
+    return true;
+}
+
+bool VideoDecoder::convertOutput(const uint8_t* data, size_t size, int64_t frameIndex,
+                                 int64_t presentationTimeUs) {
+    const OutputLayout& layout = layout_;
+    const int chromaWidth = (layout.width + 1) / 2;
+    const int chromaHeight = (layout.height + 1) / 2;
+    // Origen par (readOutputFormat): croma y luma empiezan en la misma muestra
+    const int chromaLeft = layout.cropLeft / 2;
+    const int chromaTop = layout.cropTop / 2;
+
+    // Primer byte de la región y uno más allá del último, por plano
+    const size_t yStart = layout.yOffset +
+        static_cast<size_t>(layout.cropTop) * layout.yRowStride + layout.cropLeft;
+    const size_t yEnd = yStart +
+        static_cast<size_t>(layout.height - 1) * layout.yRowStride + layout.width;
+    const size_t chromaStart = static_cast<size_t>(chromaTop) * layout.uvRowStride +
+        static_cast<size_t>(chromaLeft) * layout.uvPixelStride;
+    const size_t chromaSpan = static_cast<size_t>(chromaHeight - 1) * layout.uvRowStride +
+        static_cast<size_t>(chromaWidth - 1) * layout.uvPixelStride + 1;
+    const size_t uStart = layout.uOffset + chromaStart;
+    const size_t vStart = layout.vOffset + chromaStart;
+    const size_t needed = std::max({yEnd, uStart + chromaSpan, vStart + chromaSpan});
+    if (needed > size) {
+        LOGE("Buffer de salida de %zu bytes, se necesitan %zu", size, needed);
+        return false;
+    }
+
+    const int64_t outputNs = monotonicNs();
+    int index;
+    {
+        // Cola llena: esperar a que Dart devuelva el slot (retiene al códec)
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_.wait(lock, [this] {
+            return stop_ || slots_[writeIndex_].state == SlotState::Free;
+        });
+        if (stop_) return true;
+        index = writeIndex_;
+    }
+
+    // El slot Free solo lo toca este hilo hasta marcarlo Ready
+    Slot& slot = slots_[index];
+    slot.info.letterbox = preprocessYuv420ToTensorAs(
+        data + yStart, data + uStart, data + vStart,
+        layout.width, layout.height, layout.yRowStride, layout.uvRowStride,
+        layout.uvPixelStride,
+        rotation_, false, targetSize_, format_, slot.tensor);
+
+    const bool rotated = rotation_ == 90 || rotation_ == 270;
+    std::lock_guard<std::mutex> lock(mutex_);
+    slot.info.frameIndex = frameIndex;
+    slot.info.presentationTimeUs = presentationTimeUs;
+    slot.info.imageWidth = rotated ? layout.height : layout.width;
+    slot.info.imageHeight = rotated ? layout.width : layout.height;
+    slot.info.latencyNs = monotonicNs() - outputNs;
+    slot.state = SlotState::Ready;
+    writeIndex_ = (index + 1) % slotCount();
+    stats_.sampled++;
+    return true;
+}
+
+void VideoDecoder::finish(VideoState state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = state;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSUMIDOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int VideoDecoder::acquire(VideoFrameInfo* info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slot& slot = slots_[readIndex_];
+    if (slot.state != SlotState::Ready) return -1;
+
+    const int index = readIndex_;
+    slot.state = SlotState::Acquired;
+    if (info) *info = slot.info;
+    readIndex_ = (readIndex_ + 1) % slotCount();
+    return index;
+}
+
+bool VideoDecoder::release(int slot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot < 0 || slot >= slotCount() || slots_[slot].state != SlotState::Acquired) {
+            return false;
+        }
+        slots_[slot].state = SlotState::Free;
+    }
+    released_.notify_one();
+    return true;
+}
+
+void* VideoDecoder::tensor(int slot) const {
+    if (slot < 0 || slot >= slotCount()) return nullptr;
+    return slots_[slot].tensor;
+}
+
+VideoState VideoDecoder::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slots_[readIndex_].state == SlotState::Ready) return VideoState::Decoding;
+    return state_;
+}
+
+VideoDecoderStats VideoDecoder::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
@@ -0,0 +1,184 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             video_decoder.h                                   ║
+// ║          Análisis de video: AMediaExtractor + AMediaCodec → tensores YOLO     ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Un hilo propio decodifica el video a buffers YUV del códec y genera el       ║
+// ║  tensor de cada frame muestreado directamente desde ellos, sin copiar         ║
+// ║  planos ni pasar por Dart. La cola es acotada: si Dart no consume, el hilo    ║
+// ║  deja de decodificar.                                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef VIDEO_DECODER_H
+#define VIDEO_DECODER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "yuv_preprocess.h"
+
+struct AMediaCodec;
+struct AMediaExtractor;
+struct AMediaFormat;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Estado de la decodificación.
+ */
+enum class VideoState { Decoding, Ended, Failed };
+
+/**
+ * @brief Metadatos del tensor de un frame entregado.
+ */
+struct VideoFrameInfo {
+    int64_t frameIndex;           // Índice del frame en el video (antes de muestrear)
+    int64_t presentationTimeUs;   // Instante del frame en el video
+    LetterboxParams letterbox;
+    int imageWidth;               // Dimensiones tras aplicar la rotación del video
+    int imageHeight;
+    int64_t latencyNs;            // Desde que el códec entregó el frame hasta el tensor
+};
+
+/**
+ * @brief Contadores de la decodificación.
+ */
+struct VideoDecoderStats {
+    int64_t decoded;     // Frames entregados por el códec
+    int64_t sampled;     // Frames convertidos a tensor (1 de cada sampleEvery)
+    int64_t durationUs;  // Duración de la pista (0 si el contenedor no la declara)
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DECODIFICADOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Decodifica la primera pista de video de un archivo y entrega el
+ *        tensor letterbox de 1 de cada `sampleEvery` frames, en orden.
+ *
+ * El códec se configura con salida a ByteBuffer en YUV420Flexible; el NDK no
+ * expone getOutputImage, así que el layout de los planos sale del formato de
+ * salida: de "image-data" (MediaImage2, lo que usa Image en Java) si el
+ * códec lo publica, y si no del formato de color (I420 o NV12) con stride y
+ * slice-height. Flexible sin "image-data" no tiene layout conocido y el
+ * análisis falla. El recorte se alinea a origen par. El tensor se genera con
+ * preprocessYuv420ToTensorAs leyendo el buffer del códec, que se devuelve en
+ * cuanto termina: ningún plano se copia.
+ *
+ * Los `queueDepth` slots forman un anillo FIFO. Con todos ocupados el hilo
+ * espera antes de convertir el siguiente frame muestreado, lo que detiene
+ * también al códec (decodificación por delante acotada, sin descartes). Los
+ * frames no muestreados se decodifican igual (los códecs inter-frame los
+ * necesitan) pero se devuelven sin convertir.
+ */
+class VideoDecoder {
+public:
+    /// Slots máximos del anillo de tensores.
+    static constexpr int kMaxSlots = 4;
+    static constexpr int kDefaultSlots = 2;
+
+    /**
+     * @brief Abre el archivo, elige la pista de video y arranca el hilo.
+     *
+     * @param path        Ruta de un archivo local (MP4, 3GP, WebM, MKV...)
+     * @param sampleEvery Convertir 1 de cada N frames (>= 1)
+     * @param queueDepth  Slots del anillo (1..kMaxSlots; <= 0 usa kDefaultSlots)
+     * @return Decodificador en marcha, o nullptr si el archivo no tiene una
+     *         pista de video decodificable o falló la reserva
+     */
+    static std::unique_ptr<VideoDecoder> open(
+        const char* path, int sampleEvery, int queueDepth, int targetSize,
+        const TensorOutputFormat& format = TensorOutputFormat{});
+
+    ~VideoDecoder();
+
+    VideoDecoder(const VideoDecoder&) = delete;
+    VideoDecoder& operator=(const VideoDecoder&) = delete;
+
+    /**
+     * @brief Entrega el frame listo más antiguo, sin esperar.
+     * @return Slot entregado (devolver con release), o -1 si no hay ninguno
+     */
+    int acquire(VideoFrameInfo* info);
+
+    /** Devuelve un slot entregado por acquire. */
+    bool release(int slot);
+
+    /** Tensor de un slot, o nullptr si no es válido. Fijo durante la vida del objeto. */
+    void* tensor(int slot) const;
+
+    /**
+     * @brief Ended o Failed solo cuando ya no quedan frames por entregar ni
+     *        por decodificar.
+     */
+    VideoState state() const;
+
+    VideoDecoderStats stats() const;
+
+    int slotCount() const { return static_cast<int>(slots_.size()); }
+    size_t tensorBytes() const { return tensorBytes_; }
+
+private:
+    enum class SlotState { Free, Ready, Acquired };
+
+    struct Slot {
+        SlotState state = SlotState::Free;
+        void* tensor = nullptr;  // alignedAlloc
+        VideoFrameInfo info{};
+    };
+
+    /** Layout de los planos del buffer de salida del códec. */
+    struct OutputLayout {
+        int width = 0;           // Recorte (origen par)
+        int height = 0;
+        int cropLeft = 0;
+        int cropTop = 0;
+        size_t yOffset = 0;      // Inicio de cada plano en el buffer
+        size_t uOffset = 0;
+        size_t vOffset = 0;
+        int yRowStride = 0;
+        int uvRowStride = 0;
+        int uvPixelStride = 0;   // 1 planar, 2 intercalado (NV12/NV21)
+    };
+
+    VideoDecoder(AMediaExtractor* extractor, AMediaCodec* codec, int sampleEvery,
+                 int queueDepth, int targetSize, const TensorOutputFormat& format,
+                 int rotation, int64_t durationUs);
+
+    void decodeLoop();
+    bool feedInput();
+    bool readOutputFormat(AMediaFormat* format);
+    bool convertOutput(const uint8_t* data, size_t size, int64_t frameIndex,
+                       int64_t presentationTimeUs);
+    void finish(VideoState state);
+
+    AMediaExtractor* extractor_;
+    AMediaCodec* codec_;
+    const int sampleEvery_;
+    const int targetSize_;
+    const TensorOutputFormat format_;
+    const int rotation_;
+    size_t tensorBytes_ = 0;
+    bool valid_ = false;
+    bool inputDone_ = false;
+    OutputLayout layout_{};  // Solo lo usa el hilo
+
+    std::vector<Slot> slots_;
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    std::thread worker_;
+    bool stop_ = false;
+    VideoState state_ = VideoState::Decoding;
+    int writeIndex_ = 0;  // Próximo slot que llena el hilo
+    int readIndex_ = 0;   // Próximo slot que entrega acquire
+    VideoDecoderStats stats_{};
+};
+
+#endif // VIDEO_DECODER_H
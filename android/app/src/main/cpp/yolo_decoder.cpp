@@ -0,0 +1,299 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             yolo_decoder.cpp                                  ║
+// ║          Decodificador nativo de la salida YOLO11n + NMS por clase            ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Reemplaza el recorrido Dart de List<List<List<double>>> y el NMS O(n²).      ║
+// ║  El tensor es [canal][predicción]: el argmax recorre clases por bloques de    ║
+// ║  predicciones contiguas para leer cada fila de forma secuencial.              ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "yolo_decoder.h"
+
+#include <algorithm>
+
+#include "native_memory.h"
+#include "native_stats.h"
+
+// Para instrucciones NEON en ARM
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Predicciones por bloque del argmax (4 vectores NEON de 4 floats)
+constexpr int kArgmaxBlock = 16;
+
+// Canales de caja antes de los scores de clase (cx, cy, w, h)
+constexpr int kBoxChannels = 4;
+
+/**
+ * Candidato tras filtrar por confianza, ya en espacio de la imagen.
+ */
+struct Candidate {
+    float x1;
+    float y1;
+    float x2;
+    float y2;
+    float score;
+    int classId;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ARGMAX DE CLASES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Argmax escalar sobre [begin, begin + count).
+ *
+ * Mismo criterio que el postprocesado Dart: score inicial 0 y comparación
+ * estricta, de modo que en empate gana la clase de menor índice.
+ */
+void argmaxScalar(
+    const float* classScores,
+    int stride,
+    int numClasses,
+    int begin,
+    int count,
+    float* bestScore,
+    int* bestClass
+) {
+    for (int i = 0; i < count; i++) {
+        bestScore[i] = 0.0f;
+        bestClass[i] = 0;
+    }
+
+    for (int c = 0; c < numClasses; c++) {
+        const float* row = classScores + c * stride + begin;
+        for (int i = 0; i < count; i++) {
+            if (row[i] > bestScore[i]) {
+                bestScore[i] = row[i];
+                bestClass[i] = c;
+            }
+        }
+    }
+}
+
+#if USE_NEON
+/**
+ * Argmax NEON de un bloque completo de kArgmaxBlock predicciones.
+ */
+void argmaxNeon16(
+    const float* classScores,
+    int stride,
+    int numClasses,
+    int begin,
+    float* bestScore,
+    int* bestClass
+) {
+    float32x4_t best0 = vdupq_n_f32(0.0f);
+    float32x4_t best1 = best0;
+    float32x4_t best2 = best0;
+    float32x4_t best3 = best0;
+    uint32x4_t cls0 = vdupq_n_u32(0);
+    uint32x4_t cls1 = cls0;
+    uint32x4_t cls2 = cls0;
+    uint32x4_t cls3 = cls0;
+
+    for (int c = 0; c < numClasses; c++) {
+        const float* row = classScores + c * stride + begin;
+        const uint32x4_t classId = vdupq_n_u32(static_cast<uint32_t>(c));
+
+        const float32x4_t s0 = vld1q_f32(row);
+        const float32x4_t s1 = vld1q_f32(row + 4);
+        const float32x4_t s2 = vld1q_f32(row + 8);
+        const float32x4_t s3 = vld1q_f32(row + 12);
+
+        const uint32x4_t m0 = vcgtq_f32(s0, best0);
+        const uint32x4_t m1 = vcgtq_f32(s1, best1);
+        const uint32x4_t m2 = vcgtq_f32(s2, best2);
+        const uint32x4_t m3 = vcgtq_f32(s3, best3);
+
+        best0 = vbslq_f32(m0, s0, best0);
+        best1 = vbslq_f32(m1, s1, best1);
+        best2 = vbslq_f32(m2, s2, best2);
+        best3 = vbslq_f32(m3, s3, best3);
+
+        cls0 = vbslq_u32(m0, classId, cls0);
+        cls1 = vbslq_u32(m1, classId, cls1);
+        cls2 = vbslq_u32(m2, classId, cls2);
+        cls3 = vbslq_u32(m3, classId, cls3);
+    }
+
+    vst1q_f32(bestScore, best0);
+    vst1q_f32(bestScore + 4, best1);
+    vst1q_f32(bestScore + 8, best2);
+    vst1q_f32(bestScore + 12, best3);
+
+    auto* classOut = reinterpret_cast<uint32_t*>(bestClass);
+    vst1q_u32(classOut, cls0);
+    vst1q_u32(classOut + 4, cls1);
+    vst1q_u32(classOut + 8, cls2);
+    vst1q_u32(classOut + 12, cls3);
+}
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// NMS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+inline float area(const Candidate& c) {
+    return (c.x2 - c.x1) * (c.y2 - c.y1);
+}
+
+/**
+ * IoU igual a `Detection.calculateIoU`.
+ */
+inline float iou(const Candidate& a, float areaA, const Candidate& b, float areaB) {
+    const float w = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+    const float h = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+    if (w <= 0.0f || h <= 0.0f) return 0.0f;
+
+    const float intersection = w * h;
+    const float unionArea = areaA + areaB - intersection;
+    return unionArea > 0.0f ? intersection / unionArea : 0.0f;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DECODIFICACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int decodeYoloOutput(
+    const float* output,
+    const YoloDecodeParams& params,
+    float* detectionsOut,
+    int maxDetections
+) {
+    const int n = params.numPredictions;
+    if (!output || !detectionsOut || maxDetections <= 0 || n <= 0 ||
+        params.numClasses <= 0 || params.scale <= 0.0) {
+        return 0;
+    }
+
+    const float* cxRow = output;
+    const float* cyRow = output + n;
+    const float* wRow = output + 2 * n;
+    const float* hRow = output + 3 * n;
+    const float* classScores = output + kBoxChannels * n;
+
+    const float inputSize = static_cast<float>(params.inputSize);
+    const float invScale = static_cast<float>(1.0 / params.scale);
+    const float padLeft = static_cast<float>(params.padLeft);
+    const float padTop = static_cast<float>(params.padTop);
+    const float maxX = static_cast<float>(params.imageWidth);
+    const float maxY = static_cast<float>(params.imageHeight);
+
+    // Buffers por hilo: conservan su capacidad entre frames (sin reservas)
+    thread_local TrackedVector<Candidate, MemoryArena::Scratch> candidates;
+    thread_local TrackedVector<uint8_t, MemoryArena::Scratch> suppressed;
+    thread_local TrackedVector<float, MemoryArena::Scratch> areas;
+    candidates.clear();
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // 1. Argmax por bloques + filtro de confianza + caja en espacio imagen
+    // ─────────────────────────────────────────────────────────────────────────
+    {
+        ScopedStageTimer decodeTimer(
+            NativeStage::Decode,
+            static_cast<int64_t>(kBoxChannels + params.numClasses) * n * sizeof(float));
+
+        float bestScore[kArgmaxBlock];
+        int bestClass[kArgmaxBlock];
+
+        for (int begin = 0; begin < n; begin += kArgmaxBlock) {
+            const int count = std::min(kArgmaxBlock, n - begin);
+
+#if USE_NEON
+            if (count == kArgmaxBlock) {
+                argmaxNeon16(classScores, n, params.numClasses, begin, bestScore, bestClass);
+            } else {
+                argmaxScalar(classScores, n, params.numClasses, begin, count,
+                             bestScore, bestClass);
+            }
+#else
+            argmaxScalar(classScores, n, params.numClasses, begin, count,
+                         bestScore, bestClass);
+#endif
+
+            for (int k = 0; k < count; k++) {
+                if (bestScore[k] < params.confidenceThreshold) continue;
+
+                const int i = begin + k;
+                const float cx = cxRow[i] * inputSize;
+                const float cy = cyRow[i] * inputSize;
+                const float halfW = wRow[i] * inputSize * 0.5f;
+                const float halfH = hRow[i] * inputSize * 0.5f;
+
+                // Deshacer letterbox y recortar a la imagen original
+                Candidate box;
+                box.x1 = std::min(std::max((cx - halfW - padLeft) * invScale, 0.0f), maxX);
+                box.y1 = std::min(std::max((cy - halfH - padTop) * invScale, 0.0f), maxY);
+                box.x2 = std::min(std::max((cx + halfW - padLeft) * invScale, 0.0f), maxX);
+                box.y2 = std::min(std::max((cy + halfH - padTop) * invScale, 0.0f), maxY);
+                if (box.x2 <= box.x1 || box.y2 <= box.y1) continue;
+
+                box.score = bestScore[k];
+                box.classId = bestClass[k];
+                candidates.push_back(box);
+            }
+        }
+    }
+
+    // Top-K + NMS (se registra también cuando no hay candidatos)
+    ScopedStageTimer nmsTimer(NativeStage::Nms,
+                              static_cast<int64_t>(candidates.size()) * sizeof(Candidate));
+    if (candidates.empty()) return 0;
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // 2. Top-K parcial ordenado por score
+    // ─────────────────────────────────────────────────────────────────────────
+    const auto byScore = [](const Candidate& a, const Candidate& b) {
+        return a.score > b.score;
+    };
+    const int total = static_cast<int>(candidates.size());
+    const int k = std::min(total, kMaxNmsCandidates);
+    std::partial_sort(candidates.begin(), candidates.begin() + k,
+                      candidates.end(), byScore);
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // 3. NMS voraz por clase
+    // ─────────────────────────────────────────────────────────────────────────
+    suppressed.assign(k, 0);
+    areas.resize(k);
+    for (int i = 0; i < k; i++) {
+        areas[i] = area(candidates[i]);
+    }
+
+    int written = 0;
+    for (int i = 0; i < k && written < maxDetections; i++) {
+        if (suppressed[i]) continue;
+
+        const Candidate& kept = candidates[i];
+        float* dst = detectionsOut + written * kDetectionStride;
+        dst[0] = kept.x1;
+        dst[1] = kept.y1;
+        dst[2] = kept.x2;
+        dst[3] = kept.y2;
+        dst[4] = kept.score;
+        dst[5] = static_cast<float>(kept.classId);
+        written++;
+
+        for (int j = i + 1; j < k; j++) {
+            if (suppressed[j] || candidates[j].classId != kept.classId) continue;
+            if (iou(kept, areas[i], candidates[j], areas[j]) >= params.iouThreshold) {
+                suppressed[j] = 1;
+            }
+        }
+    }
+
+    return written;
+}
@@ -0,0 +1,73 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              yolo_decoder.h                                   ║
+// ║          Decodificador nativo de la salida YOLO11n + NMS por clase            ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  [1, 4 + C, N] float32 → detecciones empaquetadas en espacio de la imagen.    ║
+// ║  Argmax vectorizado, top-K parcial y NMS ordenado por clase.                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef YOLO_DECODER_H
+#define YOLO_DECODER_H
+
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Floats por detección empaquetada: x1, y1, x2, y2, score, classId.
+constexpr int kDetectionStride = 6;
+
+/// Candidatos máximos que entran al NMS (los de mayor score).
+constexpr int kMaxNmsCandidates = 1024;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PARÁMETROS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Parámetros de decodificación.
+ *
+ * scale/padLeft/padTop son los del letterbox aplicado en el preprocesado
+ * (mismos campos que `_PreprocessResult` en yolo_service.dart).
+ */
+struct YoloDecodeParams {
+    int numClasses;
+    int numPredictions;
+    int inputSize;
+    float confidenceThreshold;
+    float iouThreshold;
+    double scale;
+    int padLeft;
+    int padTop;
+    int imageWidth;
+    int imageHeight;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DECODIFICACIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Decodifica la salida cruda de YOLO y aplica NMS.
+ *
+ * Para cada predicción toma la clase de mayor score, descarta las que no
+ * superan el umbral, desnormaliza la caja, deshace el letterbox y la recorta
+ * a la imagen. Los candidatos se ordenan por score (top-K parcial de
+ * kMaxNmsCandidates) y se suprimen solapamientos de la misma clase con
+ * IoU >= iouThreshold.
+ *
+ * @param output        Tensor de salida [4 + numClasses][numPredictions]
+ * @param params        Umbrales, letterbox y dimensiones de la imagen
+ * @param detectionsOut Salida empaquetada (maxDetections * kDetectionStride floats)
+ * @param maxDetections Capacidad de detectionsOut en detecciones
+ * @return Número de detecciones escritas, ordenadas por score descendente
+ */
+int decodeYoloOutput(
+    const float* output,
+    const YoloDecodeParams& params,
+    float* detectionsOut,
+    int maxDetections
+);
+
+#endif // YOLO_DECODER_H
@@ -0,0 +1,747 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           yuv_preprocess.cpp                                  ║
+// ║          Preprocesamiento fusionado YUV420 → tensor letterbox float32         ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Reemplaza la cadena Dart copyResize + bucle 640×640×3 de _preprocess.        ║
+// ║  Una sola pasada: muestreo bilineal + BT.601 + normalización + padding.       ║
+// ║  Las filas del tensor se reparten en bandas sobre el pool de hilos.           ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "yuv_preprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "gles_preprocess.h"
+#include "native_stats.h"
+#include "thread_pool.h"
+#include "yuv_preprocess_internal.h"
+#include "yuv_to_rgb.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Pesos de interpolación en punto fijo Q8
+constexpr int kInterpBits = 8;
+constexpr int kInterpOne = 1 << kInterpBits;
+
+// Filas del tensor por banda del reparto multihilo
+constexpr int kBandRowAlignment = 16;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TABLAS DE MUESTREO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Construye las muestras de un eje del tensor.
+ *
+ * La coordenada fuente sigue la convención de img.copyResize
+ * (s = d * srcLen / count), y se invierte después si el eje queda espejado
+ * por la rotación o por la cámara frontal.
+ */
+void buildAxisTaps(
+    AxisTapVector& taps,
+    int count,
+    int srcLen,
+    bool reversed,
+    int lumaStride,
+    int chromaStride
+) {
+    taps.resize(count);
+    const double step = static_cast<double>(srcLen) / count;
+    const int last = srcLen - 1;
+
+    for (int d = 0; d < count; d++) {
+        double s = d * step;
+        if (reversed) s = last - s;
+        s = std::min(std::max(s, 0.0), static_cast<double>(last));
+
+        const int i0 = static_cast<int>(s);
+        const int i1 = std::min(i0 + 1, last);
+        const int w1 = static_cast<int>((s - i0) * kInterpOne + 0.5);
+
+        taps[d] = {
+            i0 * lumaStride,
+            i1 * lumaStride,
+            (i0 >> 1) * chromaStride,
+            (i1 >> 1) * chromaStride,
+            w1,
+        };
+    }
+}
+
+/**
+ * Interpolación bilineal Q8×Q8 con redondeo.
+ */
+inline int bilinear(int p00, int p01, int p10, int p11, int wx, int wy) {
+    const int top = p00 * (kInterpOne - wx) + p01 * wx;
+    const int bottom = p10 * (kInterpOne - wx) + p11 * wx;
+    return (top * (kInterpOne - wy) + bottom * wy + (1 << (2 * kInterpBits - 1)))
+           >> (2 * kInterpBits);
+}
+
+template <typename T>
+inline void fillPad(T* dst, int pixelCount, T pad) {
+    std::fill(dst, dst + pixelCount * 3, pad);
+}
+
+/**
+ * float32 → IEEE 754 binary16 con redondeo al par más cercano (mismo
+ * resultado que la conversión por hardware de vcvt_f16_f32).
+ */
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent >= 31) {
+        // Desborde (o NaN/Inf): infinito con el mismo signo
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (exponent <= 0) {
+        // Subnormal en half, o cero si queda fuera de rango
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        const int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;  // puede subir el exponente
+    return static_cast<uint16_t>(sign | half);
+}
+
+/**
+ * Valor normalizado en [0, 1] → elemento cuantizado, saturado al rango del tipo.
+ */
+inline int quantize(float value, const TensorOutputFormat& format, int minValue, int maxValue) {
+    const long q = std::lround(static_cast<double>(value) / format.scale) + format.zeroPoint;
+    return static_cast<int>(std::min<long>(std::max<long>(q, minValue), maxValue));
+}
+
+/**
+ * Tabla byte → elemento del tensor y valor de padding para un formato.
+ */
+template <typename T>
+struct OutputTable {
+    T values[256];
+    T pad;
+};
+
+void buildOutputTable(OutputTable<uint16_t>& table) {
+    const float* lut = normalizationLut();
+    for (int i = 0; i < 256; i++) table.values[i] = floatToHalf(lut[i]);
+    table.pad = floatToHalf(kPadValue);
+}
+
+template <typename T>
+void buildOutputTable(OutputTable<T>& table, const TensorOutputFormat& format,
+                      int minValue, int maxValue) {
+    const float* lut = normalizationLut();
+    for (int i = 0; i < 256; i++) {
+        table.values[i] = static_cast<T>(quantize(lut[i], format, minValue, maxValue));
+    }
+    table.pad = static_cast<T>(quantize(kPadValue, format, minValue, maxValue));
+}
+
+/**
+ * Muestrea una fila de salida: bilineal sobre Y y sobre U/V con los mismos
+ * pesos (croma a la escala correspondiente), y BT.601 Q8.
+ *
+ * store(tx, rgb) recibe cada píxel convertido.
+ */
+template <typename Store>
+inline void sampleRow(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    const AxisTap& row,
+    const AxisTap* cols,
+    int count,
+    Store&& store
+) {
+    const uint8_t* y0 = yPlane + row.luma0;
+    const uint8_t* y1 = yPlane + row.luma1;
+    const uint8_t* u0 = uPlane + row.chroma0;
+    const uint8_t* u1 = uPlane + row.chroma1;
+    const uint8_t* v0 = vPlane + row.chroma0;
+    const uint8_t* v1 = vPlane + row.chroma1;
+    const int wy = row.weight1;
+
+    for (int tx = 0; tx < count; tx++) {
+        const AxisTap& col = cols[tx];
+        const int wx = col.weight1;
+
+        const int yv = bilinear(y0[col.luma0], y0[col.luma1],
+                                y1[col.luma0], y1[col.luma1], wx, wy);
+        const int uv = bilinear(u0[col.chroma0], u0[col.chroma1],
+                                u1[col.chroma0], u1[col.chroma1], wx, wy);
+        const int vv = bilinear(v0[col.chroma0], v0[col.chroma1],
+                                v1[col.chroma0], v1[col.chroma1], wx, wy);
+
+        uint8_t rgb[3];
+        yuvToRgbPixelQ8(yv, uv, vv, rgb);
+        store(tx, rgb);
+    }
+}
+
+/**
+ * Muestrea una fila de salida de una imagen RGB888/RGBA8888: bilineal por
+ * canal (los offsets de las tablas ya están en bytes).
+ */
+template <typename Store>
+inline void sampleRgbRow(
+    const uint8_t* pixels,
+    const AxisTap& row,
+    const AxisTap* cols,
+    int count,
+    Store&& store
+) {
+    const uint8_t* r0 = pixels + row.luma0;
+    const uint8_t* r1 = pixels + row.luma1;
+    const int wy = row.weight1;
+
+    for (int tx = 0; tx < count; tx++) {
+        const AxisTap& col = cols[tx];
+        const uint8_t* p00 = r0 + col.luma0;
+        const uint8_t* p01 = r0 + col.luma1;
+        const uint8_t* p10 = r1 + col.luma0;
+        const uint8_t* p11 = r1 + col.luma1;
+
+        uint8_t rgb[3];
+        for (int c = 0; c < 3; c++) {
+            rgb[c] = static_cast<uint8_t>(
+                bilinear(p00[c], p01[c], p10[c], p11[c], col.weight1, wy));
+        }
+        store(tx, rgb);
+    }
+}
+
+/**
+ * Sentido de recorrido de cada eje de salida sobre la imagen fuente.
+ *
+ * Las columnas de salida recorren X de la fuente en 0/180 e Y en 90/270; la
+ * inversión combina el sentido de la rotación con el espejo.
+ */
+void orientationReversal(int orientation, bool mirror, bool& colReversed, bool& rowReversed) {
+    switch (orientation) {
+        case 90:
+            colReversed = !mirror;
+            rowReversed = false;
+            break;
+        case 180:
+            colReversed = !mirror;
+            rowReversed = true;
+            break;
+        case 270:
+            colReversed = mirror;
+            rowReversed = true;
+            break;
+        default:
+            colReversed = mirror;
+            rowReversed = false;
+            break;
+    }
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TABLAS DE MUESTREO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Tabla de normalización uint8 → [0, 1].
+ */
+const float* normalizationLut() {
+    static const auto* lut = [] {
+        static float table[256];
+        for (int i = 0; i < 256; i++) {
+            table[i] = static_cast<float>(i) / 255.0f;
+        }
+        return table;
+    }();
+    return lut;
+}
+
+/**
+ * Construye las tablas de muestreo del frame rotado/espejado a
+ * dstWidth × dstHeight píxeles.
+ */
+void buildSamplingTaps(
+    AxisTapVector& colTaps,
+    AxisTapVector& rowTaps,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int dstWidth,
+    int dstHeight
+) {
+    bool colReversed;
+    bool rowReversed;
+    orientationReversal(sensorOrientation, mirror, colReversed, rowReversed);
+
+    if (sensorOrientation == 90 || sensorOrientation == 270) {
+        buildAxisTaps(colTaps, dstWidth, height, colReversed,
+                      yRowStride, uvRowStride);
+        buildAxisTaps(rowTaps, dstHeight, width, rowReversed,
+                      1, uvPixelStride);
+    } else {
+        buildAxisTaps(colTaps, dstWidth, width, colReversed,
+                      1, uvPixelStride);
+        buildAxisTaps(rowTaps, dstHeight, height, rowReversed,
+                      yRowStride, uvRowStride);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// LETTERBOX
+// ═══════════════════════════════════════════════════════════════════════════════
+
+LetterboxParams computeLetterbox(int srcWidth, int srcHeight, int targetSize) {
+    LetterboxParams params{};
+    if (srcWidth <= 0 || srcHeight <= 0 || targetSize <= 0) {
+        return params;
+    }
+
+    const double scaleWidth = static_cast<double>(targetSize) / srcWidth;
+    const double scaleHeight = static_cast<double>(targetSize) / srcHeight;
+    params.scale = std::min(scaleWidth, scaleHeight);
+
+    // Dart round(): mitad lejos de cero, igual que std::lround
+    params.newWidth = static_cast<int>(std::lround(srcWidth * params.scale));
+    params.newHeight = static_cast<int>(std::lround(srcHeight * params.scale));
+    params.padLeft = (targetSize - params.newWidth) / 2;
+    params.padTop = (targetSize - params.newHeight) / 2;
+    return params;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PREPROCESAMIENTO FUSIONADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/**
+ * Rellena count píxeles consecutivos a partir de pixel: un tramo intercalado
+ * en NHWC, o un tramo en cada plano en NCHW.
+ */
+template <bool Planar, typename T>
+inline void fillPadPixels(T* tensor, int planeElements, int pixel, int count, T pad) {
+    if (Planar) {
+        for (int c = 0; c < 3; c++) {
+            T* plane = tensor + c * planeElements + pixel;
+            std::fill(plane, plane + count, pad);
+        }
+    } else {
+        fillPad(tensor + pixel * 3, count, pad);
+    }
+}
+
+/**
+ * Escribe el tensor completo de tipo T: padding, zona útil muestreada y
+ * normalizada/cuantizada con values, padding inferior. Planar elige NCHW.
+ *
+ * sampler(ty, store) muestrea la fila ty de la zona útil y entrega cada
+ * píxel RGB con store(tx, rgb); se llama desde las bandas del pool.
+ */
+template <bool Planar, typename T, typename Sampler>
+void writeTensor(
+    const Sampler& sampler,
+    const LetterboxParams& params,
+    int targetSize,
+    const T* values,
+    T pad,
+    T* tensorOut
+) {
+    const int planeElements = targetSize * targetSize;
+    const int padRight = targetSize - params.padLeft - params.newWidth;
+
+    // Filas de padding superior
+    fillPadPixels<Planar>(tensorOut, planeElements, 0, params.padTop * targetSize, pad);
+
+    // Filas del tensor repartidas en bandas que escriben filas disjuntas
+    ThreadPool::shared().parallelFor(params.newHeight, kBandRowAlignment, [&](int tyBegin, int tyEnd) {
+        for (int ty = tyBegin; ty < tyEnd; ty++) {
+            const int rowPixel = (params.padTop + ty) * targetSize;
+            const int first = rowPixel + params.padLeft;
+
+            fillPadPixels<Planar>(tensorOut, planeElements, rowPixel, params.padLeft, pad);
+
+            if (Planar) {
+                T* r = tensorOut + first;
+                T* g = r + planeElements;
+                T* b = g + planeElements;
+                sampler(ty, [r, g, b, values](int tx, const uint8_t* rgb) {
+                    r[tx] = values[rgb[0]];
+                    g[tx] = values[rgb[1]];
+                    b[tx] = values[rgb[2]];
+                });
+            } else {
+                T* dst = tensorOut + first * 3;
+                sampler(ty, [dst, values](int tx, const uint8_t* rgb) {
+                    T* pixel = dst + tx * 3;
+                    pixel[0] = values[rgb[0]];
+                    pixel[1] = values[rgb[1]];
+                    pixel[2] = values[rgb[2]];
+                });
+            }
+
+            fillPadPixels<Planar>(tensorOut, planeElements, first + params.newWidth,
+                                  padRight, pad);
+        }
+    });
+
+    // Filas de padding inferior
+    const int bottomRows = targetSize - params.padTop - params.newHeight;
+    fillPadPixels<Planar>(tensorOut, planeElements,
+                          (params.padTop + params.newHeight) * targetSize,
+                          bottomRows * targetSize, pad);
+}
+
+/**
+ * writeTensor con la disposición elegida en tiempo de ejecución.
+ */
+template <typename T, typename Sampler>
+void writeTensorAs(
+    TensorLayout layout,
+    const Sampler& sampler,
+    const LetterboxParams& params,
+    int targetSize,
+    const T* values,
+    T pad,
+    void* tensorOut
+) {
+    T* tensor = static_cast<T*>(tensorOut);
+    if (layout == TensorLayout::Nchw) {
+        writeTensor<true>(sampler, params, targetSize, values, pad, tensor);
+    } else {
+        writeTensor<false>(sampler, params, targetSize, values, pad, tensor);
+    }
+}
+
+/**
+ * Escribe el tensor en el tipo de format: construye la tabla byte → elemento
+ * (float32 comparte la LUT global, el resto se construye por llamada con 256
+ * entradas) y, si el letterbox no tiene zona útil, solo rellena.
+ */
+template <typename Sampler>
+void writeFormattedTensor(
+    const TensorOutputFormat& format,
+    const Sampler& sampler,
+    const LetterboxParams& params,
+    int targetSize,
+    void* tensorOut
+) {
+    OutputTable<uint16_t> halfTable;
+    OutputTable<uint8_t> uint8Table;
+    OutputTable<int8_t> int8Table;
+    switch (format.dataType) {
+        case TensorDataType::Float16:
+            buildOutputTable(halfTable);
+            break;
+        case TensorDataType::Uint8:
+            buildOutputTable(uint8Table, format, 0, 255);
+            break;
+        case TensorDataType::Int8:
+            buildOutputTable(int8Table, format, -128, 127);
+            break;
+        case TensorDataType::Float32:
+            break;
+    }
+
+    if (params.newWidth <= 0 || params.newHeight <= 0) {
+        const int pixels = targetSize * targetSize;
+        switch (format.dataType) {
+            case TensorDataType::Float32:
+                fillPad(static_cast<float*>(tensorOut), pixels, kPadValue);
+                break;
+            case TensorDataType::Float16:
+                fillPad(static_cast<uint16_t*>(tensorOut), pixels, halfTable.pad);
+                break;
+            case TensorDataType::Uint8:
+                fillPad(static_cast<uint8_t*>(tensorOut), pixels, uint8Table.pad);
+                break;
+            case TensorDataType::Int8:
+                fillPad(static_cast<int8_t*>(tensorOut), pixels, int8Table.pad);
+                break;
+        }
+        return;
+    }
+
+    switch (format.dataType) {
+        case TensorDataType::Float32:
+            writeTensorAs(format.layout, sampler, params, targetSize,
+                          normalizationLut(), kPadValue, tensorOut);
+            break;
+        case TensorDataType::Float16:
+            writeTensorAs(format.layout, sampler, params, targetSize,
+                          halfTable.values, halfTable.pad, tensorOut);
+            break;
+        case TensorDataType::Uint8:
+            writeTensorAs(format.layout, sampler, params, targetSize,
+                          uint8Table.values, uint8Table.pad, tensorOut);
+            break;
+        case TensorDataType::Int8:
+            writeTensorAs(format.layout, sampler, params, targetSize,
+                          int8Table.values, int8Table.pad, tensorOut);
+            break;
+    }
+}
+
+} // namespace
+
+size_t tensorElementBytes(TensorDataType dataType) {
+    switch (dataType) {
+        case TensorDataType::Float32:
+            return sizeof(float);
+        case TensorDataType::Float16:
+            return sizeof(uint16_t);
+        case TensorDataType::Uint8:
+        case TensorDataType::Int8:
+            return 1;
+    }
+    return 0;
+}
+
+bool validTensorFormat(const TensorOutputFormat& format) {
+    if (tensorElementBytes(format.dataType) == 0) return false;
+    if (format.layout != TensorLayout::Nhwc && format.layout != TensorLayout::Nchw) {
+        return false;
+    }
+    if (format.dataType == TensorDataType::Uint8 || format.dataType == TensorDataType::Int8) {
+        return format.scale > 0.0f && std::isfinite(format.scale);
+    }
+    return true;
+}
+
+LetterboxParams preprocessYuv420ToTensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    float* tensorOut
+) {
+    return preprocessYuv420ToTensorAs(
+        yPlane, uPlane, vPlane, width, height,
+        yRowStride, uvRowStride, uvPixelStride,
+        sensorOrientation, mirror, targetSize, TensorOutputFormat{}, tensorOut);
+}
+
+LetterboxParams preprocessYuv420ToTensorAs(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    const TensorOutputFormat& format,
+    void* tensorOut
+) {
+    traceFrame(width, height);
+
+    // Bytes tocados: planos YUV420 leídos + tensor escrito
+    const size_t elementBytes = tensorElementBytes(format.dataType);
+    ScopedStageTimer timer(NativeStage::Normalize,
+                           static_cast<int64_t>(width) * height * 3 / 2 +
+                           static_cast<int64_t>(targetSize) * targetSize * 3 * elementBytes);
+
+    // Dimensiones de la imagen tras rotar (las que ve el modelo)
+    const bool transposed = sensorOrientation == 90 || sensorOrientation == 270;
+    const int rotatedWidth = transposed ? height : width;
+    const int rotatedHeight = transposed ? width : height;
+
+    const LetterboxParams params =
+        computeLetterbox(rotatedWidth, rotatedHeight, targetSize);
+
+    const bool useful = params.newWidth > 0 && params.newHeight > 0;
+
+    // Backend GPU (solo float32): si no hay contexto o falla el frame, sigue
+    // el camino CPU
+    if (useful && format.dataType == TensorDataType::Float32 &&
+        preprocessBackend() == PreprocessBackend::Gpu &&
+        glesPreprocessYuv420ToTensor(yPlane, uPlane, vPlane, width, height,
+                                     yRowStride, uvRowStride, uvPixelStride,
+                                     sensorOrientation, mirror, targetSize,
+                                     params, format.layout,
+                                     static_cast<float*>(tensorOut))) {
+        notePreprocessBackendUsed(PreprocessBackend::Gpu);
+        return params;
+    }
+
+    // Tablas por hilo: conservan su capacidad entre frames (sin reservas)
+    thread_local AxisTapVector colTaps;
+    thread_local AxisTapVector rowTaps;
+    if (useful) {
+        notePreprocessBackendUsed(PreprocessBackend::Cpu);
+        buildSamplingTaps(colTaps, rowTaps, width, height,
+                          yRowStride, uvRowStride, uvPixelStride,
+                          sensorOrientation, mirror, params.newWidth, params.newHeight);
+    }
+
+    // Las tablas son thread_local del llamador: se pasan por puntero para que
+    // los trabajadores del pool lean las mismas
+    const AxisTap* cols = colTaps.data();
+    const AxisTap* rows = rowTaps.data();
+    const int count = params.newWidth;
+    const auto sampler = [=](int ty, auto&& store) {
+        sampleRow(yPlane, uPlane, vPlane, rows[ty], cols, count, store);
+    };
+
+    writeFormattedTensor(format, sampler, params, targetSize, tensorOut);
+    return params;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// IMÁGENES RGB
+// ═══════════════════════════════════════════════════════════════════════════════
+
+size_t rgbPixelBytes(RgbPixelFormat pixelFormat) {
+    switch (pixelFormat) {
+        case RgbPixelFormat::Rgba8888:
+            return 4;
+        case RgbPixelFormat::Rgb888:
+            return 3;
+    }
+    return 0;
+}
+
+LetterboxParams preprocessRgbToTensorAs(
+    const uint8_t* pixels,
+    int width,
+    int height,
+    int rowStride,
+    RgbPixelFormat pixelFormat,
+    int orientation,
+    bool mirror,
+    int targetSize,
+    const TensorOutputFormat& format,
+    void* tensorOut,
+    int sourceWidth,
+    int sourceHeight
+) {
+    traceFrame(width, height);
+
+    // Bytes tocados: imagen leída (cota) + tensor escrito
+    const int pixelBytes = static_cast<int>(rgbPixelBytes(pixelFormat));
+    ScopedStageTimer timer(NativeStage::Normalize,
+                           static_cast<int64_t>(rowStride) * height +
+                           static_cast<int64_t>(targetSize) * targetSize * 3 *
+                           tensorElementBytes(format.dataType));
+
+    const bool transposed = orientation == 90 || orientation == 270;
+    const bool hasSource = sourceWidth > 0 && sourceHeight > 0;
+    const LetterboxParams params = computeLetterbox(
+        hasSource ? sourceWidth : (transposed ? height : width),
+        hasSource ? sourceHeight : (transposed ? width : height), targetSize);
+
+    thread_local AxisTapVector colTaps;
+    thread_local AxisTapVector rowTaps;
+    if (params.newWidth > 0 && params.newHeight > 0) {
+        notePreprocessBackendUsed(PreprocessBackend::Cpu);
+
+        bool colReversed;
+        bool rowReversed;
+        orientationReversal(orientation, mirror, colReversed, rowReversed);
+
+        // Las tablas guardan offsets en bytes; la croma no se usa
+        if (transposed) {
+            buildAxisTaps(colTaps, params.newWidth, height, colReversed, rowStride, 0);
+            buildAxisTaps(rowTaps, params.newHeight, width, rowReversed, pixelBytes, 0);
+        } else {
+            buildAxisTaps(colTaps, params.newWidth, width, colReversed, pixelBytes, 0);
+            buildAxisTaps(rowTaps, params.newHeight, height, rowReversed, rowStride, 0);
+        }
+    }
+
+    const AxisTap* cols = colTaps.data();
+    const AxisTap* rows = rowTaps.data();
+    const int count = params.newWidth;
+    const auto sampler = [=](int ty, auto&& store) {
+        sampleRgbRow(pixels, rows[ty], cols, count, store);
+    };
+
+    writeFormattedTensor(format, sampler, params, targetSize, tensorOut);
+    return params;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN CON REDUCCIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void convertYuv420ToRgbScaled(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int dstWidth,
+    int dstHeight,
+    uint8_t* rgbOutput
+) {
+    if (dstWidth <= 0 || dstHeight <= 0) return;
+
+    traceFrame(width, height);
+
+    // Bytes tocados: planos YUV420 leídos (cota) + RGB888 de destino escrito
+    ScopedStageTimer timer(NativeStage::Resize,
+                           static_cast<int64_t>(width) * height * 3 / 2 +
+                           static_cast<int64_t>(dstWidth) * dstHeight * 3);
+
+    thread_local AxisTapVector colTaps;
+    thread_local AxisTapVector rowTaps;
+    buildSamplingTaps(colTaps, rowTaps, width, height,
+                      yRowStride, uvRowStride, uvPixelStride,
+                      sensorOrientation, mirror, dstWidth, dstHeight);
+
+    // Mismo reparto que el tensor: tablas capturadas por puntero
+    const AxisTap* cols = colTaps.data();
+    const AxisTap* rows = rowTaps.data();
+    const long rowBytes = static_cast<long>(dstWidth) * 3;
+
+    ThreadPool::shared().parallelFor(dstHeight, kBandRowAlignment, [&](int dyBegin, int dyEnd) {
+        for (int dy = dyBegin; dy < dyEnd; dy++) {
+            uint8_t* dst = rgbOutput + dy * rowBytes;
+            sampleRow(yPlane, uPlane, vPlane, rows[dy], cols, dstWidth,
+                      [dst](int dx, const uint8_t* rgb) {
+                          uint8_t* pixel = dst + dx * 3;
+                          pixel[0] = rgb[0];
+                          pixel[1] = rgb[1];
+                          pixel[2] = rgb[2];
+                      });
+        }
+    });
+}
@@ -0,0 +1,254 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            yuv_preprocess.h                                   ║
+// ║          Preprocesamiento fusionado YUV420 → tensor letterbox del modelo      ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Convierte, rota, redimensiona, rellena y normaliza en una sola pasada.       ║
+// ║  Escribe directamente en el tensor de entrada del modelo (NHWC o NCHW).       ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef YUV_PREPROCESS_H
+#define YUV_PREPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PARÁMETROS DE LETTERBOX
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Parámetros del letterbox aplicado a la imagen.
+ *
+ * Mismos campos que `_PreprocessResult` en yolo_service.dart, para que el
+ * postprocesamiento pueda devolver las cajas al espacio de la imagen original.
+ */
+struct LetterboxParams {
+    double scale;
+    int padLeft;
+    int padTop;
+    int newWidth;
+    int newHeight;
+};
+
+/**
+ * @brief Calcula el letterbox igual que `YoloDetector._preprocess`.
+ *
+ * scale = min(target / ancho, target / alto), dimensiones redondeadas y
+ * padding centrado (división entera).
+ *
+ * @param srcWidth   Ancho de la imagen (ya rotada)
+ * @param srcHeight  Alto de la imagen (ya rotada)
+ * @param targetSize Lado del tensor cuadrado (640 para YOLO11n)
+ */
+LetterboxParams computeLetterbox(int srcWidth, int srcHeight, int targetSize);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FORMATO DEL TENSOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Tipo de elemento del tensor de entrada.
+ *
+ * Valores estables: se usan tal cual desde JNI y dart:ffi.
+ */
+enum class TensorDataType : int32_t {
+    Float32 = 0,  // [0, 1]
+    Float16 = 1,  // [0, 1] en IEEE 754 binary16
+    Uint8 = 2,    // round(v / scale) + zeroPoint, saturado a [0, 255]
+    Int8 = 3,     // round(v / scale) + zeroPoint, saturado a [-128, 127]
+};
+
+/**
+ * @brief Disposición de los canales en el tensor de entrada.
+ *
+ * Valores estables: se usan tal cual desde JNI y dart:ffi.
+ */
+enum class TensorLayout : int32_t {
+    Nhwc = 0,  // [1, H, W, 3]: RGB intercalado por píxel (TFLite)
+    Nchw = 1,  // [1, 3, H, W]: un plano de H × W por canal (exportes ONNX/NNAPI)
+};
+
+/**
+ * @brief Tipo, cuantización y disposición del tensor de entrada del modelo.
+ *
+ * scale y zeroPoint son los del tensor de entrada del .tflite y solo se usan
+ * con Uint8/Int8: el valor normalizado v = pixel / 255 se cuantiza como
+ * round(v / scale) + zeroPoint.
+ */
+struct TensorOutputFormat {
+    TensorDataType dataType = TensorDataType::Float32;
+    float scale = 1.0f;
+    int32_t zeroPoint = 0;
+    TensorLayout layout = TensorLayout::Nhwc;
+};
+
+/**
+ * @brief Bytes por elemento del tipo, o 0 si no es válido.
+ */
+size_t tensorElementBytes(TensorDataType dataType);
+
+/**
+ * @brief true si el tipo y la disposición existen y, si es cuantizado,
+ *        scale > 0.
+ */
+bool validTensorFormat(const TensorOutputFormat& format);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// PREPROCESAMIENTO FUSIONADO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Convierte un frame YUV420 directamente al tensor de entrada YOLO.
+ *
+ * Para cada píxel del tensor calcula su posición en el frame original
+ * (deshaciendo espejo y rotación), interpola bilinealmente Y/U/V, convierte a
+ * RGB (BT.601) y normaliza a [0, 1]. El área fuera de la imagen se rellena con
+ * gris 114/255. No existe ningún frame RGB intermedio.
+ *
+ * @param yPlane            Puntero al plano Y
+ * @param uPlane            Puntero al plano U
+ * @param vPlane            Puntero al plano V
+ * @param width             Ancho del frame del sensor
+ * @param height            Alto del frame del sensor
+ * @param yRowStride        Stride del plano Y en bytes
+ * @param uvRowStride       Stride de los planos UV en bytes
+ * @param uvPixelStride     Stride entre píxeles UV (1 planar, 2 semi-planar)
+ * @param sensorOrientation Rotación horaria a aplicar (0, 90, 180, 270)
+ * @param mirror            Espejo horizontal tras rotar (cámara frontal)
+ * @param targetSize        Lado del tensor cuadrado
+ * @param tensorOut         Buffer de salida (targetSize * targetSize * 3 floats)
+ * @return Parámetros de letterbox usados
+ */
+LetterboxParams preprocessYuv420ToTensor(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    float* tensorOut
+);
+
+/**
+ * @brief Igual que preprocessYuv420ToTensor, escribiendo el tensor en el tipo
+ *        y la disposición del modelo.
+ *
+ * La normalización y la cuantización se aplican con una tabla de 256
+ * entradas por llamada, así que un tensor uint8/int8 cuesta lo mismo que uno
+ * float32 y escribe 4× menos bytes. En NCHW cada fila de salida se escribe
+ * como tres tramos contiguos, uno por plano. El backend GPU solo genera
+ * Float32 (en ambas disposiciones); los demás tipos usan el kernel CPU.
+ *
+ * @param format    Tipo y cuantización (validTensorFormat)
+ * @param tensorOut Buffer de salida (targetSize² * 3 elementos del tipo)
+ */
+LetterboxParams preprocessYuv420ToTensorAs(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int targetSize,
+    const TensorOutputFormat& format,
+    void* tensorOut
+);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// IMÁGENES RGB
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Formato de los píxeles de una imagen ya decodificada.
+ *
+ * Valores estables: se usan tal cual desde dart:ffi.
+ */
+enum class RgbPixelFormat : int32_t {
+    Rgba8888 = 0,  // AImageDecoder, img.Image.getBytes(order: rgba)
+    Rgb888 = 1,
+};
+
+/**
+ * @brief Bytes por píxel del formato, o 0 si no es válido.
+ */
+size_t rgbPixelBytes(RgbPixelFormat pixelFormat);
+
+/**
+ * @brief Letterbox de una imagen RGB(A) ya decodificada al tensor del modelo.
+ *
+ * Mismo tensor que el preprocesado YUV (padding 114, tipo y disposición de
+ * format) con muestreo bilineal por canal en la convención de
+ * img.copyResize. Las filas se reparten en el pool de hilos; siempre en CPU.
+ *
+ * sourceWidth/sourceHeight permiten muestrear una versión reducida de la
+ * imagen (decodificación submuestreada) con el letterbox de la original: las
+ * cajas del postprocesado quedan entonces en coordenadas de la original.
+ *
+ * @param rowStride    Bytes entre filas (>= width * rgbPixelBytes)
+ * @param orientation  Rotación horaria a aplicar (0, 90, 180, 270)
+ * @param mirror       Espejo horizontal tras rotar
+ * @param tensorOut    Buffer de salida (targetSize² * 3 elementos del tipo)
+ * @param sourceWidth  Ancho (ya rotado) con el que se calcula el letterbox;
+ *                     0 = el de la imagen
+ * @param sourceHeight Alto (ya rotado) con el que se calcula el letterbox
+ * @return Parámetros de letterbox de la imagen ya rotada
+ */
+LetterboxParams preprocessRgbToTensorAs(
+    const uint8_t* pixels,
+    int width,
+    int height,
+    int rowStride,
+    RgbPixelFormat pixelFormat,
+    int orientation,
+    bool mirror,
+    int targetSize,
+    const TensorOutputFormat& format,
+    void* tensorOut,
+    int sourceWidth = 0,
+    int sourceHeight = 0
+);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN CON REDUCCIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Convierte un frame YUV420 a RGB888 muestreando directamente a la
+ *        resolución de destino.
+ *
+ * Mismo muestreo que el tensor (bilineal sobre Y, U/V a la escala de croma
+ * correspondiente, BT.601 Q8), sin letterbox ni normalización: el costo es
+ * proporcional a dstWidth × dstHeight y no al tamaño del sensor. Con
+ * dstWidth/dstHeight iguales a las de computeLetterbox el resultado coincide
+ * con la zona útil del tensor.
+ *
+ * @param dstWidth  Ancho de salida (de la imagen ya rotada)
+ * @param dstHeight Alto de salida (de la imagen ya rotada)
+ * @param rgbOutput Buffer de salida (dstWidth * dstHeight * 3 bytes)
+ */
+void convertYuv420ToRgbScaled(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int dstWidth,
+    int dstHeight,
+    uint8_t* rgbOutput
+);
+
+#endif // YUV_PREPROCESS_H
@@ -0,0 +1,68 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                        yuv_preprocess_internal.h                              ║
+// ║          Tablas de muestreo compartidas por los caminos CPU y GPU             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Solo para yuv_preprocess.cpp y gles_preprocess.cpp: el shader consume las    ║
+// ║  mismas tablas que el kernel CPU para producir el mismo tensor.               ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef YUV_PREPROCESS_INTERNAL_H
+#define YUV_PREPROCESS_INTERNAL_H
+
+#include "native_memory.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Valor de padding de YOLO (gris 114) ya normalizado.
+constexpr float kPadValue = 114.0f / 255.0f;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// TABLAS DE MUESTREO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Muestra precalculada de un eje del tensor.
+ *
+ * Los offsets ya incluyen el stride del plano correspondiente, de modo que el
+ * bucle interno solo suma offset de fila + offset de columna sin importar si
+ * el eje del tensor corresponde a X o Y del sensor (rotación 90/270).
+ *
+ * Cinco int32 sin relleno: se sube tal cual a un SSBO std430.
+ */
+struct AxisTap {
+    int luma0;
+    int luma1;
+    int chroma0;
+    int chroma1;
+    int weight1;  // peso de la muestra 1 en Q8 (0..256)
+};
+
+/** Tabla de un eje, contabilizada en la arena Scratch. */
+using AxisTapVector = TrackedVector<AxisTap, MemoryArena::Scratch>;
+
+/**
+ * Construye las tablas de muestreo del frame rotado/espejado a
+ * dstWidth × dstHeight píxeles.
+ */
+void buildSamplingTaps(
+    AxisTapVector& colTaps,
+    AxisTapVector& rowTaps,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror,
+    int dstWidth,
+    int dstHeight
+);
+
+/**
+ * Tabla de normalización uint8 → [0, 1].
+ */
+const float* normalizationLut();
+
+#endif // YUV_PREPROCESS_INTERNAL_H
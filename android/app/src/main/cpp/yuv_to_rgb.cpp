@@ -0,0 +1,449 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                              yuv_to_rgb.cpp                                   ║
+// ║          Kernels de conversión YUV420 → RGB888 con rotación y espejo          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Cada píxel se escribe directamente en su posición rotada/espejada.           ║
+// ║  Con rotación 90/270 se recorre por bloques para que las escrituras sigan     ║
+// ║  siendo contiguas (bloques 8×8 transpuestos en registros con NEON).           ║
+// ║  NEON despacha por frame según uvPixelStride: planar / semi-planar (vld2).    ║
+// ║  Escalar, NEON y SSE4.1/AVX2 comparten la aritmética Q8: salida idéntica.     ║
+// ║  Los kernels SIMD viven en yuv_to_rgb_{neon,sse41,avx2}.cpp.                  ║
+// ║  El kernel se elige en tiempo de ejecución según cpuFeatures().               ║
+// ║  El frame se reparte en bandas de filas pares sobre el pool de hilos.         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#include "yuv_to_rgb.h"
+
+#include <algorithm>
+
+#include "cpu_features.h"
+#include "native_stats.h"
+#include "thread_pool.h"
+#include "yuv_to_rgb_internal.h"
+
+// Kernel NEON (yuv_to_rgb_neon.cpp): esta unidad no se compila con NEON en
+// armeabi-v7a, el kernel solo se llama si la CPU lo soporta
+#if defined(__aarch64__) || defined(__arm__)
+#define USE_NEON 1
+#else
+#define USE_NEON 0
+#endif
+
+// Kernels SSE4.1 / AVX2 (yuv_to_rgb_sse41.cpp, yuv_to_rgb_avx2.cpp)
+#if defined(__x86_64__)
+#define USE_X86_SIMD 1
+#else
+#define USE_X86_SIMD 0
+#endif
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONSTANTES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+// Lado del bloque del recorrido escalar transpuesto: 32 filas fuente siguen en
+// L1 mientras se escribe cada fila destino de 32 píxeles.
+constexpr int kScalarTileSize = 32;
+
+// Filas por banda del reparto multihilo: par (cada banda empieza en su propia
+// fila UV) y múltiplo de 8 (bandas completas del camino NEON transpuesto).
+constexpr int kBandRowAlignment = 16;
+
+/**
+ * Contribuciones de una muestra UV a R, G y B.
+ *
+ * Cada muestra sirve a un bloque 2×2 de píxeles: se calcula una vez por fila
+ * UV y se aplica a las dos filas Y que cubre.
+ */
+struct ChromaTermsScalar {
+    int r;  // 1.402 * V'
+    int g;  // 0.344136 * U' + 0.714136 * V'
+    int b;  // 1.772 * U'
+};
+
+/**
+ * Términos BT.601 en punto fijo Q8, con el mismo redondeo que los kernels
+ * SIMD y que yuvToRgbPixelQ8 (desplazamiento aritmético de cada producto).
+ */
+inline ChromaTermsScalar chromaTermsQ8(int u, int v) {
+    const int du = u - 128;
+    const int dv = v - 128;
+    return {
+        (359 * dv) >> 8,
+        ((88 * du) >> 8) + ((183 * dv) >> 8),
+        (454 * du) >> 8,
+    };
+}
+
+inline void applyChroma(int y, const ChromaTermsScalar& terms, uint8_t* rgb) {
+    rgb[0] = clamp255(y + terms.r);
+    rgb[1] = clamp255(y - terms.g);
+    rgb[2] = clamp255(y + terms.b);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ORIENTACIÓN DE SALIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+OutputMapping computeOutputMapping(int width, int height,
+                                   int sensorOrientation, bool mirror) {
+    const long w = width;
+    const long h = height;
+
+    switch (sensorOrientation) {
+        case 90:
+            // dst(x, y) = src(y, h-1-x)
+            return mirror ? OutputMapping{height, width, 0, h, 1}
+                          : OutputMapping{height, width, h - 1, h, -1};
+        case 180:
+            return mirror ? OutputMapping{width, height, (h - 1) * w, 1, -w}
+                          : OutputMapping{width, height, (h - 1) * w + w - 1, -1, -w};
+        case 270:
+            // dst(x, y) = src(w-1-y, x)
+            return mirror ? OutputMapping{height, width, (w - 1) * h + h - 1, -h, -1}
+                          : OutputMapping{height, width, (w - 1) * h, -h, 1};
+        default:
+            return mirror ? OutputMapping{width, height, w - 1, -1, w}
+                          : OutputMapping{width, height, 0, 1, w};
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGIÓN DE INTERÉS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+CropRect clampCropRect(const CropRect& crop, int width, int height) {
+    // Extremos en int64: x + width puede desbordar con valores de Dart/JNI
+    const int64_t right = std::min<int64_t>(static_cast<int64_t>(crop.x) + crop.width, width);
+    const int64_t bottom = std::min<int64_t>(static_cast<int64_t>(crop.y) + crop.height, height);
+    const int left = std::max(crop.x, 0) & ~1;
+    const int top = std::max(crop.y, 0) & ~1;
+
+    if (crop.width <= 0 || crop.height <= 0 || right <= left || bottom <= top) {
+        return CropRect{0, 0, 0, 0};
+    }
+    return CropRect{left, top, static_cast<int>(right - left), static_cast<int>(bottom - top)};
+}
+
+bool cropYuv420(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const CropRect& crop,
+    Yuv420Region& region
+) {
+    region.rect = clampCropRect(crop, width, height);
+    if (region.rect.width <= 0 || region.rect.height <= 0) return false;
+
+    // Origen par: la fila/columna de croma es exactamente la mitad
+    const long lumaOffset = static_cast<long>(region.rect.y) * yRowStride + region.rect.x;
+    const long chromaOffset = static_cast<long>(region.rect.y / 2) * uvRowStride +
+                              static_cast<long>(region.rect.x / 2) * uvPixelStride;
+    region.y = yPlane + lumaOffset;
+    region.u = uPlane + chromaOffset;
+    region.v = vPlane + chromaOffset;
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN ESCALAR (Fallback)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/**
+ * Kernel escalar sobre una banda de filas.
+ *
+ * Los planos apuntan a la primera fila de la banda (par) y map.origin ya
+ * incluye su desplazamiento en la salida.
+ */
+void convertScalarBand(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    if (map.colStep == 1 || map.colStep == -1) {
+        // 0/180: cada fila fuente es una fila destino (derecha o invertida).
+        // Se procesan pares de filas que comparten la misma fila UV.
+        for (int row = 0; row < height; row += 2) {
+            const bool pair = row + 1 < height;  // altura impar: última fila sola
+            const uint8_t* yRow0 = yPlane + row * yRowStride;
+            const uint8_t* yRow1 = yRow0 + yRowStride;
+            const uint8_t* uRow = uPlane + (row / 2) * uvRowStride;
+            const uint8_t* vRow = vPlane + (row / 2) * uvRowStride;
+            const long dstRow0 = map.origin + row * map.rowStep;
+            const long dstRow1 = dstRow0 + map.rowStep;
+
+            for (int col = 0; col < width; col += 2) {
+                const int uvIndex = (col / 2) * uvPixelStride;
+                const ChromaTermsScalar terms =
+                    chromaTermsQ8(uRow[uvIndex], vRow[uvIndex]);
+                const int last = std::min(col + 2, width);
+
+                for (int c = col; c < last; c++) {
+                    applyChroma(yRow0[c], terms, rgbOutput + (dstRow0 + c * map.colStep) * 3);
+                    if (pair) {
+                        applyChroma(yRow1[c], terms, rgbOutput + (dstRow1 + c * map.colStep) * 3);
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // 90/270: cada columna fuente es una fila destino. Se recorre por bloques
+    // y, dentro del bloque, por pares de columnas (dos filas destino) y pares
+    // de filas, de modo que cada muestra UV se calcula una vez para sus 2×2
+    // píxeles y las escrituras siguen siendo contiguas.
+    for (int tileRow = 0; tileRow < height; tileRow += kScalarTileSize) {
+        const int rowEnd = std::min(tileRow + kScalarTileSize, height);
+
+        for (int tileCol = 0; tileCol < width; tileCol += kScalarTileSize) {
+            const int colEnd = std::min(tileCol + kScalarTileSize, width);
+
+            for (int col = tileCol; col < colEnd; col += 2) {
+                const bool colPair = col + 1 < colEnd;
+                const int uvColOffset = (col / 2) * uvPixelStride;
+                long dstA = map.origin + col * map.colStep + tileRow * map.rowStep;
+                long dstB = dstA + map.colStep;
+
+                for (int row = tileRow; row < rowEnd; row += 2) {
+                    const bool rowPair = row + 1 < rowEnd;
+                    const int uvIndex = (row / 2) * uvRowStride + uvColOffset;
+                    const ChromaTermsScalar terms =
+                        chromaTermsQ8(uPlane[uvIndex], vPlane[uvIndex]);
+                    const uint8_t* y0 = yPlane + row * yRowStride + col;
+                    const uint8_t* y1 = y0 + yRowStride;
+
+                    applyChroma(y0[0], terms, rgbOutput + dstA * 3);
+                    if (rowPair) {
+                        applyChroma(y1[0], terms, rgbOutput + (dstA + map.rowStep) * 3);
+                    }
+                    if (colPair) {
+                        applyChroma(y0[1], terms, rgbOutput + dstB * 3);
+                        if (rowPair) {
+                            applyChroma(y1[1], terms, rgbOutput + (dstB + map.rowStep) * 3);
+                        }
+                    }
+
+                    dstA += 2 * map.rowStep;
+                    dstB += 2 * map.rowStep;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void convertRegionQ8(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    const OutputMapping& map,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int colBegin,
+    int colEnd,
+    int rowBegin,
+    int rowEnd
+) {
+    for (int row = rowBegin; row < rowEnd; row++) {
+        const uint8_t* yRow = yPlane + row * yRowStride;
+        const int uvRowOffset = (row / 2) * uvRowStride;
+
+        for (int col = colBegin; col < colEnd; col++) {
+            const int uvIndex = uvRowOffset + (col / 2) * uvPixelStride;
+            uint8_t* dst = rgbOutput +
+                (map.origin + col * map.colStep + row * map.rowStep) * 3;
+            yuvToRgbPixelQ8(yRow[col], uPlane[uvIndex], vPlane[uvIndex], dst);
+        }
+    }
+}
+
+void convertYuv420ToRgbScalar(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror
+) {
+    const OutputMapping map =
+        computeOutputMapping(width, height, sensorOrientation, mirror);
+    convertScalarBand(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                      yRowStride, uvRowStride, uvPixelStride, map);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN NEON OPTIMIZADA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+#if USE_NEON
+void convertYuv420ToRgbNeon(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror
+) {
+    const OutputMapping map =
+        computeOutputMapping(width, height, sensorOrientation, mirror);
+    convertNeonBand(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                    yRowStride, uvRowStride, uvPixelStride, map);
+}
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// CONVERSIÓN x86_64 (SSE4.1 / AVX2)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+#if USE_X86_SIMD
+void convertYuv420ToRgbSse41(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror
+) {
+    const OutputMapping map =
+        computeOutputMapping(width, height, sensorOrientation, mirror);
+    convertSse41Band(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                     yRowStride, uvRowStride, uvPixelStride, map);
+}
+
+void convertYuv420ToRgbAvx2(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror
+) {
+    const OutputMapping map =
+        computeOutputMapping(width, height, sensorOrientation, mirror);
+    convertAvx2Band(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                    yRowStride, uvRowStride, uvPixelStride, map);
+}
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FUNCIÓN PRINCIPAL DE CONVERSIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/**
+ * Kernel por bandas instalado para esta CPU.
+ */
+struct ConvertKernel {
+    const char* name;
+    ConvertBandFn fn;
+};
+
+/**
+ * Elige el mejor kernel compilado que la CPU soporta: NEON (también en
+ * armeabi-v7a, donde se comprueba HWCAP_NEON), AVX2 o SSE4.1 en x86_64 y
+ * escalar en otro caso. Todos producen la misma salida bit a bit.
+ *
+ * dotprod/i8mm/SVE2 no tienen kernel propio: la conversión son
+ * multiplicaciones int16 por constantes sin reducciones, y SVE2 con los
+ * vectores de 128 bits de los núcleos Android actuales no mejora a NEON.
+ */
+ConvertKernel selectKernel(uint32_t features) {
+#if USE_NEON
+    if (features & kCpuNeon) return {"neon", convertNeonBand};
+#endif
+#if USE_X86_SIMD
+    if (features & kCpuAvx2) return {"avx2", convertAvx2Band};
+    if (features & kCpuSse41) return {"sse4.1", convertSse41Band};
+#endif
+    return {"scalar", convertScalarBand};
+}
+
+const ConvertKernel& activeKernel() {
+    static const ConvertKernel kernel = selectKernel(cpuFeatures());
+    return kernel;
+}
+
+} // namespace
+
+const char* yuvKernelName() {
+    return activeKernel().name;
+}
+
+void convertYuv420ToRgb(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation,
+    bool mirror
+) {
+    traceFrame(width, height);
+
+    // Bytes tocados: planos YUV420 leídos + RGB888 escrito
+    ScopedStageTimer timer(NativeStage::Convert,
+                           static_cast<int64_t>(width) * height * 9 / 2);
+
+    const OutputMapping map =
+        computeOutputMapping(width, height, sensorOrientation, mirror);
+    const ConvertBandFn kernel = activeKernel().fn;
+
+    // Bandas horizontales de filas pares: cada banda empieza en una fila UV
+    // propia y escribe una región disjunta de la salida
+    ThreadPool::shared().parallelFor(height, kBandRowAlignment, [&](int rowBegin, int rowEnd) {
+        OutputMapping band = map;
+        band.origin += rowBegin * map.rowStep;
+
+        const uint8_t* yBand = yPlane + static_cast<long>(rowBegin) * yRowStride;
+        const long uvOffset = static_cast<long>(rowBegin / 2) * uvRowStride;
+        kernel(yBand, uPlane + uvOffset, vPlane + uvOffset, rgbOutput,
+               width, rowEnd - rowBegin, yRowStride, uvRowStride,
+               uvPixelStride, band);
+    });
+}
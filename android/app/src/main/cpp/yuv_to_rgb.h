@@ -3,7 +3,7 @@
 // ║              Header para conversión YUV420 a RGB optimizada                   ║
 // ╠═══════════════════════════════════════════════════════════════════════════════╣
 // ║  Declaraciones de funciones de conversión de color optimizadas con NEON.     ║
-// ║  Incluye versiones scalar (fallback) y SIMD (ARM NEON).                       ║
+// ║  Incluye versiones scalar (fallback) y SIMD (ARM NEON, x86_64 SSE4.1/AVX2).   ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
 #ifndef YUV_TO_RGB_H
@@ -11,21 +11,117 @@
 
 #include <cstdint>
 
+// ═══════════════════════════════════════════════════════════════════════════════
+// ORIENTACIÓN DE SALIDA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Ubicación en el buffer de salida de cada píxel del sensor.
+ *
+ * El píxel fuente (x, y) se escribe en el píxel destino
+ * `origin + x * colStep + y * rowStep` (en píxeles, no bytes). Equivale a
+ * img.copyRotate(angle: sensorOrientation) seguido de img.flipHorizontal.
+ */
+struct OutputMapping {
+    int dstWidth;
+    int dstHeight;
+    long origin;
+    long colStep;
+    long rowStep;
+};
+
+/**
+ * @brief Calcula la ubicación de salida para una rotación y espejo.
+ *
+ * @param width             Ancho del frame del sensor
+ * @param height            Alto del frame del sensor
+ * @param sensorOrientation Rotación horaria a aplicar (0, 90, 180, 270)
+ * @param mirror            Espejo horizontal tras rotar (cámara frontal)
+ */
+OutputMapping computeOutputMapping(int width, int height,
+                                   int sensorOrientation, bool mirror);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGIÓN DE INTERÉS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Rectángulo en coordenadas del sensor (antes de rotar y espejar).
+ */
+struct CropRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+/**
+ * @brief Planos de una región de un frame YUV420.
+ *
+ * Los punteros apuntan al primer píxel de rect y conservan los strides del
+ * frame, así que cualquier kernel que reciba (y, u, v, rect.width,
+ * rect.height) solo lee las filas y columnas de la región.
+ */
+struct Yuv420Region {
+    const uint8_t* y;
+    const uint8_t* u;
+    const uint8_t* v;
+    CropRect rect;
+};
+
+/**
+ * @brief Ajusta crop al frame: lo intersecta con width × height y alinea el
+ *        origen a coordenadas pares (la croma es 2×2), ampliando el ancho y
+ *        el alto para seguir cubriendo la región pedida.
+ *
+ * @return Región efectiva; width/height 0 si la intersección es vacía
+ */
+CropRect clampCropRect(const CropRect& crop, int width, int height);
+
+/**
+ * @brief Desplaza los planos al origen de la región (clampCropRect).
+ *
+ * Rotar o espejar la región da la misma zona que en el frame completo
+ * rotado, de modo que la salida de un kernel sobre la región es un recorte
+ * exacto de la salida sobre el frame.
+ *
+ * @return false si la región efectiva es vacía
+ */
+bool cropYuv420(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const CropRect& crop,
+    Yuv420Region& region
+);
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // FUNCIONES DE CONVERSIÓN
 // ═══════════════════════════════════════════════════════════════════════════════
 
 /**
- * @brief Convierte una imagen YUV420 (NV21) a RGB24.
+ * @brief Convierte una imagen YUV420 a RGB24 ya rotada y espejada.
+ *
+ * Cada píxel se escribe directamente en su posición final, sin pasadas
+ * adicionales de rotación o espejo. Con rotación 90/270 la salida mide
+ * height × width. Usa el kernel SIMD elegido en tiempo de ejecución.
  *
  * @param yPlane     Puntero al plano Y (luminancia)
- * @param uvPlane    Puntero al plano UV entrelazado (NV21: V primero, U segundo)
+ * @param uPlane     Puntero al plano U (crominancia)
+ * @param vPlane     Puntero al plano V (crominancia)
  * @param rgbOutput  Puntero al buffer de salida RGB (debe tener width * height * 3 bytes)
- * @param width      Ancho de la imagen
- * @param height     Alto de la imagen
+ * @param width      Ancho de la imagen del sensor
+ * @param height     Alto de la imagen del sensor
  * @param yRowStride Stride del plano Y en bytes
  * @param uvRowStride Stride del plano UV en bytes
  * @param uvPixelStride Stride entre píxeles UV (típicamente 2 para NV21)
+ * @param sensorOrientation Rotación horaria a aplicar (0, 90, 180, 270)
+ * @param mirror     Espejo horizontal tras rotar (cámara frontal)
  */
 void convertYuv420ToRgb(
     const uint8_t* yPlane,
@@ -36,12 +132,24 @@ void convertYuv420ToRgb(
     int height,
     int yRowStride,
     int uvRowStride,
-    int uvPixelStride
+    int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false
 );
 
+/**
+ * @brief Nombre del kernel que usa convertYuv420ToRgb en esta CPU
+ *        ("neon", "avx2", "sse4.1" o "scalar").
+ *
+ * La elección se hace una vez (JNI_OnLoad la fuerza) a partir de
+ * cpuFeatures(); las versiones siguientes siguen disponibles para pruebas.
+ */
+const char* yuvKernelName();
+
 /**
  * @brief Versión escalar (fallback) de conversión YUV a RGB.
- *        Usa fórmulas ITU-R BT.601.
+ *        Fórmulas ITU-R BT.601 en punto fijo Q8, con el mismo redondeo que
+ *        los kernels SIMD (salida idéntica bit a bit).
  */
 void convertYuv420ToRgbScalar(
     const uint8_t* yPlane,
@@ -52,13 +160,18 @@ void convertYuv420ToRgbScalar(
     int height,
     int yRowStride,
     int uvRowStride,
-    int uvPixelStride
+    int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false
 );
 
-#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#if defined(__aarch64__) || defined(__arm__)
 /**
  * @brief Versión NEON optimizada de conversión YUV a RGB.
- *        Procesa 8 píxeles en paralelo usando instrucciones SIMD.
+ *        Procesa 16 píxeles por iteración con caminos especializados por
+ *        uvPixelStride (planar con vld1, semi-planar con vld2), elegidos una
+ *        vez por frame; con rotación 90/270 escribe bloques transpuestos.
+ *        En armeabi-v7a solo llamar si cpuFeatures() incluye kCpuNeon.
  */
 void convertYuv420ToRgbNeon(
     const uint8_t* yPlane,
@@ -69,7 +182,46 @@ void convertYuv420ToRgbNeon(
     int height,
     int yRowStride,
     int uvRowStride,
-    int uvPixelStride
+    int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false
+);
+#endif
+
+#if defined(__x86_64__)
+/**
+ * @brief Versión SSE4.1 (x86_64): 16 píxeles por iteración.
+ */
+void convertYuv420ToRgbSse41(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false
+);
+
+/**
+ * @brief Versión AVX2 (x86_64): 32 píxeles por iteración. Requiere que la
+ *        CPU soporte AVX2.
+ */
+void convertYuv420ToRgbAvx2(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false
 );
 #endif
 
@@ -84,4 +236,16 @@ inline uint8_t clamp255(int value) {
     return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
 }
 
+/**
+ * @brief Conversión BT.601 de un píxel en punto fijo Q8.
+ *        Mismas constantes que el kernel NEON (359/88/183/454).
+ */
+inline void yuvToRgbPixelQ8(int y, int u, int v, uint8_t* rgb) {
+    const int du = u - 128;
+    const int dv = v - 128;
+    rgb[0] = clamp255(y + ((359 * dv) >> 8));
+    rgb[1] = clamp255(y - ((88 * du) >> 8) - ((183 * dv) >> 8));
+    rgb[2] = clamp255(y + ((454 * du) >> 8));
+}
+
 #endif // YUV_TO_RGB_H
@@ -0,0 +1,124 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            yuv_to_rgb_avx2.cpp                                ║
+// ║              Kernel YUV420 → RGB888 con AVX2 (x86_64)                         ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  32 píxeles por iteración. Se compila con -mavx2 y solo se llama cuando la    ║
+// ║  CPU lo soporta (emuladores recientes, ChromeOS).                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#if defined(__x86_64__)
+
+#include <immintrin.h>
+
+#include "yuv_to_rgb_x86.h"
+
+namespace {
+
+/**
+ * Duplica cada término int16 para sus 2 píxeles: [0] píxeles 0-15,
+ * [1] píxeles 16-31 (unpack opera por carril de 128 bits; permute2x128
+ * restablece el orden).
+ */
+inline void duplicateTerms(__m256i terms, __m256i* out) {
+    const __m256i lo = _mm256_unpacklo_epi16(terms, terms);
+    const __m256i hi = _mm256_unpackhi_epi16(terms, terms);
+    out[0] = _mm256_permute2x128_si256(lo, hi, 0x20);
+    out[1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+}
+
+/**
+ * Suma luma + término y empaqueta 32 píxeles a uint8 en orden.
+ */
+inline void packPixels(__m256i lo, __m256i hi, __m128i* out) {
+    // packus intercala carriles: permute4x64 devuelve el orden de píxeles
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+    out[0] = _mm256_castsi256_si128(packed);
+    out[1] = _mm256_extracti128_si256(packed, 1);
+}
+
+/**
+ * Bloque AVX2: 16 muestras de croma → 32 píxeles (misma aritmética Q8 que
+ * Sse41Block).
+ */
+struct Avx2Block {
+    static constexpr int kPixels = 32;
+
+    /// Términos int16 duplicados por píxel: [0] píxeles 0-15, [1] 16-31.
+    struct Terms {
+        __m256i r[2];
+        __m256i g[2];
+        __m256i b[2];
+    };
+
+    template <ChromaLayout Layout>
+    static __m256i loadChroma(const uint8_t* row, int sample, int pixelStride) {
+        if constexpr (Layout == ChromaLayout::Planar) {
+            return _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + sample)));
+        } else if constexpr (Layout == ChromaLayout::SemiPlanar) {
+            return _mm256_and_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + sample * 2)),
+                _mm256_set1_epi16(0x00FF));
+        } else {
+            alignas(32) int16_t lanes[16];
+            for (int i = 0; i < 16; i++) {
+                lanes[i] = row[(sample + i) * pixelStride];
+            }
+            return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+        }
+    }
+
+    template <ChromaLayout Layout>
+    static Terms loadTerms(const uint8_t* uRow, const uint8_t* vRow, int col,
+                           int pixelStride) {
+        const __m256i bias = _mm256_set1_epi16(128);
+        const __m256i u = _mm256_sub_epi16(loadChroma<Layout>(uRow, col / 2, pixelStride), bias);
+        const __m256i v = _mm256_sub_epi16(loadChroma<Layout>(vRow, col / 2, pixelStride), bias);
+
+        const __m256i r = _mm256_add_epi16(
+            v, _mm256_srai_epi16(_mm256_mullo_epi16(v, _mm256_set1_epi16(103)), 8));
+        const __m256i g = _mm256_add_epi16(
+            _mm256_srai_epi16(_mm256_mullo_epi16(u, _mm256_set1_epi16(88)), 8),
+            _mm256_srai_epi16(_mm256_mullo_epi16(v, _mm256_set1_epi16(183)), 8));
+        const __m256i b = _mm256_add_epi16(
+            u, _mm256_srai_epi16(_mm256_mullo_epi16(u, _mm256_set1_epi16(198)), 8));
+
+        Terms terms;
+        duplicateTerms(r, terms.r);
+        duplicateTerms(g, terms.g);
+        duplicateTerms(b, terms.b);
+        return terms;
+    }
+
+    static void apply(const uint8_t* yRow, int col, const Terms& terms,
+                      __m128i* r, __m128i* g, __m128i* b) {
+        const __m256i yLo = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + col)));
+        const __m256i yHi = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + col + 16)));
+
+        packPixels(_mm256_add_epi16(yLo, terms.r[0]), _mm256_add_epi16(yHi, terms.r[1]), r);
+        packPixels(_mm256_sub_epi16(yLo, terms.g[0]), _mm256_sub_epi16(yHi, terms.g[1]), g);
+        packPixels(_mm256_add_epi16(yLo, terms.b[0]), _mm256_add_epi16(yHi, terms.b[1]), b);
+    }
+};
+
+} // namespace
+
+void convertAvx2Band(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    convertX86Band<Avx2Block>(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                              yRowStride, uvRowStride, uvPixelStride, map);
+}
+
+#endif // __x86_64__
@@ -0,0 +1,124 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          yuv_to_rgb_internal.h                                ║
+// ║              Piezas compartidas entre los kernels YUV420 → RGB888             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Solo para yuv_to_rgb*.cpp: firma de kernel por bandas, bordes escalares Q8   ║
+// ║  y los kernels NEON y x86 (SSE4.1 / AVX2) compilados en unidades propias.     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef YUV_TO_RGB_INTERNAL_H
+#define YUV_TO_RGB_INTERNAL_H
+
+#include <cstdint>
+
+#include "yuv_to_rgb.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DISPOSICIÓN DE CROMA
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Disposición de los planos de croma, resuelta una vez por frame.
+ */
+enum class ChromaLayout {
+    Planar,      // uvPixelStride == 1 (I420)
+    SemiPlanar,  // uvPixelStride == 2 (NV21/NV12, caso habitual en Android)
+    Strided,     // Cualquier otro stride (gather escalar)
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// KERNELS POR BANDAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Firma común de los kernels sobre una banda de filas.
+ *
+ * Los planos apuntan a la primera fila de la banda (par) y map.origin ya
+ * incluye su desplazamiento en la salida.
+ */
+using ConvertBandFn = void (*)(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+);
+
+/**
+ * Convierte píxel a píxel una región (bordes que no completan un bloque).
+ * Usa la misma aritmética Q8 que los caminos vectoriales.
+ */
+void convertRegionQ8(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    const OutputMapping& map,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    int colBegin,
+    int colEnd,
+    int rowBegin,
+    int rowEnd
+);
+
+#if defined(__aarch64__) || defined(__arm__)
+/**
+ * Kernel NEON (16 píxeles por iteración). En armeabi-v7a solo llamar si la
+ * CPU tiene NEON (HWCAP_NEON).
+ */
+void convertNeonBand(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+);
+#endif
+
+#if defined(__x86_64__)
+/**
+ * Kernel SSE4.1 (16 píxeles por iteración), línea base del ABI x86_64.
+ */
+void convertSse41Band(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+);
+
+/**
+ * Kernel AVX2 (32 píxeles por iteración). Solo llamar si la CPU lo soporta.
+ */
+void convertAvx2Band(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+);
+#endif
+
+#endif // YUV_TO_RGB_INTERNAL_H
@@ -0,0 +1,369 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            yuv_to_rgb_neon.cpp                                ║
+// ║              Kernel YUV420 → RGB888 con NEON (armeabi-v7a / arm64)            ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Única unidad compilada con -mfpu=neon en armeabi-v7a: el resto de la         ║
+// ║  biblioteca no emite NEON y el kernel solo se instala con HWCAP_NEON.         ║
+// ║  16 píxeles por iteración con la misma aritmética Q8 que el camino escalar.   ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#include "yuv_to_rgb_internal.h"
+
+namespace {
+
+/**
+ * Términos de croma Q8 de 8 muestras; cada muestra sirve a 2 píxeles.
+ *
+ * Constantes Q8 359/88/183/454 (BT.601). 359 y 454 se descomponen en
+ * 256 + 103 y 256 + 198: el producto completo por (V-128) desborda int16,
+ * mientras que d + ((k·d) >> 8) da exactamente ((256 + k)·d) >> 8.
+ */
+struct ChromaTerms {
+    int16x8_t r;  // 1.402 * V'
+    int16x8_t g;  // 0.344136 * U' + 0.714136 * V'
+    int16x8_t b;  // 1.772 * U'
+};
+
+inline ChromaTerms chromaTerms(uint8x8_t u8, uint8x8_t v8) {
+    const int16x8_t v_c1 = vdupq_n_s16(103);   // 1.402 * 256 - 256
+    const int16x8_t v_c2 = vdupq_n_s16(88);    // 0.344136 * 256
+    const int16x8_t v_c3 = vdupq_n_s16(183);   // 0.714136 * 256
+    const int16x8_t v_c4 = vdupq_n_s16(198);   // 1.772 * 256 - 256
+    const int16x8_t v_128 = vdupq_n_s16(128);
+
+    // U - 128, V - 128
+    const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), v_128);
+    const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), v_128);
+
+    ChromaTerms terms;
+    terms.r = vaddq_s16(v, vshrq_n_s16(vmulq_s16(v_c1, v), 8));
+    terms.g = vaddq_s16(vshrq_n_s16(vmulq_s16(v_c2, u), 8),
+                        vshrq_n_s16(vmulq_s16(v_c3, v), 8));
+    terms.b = vaddq_s16(u, vshrq_n_s16(vmulq_s16(v_c4, u), 8));
+    return terms;
+}
+
+/**
+ * Carga 8 muestras consecutivas de un plano de croma.
+ *
+ * @param row    Inicio de la fila de croma
+ * @param sample Índice de la primera muestra (columna de píxel / 2)
+ */
+template <ChromaLayout Layout>
+inline uint8x8_t loadChroma8(const uint8_t* row, int sample, int pixelStride) {
+    if (Layout == ChromaLayout::Planar) {
+        return vld1_u8(row + sample);
+    }
+    if (Layout == ChromaLayout::SemiPlanar) {
+        // Bytes alternos U/V: vld2 separa las muestras propias en val[0]
+        return vld2_u8(row + sample * 2).val[0];
+    }
+
+    uint8_t gathered[8];
+    for (int i = 0; i < 8; i++) {
+        gathered[i] = row[(sample + i) * pixelStride];
+    }
+    return vld1_u8(gathered);
+}
+
+/**
+ * Aplica términos de croma ya duplicados a 8 valores Y.
+ */
+inline void applyChroma8(uint8x8_t y8, int16x8_t rTerm, int16x8_t gTerm,
+                         int16x8_t bTerm, uint8x8_t& r8, uint8x8_t& g8,
+                         uint8x8_t& b8) {
+    const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(y8));
+
+    // Clamp a [0, 255] y convertir a uint8
+    r8 = vqmovun_s16(vaddq_s16(y, rTerm));
+    g8 = vqmovun_s16(vsubq_s16(y, gTerm));
+    b8 = vqmovun_s16(vaddq_s16(y, bTerm));
+}
+
+/**
+ * Términos de croma de 16 píxeles consecutivos (8 muestras duplicadas).
+ */
+struct ChromaTerms16 {
+    int16x8x2_t r;
+    int16x8x2_t g;
+    int16x8x2_t b;
+};
+
+/**
+ * Carga 8 muestras UV y calcula sus términos para 16 píxeles.
+ *
+ * Las muestras se convierten una sola vez y se duplican con vzip; el mismo
+ * resultado sirve a las dos filas Y que comparten la fila UV.
+ */
+template <ChromaLayout Layout>
+inline ChromaTerms16 loadChromaTerms16(
+    const uint8_t* uRow,
+    const uint8_t* vRow,
+    int col,
+    int uvPixelStride
+) {
+    const ChromaTerms terms = chromaTerms(
+        loadChroma8<Layout>(uRow, col / 2, uvPixelStride),
+        loadChroma8<Layout>(vRow, col / 2, uvPixelStride));
+
+    return {
+        vzipq_s16(terms.r, terms.r),
+        vzipq_s16(terms.g, terms.g),
+        vzipq_s16(terms.b, terms.b),
+    };
+}
+
+/**
+ * Convierte 16 píxeles de una fila Y con términos de croma ya calculados.
+ *
+ * Salida en dos mitades: [0] píxeles col..col+7, [1] píxeles col+8..col+15.
+ */
+inline void applyChroma16(
+    const uint8_t* yRow,
+    int col,
+    const ChromaTerms16& terms,
+    uint8x8_t* r,
+    uint8x8_t* g,
+    uint8x8_t* b
+) {
+    const uint8x16_t y16 = vld1q_u8(yRow + col);
+    applyChroma8(vget_low_u8(y16), terms.r.val[0], terms.g.val[0], terms.b.val[0],
+                 r[0], g[0], b[0]);
+    applyChroma8(vget_high_u8(y16), terms.r.val[1], terms.g.val[1], terms.b.val[1],
+                 r[1], g[1], b[1]);
+}
+
+/**
+ * Almacena 8 píxeles RGB intercalados, opcionalmente en orden inverso.
+ *
+ * @param dst Dirección del píxel destino más bajo de los 8
+ */
+inline void storeRgb8(uint8_t* dst, uint8x8_t r, uint8x8_t g, uint8x8_t b,
+                      bool reversed) {
+    uint8x8x3_t rgb;
+    rgb.val[0] = reversed ? vrev64_u8(r) : r;
+    rgb.val[1] = reversed ? vrev64_u8(g) : g;
+    rgb.val[2] = reversed ? vrev64_u8(b) : b;
+    vst3_u8(dst, rgb);
+}
+
+/**
+ * Transpone en registros un bloque 8×8 de bytes (una fila por vector).
+ */
+inline void transpose8x8(uint8x8_t* m) {
+    const uint8x8x2_t t01 = vtrn_u8(m[0], m[1]);
+    const uint8x8x2_t t23 = vtrn_u8(m[2], m[3]);
+    const uint8x8x2_t t45 = vtrn_u8(m[4], m[5]);
+    const uint8x8x2_t t67 = vtrn_u8(m[6], m[7]);
+
+    const uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]),
+                                      vreinterpret_u16_u8(t23.val[0]));
+    const uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]),
+                                      vreinterpret_u16_u8(t23.val[1]));
+    const uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]),
+                                      vreinterpret_u16_u8(t67.val[0]));
+    const uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]),
+                                      vreinterpret_u16_u8(t67.val[1]));
+
+    const uint32x2x2_t w04 = vtrn_u32(vreinterpret_u32_u16(u02.val[0]),
+                                      vreinterpret_u32_u16(u46.val[0]));
+    const uint32x2x2_t w15 = vtrn_u32(vreinterpret_u32_u16(u13.val[0]),
+                                      vreinterpret_u32_u16(u57.val[0]));
+    const uint32x2x2_t w26 = vtrn_u32(vreinterpret_u32_u16(u02.val[1]),
+                                      vreinterpret_u32_u16(u46.val[1]));
+    const uint32x2x2_t w37 = vtrn_u32(vreinterpret_u32_u16(u13.val[1]),
+                                      vreinterpret_u32_u16(u57.val[1]));
+
+    m[0] = vreinterpret_u8_u32(w04.val[0]);
+    m[1] = vreinterpret_u8_u32(w15.val[0]);
+    m[2] = vreinterpret_u8_u32(w26.val[0]);
+    m[3] = vreinterpret_u8_u32(w37.val[0]);
+    m[4] = vreinterpret_u8_u32(w04.val[1]);
+    m[5] = vreinterpret_u8_u32(w15.val[1]);
+    m[6] = vreinterpret_u8_u32(w26.val[1]);
+    m[7] = vreinterpret_u8_u32(w37.val[1]);
+}
+
+/**
+ * Transpone un bloque 8 filas × 8 columnas fuente y lo escribe como 8
+ * segmentos contiguos de filas destino.
+ */
+inline void storeTransposed8x8(
+    uint8_t* rgbOutput,
+    const OutputMapping& map,
+    int tileCol,
+    int tileRow,
+    uint8x8_t* r,
+    uint8x8_t* g,
+    uint8x8_t* b
+) {
+    const bool reversed = map.rowStep < 0;
+
+    transpose8x8(r);
+    transpose8x8(g);
+    transpose8x8(b);
+
+    // Tras transponer, el vector j contiene la columna fuente tileCol + j
+    for (int j = 0; j < 8; j++) {
+        const long start =
+            map.origin + (tileCol + j) * map.colStep + tileRow * map.rowStep;
+        const long first = reversed ? start - 7 : start;
+        storeRgb8(rgbOutput + first * 3, r[j], g[j], b[j], reversed);
+    }
+}
+
+/**
+ * Kernel NEON especializado por disposición de croma.
+ */
+template <ChromaLayout Layout>
+void convertNeonImpl(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    const int width16 = width & ~15;
+
+    // En semi-planar, vld2 de las últimas 8 muestras lee un byte más allá de
+    // la última muestra propia; en la última fila UV ese byte puede quedar
+    // fuera del buffer del plano.
+    const int lastUvRow = (height - 1) / 2;
+    const int lastRowWidth16 =
+        Layout == ChromaLayout::SemiPlanar ? ((width - 1) & ~15) : width16;
+
+    if (map.colStep == 1 || map.colStep == -1) {
+        // 0/180: filas destino contiguas, invertidas si colStep es -1
+        const bool reversed = map.colStep < 0;
+
+        // Pares de filas que comparten fila UV; con altura impar la última
+        // fila se procesa sola.
+        for (int row = 0; row < height; row += 2) {
+            const int rowCount = row + 1 < height ? 2 : 1;
+            const uint8_t* uRow = uPlane + (row / 2) * uvRowStride;
+            const uint8_t* vRow = vPlane + (row / 2) * uvRowStride;
+            const int vectorEnd = row / 2 == lastUvRow ? lastRowWidth16 : width16;
+
+            // Procesar 16 píxeles a la vez
+            for (int col = 0; col < vectorEnd; col += 16) {
+                const ChromaTerms16 terms =
+                    loadChromaTerms16<Layout>(uRow, vRow, col, uvPixelStride);
+
+                for (int i = 0; i < rowCount; i++) {
+                    const long dstRow = map.origin + (row + i) * map.rowStep;
+                    uint8x8_t r[2], g[2], b[2];
+                    applyChroma16(yPlane + (row + i) * yRowStride, col, terms, r, g, b);
+
+                    for (int half = 0; half < 2; half++) {
+                        const int start = col + half * 8;
+                        const long first = reversed ? dstRow - start - 7 : dstRow + start;
+                        storeRgb8(rgbOutput + first * 3, r[half], g[half], b[half], reversed);
+                    }
+                }
+            }
+
+            // Procesar píxeles restantes con método escalar
+            convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                            yRowStride, uvRowStride, uvPixelStride,
+                            vectorEnd, width, row, row + rowCount);
+        }
+        return;
+    }
+
+    // 90/270: bandas de 8 filas fuente convertidas en bloques de 16 columnas,
+    // transpuestas en registros (dos bloques 8×8) y almacenadas como
+    // segmentos contiguos de filas destino.
+    const int height8 = height & ~7;
+
+    for (int tileRow = 0; tileRow < height8; tileRow += 8) {
+        const int vectorEnd =
+            (tileRow + 7) / 2 == lastUvRow ? lastRowWidth16 : width16;
+
+        for (int tileCol = 0; tileCol < vectorEnd; tileCol += 16) {
+            uint8x8_t rLo[8], gLo[8], bLo[8];
+            uint8x8_t rHi[8], gHi[8], bHi[8];
+
+            // 4 filas UV, cada una aplicada a sus 2 filas Y
+            for (int i = 0; i < 8; i += 2) {
+                const int row = tileRow + i;
+                const ChromaTerms16 terms = loadChromaTerms16<Layout>(
+                    uPlane + (row / 2) * uvRowStride,
+                    vPlane + (row / 2) * uvRowStride,
+                    tileCol, uvPixelStride);
+
+                for (int k = 0; k < 2; k++) {
+                    uint8x8_t r[2], g[2], b[2];
+                    applyChroma16(yPlane + (row + k) * yRowStride, tileCol, terms, r, g, b);
+                    rLo[i + k] = r[0];
+                    gLo[i + k] = g[0];
+                    bLo[i + k] = b[0];
+                    rHi[i + k] = r[1];
+                    gHi[i + k] = g[1];
+                    bHi[i + k] = b[1];
+                }
+            }
+
+            storeTransposed8x8(rgbOutput, map, tileCol, tileRow, rLo, gLo, bLo);
+            storeTransposed8x8(rgbOutput, map, tileCol + 8, tileRow, rHi, gHi, bHi);
+        }
+
+        // Columnas a la derecha del último bloque de la banda
+        convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                        yRowStride, uvRowStride, uvPixelStride,
+                        vectorEnd, width, tileRow, tileRow + 8);
+    }
+
+    // Filas debajo de la última banda completa
+    convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                    yRowStride, uvRowStride, uvPixelStride,
+                    0, width, height8, height);
+}
+
+} // namespace
+
+/**
+ * Kernel NEON sobre una banda de filas (mismas convenciones que
+ * convertScalarBand).
+ */
+void convertNeonBand(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    // Despacho por disposición de croma una sola vez por frame
+    switch (uvPixelStride) {
+        case 1:
+            convertNeonImpl<ChromaLayout::Planar>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+        case 2:
+            convertNeonImpl<ChromaLayout::SemiPlanar>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+        default:
+            convertNeonImpl<ChromaLayout::Strided>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+    }
+}
+
+#endif
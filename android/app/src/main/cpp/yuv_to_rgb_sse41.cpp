@@ -0,0 +1,106 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           yuv_to_rgb_sse41.cpp                                ║
+// ║              Kernel YUV420 → RGB888 con SSE4.1 (x86_64)                       ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  16 píxeles por iteración con la misma aritmética Q8 que NEON y el camino     ║
+// ║  escalar: salida idéntica bit a bit en todos los ABIs.                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#if defined(__x86_64__)
+
+#include "yuv_to_rgb_x86.h"
+
+namespace {
+
+/**
+ * Bloque SSE4.1: 8 muestras de croma → 16 píxeles.
+ *
+ * Constantes Q8 359/88/183/454 (BT.601) descompuestas como en NEON:
+ * d + ((k·d) >> 8) con k = 103 y 198 evita desbordar int16.
+ */
+struct Sse41Block {
+    static constexpr int kPixels = 16;
+
+    /// Términos int16 duplicados por píxel: [0] píxeles 0-7, [1] píxeles 8-15.
+    struct Terms {
+        __m128i r[2];
+        __m128i g[2];
+        __m128i b[2];
+    };
+
+    template <ChromaLayout Layout>
+    static __m128i loadChroma(const uint8_t* row, int sample, int pixelStride) {
+        if constexpr (Layout == ChromaLayout::Planar) {
+            return _mm_cvtepu8_epi16(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + sample)));
+        } else if constexpr (Layout == ChromaLayout::SemiPlanar) {
+            // Bytes pares de 16 bytes intercalados = 8 muestras en int16
+            return _mm_and_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + sample * 2)),
+                _mm_set1_epi16(0x00FF));
+        } else {
+            alignas(16) int16_t lanes[8];
+            for (int i = 0; i < 8; i++) {
+                lanes[i] = row[(sample + i) * pixelStride];
+            }
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+        }
+    }
+
+    template <ChromaLayout Layout>
+    static Terms loadTerms(const uint8_t* uRow, const uint8_t* vRow, int col,
+                           int pixelStride) {
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i u = _mm_sub_epi16(loadChroma<Layout>(uRow, col / 2, pixelStride), bias);
+        const __m128i v = _mm_sub_epi16(loadChroma<Layout>(vRow, col / 2, pixelStride), bias);
+
+        const __m128i r = _mm_add_epi16(
+            v, _mm_srai_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(103)), 8));
+        const __m128i g = _mm_add_epi16(
+            _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(88)), 8),
+            _mm_srai_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(183)), 8));
+        const __m128i b = _mm_add_epi16(
+            u, _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(198)), 8));
+
+        return {
+            {_mm_unpacklo_epi16(r, r), _mm_unpackhi_epi16(r, r)},
+            {_mm_unpacklo_epi16(g, g), _mm_unpackhi_epi16(g, g)},
+            {_mm_unpacklo_epi16(b, b), _mm_unpackhi_epi16(b, b)},
+        };
+    }
+
+    static void apply(const uint8_t* yRow, int col, const Terms& terms,
+                      __m128i* r, __m128i* g, __m128i* b) {
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + col));
+        const __m128i yLo = _mm_cvtepu8_epi16(y);
+        const __m128i yHi = _mm_unpackhi_epi8(y, _mm_setzero_si128());
+
+        // packus satura a [0, 255] igual que clamp255
+        r[0] = _mm_packus_epi16(_mm_add_epi16(yLo, terms.r[0]),
+                                _mm_add_epi16(yHi, terms.r[1]));
+        g[0] = _mm_packus_epi16(_mm_sub_epi16(yLo, terms.g[0]),
+                                _mm_sub_epi16(yHi, terms.g[1]));
+        b[0] = _mm_packus_epi16(_mm_add_epi16(yLo, terms.b[0]),
+                                _mm_add_epi16(yHi, terms.b[1]));
+    }
+};
+
+} // namespace
+
+void convertSse41Band(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    convertX86Band<Sse41Block>(yPlane, uPlane, vPlane, rgbOutput, width, height,
+                               yRowStride, uvRowStride, uvPixelStride, map);
+}
+
+#endif // __x86_64__
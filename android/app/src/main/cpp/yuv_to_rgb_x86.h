@@ -0,0 +1,356 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            yuv_to_rgb_x86.h                                   ║
+// ║              Recorrido común de los kernels x86 (SSE4.1 / AVX2)               ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Incluido solo por yuv_to_rgb_sse41.cpp y yuv_to_rgb_avx2.cpp. Todo vive en   ║
+// ║  un namespace anónimo: cada unidad lo compila con sus propias flags de        ║
+// ║  destino y ninguna instancia AVX2 puede acabar en el camino SSE4.1.           ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+#ifndef YUV_TO_RGB_X86_H
+#define YUV_TO_RGB_X86_H
+
+#include <smmintrin.h>
+#include <tmmintrin.h>
+
+#include <cstdint>
+
+#include "yuv_to_rgb_internal.h"
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ENTRELAZADO RGB24
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Máscaras pshufb para entrelazar 16 píxeles planar (R, G, B) en 48 bytes
+ * RGB24: [invertido][bloque de 16 bytes][canal]. -128 deja el byte a cero.
+ */
+struct InterleaveMasks {
+    int8_t bytes[2][3][3][16];
+};
+
+constexpr InterleaveMasks makeInterleaveMasks() {
+    InterleaveMasks masks{};
+    for (int reversed = 0; reversed < 2; reversed++) {
+        for (int block = 0; block < 3; block++) {
+            for (int channel = 0; channel < 3; channel++) {
+                for (int k = 0; k < 16; k++) {
+                    const int position = block * 16 + k;
+                    const int pixel = position / 3;
+                    const int source = reversed ? 15 - pixel : pixel;
+                    masks.bytes[reversed][block][channel][k] =
+                        position % 3 == channel ? static_cast<int8_t>(source) : -128;
+                }
+            }
+        }
+    }
+    return masks;
+}
+
+alignas(16) constexpr InterleaveMasks kInterleaveMasks = makeInterleaveMasks();
+
+/**
+ * Almacena 16 píxeles RGB24 (en orden inverso si reversed).
+ */
+inline void storeRgb16(uint8_t* dst, __m128i r, __m128i g, __m128i b, bool reversed) {
+    const auto& masks = kInterleaveMasks.bytes[reversed ? 1 : 0];
+
+    for (int block = 0; block < 3; block++) {
+        const __m128i rPart = _mm_shuffle_epi8(
+            r, _mm_load_si128(reinterpret_cast<const __m128i*>(masks[block][0])));
+        const __m128i gPart = _mm_shuffle_epi8(
+            g, _mm_load_si128(reinterpret_cast<const __m128i*>(masks[block][1])));
+        const __m128i bPart = _mm_shuffle_epi8(
+            b, _mm_load_si128(reinterpret_cast<const __m128i*>(masks[block][2])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + block * 16),
+                         _mm_or_si128(_mm_or_si128(rPart, gPart), bPart));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ESCRITURA TRANSPUESTA (90/270)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Máscaras pshufb para escribir 8 píxeles de una columna fuente (24 bytes de
+ * una fila destino) a partir de [R(8) | G(8)] y [B(c) | B(c + 1)].
+ * Índices: [invertido][parte: bytes 0-15 / 16-23] y, para B, la columna par
+ * o impar del par.
+ */
+struct ColumnMasks {
+    int8_t rg[2][2][16];
+    int8_t b[2][2][2][16];
+};
+
+constexpr ColumnMasks makeColumnMasks() {
+    ColumnMasks masks{};
+    for (int reversed = 0; reversed < 2; reversed++) {
+        for (int part = 0; part < 2; part++) {
+            for (int k = 0; k < 16; k++) {
+                const int position = part * 16 + k;
+                const int pixel = position / 3;
+                const int channel = position % 3;
+                const int source = reversed ? 7 - pixel : pixel;
+                const bool inside = position < 24;
+
+                masks.rg[reversed][part][k] = !inside || channel == 2
+                    ? -128
+                    : static_cast<int8_t>(channel == 0 ? source : 8 + source);
+                for (int odd = 0; odd < 2; odd++) {
+                    masks.b[reversed][odd][part][k] = inside && channel == 2
+                        ? static_cast<int8_t>(source + 8 * odd)
+                        : -128;
+                }
+            }
+        }
+    }
+    return masks;
+}
+
+alignas(16) constexpr ColumnMasks kColumnMasks = makeColumnMasks();
+
+inline __m128i loadMask(const int8_t* mask) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+/**
+ * Transpone 8 filas de 16 bytes: pairs[i] contiene las columnas 2i y 2i + 1
+ * (8 bytes cada una, filas 0-7).
+ */
+inline void transpose8x16(const __m128i* rows, __m128i* pairs) {
+    const __m128i t0 = _mm_unpacklo_epi8(rows[0], rows[1]);
+    const __m128i t1 = _mm_unpackhi_epi8(rows[0], rows[1]);
+    const __m128i t2 = _mm_unpacklo_epi8(rows[2], rows[3]);
+    const __m128i t3 = _mm_unpackhi_epi8(rows[2], rows[3]);
+    const __m128i t4 = _mm_unpacklo_epi8(rows[4], rows[5]);
+    const __m128i t5 = _mm_unpackhi_epi8(rows[4], rows[5]);
+    const __m128i t6 = _mm_unpacklo_epi8(rows[6], rows[7]);
+    const __m128i t7 = _mm_unpackhi_epi8(rows[6], rows[7]);
+
+    const __m128i u0 = _mm_unpacklo_epi16(t0, t2);
+    const __m128i u1 = _mm_unpackhi_epi16(t0, t2);
+    const __m128i u2 = _mm_unpacklo_epi16(t1, t3);
+    const __m128i u3 = _mm_unpackhi_epi16(t1, t3);
+    const __m128i u4 = _mm_unpacklo_epi16(t4, t6);
+    const __m128i u5 = _mm_unpackhi_epi16(t4, t6);
+    const __m128i u6 = _mm_unpacklo_epi16(t5, t7);
+    const __m128i u7 = _mm_unpackhi_epi16(t5, t7);
+
+    pairs[0] = _mm_unpacklo_epi32(u0, u4);
+    pairs[1] = _mm_unpackhi_epi32(u0, u4);
+    pairs[2] = _mm_unpacklo_epi32(u1, u5);
+    pairs[3] = _mm_unpackhi_epi32(u1, u5);
+    pairs[4] = _mm_unpacklo_epi32(u2, u6);
+    pairs[5] = _mm_unpackhi_epi32(u2, u6);
+    pairs[6] = _mm_unpacklo_epi32(u3, u7);
+    pairs[7] = _mm_unpackhi_epi32(u3, u7);
+}
+
+/**
+ * Escribe un bloque de 8 filas × 16 columnas fuente (planar R, G, B) con
+ * rotación 90/270: cada columna fuente es un segmento de 8 píxeles de una
+ * fila destino.
+ */
+inline void storeTransposed8x16(
+    uint8_t* rgbOutput,
+    const OutputMapping& map,
+    int col,
+    int row,
+    const __m128i* r,
+    const __m128i* g,
+    const __m128i* b
+) {
+    __m128i rPairs[8], gPairs[8], bPairs[8];
+    transpose8x16(r, rPairs);
+    transpose8x16(g, gPairs);
+    transpose8x16(b, bPairs);
+
+    // rowStep ±1: con -1 las 8 filas fuente se escriben hacia atrás
+    const bool reversed = map.rowStep < 0;
+    const int rev = reversed ? 1 : 0;
+    const __m128i rgMask0 = loadMask(kColumnMasks.rg[rev][0]);
+    const __m128i rgMask1 = loadMask(kColumnMasks.rg[rev][1]);
+
+    for (int pair = 0; pair < 8; pair++) {
+        for (int odd = 0; odd < 2; odd++) {
+            const __m128i rg = odd
+                ? _mm_unpackhi_epi64(rPairs[pair], gPairs[pair])
+                : _mm_unpacklo_epi64(rPairs[pair], gPairs[pair]);
+
+            const long first = map.origin + (col + pair * 2 + odd) * map.colStep +
+                               row * map.rowStep;
+            uint8_t* dst = rgbOutput + (reversed ? first - 7 : first) * 3;
+
+            const __m128i part0 = _mm_or_si128(
+                _mm_shuffle_epi8(rg, rgMask0),
+                _mm_shuffle_epi8(bPairs[pair], loadMask(kColumnMasks.b[rev][odd][0])));
+            const __m128i part1 = _mm_or_si128(
+                _mm_shuffle_epi8(rg, rgMask1),
+                _mm_shuffle_epi8(bPairs[pair], loadMask(kColumnMasks.b[rev][odd][1])));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), part0);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), part1);
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RECORRIDO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Recorrido común, parametrizado por el bloque vectorial.
+ *
+ * Block define kPixels (múltiplo de 16), Terms, loadTerms<Layout>() (términos
+ * de croma de kPixels / 2 muestras) y apply() (una fila Y → kPixels / 16
+ * vectores R, G, B de 16 bytes). Misma estructura que el kernel NEON: pares
+ * de filas que comparten croma, bordes con convertRegionQ8 y, en 90/270,
+ * bandas de 8 filas transpuestas en registros.
+ */
+template <typename Block, ChromaLayout Layout>
+void convertX86Impl(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    constexpr int kPixels = Block::kPixels;
+    constexpr int kVectors = kPixels / 16;
+    const int widthN = width / kPixels * kPixels;
+
+    // En semi-planar la carga de las últimas muestras lee un byte más allá de
+    // la última muestra propia; en la última fila UV puede quedar fuera del
+    // buffer del plano.
+    const int lastUvRow = (height - 1) / 2;
+    const int lastRowWidthN = Layout == ChromaLayout::SemiPlanar
+        ? (width - 1) / kPixels * kPixels
+        : widthN;
+
+    if (map.colStep == 1 || map.colStep == -1) {
+        // 0/180: filas destino contiguas, invertidas si colStep es -1
+        const bool reversed = map.colStep < 0;
+
+        for (int row = 0; row < height; row += 2) {
+            const int rowCount = row + 1 < height ? 2 : 1;
+            const uint8_t* uRow = uPlane + (row / 2) * uvRowStride;
+            const uint8_t* vRow = vPlane + (row / 2) * uvRowStride;
+            const int vectorEnd = row / 2 == lastUvRow ? lastRowWidthN : widthN;
+
+            for (int col = 0; col < vectorEnd; col += kPixels) {
+                const typename Block::Terms terms =
+                    Block::template loadTerms<Layout>(uRow, vRow, col, uvPixelStride);
+
+                for (int i = 0; i < rowCount; i++) {
+                    const long dstRow = map.origin + (row + i) * map.rowStep;
+                    __m128i r[kVectors], g[kVectors], b[kVectors];
+                    Block::apply(yPlane + (row + i) * yRowStride, col, terms, r, g, b);
+
+                    for (int part = 0; part < kVectors; part++) {
+                        const int start = col + part * 16;
+                        const long first = reversed ? dstRow - start - 15 : dstRow + start;
+                        storeRgb16(rgbOutput + first * 3, r[part], g[part], b[part], reversed);
+                    }
+                }
+            }
+
+            convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                            yRowStride, uvRowStride, uvPixelStride,
+                            vectorEnd, width, row, row + rowCount);
+        }
+        return;
+    }
+
+    // 90/270: bandas de 8 filas fuente convertidas en bloques de kPixels
+    // columnas, transpuestas en registros (8×16) y almacenadas como
+    // segmentos contiguos de filas destino
+    const int height8 = height & ~7;
+
+    for (int tileRow = 0; tileRow < height8; tileRow += 8) {
+        const int vectorEnd =
+            (tileRow + 7) / 2 == lastUvRow ? lastRowWidthN : widthN;
+
+        for (int tileCol = 0; tileCol < vectorEnd; tileCol += kPixels) {
+            __m128i rRows[kVectors][8], gRows[kVectors][8], bRows[kVectors][8];
+
+            for (int i = 0; i < 8; i += 2) {
+                const int row = tileRow + i;
+                const typename Block::Terms terms = Block::template loadTerms<Layout>(
+                    uPlane + (row / 2) * uvRowStride,
+                    vPlane + (row / 2) * uvRowStride,
+                    tileCol, uvPixelStride);
+
+                for (int k = 0; k < 2; k++) {
+                    __m128i r[kVectors], g[kVectors], b[kVectors];
+                    Block::apply(yPlane + (row + k) * yRowStride, tileCol, terms, r, g, b);
+                    for (int part = 0; part < kVectors; part++) {
+                        rRows[part][i + k] = r[part];
+                        gRows[part][i + k] = g[part];
+                        bRows[part][i + k] = b[part];
+                    }
+                }
+            }
+
+            for (int part = 0; part < kVectors; part++) {
+                storeTransposed8x16(rgbOutput, map, tileCol + part * 16, tileRow,
+                                    rRows[part], gRows[part], bRows[part]);
+            }
+        }
+
+        // Columnas a la derecha del último bloque de la banda
+        convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                        yRowStride, uvRowStride, uvPixelStride,
+                        vectorEnd, width, tileRow, tileRow + 8);
+    }
+
+    // Filas debajo de la última banda completa
+    convertRegionQ8(yPlane, uPlane, vPlane, rgbOutput, map,
+                    yRowStride, uvRowStride, uvPixelStride,
+                    0, width, height8, height);
+}
+
+/**
+ * Despacho por disposición de croma una sola vez por banda.
+ */
+template <typename Block>
+void convertX86Band(
+    const uint8_t* yPlane,
+    const uint8_t* uPlane,
+    const uint8_t* vPlane,
+    uint8_t* rgbOutput,
+    int width,
+    int height,
+    int yRowStride,
+    int uvRowStride,
+    int uvPixelStride,
+    const OutputMapping& map
+) {
+    switch (uvPixelStride) {
+        case 1:
+            convertX86Impl<Block, ChromaLayout::Planar>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+        case 2:
+            convertX86Impl<Block, ChromaLayout::SemiPlanar>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+        default:
+            convertX86Impl<Block, ChromaLayout::Strided>(
+                yPlane, uPlane, vPlane, rgbOutput, width, height,
+                yRowStride, uvRowStride, uvPixelStride, map);
+            break;
+    }
+}
+
+} // namespace
+
+#endif // YUV_TO_RGB_X86_H
@@ -12,6 +12,7 @@ package edu.epn.nutrivision.nutrivision_aiepn_mobile
 import android.os.Bundle
 import io.flutter.embedding.android.FlutterActivity
 import io.flutter.embedding.engine.FlutterEngine
+import io.flutter.plugin.common.MethodCall
 import io.flutter.plugin.common.MethodChannel
 import java.nio.ByteBuffer
 
@@ -21,9 +22,129 @@ class MainActivity : FlutterActivity() {
         private const val CHANNEL = "edu.epn.nutrivision/native_image_processor"
     }
 
+    /**
+     * Buffers directos de los planos Y/U/V, registrados una vez y reutilizados.
+     *
+     * Ruta de respaldo para cuando dart:ffi no está disponible: evita
+     * `allocateDirect` por plano y por frame. Solo crecen si cambia la
+     * resolución.
+     */
+    private val planeBuffers = arrayOfNulls<ByteBuffer>(3)
+
+    /**
+     * Copia los bytes del plano en su buffer directo persistente.
+     */
+    private fun directPlane(index: Int, bytes: ByteArray): ByteBuffer {
+        val current = planeBuffers[index]
+        val buffer = if (current != null && current.capacity() >= bytes.size) {
+            current
+        } else {
+            ByteBuffer.allocateDirect(bytes.size).also { planeBuffers[index] = it }
+        }
+        buffer.clear()
+        buffer.put(bytes)
+        buffer.rewind()
+        return buffer
+    }
+
+    /** Anillos nativos de salida: RGB888 y tensor (float32, float16 o 8 bits). */
+    private val rgbPool = NativeBufferPool(2)
+    private val tensorPool = NativeBufferPool(2)
+
+    /** Copias en heap para responder por el MethodChannel (el codec serializa al responder). */
+    private var rgbBytes: ByteArray? = null
+    private var tensorBytes: ByteArray? = null
+
+    /**
+     * Copia el contenido de un slot nativo al array persistente indicado,
+     * realocándolo solo si cambia el tamaño.
+     */
+    private fun copyToHeap(buffer: ByteBuffer, bytes: Int, current: ByteArray?): ByteArray {
+        val target = if (current != null && current.size == bytes) current else ByteArray(bytes)
+        buffer.rewind()
+        buffer.get(target, 0, bytes)
+        buffer.rewind()
+        return target
+    }
+
+    /**
+     * Formato del tensor pedido por Dart ("tensorType", "quantScale",
+     * "zeroPoint", "tensorLayout"); float32 NHWC si no vienen.
+     */
+    private fun tensorFormat(call: MethodCall): NativeImageProcessor.TensorFormat =
+        NativeImageProcessor.TensorFormat(
+            dataType = call.argument<Int>("tensorType") ?: NativeImageProcessor.TENSOR_TYPE_F32,
+            quantScale = call.argument<Double>("quantScale")?.toFloat() ?: 1f,
+            zeroPoint = call.argument<Int>("zeroPoint") ?: 0,
+            layout = call.argument<Int>("tensorLayout") ?: NativeImageProcessor.TENSOR_LAYOUT_NHWC
+        )
+
+    /** Planos desplazados al origen de la región de interés y su tamaño. */
+    private class CroppedFrame(
+        val y: ByteBuffer,
+        val u: ByteBuffer,
+        val v: ByteBuffer,
+        val width: Int,
+        val height: Int
+    )
+
+    /**
+     * Región de interés pedida por Dart ("cropX", "cropY", "cropWidth",
+     * "cropHeight"), ya ajustada al frame con origen par. Sin región se
+     * usa el frame completo.
+     *
+     * Los planos se recortan con slice(): los strides no cambian y el kernel
+     * solo lee las filas y columnas de la región.
+     */
+    private fun cropFrame(
+        call: MethodCall,
+        y: ByteBuffer,
+        u: ByteBuffer,
+        v: ByteBuffer,
+        width: Int,
+        height: Int,
+        yRowStride: Int,
+        uvRowStride: Int,
+        uvPixelStride: Int
+    ): CroppedFrame {
+        val cropWidth = call.argument<Int>("cropWidth") ?: 0
+        val cropHeight = call.argument<Int>("cropHeight") ?: 0
+        if (cropWidth <= 0 || cropHeight <= 0) return CroppedFrame(y, u, v, width, height)
+
+        val cropX = call.argument<Int>("cropX") ?: 0
+        val cropY = call.argument<Int>("cropY") ?: 0
+        require(cropX >= 0 && cropY >= 0 && cropX % 2 == 0 && cropY % 2 == 0 &&
+                cropX + cropWidth <= width && cropY + cropHeight <= height) {
+            "Región de interés fuera del frame"
+        }
+
+        val lumaOffset = cropY * yRowStride + cropX
+        val chromaOffset = (cropY / 2) * uvRowStride + (cropX / 2) * uvPixelStride
+        return CroppedFrame(
+            slicePlane(y, lumaOffset), slicePlane(u, chromaOffset), slicePlane(v, chromaOffset),
+            cropWidth, cropHeight
+        )
+    }
+
+    private fun slicePlane(buffer: ByteBuffer, offset: Int): ByteBuffer =
+        buffer.duplicate().apply { position(offset) }.slice()
+
+    /** Modo de ingesta nativa (Camera2 → AImageReader), creado bajo demanda. */
+    private var cameraIngest: NativeCameraIngest? = null
+
+    override fun onDestroy() {
+        cameraIngest?.stop()
+        rgbPool.release()
+        tensorPool.release()
+        super.onDestroy()
+    }
+
     override fun configureFlutterEngine(flutterEngine: FlutterEngine) {
         super.configureFlutterEngine(flutterEngine)
 
+        // Antes del entrypoint de Dart: el índice nutricional se mapea desde el APK
+        NativeImageProcessor.registerAssetManager(applicationContext.assets)
+
         MethodChannel(flutterEngine.dartExecutor.binaryMessenger, CHANNEL).setMethodCallHandler { call, result ->
             when (call.method) {
                 "convertYuvToRgb" -> {
@@ -36,25 +157,48 @@ class MainActivity : FlutterActivity() {
                         val yRowStride = call.argument<Int>("yRowStride")!!
                         val uvRowStride = call.argument<Int>("uvRowStride")!!
                         val uvPixelStride = call.argument<Int>("uvPixelStride")!!
+                        val sensorOrientation = call.argument<Int>("sensorOrientation") ?: 0
+                        val mirror = call.argument<Boolean>("mirror") ?: false
+                        val targetWidth = call.argument<Int>("targetWidth") ?: 0
+                        val targetHeight = call.argument<Int>("targetHeight") ?: 0
+                        val scaled = targetWidth > 0 && targetHeight > 0
 
-                        // Crear ByteBuffers directos para JNI
-                        val yBuffer = ByteBuffer.allocateDirect(yBytes.size).put(yBytes)
-                        val uBuffer = ByteBuffer.allocateDirect(uBytes.size).put(uBytes)
-                        val vBuffer = ByteBuffer.allocateDirect(vBytes.size).put(vBytes)
-
-                        // Resetear posición de los buffers
-                        yBuffer.rewind()
-                        uBuffer.rewind()
-                        vBuffer.rewind()
-
-                        val rgbBytes = NativeImageProcessor.convertYuvToRgb(
-                            yBuffer, uBuffer, vBuffer,
-                            width, height,
-                            yRowStride, uvRowStride, uvPixelStride
+                        // ByteBuffers directos persistentes para JNI
+                        val frame = cropFrame(
+                            call,
+                            directPlane(0, yBytes), directPlane(1, uBytes), directPlane(2, vBytes),
+                            width, height, yRowStride, uvRowStride, uvPixelStride
                         )
 
-                        if (rgbBytes != null) {
-                            result.success(rgbBytes)
+                        val slot = if (scaled) {
+                            NativeImageProcessor.convertYuvToRgbScaledPooled(
+                                rgbPool.nativeHandle,
+                                frame.y, frame.u, frame.v,
+                                frame.width, frame.height,
+                                yRowStride, uvRowStride, uvPixelStride,
+                                sensorOrientation, mirror,
+                                targetWidth, targetHeight
+                            )
+                        } else {
+                            NativeImageProcessor.convertYuvToRgbPooled(
+                                rgbPool.nativeHandle,
+                                frame.y, frame.u, frame.v,
+                                frame.width, frame.height,
+                                yRowStride, uvRowStride, uvPixelStride,
+                                sensorOrientation, mirror
+                            )
+                        }
+                        val rgbBuffer = rgbPool.buffer(slot)
+                        val outputBytes = if (scaled) {
+                            targetWidth * targetHeight * 3
+                        } else {
+                            frame.width * frame.height * 3
+                        }
+
+                        if (rgbBuffer != null) {
+                            val bytes = copyToHeap(rgbBuffer, outputBytes, rgbBytes)
+                            rgbBytes = bytes
+                            result.success(bytes)
                         } else {
                             result.error("CONVERSION_ERROR", "Error en conversión nativa", null)
                         }
@@ -62,6 +206,192 @@ class MainActivity : FlutterActivity() {
                         result.error("CONVERSION_ERROR", e.message, null)
                     }
                 }
+                "preprocessYuvToTensor" -> {
+                    try {
+                        val yBytes = call.argument<ByteArray>("yBytes")!!
+                        val uBytes = call.argument<ByteArray>("uBytes")!!
+                        val vBytes = call.argument<ByteArray>("vBytes")!!
+                        val width = call.argument<Int>("width")!!
+                        val height = call.argument<Int>("height")!!
+                        val yRowStride = call.argument<Int>("yRowStride")!!
+                        val uvRowStride = call.argument<Int>("uvRowStride")!!
+                        val uvPixelStride = call.argument<Int>("uvPixelStride")!!
+                        val sensorOrientation = call.argument<Int>("sensorOrientation")!!
+                        val mirror = call.argument<Boolean>("mirror")!!
+                        val targetSize = call.argument<Int>("targetSize")!!
+                        val format = tensorFormat(call)
+
+                        val frame = cropFrame(
+                            call,
+                            directPlane(0, yBytes), directPlane(1, uBytes), directPlane(2, vBytes),
+                            width, height, yRowStride, uvRowStride, uvPixelStride
+                        )
+
+                        val slot = tensorPool.acquire(targetSize, targetSize, format.bufferFormat)
+                        val tensorBuffer = tensorPool.buffer(slot)
+                        if (tensorBuffer == null) {
+                            result.error("PREPROCESS_ERROR", "Sin buffer de tensor nativo", null)
+                            return@setMethodCallHandler
+                        }
+
+                        val params = NativeImageProcessor.preprocessYuvToTensor(
+                            frame.y, frame.u, frame.v,
+                            frame.width, frame.height,
+                            yRowStride, uvRowStride, uvPixelStride,
+                            sensorOrientation, mirror,
+                            targetSize, format.dataType, format.quantScale, format.zeroPoint,
+                            format.layout, tensorBuffer
+                        )
+
+                        if (params != null) {
+                            val bytes = copyToHeap(
+                                tensorBuffer, targetSize * targetSize * 3 * format.elementBytes, tensorBytes
+                            )
+                            tensorBytes = bytes
+
+                            result.success(mapOf(
+                                "tensor" to bytes,
+                                "scale" to params[0],
+                                "padLeft" to params[1].toInt(),
+                                "padTop" to params[2].toInt(),
+                                "newWidth" to params[3].toInt(),
+                                "newHeight" to params[4].toInt()
+                            ))
+                        } else {
+                            result.error("PREPROCESS_ERROR", "Error en preprocesado nativo", null)
+                        }
+                    } catch (e: Exception) {
+                        result.error("PREPROCESS_ERROR", e.message, null)
+                    }
+                }
+                "setWorkerCount" -> {
+                    try {
+                        val count = call.argument<Int>("count") ?: 0
+                        result.success(NativeImageProcessor.setWorkerCount(count))
+                    } catch (e: Exception) {
+                        result.error("WORKER_ERROR", e.message, null)
+                    }
+                }
+                "getWorkerCount" -> {
+                    try {
+                        result.success(NativeImageProcessor.getWorkerCount())
+                    } catch (e: Exception) {
+                        result.success(1)
+                    }
+                }
+                "setPreprocessBackend" -> {
+                    try {
+                        val backend = call.argument<Int>("backend") ?: 0
+                        result.success(NativeImageProcessor.setPreprocessBackend(backend))
+                    } catch (e: Exception) {
+                        result.error("BACKEND_ERROR", e.message, null)
+                    }
+                }
+                "getPreprocessBackendName" -> {
+                    try {
+                        result.success(NativeImageProcessor.getPreprocessBackendName())
+                    } catch (e: Exception) {
+                        result.error("BACKEND_ERROR", e.message, null)
+                    }
+                }
+                "getNativeStats" -> {
+                    try {
+                        result.success(NativeImageProcessor.getNativeStats())
+                    } catch (e: Exception) {
+                        result.error("STATS_ERROR", e.message, null)
+                    }
+                }
+                "resetNativeStats" -> {
+                    try {
+                        NativeImageProcessor.resetNativeStats()
+                        result.success(null)
+                    } catch (e: Exception) {
+                        result.error("STATS_ERROR", e.message, null)
+                    }
+                }
+                "getNativeMemoryStats" -> {
+                    try {
+                        result.success(NativeImageProcessor.getNativeMemoryStats())
+                    } catch (e: Exception) {
+                        result.error("MEMORY_ERROR", e.message, null)
+                    }
+                }
+                "resetNativeMemoryPeaks" -> {
+                    try {
+                        NativeImageProcessor.resetNativeMemoryPeaks()
+                        result.success(null)
+                    } catch (e: Exception) {
+                        result.error("MEMORY_ERROR", e.message, null)
+                    }
+                }
+                "setNativeMemoryBudget" -> {
+                    try {
+                        val bytes = call.argument<Number>("bytes")?.toLong() ?: -1L
+                        result.success(NativeImageProcessor.setNativeMemoryBudget(bytes))
+                    } catch (e: Exception) {
+                        result.error("MEMORY_ERROR", e.message, null)
+                    }
+                }
+                "setTraceEnabled" -> {
+                    try {
+                        val enabled = call.argument<Boolean>("enabled") ?: false
+                        NativeImageProcessor.setTraceEnabled(enabled)
+                        result.success(null)
+                    } catch (e: Exception) {
+                        result.error("TRACE_ERROR", e.message, null)
+                    }
+                }
+                "isTraceEnabled" -> {
+                    try {
+                        result.success(NativeImageProcessor.isTraceEnabled())
+                    } catch (e: Exception) {
+                        result.success(false)
+                    }
+                }
+                "startNativeIngest" -> {
+                    try {
+                        val front = call.argument<Boolean>("front") ?: false
+                        val width = call.argument<Int>("width") ?: 1280
+                        val height = call.argument<Int>("height") ?: 720
+                        val targetSize = call.argument<Int>("targetSize")!!
+
+                        val ingest = cameraIngest ?: NativeCameraIngest(this).also { cameraIngest = it }
+                        ingest.start(front, width, height, targetSize, tensorFormat(call)) { config ->
+                            runOnUiThread {
+                                if (config != null) {
+                                    result.success(mapOf(
+                                        "width" to config.width,
+                                        "height" to config.height,
+                                        "sensorOrientation" to config.sensorOrientation,
+                                        "mirror" to config.mirror
+                                    ))
+                                } else {
+                                    result.error("INGEST_ERROR", "No se pudo iniciar la ingesta nativa", null)
+                                }
+                            }
+                        }
+                    } catch (e: Exception) {
+                        result.error("INGEST_ERROR", e.message, null)
+                    }
+                }
+                "stopNativeIngest" -> {
+                    try {
+                        cameraIngest?.stop()
+                        result.success(null)
+                    } catch (e: Exception) {
+                        result.error("INGEST_ERROR", e.message, null)
+                    }
+                }
+                "setIngestOrientation" -> {
+                    try {
+                        val sensorOrientation = call.argument<Int>("sensorOrientation")!!
+                        val mirror = call.argument<Boolean>("mirror") ?: false
+                        NativeImageProcessor.setIngestOrientation(sensorOrientation, mirror)
+                        result.success(null)
+                    } catch (e: Exception) {
+                        result.error("INGEST_ERROR", e.message, null)
+                    }
+                }
                 "isNeonSupported" -> {
                     try {
                         result.success(NativeImageProcessor.isNeonSupported())
@@ -69,6 +399,16 @@ class MainActivity : FlutterActivity() {
                         result.success(false)
                     }
                 }
+                "getKernelInfo" -> {
+                    try {
+                        result.success(mapOf(
+                            "kernel" to NativeImageProcessor.getKernelName(),
+                            "cpuFeatures" to NativeImageProcessor.getCpuFeatures()
+                        ))
+                    } catch (e: Exception) {
+                        result.error("KERNEL_ERROR", e.message, null)
+                    }
+                }
                 else -> {
                     result.notImplemented()
                 }
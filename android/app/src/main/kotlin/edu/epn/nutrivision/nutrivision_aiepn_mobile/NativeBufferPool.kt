@@ -0,0 +1,77 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                           NativeBufferPool.kt                                 ║
+// ║              Anillo de buffers nativos persistentes para frames               ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Envuelve el FrameBufferPool C++: los buffers se reservan una vez y solo se   ║
+// ║  realocan al cambiar resolución o formato.                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+package edu.epn.nutrivision.nutrivision_aiepn_mobile
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Pool nativo de buffers de salida con vistas ByteBuffer cacheadas.
+ *
+ * Las vistas directas de cada slot se crean una sola vez por generación del
+ * pool, así que en régimen estable no hay reservas ni en Java ni en C++.
+ *
+ * @param slotCount Número de slots del anillo
+ */
+class NativeBufferPool(slotCount: Int) {
+
+    private var handle: Long = NativeImageProcessor.createBufferPool(slotCount)
+
+    private val views = arrayOfNulls<ByteBuffer>(slotCount)
+    private var viewsGeneration = -1L
+
+    /** true si el pool nativo se creó correctamente. */
+    val isValid: Boolean
+        get() = handle != 0L
+
+    /** Handle nativo para las funciones JNI `*Pooled`. */
+    val nativeHandle: Long
+        get() = handle
+
+    /**
+     * Reserva el siguiente slot para (width, height, format).
+     *
+     * @return Índice del slot, -1 si falla
+     */
+    fun acquire(width: Int, height: Int, format: Int): Int {
+        if (handle == 0L) return -1
+        return NativeImageProcessor.acquirePoolSlot(handle, width, height, format)
+    }
+
+    /**
+     * Vista directa (orden nativo) del slot, válida hasta que el anillo lo reutilice.
+     */
+    fun buffer(slot: Int): ByteBuffer? {
+        if (handle == 0L || slot < 0 || slot >= views.size) return null
+
+        val generation = NativeImageProcessor.getPoolGeneration(handle)
+        if (generation != viewsGeneration) {
+            views.fill(null)
+            viewsGeneration = generation
+        }
+
+        val view = views[slot]
+            ?: NativeImageProcessor.getPoolBuffer(handle, slot)
+                ?.order(ByteOrder.nativeOrder())
+                ?.also { views[slot] = it }
+        view?.clear()
+        return view
+    }
+
+    /**
+     * Libera la memoria nativa. El pool no puede usarse después.
+     */
+    fun release() {
+        if (handle != 0L) {
+            NativeImageProcessor.destroyBufferPool(handle)
+            handle = 0L
+        }
+        views.fill(null)
+    }
+}
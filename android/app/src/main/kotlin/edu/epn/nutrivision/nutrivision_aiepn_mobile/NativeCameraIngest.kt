@@ -0,0 +1,208 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          NativeCameraIngest.kt                                ║
+// ║              Sesión Camera2 que alimenta la ingesta nativa                    ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Abre la cámara con Camera2 y usa como destino la Surface del AImageReader    ║
+// ║  nativo: los frames nunca pasan por ByteBuffers de Java ni por Dart.          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+package edu.epn.nutrivision.nutrivision_aiepn_mobile
+
+import android.annotation.SuppressLint
+import android.content.Context
+import android.graphics.ImageFormat
+import android.hardware.camera2.CameraCaptureSession
+import android.hardware.camera2.CameraCharacteristics
+import android.hardware.camera2.CameraDevice
+import android.hardware.camera2.CameraManager
+import android.os.Handler
+import android.os.HandlerThread
+import android.util.Log
+import android.util.Size
+import android.view.Surface
+import kotlin.math.abs
+
+/**
+ * Modo de ingesta nativa: Camera2 → AImageReader → tensor en C++.
+ *
+ * La cámara es de un solo cliente, así que Dart debe liberar su
+ * `CameraController` antes de [start]. No hay vista previa: la sesión solo
+ * tiene la Surface del lector como destino.
+ */
+class NativeCameraIngest(private val context: Context) {
+
+    companion object {
+        private const val TAG = "NativeCameraIngest"
+    }
+
+    /** Configuración efectiva de la sesión abierta. */
+    data class Config(val width: Int, val height: Int, val sensorOrientation: Int, val mirror: Boolean)
+
+    private var thread: HandlerThread? = null
+    // Se asignan en el hilo de cámara y se cierran desde el hilo principal
+    @Volatile private var device: CameraDevice? = null
+    @Volatile private var session: CameraCaptureSession? = null
+    private var surface: Surface? = null
+
+    /** true mientras hay una sesión abierta o abriéndose. */
+    val isRunning: Boolean
+        get() = thread != null
+
+    /**
+     * Abre la cámara y empieza a entregar frames a la ingesta nativa.
+     *
+     * @param front Cámara frontal (espejo) o trasera
+     * @param width Ancho deseado; se elige la salida YUV más cercana
+     * @param height Alto deseado
+     * @param targetSize Lado del tensor YOLO
+     * @param format Tipo y cuantización del tensor de entrada del modelo
+     * @param onResult Configuración elegida, o null si falla (en el hilo de cámara)
+     */
+    fun start(
+        front: Boolean,
+        width: Int,
+        height: Int,
+        targetSize: Int,
+        format: NativeImageProcessor.TensorFormat,
+        onResult: (Config?) -> Unit
+    ) {
+        stop()
+
+        val manager = context.getSystemService(Context.CAMERA_SERVICE) as CameraManager
+        val facing = if (front) CameraCharacteristics.LENS_FACING_FRONT else CameraCharacteristics.LENS_FACING_BACK
+        val cameraId = manager.cameraIdList.firstOrNull {
+            manager.getCameraCharacteristics(it).get(CameraCharacteristics.LENS_FACING) == facing
+        }
+        if (cameraId == null) {
+            onResult(null)
+            return
+        }
+
+        val characteristics = manager.getCameraCharacteristics(cameraId)
+        val orientation = characteristics.get(CameraCharacteristics.SENSOR_ORIENTATION) ?: 0
+        val size = closestYuvSize(characteristics, width, height)
+        if (size == null) {
+            onResult(null)
+            return
+        }
+
+        val readerSurface = NativeImageProcessor.startIngest(
+            size.width, size.height, 0, orientation, front, targetSize,
+            format.dataType, format.quantScale, format.zeroPoint, format.layout
+        )
+        if (readerSurface == null) {
+            onResult(null)
+            return
+        }
+        surface = readerSurface
+
+        val cameraThread = HandlerThread("NativeCameraIngest").also { it.start() }
+        thread = cameraThread
+        val handler = Handler(cameraThread.looper)
+        val config = Config(size.width, size.height, orientation, front)
+
+        // Los callbacks de error pueden llegar después de onConfigured
+        var delivered = false
+        val deliver = { result: Config? ->
+            if (!delivered) {
+                delivered = true
+                onResult(result)
+            }
+        }
+
+        try {
+            openCamera(manager, cameraId, readerSurface, handler, config, deliver)
+        } catch (e: Exception) {
+            stop()
+            throw e
+        }
+    }
+
+    @SuppressLint("MissingPermission")
+    private fun openCamera(
+        manager: CameraManager,
+        cameraId: String,
+        readerSurface: Surface,
+        handler: Handler,
+        config: Config,
+        deliver: (Config?) -> Unit
+    ) {
+        manager.openCamera(cameraId, object : CameraDevice.StateCallback() {
+            override fun onOpened(camera: CameraDevice) {
+                device = camera
+                createSession(camera, readerSurface, handler) { ok ->
+                    deliver(if (ok) config else null)
+                }
+            }
+
+            override fun onDisconnected(camera: CameraDevice) {
+                // Otra app tomó la cámara: si aún no se configuró la sesión,
+                // el resultado pendiente tiene que completarse igual
+                camera.close()
+                device = null
+                deliver(null)
+            }
+
+            override fun onError(camera: CameraDevice, error: Int) {
+                Log.e(TAG, "Error de cámara: $error")
+                camera.close()
+                device = null
+                deliver(null)
+            }
+        }, handler)
+    }
+
+    /**
+     * Cierra la sesión y la cámara y destruye la ingesta nativa.
+     */
+    fun stop() {
+        session?.close()
+        session = null
+        device?.close()
+        device = null
+
+        thread?.quitSafely()
+        thread?.join()
+        thread = null
+
+        if (surface != null) {
+            NativeImageProcessor.stopIngest()
+            surface?.release()
+            surface = null
+        }
+    }
+
+    private fun createSession(
+        camera: CameraDevice,
+        target: Surface,
+        handler: Handler,
+        onConfigured: (Boolean) -> Unit
+    ) {
+        @Suppress("DEPRECATION")
+        camera.createCaptureSession(listOf(target), object : CameraCaptureSession.StateCallback() {
+            override fun onConfigured(captureSession: CameraCaptureSession) {
+                session = captureSession
+                val request = camera.createCaptureRequest(CameraDevice.TEMPLATE_PREVIEW).apply {
+                    addTarget(target)
+                }.build()
+                captureSession.setRepeatingRequest(request, null, handler)
+                onConfigured(true)
+            }
+
+            override fun onConfigureFailed(captureSession: CameraCaptureSession) {
+                Log.e(TAG, "No se pudo configurar la sesión de captura")
+                onConfigured(false)
+            }
+        }, handler)
+    }
+
+    /**
+     * Salida YUV_420_888 de área más cercana a la pedida.
+     */
+    private fun closestYuvSize(characteristics: CameraCharacteristics, width: Int, height: Int): Size? {
+        val map = characteristics.get(CameraCharacteristics.SCALER_STREAM_CONFIGURATION_MAP)
+        val sizes = map?.getOutputSizes(ImageFormat.YUV_420_888) ?: return null
+        val area = width.toLong() * height
+        return sizes.minByOrNull { abs(it.width.toLong() * it.height - area) }
+    }
+}
@@ -8,6 +8,8 @@
 
 package edu.epn.nutrivision.nutrivision_aiepn_mobile
 
+import android.content.res.AssetManager
+import android.view.Surface
 import java.nio.ByteBuffer
 
 /**
@@ -51,6 +53,326 @@ object NativeImageProcessor {
         uvPixelStride: Int
     ): ByteArray?
 
+    /**
+     * Preprocesa un frame YUV420 directamente al tensor de entrada YOLO.
+     *
+     * Fusiona conversión, rotación, espejo, resize, letterbox y normalización
+     * en una sola pasada nativa, sin frame RGB intermedio.
+     *
+     * @param yBuffer Buffer del plano Y (luminancia)
+     * @param uBuffer Buffer del plano U (crominancia)
+     * @param vBuffer Buffer del plano V (crominancia)
+     * @param width Ancho del frame del sensor
+     * @param height Alto del frame del sensor
+     * @param yRowStride Stride del plano Y en bytes
+     * @param uvRowStride Stride del plano UV en bytes
+     * @param uvPixelStride Stride entre píxeles UV
+     * @param sensorOrientation Rotación a aplicar (0, 90, 180, 270)
+     * @param mirror Espejo horizontal (cámara frontal)
+     * @param targetSize Lado del tensor cuadrado (640)
+     * @param dataType Tipo de elemento (TENSOR_TYPE_*)
+     * @param quantScale Escala de cuantización del modelo (uint8/int8)
+     * @param zeroPoint Zero-point de cuantización del modelo (uint8/int8)
+     * @param layout Disposición del tensor (TENSOR_LAYOUT_*)
+     * @param tensorBuffer Buffer directo de salida (targetSize² × 3 elementos)
+     * @return DoubleArray [scale, padLeft, padTop, newWidth, newHeight]
+     */
+    @JvmStatic
+    external fun preprocessYuvToTensor(
+        yBuffer: ByteBuffer,
+        uBuffer: ByteBuffer,
+        vBuffer: ByteBuffer,
+        width: Int,
+        height: Int,
+        yRowStride: Int,
+        uvRowStride: Int,
+        uvPixelStride: Int,
+        sensorOrientation: Int,
+        mirror: Boolean,
+        targetSize: Int,
+        dataType: Int,
+        quantScale: Float,
+        zeroPoint: Int,
+        layout: Int,
+        tensorBuffer: ByteBuffer
+    ): DoubleArray?
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // Pool de buffers nativos
+    // ─────────────────────────────────────────────────────────────────────────
+
+    /** Formato RGB888 (3 bytes por píxel). */
+    const val BUFFER_FORMAT_RGB888 = 0
+
+    /** Formato tensor float32 (12 bytes por píxel). */
+    const val BUFFER_FORMAT_TENSOR_F32 = 1
+
+    /** Formato tensor float16 (6 bytes por píxel). */
+    const val BUFFER_FORMAT_TENSOR_F16 = 2
+
+    /** Formato tensor uint8/int8 (3 bytes por píxel). */
+    const val BUFFER_FORMAT_TENSOR_Q8 = 3
+
+    /** Tipos de elemento del tensor de entrada (TensorDataType nativo). */
+    const val TENSOR_TYPE_F32 = 0
+    const val TENSOR_TYPE_F16 = 1
+    const val TENSOR_TYPE_UINT8 = 2
+    const val TENSOR_TYPE_INT8 = 3
+
+    /** Disposiciones del tensor de entrada (TensorLayout nativo). */
+    const val TENSOR_LAYOUT_NHWC = 0
+    const val TENSOR_LAYOUT_NCHW = 1
+
+    /**
+     * Tipo, cuantización y disposición del tensor de entrada del modelo.
+     *
+     * @property quantScale Escala del tensor de entrada (solo uint8/int8)
+     * @property zeroPoint Zero-point del tensor de entrada (solo uint8/int8)
+     * @property layout NHWC intercalado o NCHW planar (TENSOR_LAYOUT_*)
+     */
+    data class TensorFormat(
+        val dataType: Int = TENSOR_TYPE_F32,
+        val quantScale: Float = 1f,
+        val zeroPoint: Int = 0,
+        val layout: Int = TENSOR_LAYOUT_NHWC
+    ) {
+        /** Bytes por elemento. */
+        val elementBytes: Int
+            get() = when (dataType) {
+                TENSOR_TYPE_F32 -> 4
+                TENSOR_TYPE_F16 -> 2
+                else -> 1
+            }
+
+        /** Formato de slot del pool para este tipo. */
+        val bufferFormat: Int
+            get() = when (dataType) {
+                TENSOR_TYPE_F32 -> BUFFER_FORMAT_TENSOR_F32
+                TENSOR_TYPE_F16 -> BUFFER_FORMAT_TENSOR_F16
+                else -> BUFFER_FORMAT_TENSOR_Q8
+            }
+    }
+
+    /**
+     * Crea un anillo de buffers nativos reutilizables (alineados a 64 bytes).
+     *
+     * @param slotCount Número de slots (1-8)
+     * @return Handle del pool, 0 si falla
+     */
+    @JvmStatic
+    external fun createBufferPool(slotCount: Int): Long
+
+    /**
+     * Destruye el pool y libera sus buffers.
+     */
+    @JvmStatic
+    external fun destroyBufferPool(handle: Long)
+
+    /**
+     * Entrega el siguiente slot del anillo para el tamaño y formato dados.
+     *
+     * @return Índice del slot, -1 si falla
+     */
+    @JvmStatic
+    external fun acquirePoolSlot(handle: Long, width: Int, height: Int, format: Int): Int
+
+    /**
+     * Envuelve un slot en un ByteBuffer directo (sin copia).
+     */
+    @JvmStatic
+    external fun getPoolBuffer(handle: Long, slot: Int): ByteBuffer?
+
+    /**
+     * Generación del pool: cambia cuando los slots se realocan.
+     */
+    @JvmStatic
+    external fun getPoolGeneration(handle: Long): Long
+
+    /**
+     * Convierte un frame YUV420 a RGB888 en el siguiente slot del pool.
+     *
+     * La rotación y el espejo se aplican en la misma pasada: con 90/270 el
+     * resultado mide height × width.
+     *
+     * @param sensorOrientation Rotación a aplicar (0, 90, 180, 270)
+     * @param mirror Espejo horizontal tras rotar (cámara frontal)
+     * @return Índice del slot con el resultado, -1 si falla
+     */
+    @JvmStatic
+    external fun convertYuvToRgbPooled(
+        handle: Long,
+        yBuffer: ByteBuffer,
+        uBuffer: ByteBuffer,
+        vBuffer: ByteBuffer,
+        width: Int,
+        height: Int,
+        yRowStride: Int,
+        uvRowStride: Int,
+        uvPixelStride: Int,
+        sensorOrientation: Int,
+        mirror: Boolean
+    ): Int
+
+    /**
+     * Convierte un frame YUV420 a RGB888 muestreando directamente a
+     * dstWidth × dstHeight (imagen ya rotada), en el siguiente slot del pool.
+     *
+     * El costo depende del tamaño de salida y no del sensor: pensado para la
+     * detección en vivo, donde el modelo solo usa 640 px del lado mayor.
+     *
+     * @param dstWidth Ancho de salida
+     * @param dstHeight Alto de salida
+     * @return Índice del slot con el resultado, -1 si falla
+     */
+    @JvmStatic
+    external fun convertYuvToRgbScaledPooled(
+        handle: Long,
+        yBuffer: ByteBuffer,
+        uBuffer: ByteBuffer,
+        vBuffer: ByteBuffer,
+        width: Int,
+        height: Int,
+        yRowStride: Int,
+        uvRowStride: Int,
+        uvPixelStride: Int,
+        sensorOrientation: Int,
+        mirror: Boolean,
+        dstWidth: Int,
+        dstHeight: Int
+    ): Int
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // Pool de hilos nativo
+    // ─────────────────────────────────────────────────────────────────────────
+
+    /**
+     * Fija los hilos que reparten la conversión y el preprocesado en bandas.
+     *
+     * @param count Hilos incluido el llamador (<= 0 restaura el valor por
+     *              defecto: núcleos grandes del SoC)
+     * @return Número de hilos efectivo
+     */
+    @JvmStatic
+    external fun setWorkerCount(count: Int): Int
+
+    /**
+     * Número de hilos actual del pool nativo.
+     */
+    @JvmStatic
+    external fun getWorkerCount(): Int
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // Backend de preprocesado
+    // ─────────────────────────────────────────────────────────────────────────
+
+    /**
+     * Elige dónde se genera el tensor YOLO.
+     *
+     * @param backend 0 CPU, 1 GPU (compute shader GLES 3.1 con respaldo CPU)
+     * @return false si el backend no existe
+     */
+    @JvmStatic
+    external fun setPreprocessBackend(backend: Int): Boolean
+
+    /**
+     * Backend que generó el último tensor: "gles31" o "cpu".
+     */
+    @JvmStatic
+    external fun getPreprocessBackendName(): String
+
+    /**
+     * Tiempos por etapa (CLOCK_MONOTONIC) y contadores nativos acumulados.
+     *
+     * @return Por etapa: llamadas, ns totales, ns de la última, ns máximo y
+     *         bytes; al final reservas y bytes reservados
+     */
+    @JvmStatic
+    external fun getNativeStats(): LongArray?
+
+    /**
+     * Pone a cero los tiempos y contadores nativos.
+     */
+    @JvmStatic
+    external fun resetNativeStats()
+
+    /**
+     * Contabilidad de memoria nativa.
+     *
+     * @return Bytes vivos, pico, reservas, liberaciones, rechazadas y
+     *         presupuesto; después, por arena, bytes vivos, pico y reservas
+     */
+    @JvmStatic
+    external fun getNativeMemoryStats(): LongArray?
+
+    /**
+     * Lleva los picos de memoria nativa a los bytes vivos actuales.
+     */
+    @JvmStatic
+    external fun resetNativeMemoryPeaks()
+
+    /**
+     * Fija el presupuesto de memoria nativa: pasado el límite el pipeline
+     * degrada a modos reducidos en vez de reservar más.
+     *
+     * @param bytes > 0 límite, 0 sin límite, < 0 valor por defecto
+     * @return Presupuesto vigente (0 = sin límite)
+     */
+    @JvmStatic
+    external fun setNativeMemoryBudget(bytes: Long): Long
+
+    /**
+     * Activa o desactiva las secciones ATrace por etapa del código nativo.
+     * Solo se emiten mientras hay una captura de Perfetto/systrace.
+     */
+    @JvmStatic
+    external fun setTraceEnabled(enabled: Boolean)
+
+    /**
+     * Estado del interruptor de trazas.
+     */
+    @JvmStatic
+    external fun isTraceEnabled(): Boolean
+
+    /**
+     * Crea la ingesta nativa: un AImageReader YUV_420_888 cuyos frames se
+     * preprocesan en C++ desde los planos bloqueados (sin pasar por Java).
+     *
+     * @param maxImages Imágenes en vuelo del lector (<= 0 usa el valor por defecto)
+     * @param sensorOrientation Rotación a aplicar (0, 90, 180, 270)
+     * @param mirror Espejo horizontal (cámara frontal)
+     * @param targetSize Lado del tensor cuadrado (640)
+     * @param dataType Tipo de elemento del tensor (TENSOR_TYPE_*)
+     * @param quantScale Escala de cuantización (uint8/int8)
+     * @param zeroPoint Zero-point de cuantización (uint8/int8)
+     * @param layout Disposición del tensor (TENSOR_LAYOUT_*)
+     * @return Surface destino para la sesión Camera2, o null si falla
+     */
+    @JvmStatic
+    external fun startIngest(
+        width: Int,
+        height: Int,
+        maxImages: Int,
+        sensorOrientation: Int,
+        mirror: Boolean,
+        targetSize: Int,
+        dataType: Int,
+        quantScale: Float,
+        zeroPoint: Int,
+        layout: Int
+    ): Surface?
+
+    /**
+     * Destruye la ingesta nativa. Llamar después de cerrar la sesión.
+     */
+    @JvmStatic
+    external fun stopIngest()
+
+    /**
+     * Cambia rotación y espejo de la ingesta activa.
+     */
+    @JvmStatic
+    external fun setIngestOrientation(sensorOrientation: Int, mirror: Boolean)
+
     /**
      * Verifica si las optimizaciones NEON están disponibles.
      *
@@ -58,4 +380,29 @@ object NativeImageProcessor {
      */
     @JvmStatic
     external fun isNeonSupported(): Boolean
+
+    /**
+     * Kernel de conversión elegido al cargar la biblioteca
+     * ("neon", "avx2", "sse4.1" o "scalar").
+     */
+    @JvmStatic
+    external fun getKernelName(): String
+
+    /**
+     * Extensiones SIMD detectadas en la CPU, separadas por espacios.
+     */
+    @JvmStatic
+    external fun getCpuFeatures(): String
+
+    /**
+     * Registra el AssetManager para que el código nativo mapee assets sin
+     * comprimir directamente desde el APK (índice nutricional vía dart:ffi).
+     *
+     * Debe llamarse antes de que Dart abra el índice; llamadas posteriores
+     * se ignoran.
+     *
+     * @param assets AssetManager del applicationContext
+     */
+    @JvmStatic
+    external fun registerAssetManager(assets: AssetManager)
 }
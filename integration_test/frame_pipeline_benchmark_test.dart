@@ -0,0 +1,354 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                    frame_pipeline_benchmark_test.dart                         ║
+// ║          Benchmark reproducible del pipeline de frames (YUV → detecciones)    ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Reproduce volcados .nvyuv por conversión, preprocesado, inferencia y         ║
+// ║  decodificación+NMS; reporta p50/p95/p99 por etapa y el RSS pico.             ║
+// ║                                                                               ║
+// ║  Ejecutar: flutter test integration_test/frame_pipeline_benchmark_test.dart   ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:integration_test/integration_test.dart';
+import 'package:path_provider/path_provider.dart';
+
+import 'package:nutrivision_aiepn_mobile/core/logging/log_config.dart';
+// ignore_for_file: avoid_print
+import 'package:nutrivision_aiepn_mobile/features/detection/services/detection_debug_helper.dart';
+import 'package:nutrivision_aiepn_mobile/features/detection/services/native_image_processor.dart';
+import 'package:nutrivision_aiepn_mobile/features/detection/services/yolo_service.dart';
+import 'package:nutrivision_aiepn_mobile/features/detection/services/yuv_frame_dump.dart';
+
+/// Pasadas completas sobre los frames (`--dart-define=NV_BENCH_PASSES=N`).
+const int _passes = int.fromEnvironment('NV_BENCH_PASSES', defaultValue: 3);
+
+/// Frames iniciales descartados (caché GPU, JIT, frecuencias de CPU).
+const int _warmupFrames = 5;
+
+/// JSON Lines de una ejecución anterior para comparar p95 por etapa.
+const String _baselinePath = String.fromEnvironment('NV_BENCH_BASELINE');
+
+/// Margen tolerado sobre el p95 de la línea base.
+const double _regressionFactor = 1.2;
+
+/// Etapas medidas, en orden del pipeline.
+const List<String> _stages = [
+  'convert',
+  'preprocess',
+  'inference',
+  'decode_nms',
+  'total',
+];
+
+void main() {
+  final binding = IntegrationTestWidgetsFlutterBinding.ensureInitialized();
+
+  late YoloDetector detector;
+  late List<YuvFrameDump> frames;
+  late String fixtureSource;
+
+  setUpAll(() async {
+    LogConfig.configureForTests();
+
+    detector = YoloDetector();
+    await detector.initialize();
+
+    final recorded = await _loadRecordedFrames();
+    if (recorded.isNotEmpty) {
+      frames = recorded;
+      fixtureSource = 'recorded';
+    } else {
+      frames = _syntheticFrames();
+      fixtureSource = 'synthetic';
+    }
+
+    print('═══════════════════════════════════════════════════════════');
+    print('Frame pipeline benchmark - ${frames.length} frames ($fixtureSource)');
+    print('GPU: ${detector.usesGpuDelegate}, passes: $_passes');
+    print('═══════════════════════════════════════════════════════════');
+  });
+
+  tearDownAll(() async {
+    detector.dispose();
+  });
+
+  testWidgets(
+    'Frame pipeline: per-stage p50/p95/p99 and peak RSS',
+    (WidgetTester tester) async {
+      expect(
+        NativeImageProcessor.isAvailable,
+        isTrue,
+        reason: 'El benchmark mide los kernels nativos: requiere Android',
+      );
+
+      final samples = {for (final stage in _stages) stage: <int>[]};
+      var processed = 0;
+
+      for (var pass = 0; pass < _passes; pass++) {
+        for (final frame in frames) {
+          final timings = await _runFrame(detector, frame);
+          if (timings == null) continue;
+
+          processed++;
+          if (processed <= _warmupFrames) continue;
+          timings.forEach((stage, micros) => samples[stage]!.add(micros));
+        }
+      }
+
+      expect(
+        samples['total']!,
+        isNotEmpty,
+        reason: 'Ningún frame completó el pipeline',
+      );
+
+      final report = <String, Object>{
+        'fixtures': fixtureSource,
+        'frames': frames.length,
+        'passes': _passes,
+        'gpu': detector.usesGpuDelegate,
+        'preprocess_backend':
+            await NativeImageProcessor.getPreprocessBackendName() ?? 'none',
+        'peak_rss_kb': ProcessInfo.maxRss ~/ 1024,
+      };
+
+      print(jsonEncode({'type': 'meta', ...report}));
+      final stats = <String, Map<String, int>>{};
+      for (final stage in _stages) {
+        stats[stage] = _summarize(samples[stage]!);
+        print(jsonEncode({'type': 'stage', 'stage': stage, ...stats[stage]!}));
+      }
+      binding.reportData = {...report, 'stages': stats};
+
+      if (_baselinePath.isNotEmpty) {
+        _expectNoRegression(stats, File(_baselinePath));
+      }
+    },
+    timeout: const Timeout(Duration(minutes: 10)),
+  );
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// EJECUCIÓN POR FRAME
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Pasa un frame por el pipeline y retorna la duración de cada etapa (µs),
+/// o `null` si algún kernel nativo no lo aceptó.
+///
+/// La conversión RGB es la ruta de respaldo de la pantalla en vivo: se mide
+/// a la resolución del letterbox, pero su salida no alimenta la inferencia.
+Future<Map<String, int>?> _runFrame(
+  YoloDetector detector,
+  YuvFrameDump frame,
+) async {
+  final transposed =
+      frame.sensorOrientation == 90 || frame.sensorOrientation == 270;
+  final rotatedWidth = transposed ? frame.height : frame.width;
+  final rotatedHeight = transposed ? frame.width : frame.height;
+  final scale = YoloDetector.inputSize /
+      (rotatedWidth > rotatedHeight ? rotatedWidth : rotatedHeight);
+
+  final stopwatch = Stopwatch()..start();
+  final rgb = await NativeImageProcessor.convertYuvToRgb(
+    yBytes: frame.yBytes,
+    uBytes: frame.uBytes,
+    vBytes: frame.vBytes,
+    width: frame.width,
+    height: frame.height,
+    yRowStride: frame.yRowStride,
+    uvRowStride: frame.uvRowStride,
+    uvPixelStride: frame.uvPixelStride,
+    sensorOrientation: frame.sensorOrientation,
+    mirror: frame.mirror,
+    targetWidth: (rotatedWidth * scale).round(),
+    targetHeight: (rotatedHeight * scale).round(),
+  );
+  final convertMicros = stopwatch.elapsedMicroseconds;
+  if (rgb == null) return null;
+
+  stopwatch
+    ..reset()
+    ..start();
+  final tensor = await NativeImageProcessor.preprocessYuvToTensor(
+    yBytes: frame.yBytes,
+    uBytes: frame.uBytes,
+    vBytes: frame.vBytes,
+    width: frame.width,
+    height: frame.height,
+    yRowStride: frame.yRowStride,
+    uvRowStride: frame.uvRowStride,
+    uvPixelStride: frame.uvPixelStride,
+    sensorOrientation: frame.sensorOrientation,
+    mirror: frame.mirror,
+    targetSize: YoloDetector.inputSize,
+    format: detector.inputFormat,
+  );
+  final preprocessMicros = stopwatch.elapsedMicroseconds;
+  if (tensor == null) return null;
+
+  stopwatch
+    ..reset()
+    ..start();
+  await detector.detectFromTensor(
+    tensorBytes: tensor.tensorBytes,
+    scale: tensor.scale,
+    padLeft: tensor.padLeft,
+    padTop: tensor.padTop,
+    newWidth: tensor.newWidth,
+    newHeight: tensor.newHeight,
+    imageWidth: tensor.imageWidth,
+    imageHeight: tensor.imageHeight,
+  );
+  final detectMicros = stopwatch.elapsedMicroseconds;
+
+  return {
+    'convert': convertMicros,
+    'preprocess': preprocessMicros,
+    'inference': detector.lastInterpreterRunMicros,
+    'decode_nms': detector.lastPostprocessMicros,
+    'total': convertMicros + preprocessMicros + detectMicros,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FIXTURES
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Frames grabados con `--dart-define=NV_RECORD_FRAMES=true` (o copiados
+/// con `adb push`) en el directorio de [DetectionDebugHelper].
+Future<List<YuvFrameDump>> _loadRecordedFrames() async {
+  final base = await getExternalStorageDirectory();
+  if (base == null) return const [];
+
+  final directory =
+      Directory('${base.path}/${DetectionDebugHelper.benchFramesDirName}');
+  if (!await directory.exists()) return const [];
+
+  final files = await directory
+      .list()
+      .where((entry) => entry is File && entry.path.endsWith('.nvyuv'))
+      .cast<File>()
+      .toList();
+  files.sort((a, b) => a.path.compareTo(b.path));
+
+  final frames = <YuvFrameDump>[];
+  for (final file in files) {
+    frames.addAll(YuvFrameDump.parseAll(await file.readAsBytes()));
+  }
+  return frames;
+}
+
+/// Frames deterministas que cubren las disposiciones de YUV_420_888 vistas
+/// en dispositivos: NV21 con relleno de fila (640x480 y 1280x720, rotados
+/// 90°) e I420 sin relleno.
+List<YuvFrameDump> _syntheticFrames() {
+  final frames = <YuvFrameDump>[];
+  for (var i = 0; i < 10; i++) {
+    frames
+      ..add(_syntheticFrame(640, 480, 704, 2, 90, seed: i))
+      ..add(_syntheticFrame(1280, 720, 1280 + 64, 2, 90, seed: i + 100))
+      ..add(_syntheticFrame(640, 480, 640, 1, 0, seed: i + 200));
+  }
+  return frames;
+}
+
+YuvFrameDump _syntheticFrame(
+  int width,
+  int height,
+  int rowStride,
+  int uvPixelStride,
+  int sensorOrientation, {
+  required int seed,
+}) {
+  final chromaWidth = (width + 1) ~/ 2;
+  final chromaHeight = (height + 1) ~/ 2;
+  final uvRowStride = uvPixelStride == 2 ? rowStride : chromaWidth;
+
+  // Gradientes con desplazamiento por frame: contenido estable entre
+  // ejecuciones pero distinto entre frames
+  final yBytes = Uint8List(rowStride * height);
+  for (var y = 0; y < height; y++) {
+    for (var x = 0; x < width; x++) {
+      yBytes[y * rowStride + x] = (x + y + seed * 7) & 0xFF;
+    }
+  }
+
+  // En NV21 cada plano de croma es la vista intercalada sin el último byte
+  final uvLength =
+      uvRowStride * (chromaHeight - 1) + (chromaWidth - 1) * uvPixelStride + 1;
+  final uBytes = Uint8List(uvLength);
+  final vBytes = Uint8List(uvLength);
+  for (var y = 0; y < chromaHeight; y++) {
+    for (var x = 0; x < chromaWidth; x++) {
+      final index = y * uvRowStride + x * uvPixelStride;
+      uBytes[index] = (128 + x - y + seed) & 0xFF;
+      vBytes[index] = (128 + y - x - seed) & 0xFF;
+    }
+  }
+
+  return YuvFrameDump(
+    width: width,
+    height: height,
+    yRowStride: rowStride,
+    uvRowStride: uvRowStride,
+    uvPixelStride: uvPixelStride,
+    sensorOrientation: sensorOrientation,
+    yBytes: yBytes,
+    uBytes: uBytes,
+    vBytes: vBytes,
+  );
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// ESTADÍSTICAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Percentiles por rango más cercano, en µs.
+Map<String, int> _summarize(List<int> samples) {
+  final sorted = [...samples]..sort();
+
+  int percentile(double p) {
+    if (sorted.isEmpty) return 0;
+    final rank = (p * sorted.length).ceil().clamp(1, sorted.length);
+    return sorted[rank - 1];
+  }
+
+  return {
+    'samples': sorted.length,
+    'p50_us': percentile(0.50),
+    'p95_us': percentile(0.95),
+    'p99_us': percentile(0.99),
+    'max_us': sorted.isEmpty ? 0 : sorted.last,
+  };
+}
+
+/// Falla si el p95 de alguna etapa supera la línea base en más de
+/// [_regressionFactor]. La línea base es la salida de una ejecución previa
+/// (las líneas `stage`).
+void _expectNoRegression(Map<String, Map<String, int>> stats, File baseline) {
+  final previous = <String, int>{};
+  for (final line in baseline.readAsLinesSync()) {
+    // Tolera el prefijo "flutter: " de la salida copiada del log
+    final start = line.indexOf('{"type":');
+    if (start < 0) continue;
+    final entry = jsonDecode(line.substring(start)) as Map<String, dynamic>;
+    if (entry['type'] != 'stage') continue;
+    previous[entry['stage'] as String] = entry['p95_us'] as int;
+  }
+
+  for (final stage in _stages) {
+    final before = previous[stage];
+    if (before == null || before == 0) continue;
+
+    final now = stats[stage]!['p95_us']!;
+    print('  $stage p95: ${before}us → ${now}us');
+    expect(
+      now,
+      lessThanOrEqualTo((before * _regressionFactor).round()),
+      reason: '$stage p95 regresó: ${before}us → ${now}us',
+    );
+  }
+}
@@ -150,6 +150,14 @@ abstract class AppConstants {
   /// OPTIMIZADO: Reducido de 150ms a 80ms para mayor responsividad
   static const int minInferenceIntervalMs = 80;
 
+  /// Puntaje de cambio de escena (niveles de luma, `nv_motion_score`) desde
+  /// el que se vuelve a inferir con el salto adaptativo activo
+  static const double sceneChangeThreshold = 6.0;
+
+  /// Tiempo máximo con la escena estática antes de refrescar las
+  /// detecciones aunque no haya cambio (ms)
+  static const int maxStaticSceneMs = 3000;
+
   /// Mostrar indicador de FPS en modo debug
   static const bool showDebugFps = true;
 
@@ -260,6 +260,22 @@ class ImageFileException extends ImageException {
   String get userMessage => 'No se pudo acceder al archivo de imagen.';
 }
 
+/// Excepción cuando un video no se puede abrir o su decodificación falla.
+class VideoDecodeException extends ImageException {
+  /// Ruta del archivo
+  final String? filePath;
+
+  const VideoDecodeException({
+    required super.message,
+    this.filePath,
+    super.originalError,
+    super.stackTrace,
+  }) : super(code: 'VIDEO_DECODE_ERROR');
+
+  @override
+  String get userMessage => 'No se pudo analizar el video.';
+}
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // EXCEPCIONES DE DETECCIÓN
 // ═══════════════════════════════════════════════════════════════════════════════
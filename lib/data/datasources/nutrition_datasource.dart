@@ -12,6 +12,7 @@ import 'package:flutter/services.dart';
 
 import '../../core/exceptions/app_exceptions.dart';
 import '../models/nutrition_data.dart';
+import 'nutrition_index_datasource.dart';
 
 /// Datasource para acceder a datos nutricionales desde assets.
 ///
@@ -64,6 +65,12 @@ class NutritionDatasource {
     }
   }
 
+  /// Abre el índice nutricional nativo compartido.
+  ///
+  /// Retorna null si FFI o el índice no están disponibles; en ese caso
+  /// el repositorio carga el JSON.
+  NutritionIndexDatasource? openIndex() => NutritionIndexDatasource.shared;
+
   /// Verifica si el archivo de datos existe.
   ///
   /// Útil para diagnóstico antes de intentar cargar.
@@ -0,0 +1,416 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                      nutrition_index_datasource.dart                          ║
+// ║          Índice nutricional binario mapeado en memoria (dart:ffi)             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Lee nutrition_index.nvni (generado en el build) directamente desde la        ║
+// ║  región mapeada por el código nativo: sin parsear JSON al arrancar y con      ║
+// ║  consulta O(1) por classId de labels.txt.                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import '../../core/logging/app_logger.dart';
+import '../../features/detection/services/native_ffi_bindings.dart';
+import '../models/nutrients_per_100g.dart';
+import '../models/nutrition_data.dart';
+import '../models/nutrition_info.dart';
+import '../models/standard_portion.dart';
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// LAYOUT (espejo de nutrition_index.h)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+final class _StringRef extends Struct {
+  @Uint32()
+  external int offset;
+
+  @Uint32()
+  external int length;
+}
+
+final class _Header extends Struct {
+  @Uint32()
+  external int magic;
+
+  @Uint32()
+  external int version;
+
+  @Uint32()
+  external int fileSize;
+
+  @Uint32()
+  external int classCount;
+
+  @Uint32()
+  external int rowsOffset;
+
+  @Uint32()
+  external int labelOrderOffset;
+
+  @Uint32()
+  external int portionCount;
+
+  @Uint32()
+  external int portionsOffset;
+
+  @Uint32()
+  external int componentCount;
+
+  @Uint32()
+  external int componentsOffset;
+
+  @Uint32()
+  external int stringsOffset;
+
+  @Uint32()
+  external int stringsSize;
+
+  external _StringRef schemaVersion;
+  external _StringRef source;
+  external _StringRef apiUrl;
+  external _StringRef generatedAt;
+}
+
+final class _Row extends Struct {
+  @Array(NutritionIndexDatasource._nutrientCount)
+  external Array<Float> nutrients;
+
+  @Float()
+  external double matchScore;
+
+  @Int32()
+  external int fdcId;
+
+  @Uint8()
+  external int kind;
+
+  @Uint8()
+  external int status;
+
+  @Uint16()
+  external int portionCount;
+
+  @Uint16()
+  external int componentCount;
+
+  @Uint16()
+  external int reserved;
+
+  @Uint32()
+  external int portionFirst;
+
+  @Uint32()
+  external int componentFirst;
+
+  external _StringRef label;
+  external _StringRef description;
+}
+
+final class _Portion extends Struct {
+  @Float()
+  external double grams;
+
+  external _StringRef name;
+  external _StringRef description;
+}
+
+final class _Component extends Struct {
+  external _StringRef label;
+
+  @Float()
+  external double percent;
+
+  @Uint32()
+  external int flags;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// DATASOURCE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Datasource de nutrición y porciones respaldado por `nv_nutrition_*`.
+///
+/// El índice se abre una vez por proceso ([shared]) y lo comparten los
+/// repositorios de nutrición y de porciones. Las consultas leen las filas de
+/// layout fijo directamente de la región mapeada; solo se crean objetos Dart
+/// para lo que se consulta.
+///
+/// Ejemplo de uso:
+/// ```dart
+/// final index = NutritionIndexDatasource.shared;
+/// final info = index?.infoAt(detection.classId);
+/// print('Calorías: ${info?.nutrients.energyKcal}');
+/// ```
+class NutritionIndexDatasource {
+  static const String _tag = 'NutritionIndex';
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // CONSTANTES
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Asset dentro del APK (assets/data/nutrition_index.nvni en pubspec).
+  static const String assetName =
+      'flutter_assets/assets/data/nutrition_index.nvni';
+
+  /// Nutrientes por fila, en el orden de [NutrientsPer100g].
+  static const int _nutrientCount = 6;
+
+  /// Tipos de fila (kNutritionKind*).
+  static const int _kindDish = 1;
+  static const int _kindMissing = 2;
+
+  /// Componente ausente en la base (kComponentFlagMissing).
+  static const int _componentFlagMissing = 1;
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // ESTADO
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final Pointer<Uint8> _strings;
+
+  /// Número de clases (filas) del índice: las de labels.txt.
+  final int classCount;
+
+  NutritionIndexDatasource._(this._ffi, this._handle, this._strings, this.classCount);
+
+  static NutritionIndexDatasource? _shared;
+  static bool _openAttempted = false;
+
+  /// Índice compartido, o `null` si FFI o el índice no están disponibles
+  /// (tests en host, build sin la tarea de Gradle): los repositorios vuelven
+  /// entonces a los JSON.
+  static NutritionIndexDatasource? get shared {
+    if (_openAttempted) return _shared;
+    _openAttempted = true;
+
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null) return null;
+
+    final name = Uint8List.fromList([...utf8.encode(assetName), 0]);
+    final handle = ffi.nutritionOpen(name.address);
+    if (handle.address == 0) {
+      AppLogger.warning('Índice nutricional no disponible, usando JSON',
+          tag: _tag);
+      return null;
+    }
+
+    final header = ffi.nutritionHeader(handle).cast<_Header>().ref;
+    _shared = NutritionIndexDatasource._(
+      ffi,
+      handle,
+      ffi.nutritionStrings(handle),
+      header.classCount,
+    );
+    AppLogger.debug(
+      'Índice nutricional mapeado: ${header.classCount} clases, '
+      '${header.portionCount} porciones, ${header.fileSize} bytes',
+      tag: _tag,
+    );
+    return _shared;
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // CONSULTAS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// classId de una etiqueta (normalizada como [NutritionData.getByLabel]),
+  /// o -1 si no existe.
+  int findClassId(String label) {
+    final bytes = utf8.encode(label.toLowerCase().trim());
+    if (bytes.isEmpty) return -1;
+    final classId = _ffi.nutritionFind(_handle, bytes.address, bytes.length);
+    return classId >= 0 ? classId : -1;
+  }
+
+  /// Etiqueta del classId, o `null` si está fuera de rango.
+  String? labelAt(int classId) {
+    final row = _row(classId);
+    return row == null ? null : _string(row.label);
+  }
+
+  /// Nutrientes por 100 g del classId (sin construir el [NutritionInfo]).
+  NutrientsPer100g? nutrientsAt(int classId) {
+    final row = _row(classId);
+    if (row == null || row.kind == _kindMissing) return null;
+    return _nutrients(row);
+  }
+
+  /// Información nutricional del classId, o `null` si la clase no tiene
+  /// entrada en nutrition_fdc.json.
+  NutritionInfo? infoAt(int classId) {
+    final row = _row(classId);
+    if (row == null || row.kind == _kindMissing) return null;
+
+    final label = _string(row.label) ?? '';
+    if (row.kind == _kindDish) {
+      final components = <String, int>{};
+      final missing = <String>[];
+      for (var i = 0; i < row.componentCount; i++) {
+        final component = _ffi
+            .nutritionComponent(_handle, row.componentFirst + i)
+            .cast<_Component>()
+            .ref;
+        final name = _string(component.label) ?? '';
+        if (!component.percent.isNaN) {
+          components[name] = component.percent.toInt();
+        }
+        if (component.flags & _componentFlagMissing != 0) missing.add(name);
+      }
+
+      return NutritionInfo(
+        label: label,
+        matchScore: row.matchScore,
+        status: NutritionStatus.found,
+        isDish: true,
+        nutrients: _nutrients(row),
+        components: components,
+        missingComponents: missing,
+      );
+    }
+
+    return NutritionInfo(
+      label: label,
+      fdcId: row.fdcId >= 0 ? row.fdcId : null,
+      fdcDescription: _string(row.description),
+      matchScore: row.matchScore,
+      status: row.status < NutritionStatus.values.length
+          ? NutritionStatus.values[row.status]
+          : NutritionStatus.notFound,
+      isDish: false,
+      nutrients: _nutrients(row),
+    );
+  }
+
+  /// Información nutricional por etiqueta (búsqueda binaria nativa).
+  NutritionInfo? infoByLabel(String label) {
+    final classId = findClassId(label);
+    return classId >= 0 ? infoAt(classId) : null;
+  }
+
+  /// Porciones estándar del classId (vacía si no tiene).
+  List<StandardPortion> portionsAt(int classId) {
+    final row = _row(classId);
+    if (row == null || row.portionCount == 0) return const [];
+
+    final label = _string(row.label) ?? '';
+    return List.generate(row.portionCount, (i) {
+      final portion =
+          _ffi.nutritionPortion(_handle, row.portionFirst + i).cast<_Portion>().ref;
+      return StandardPortion(
+        ingredientLabel: label,
+        name: _string(portion.name) ?? '',
+        grams: portion.grams,
+        description: _string(portion.description),
+      );
+    }, growable: false);
+  }
+
+  /// Porciones estándar por etiqueta (sin normalizar, como el JSON).
+  List<StandardPortion> portionsByLabel(String label) {
+    final bytes = utf8.encode(label);
+    if (bytes.isEmpty) return const [];
+    final classId = _ffi.nutritionFind(_handle, bytes.address, bytes.length);
+    return classId >= 0 ? portionsAt(classId) : const [];
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // MATERIALIZACIÓN
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Construye el [NutritionData] completo (listados y estadísticas).
+  ///
+  /// Solo para las vistas que recorren toda la base; las consultas
+  /// puntuales no lo necesitan.
+  NutritionData toNutritionData() {
+    final ingredients = <String, NutritionInfo>{};
+    final dishes = <String, NutritionInfo>{};
+    var totalScore = 0.0;
+    var found = 0;
+    var notFound = 0;
+
+    for (var classId = 0; classId < classCount; classId++) {
+      final info = infoAt(classId);
+      if (info == null) continue;
+      if (info.isDish) {
+        dishes[info.label] = info;
+        continue;
+      }
+      ingredients[info.label] = info;
+      totalScore += info.matchScore;
+      if (info.status == NutritionStatus.found) found++;
+      if (info.status == NutritionStatus.notFound) notFound++;
+    }
+
+    final header = _header;
+    return NutritionData(
+      metadata: NutritionMetadata(
+        version: _string(header.schemaVersion) ?? '1.0',
+        generated: DateTime.tryParse(_string(header.generatedAt) ?? '') ??
+            DateTime.now(),
+        source: _string(header.source) ?? 'Unknown',
+        apiUrl: _string(header.apiUrl),
+        numIngredients: ingredients.length,
+        numDishes: dishes.length,
+        numTotal: ingredients.length + dishes.length,
+        nutrientsIncluded: const [
+          'energy_kcal',
+          'protein_g',
+          'fat_g',
+          'carbohydrates_g',
+          'fiber_g',
+          'sugars_g',
+        ],
+        avgMatchScore:
+            ingredients.isNotEmpty ? totalScore / ingredients.length : 0,
+        ingredientsFound: found,
+        ingredientsNotFound: notFound,
+      ),
+      ingredients: ingredients,
+      dishes: dishes,
+    );
+  }
+
+  /// Mapa etiqueta → porciones, con el formato de [PortionDatasource].
+  Map<String, List<StandardPortion>> toPortionMap() {
+    final result = <String, List<StandardPortion>>{};
+    for (var classId = 0; classId < classCount; classId++) {
+      final portions = portionsAt(classId);
+      if (portions.isNotEmpty) {
+        result[portions.first.ingredientLabel] = portions;
+      }
+    }
+    return result;
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // MÉTODOS PRIVADOS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  _Header get _header => _ffi.nutritionHeader(_handle).cast<_Header>().ref;
+
+  _Row? _row(int classId) {
+    final pointer = _ffi.nutritionRow(_handle, classId);
+    return pointer.address == 0 ? null : pointer.cast<_Row>().ref;
+  }
+
+  NutrientsPer100g _nutrients(_Row row) {
+    final values = row.nutrients;
+    return NutrientsPer100g(
+      energyKcal: values[0],
+      proteinG: values[1],
+      fatG: values[2],
+      carbohydratesG: values[3],
+      fiberG: values[4],
+      sugarsG: values[5],
+    );
+  }
+
+  String? _string(_StringRef ref) {
+    if (ref.length == 0) return null;
+    return utf8.decode((_strings + ref.offset).asTypedList(ref.length));
+  }
+}
@@ -12,6 +12,7 @@ import 'package:flutter/services.dart';
 
 import '../../core/exceptions/app_exceptions.dart';
 import '../models/standard_portion.dart';
+import 'nutrition_index_datasource.dart';
 
 /// Datasource para acceder a porciones estándar desde assets.
 ///
@@ -76,6 +77,12 @@ class PortionDatasource {
     }
   }
 
+  /// Abre el índice nutricional nativo compartido.
+  ///
+  /// Retorna null si FFI o el índice no están disponibles; en ese caso
+  /// el repositorio carga el JSON.
+  NutritionIndexDatasource? openIndex() => NutritionIndexDatasource.shared;
+
   /// Verifica si el archivo de datos existe.
   ///
   /// Útil para diagnóstico antes de intentar cargar.
@@ -13,6 +13,7 @@ import 'package:flutter/foundation.dart';
 ///
 /// Permite ajustar parametros de rendimiento en tiempo real:
 /// - Frame skip: cuantos frames saltar entre inferencias
+/// - Salto adaptativo: no inferir mientras la escena no cambia
 /// - Resolucion: calidad de la camara
 /// - Umbral de confianza: filtrado de detecciones
 /// - Opciones de visualizacion (FPS, memoria)
@@ -35,6 +36,14 @@ class CameraSettings {
   /// - 5: Maximo rendimiento, menor precision
   final int frameSkip;
 
+  /// Saltar la inferencia mientras la escena no cambia.
+  ///
+  /// Compara una miniatura de luma del frame con la del ultimo frame
+  /// inferido (nativo, FFI) y conserva las detecciones anteriores si el
+  /// plato esta quieto. [frameSkip] sigue limitando la frecuencia cuando hay
+  /// movimiento.
+  final bool adaptiveSkip;
+
   /// Resolucion de la camara.
   ///
   /// Afecta tanto la calidad de imagen como el rendimiento.
@@ -94,6 +103,9 @@ class CameraSettings {
   /// frameSkip=4 → Procesar 1 de cada 4 frames (~7.5 FPS @ 30fps cámara)
   static const int defaultFrameSkip = 4;
 
+  /// Salto adaptativo activo por defecto (sin FFI no tiene efecto).
+  static const bool defaultAdaptiveSkip = true;
+
   /// Resolucion por defecto para tiempo real.
   /// Medium resolution (720x480) ofrece mejor balance detección/rendimiento.
   /// LOW (352x288) es demasiado baja para detectar ingredientes correctamente.
@@ -122,6 +134,7 @@ class CameraSettings {
   /// Todos los parametros son validados automaticamente.
   const CameraSettings({
     this.frameSkip = defaultFrameSkip,
+    this.adaptiveSkip = defaultAdaptiveSkip,
     this.resolution = defaultResolution,
     this.confidenceThreshold = defaultConfidenceThreshold,
     this.iouThreshold = defaultIouThreshold,
@@ -176,6 +189,7 @@ class CameraSettings {
   factory CameraSettings.fromJson(Map<String, dynamic> json) {
     return CameraSettings(
       frameSkip: (json['frameSkip'] as int?) ?? defaultFrameSkip,
+      adaptiveSkip: json['adaptiveSkip'] as bool? ?? defaultAdaptiveSkip,
       resolution: CameraResolution.fromString(
         json['resolution'] as String? ?? defaultResolution.name,
       ),
@@ -195,6 +209,7 @@ class CameraSettings {
   /// Crea una copia con valores modificados.
   CameraSettings copyWith({
     int? frameSkip,
+    bool? adaptiveSkip,
     CameraResolution? resolution,
     double? confidenceThreshold,
     double? iouThreshold,
@@ -203,6 +218,7 @@ class CameraSettings {
   }) {
     return CameraSettings(
       frameSkip: frameSkip ?? this.frameSkip,
+      adaptiveSkip: adaptiveSkip ?? this.adaptiveSkip,
       resolution: resolution ?? this.resolution,
       confidenceThreshold: confidenceThreshold ?? this.confidenceThreshold,
       iouThreshold: iouThreshold ?? this.iouThreshold,
@@ -215,6 +231,7 @@ class CameraSettings {
   Map<String, dynamic> toJson() {
     return {
       'frameSkip': frameSkip,
+      'adaptiveSkip': adaptiveSkip,
       'resolution': resolution.name,
       'confidenceThreshold': confidenceThreshold,
       'iouThreshold': iouThreshold,
@@ -229,6 +246,7 @@ class CameraSettings {
   CameraSettings validated() {
     return CameraSettings(
       frameSkip: frameSkip.clamp(minFrameSkip, maxFrameSkip),
+      adaptiveSkip: adaptiveSkip,
       resolution: resolution,
       confidenceThreshold:
           confidenceThreshold.clamp(minConfidence, maxConfidence),
@@ -241,6 +259,7 @@ class CameraSettings {
   /// Verifica si la configuracion actual es la por defecto.
   bool get isDefault =>
       frameSkip == defaultFrameSkip &&
+      adaptiveSkip == defaultAdaptiveSkip &&
       resolution == defaultResolution &&
       confidenceThreshold == defaultConfidenceThreshold &&
       iouThreshold == defaultIouThreshold &&
@@ -251,6 +270,7 @@ class CameraSettings {
   String toString() {
     return 'CameraSettings('
         'frameSkip: $frameSkip, '
+        'adaptiveSkip: $adaptiveSkip, '
         'resolution: ${resolution.displayName}, '
         'confidence: ${(confidenceThreshold * 100).toInt()}%, '
         'iou: ${(iouThreshold * 100).toInt()}%, '
@@ -264,6 +284,7 @@ class CameraSettings {
     if (identical(this, other)) return true;
     return other is CameraSettings &&
         other.frameSkip == frameSkip &&
+        other.adaptiveSkip == adaptiveSkip &&
         other.resolution == resolution &&
         other.confidenceThreshold == confidenceThreshold &&
         other.iouThreshold == iouThreshold &&
@@ -274,6 +295,7 @@ class CameraSettings {
   @override
   int get hashCode => Object.hash(
         frameSkip,
+        adaptiveSkip,
         resolution,
         confidenceThreshold,
         iouThreshold,
@@ -15,6 +15,10 @@ import 'package:flutter/foundation.dart';
 /// - Preprocesamiento (resize + letterbox + normalización)
 /// - Inferencia TFLite (interpreter.run)
 /// - Postprocesamiento (parsing + NMS)
+///
+/// Opcionalmente incluye el desglose de etapas del código nativo
+/// ([nativeStats]), medido con CLOCK_MONOTONIC dentro de la biblioteca y
+/// libre del costo de Platform Channels o FFI.
 @immutable
 class PerformanceMetrics {
   /// Número de frame/inferencia.
@@ -41,6 +45,10 @@ class PerformanceMetrics {
   /// Timestamp de la medición.
   final DateTime timestamp;
 
+  /// Etapas nativas del intervalo medido (diferencia entre snapshots), o
+  /// `null` si el procesador nativo no está disponible.
+  final NativeStatsSnapshot? nativeStats;
+
   const PerformanceMetrics({
     required this.frameNumber,
     required this.totalMs,
@@ -50,6 +58,7 @@ class PerformanceMetrics {
     required this.postprocessMs,
     required this.detectionCount,
     required this.timestamp,
+    this.nativeStats,
   });
 
   // ═══════════════════════════════════════════════════════════════════════════
@@ -101,6 +110,7 @@ class PerformanceMetrics {
     int? postprocessMs,
     int? detectionCount,
     DateTime? timestamp,
+    NativeStatsSnapshot? nativeStats,
   }) {
     return PerformanceMetrics(
       frameNumber: frameNumber ?? this.frameNumber,
@@ -111,6 +121,7 @@ class PerformanceMetrics {
       postprocessMs: postprocessMs ?? this.postprocessMs,
       detectionCount: detectionCount ?? this.detectionCount,
       timestamp: timestamp ?? this.timestamp,
+      nativeStats: nativeStats ?? this.nativeStats,
     );
   }
 
@@ -124,6 +135,10 @@ class PerformanceMetrics {
       'Inference: ${inferenceMs}ms (${inferencePercent.toStringAsFixed(1)}%)',
       'Postprocess: ${postprocessMs}ms (${postprocessPercent.toStringAsFixed(1)}%)',
       'Detections: $detectionCount',
+      if (nativeStats != null) ...[
+        'Native:',
+        ...nativeStats!.toLogLines().map((line) => '  $line'),
+      ],
     ];
   }
 
@@ -143,7 +158,8 @@ class PerformanceMetrics {
         other.preprocessMs == preprocessMs &&
         other.inferenceMs == inferenceMs &&
         other.postprocessMs == postprocessMs &&
-        other.detectionCount == detectionCount;
+        other.detectionCount == detectionCount &&
+        other.nativeStats == nativeStats;
   }
 
   @override
@@ -155,5 +171,360 @@ class PerformanceMetrics {
         inferenceMs,
         postprocessMs,
         detectionCount,
+        nativeStats,
+      );
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// MÉTRICAS NATIVAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Contadores de una etapa del código nativo.
+@immutable
+class NativeStageMetrics {
+  /// Ejecuciones de la etapa.
+  final int calls;
+
+  /// Tiempo acumulado (ns).
+  final int totalNs;
+
+  /// Duración de la última ejecución (ns).
+  final int lastNs;
+
+  /// Duración máxima desde la carga o el último reset (ns).
+  final int maxNs;
+
+  /// Bytes tocados acumulados (leídos + escritos).
+  final int bytes;
+
+  const NativeStageMetrics({
+    required this.calls,
+    required this.totalNs,
+    required this.lastNs,
+    required this.maxNs,
+    required this.bytes,
+  });
+
+  /// Tiempo medio por ejecución (ms).
+  double get averageMs => calls > 0 ? totalNs / calls / 1e6 : 0;
+
+  /// Tiempo máximo (ms).
+  double get maxMs => maxNs / 1e6;
+
+  /// Ancho de banda efectivo (MB/s) sobre el tiempo acumulado.
+  double get megabytesPerSecond => totalNs > 0 ? bytes * 1e3 / totalNs : 0;
+
+  /// Diferencia respecto a [previous]. [lastNs] y [maxNs] no son
+  /// acumulativos y se conservan los actuales.
+  NativeStageMetrics since(NativeStageMetrics previous) => NativeStageMetrics(
+        calls: calls - previous.calls,
+        totalNs: totalNs - previous.totalNs,
+        lastNs: lastNs,
+        maxNs: maxNs,
+        bytes: bytes - previous.bytes,
+      );
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    return other is NativeStageMetrics &&
+        other.calls == calls &&
+        other.totalNs == totalNs &&
+        other.lastNs == lastNs &&
+        other.maxNs == maxNs &&
+        other.bytes == bytes;
+  }
+
+  @override
+  int get hashCode => Object.hash(calls, totalNs, lastNs, maxNs, bytes);
+}
+
+/// Snapshot de tiempos por etapa y contadores de la biblioteca nativa
+/// (`nv_stats_snapshot` / `getNativeStats`).
+///
+/// Los valores son acumulados desde la carga de la biblioteca o el último
+/// reset; [since] obtiene los de un intervalo.
+@immutable
+class NativeStatsSnapshot {
+  /// Etapas en el orden del snapshot (enum NativeStage en native_stats.h).
+  static const List<String> stageNames = [
+    'plane_access',
+    'convert',
+    'resize',
+    'normalize',
+    'decode',
+    'nms',
+    'copy_out',
+    'image_decode',
+    'motion',
+  ];
+
+  /// Valores por etapa: llamadas, ns totales, ns última, ns máximo, bytes.
+  static const int fieldsPerStage = 5;
+
+  /// Longitud del snapshot plano (etapas + reservas + bytes reservados).
+  static const int length = 9 * fieldsPerStage + 2;
+
+  /// Contadores por nombre de etapa.
+  final Map<String, NativeStageMetrics> stages;
+
+  /// Reservas de memoria nativa.
+  final int allocationCount;
+
+  /// Bytes reservados en memoria nativa.
+  final int allocatedBytes;
+
+  const NativeStatsSnapshot({
+    required this.stages,
+    required this.allocationCount,
+    required this.allocatedBytes,
+  });
+
+  /// Construye el snapshot desde el array plano de int64 nativo.
+  ///
+  /// Lanza [ArgumentError] si [values] tiene menos de [length] elementos.
+  factory NativeStatsSnapshot.fromValues(List<int> values) {
+    if (values.length < length) {
+      throw ArgumentError.value(
+        values.length,
+        'values',
+        'Se esperaban $length valores',
+      );
+    }
+
+    final stages = <String, NativeStageMetrics>{};
+    for (var i = 0; i < stageNames.length; i++) {
+      final base = i * fieldsPerStage;
+      stages[stageNames[i]] = NativeStageMetrics(
+        calls: values[base],
+        totalNs: values[base + 1],
+        lastNs: values[base + 2],
+        maxNs: values[base + 3],
+        bytes: values[base + 4],
+      );
+    }
+
+    final globals = stageNames.length * fieldsPerStage;
+    return NativeStatsSnapshot(
+      stages: stages,
+      allocationCount: values[globals],
+      allocatedBytes: values[globals + 1],
+    );
+  }
+
+  /// Contadores de una etapa (ceros si no consta).
+  NativeStageMetrics stage(String name) =>
+      stages[name] ??
+      const NativeStageMetrics(
+        calls: 0,
+        totalNs: 0,
+        lastNs: 0,
+        maxNs: 0,
+        bytes: 0,
+      );
+
+  /// Diferencia respecto a un snapshot anterior.
+  NativeStatsSnapshot since(NativeStatsSnapshot previous) {
+    return NativeStatsSnapshot(
+      stages: {
+        for (final entry in stages.entries)
+          entry.key: entry.value.since(previous.stage(entry.key)),
+      },
+      allocationCount: allocationCount - previous.allocationCount,
+      allocatedBytes: allocatedBytes - previous.allocatedBytes,
+    );
+  }
+
+  /// Una línea por etapa ejecutada más las reservas.
+  List<String> toLogLines() {
+    return [
+      for (final entry in stages.entries)
+        if (entry.value.calls > 0)
+          '${entry.key}: ${entry.value.averageMs.toStringAsFixed(2)}ms '
+              '× ${entry.value.calls} '
+              '(max ${entry.value.maxMs.toStringAsFixed(2)}ms, '
+              '${entry.value.megabytesPerSecond.toStringAsFixed(0)} MB/s)',
+      'Allocations: $allocationCount (${(allocatedBytes / 1024).round()} KB)',
+    ];
+  }
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    return other is NativeStatsSnapshot &&
+        mapEquals(other.stages, stages) &&
+        other.allocationCount == allocationCount &&
+        other.allocatedBytes == allocatedBytes;
+  }
+
+  @override
+  int get hashCode => Object.hash(
+        Object.hashAll(stages.entries.map((e) => Object.hash(e.key, e.value))),
+        allocationCount,
+        allocatedBytes,
+      );
+}
+
+/// Bytes vivos, pico y reservas de una arena de memoria nativa.
+@immutable
+class NativeArenaMemory {
+  /// Bytes vivos.
+  final int currentBytes;
+
+  /// Máximo de bytes vivos desde la carga o el último reset de picos.
+  final int peakBytes;
+
+  /// Reservas acumuladas.
+  final int allocations;
+
+  const NativeArenaMemory({
+    required this.currentBytes,
+    required this.peakBytes,
+    required this.allocations,
+  });
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    return other is NativeArenaMemory &&
+        other.currentBytes == currentBytes &&
+        other.peakBytes == peakBytes &&
+        other.allocations == allocations;
+  }
+
+  @override
+  int get hashCode => Object.hash(currentBytes, peakBytes, allocations);
+}
+
+/// Contabilidad de memoria de la biblioteca nativa
+/// (`nv_memory_stats` / `getNativeMemoryStats`).
+///
+/// Todas las reservas nativas pasan por un allocator contabilizado por arena;
+/// con [budgetBytes] > 0 las que lo superarían fallan ([rejected]) y el
+/// pipeline degrada a modos reducidos.
+@immutable
+class NativeMemoryStats {
+  /// Arenas en el orden del snapshot (enum MemoryArena en native_memory.h).
+  static const List<String> arenaNames = [
+    'frames',
+    'tensors',
+    'decode',
+    'tracker',
+    'scratch',
+    'ffi',
+    'other',
+  ];
+
+  /// Valores globales: vivos, pico, reservas, liberaciones, rechazadas,
+  /// presupuesto.
+  static const int globalFields = 6;
+
+  /// Valores por arena: vivos, pico, reservas.
+  static const int fieldsPerArena = 3;
+
+  /// Longitud del snapshot plano.
+  static const int length = globalFields + 7 * fieldsPerArena;
+
+  /// Bytes vivos en total.
+  final int currentBytes;
+
+  /// Máximo de bytes vivos desde la carga o el último reset de picos.
+  final int peakBytes;
+
+  /// Reservas acumuladas.
+  final int allocations;
+
+  /// Liberaciones acumuladas.
+  final int frees;
+
+  /// Reservas rechazadas por el presupuesto.
+  final int rejected;
+
+  /// Presupuesto de bytes vivos (0 = sin límite).
+  final int budgetBytes;
+
+  /// Contadores por nombre de arena.
+  final Map<String, NativeArenaMemory> arenas;
+
+  const NativeMemoryStats({
+    required this.currentBytes,
+    required this.peakBytes,
+    required this.allocations,
+    required this.frees,
+    required this.rejected,
+    required this.budgetBytes,
+    required this.arenas,
+  });
+
+  /// Construye el snapshot desde el array plano de int64 nativo.
+  ///
+  /// Lanza [ArgumentError] si [values] tiene menos de [length] elementos.
+  factory NativeMemoryStats.fromValues(List<int> values) {
+    if (values.length < length) {
+      throw ArgumentError.value(
+        values.length,
+        'values',
+        'Se esperaban $length valores',
+      );
+    }
+
+    return NativeMemoryStats(
+      currentBytes: values[0],
+      peakBytes: values[1],
+      allocations: values[2],
+      frees: values[3],
+      rejected: values[4],
+      budgetBytes: values[5],
+      arenas: {
+        for (var i = 0; i < arenaNames.length; i++)
+          arenaNames[i]: NativeArenaMemory(
+            currentBytes: values[globalFields + i * fieldsPerArena],
+            peakBytes: values[globalFields + i * fieldsPerArena + 1],
+            allocations: values[globalFields + i * fieldsPerArena + 2],
+          ),
+      },
+    );
+  }
+
+  /// Fracción del presupuesto ocupada por el pico (0 sin límite).
+  double get peakBudgetRatio => budgetBytes > 0 ? peakBytes / budgetBytes : 0;
+
+  /// Una línea global más una por arena con bytes vivos o pico.
+  List<String> toLogLines() {
+    String kb(int bytes) => '${(bytes / 1024).round()} KB';
+    return [
+      'Memory: ${kb(currentBytes)} (peak ${kb(peakBytes)}'
+          '${budgetBytes > 0 ? ' / budget ${kb(budgetBytes)}' : ''}, '
+          'rejected $rejected)',
+      for (final entry in arenas.entries)
+        if (entry.value.peakBytes > 0)
+          '${entry.key}: ${kb(entry.value.currentBytes)} '
+              '(peak ${kb(entry.value.peakBytes)}, '
+              '${entry.value.allocations} allocs)',
+    ];
+  }
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    return other is NativeMemoryStats &&
+        other.currentBytes == currentBytes &&
+        other.peakBytes == peakBytes &&
+        other.allocations == allocations &&
+        other.frees == frees &&
+        other.rejected == rejected &&
+        other.budgetBytes == budgetBytes &&
+        mapEquals(other.arenas, arenas);
+  }
+
+  @override
+  int get hashCode => Object.hash(
+        currentBytes,
+        peakBytes,
+        allocations,
+        frees,
+        rejected,
+        budgetBytes,
+        Object.hashAll(arenas.entries.map((e) => Object.hash(e.key, e.value))),
       );
 }
@@ -8,6 +8,7 @@
 
 import '../../core/logging/app_logger.dart';
 import '../datasources/nutrition_datasource.dart';
+import '../datasources/nutrition_index_datasource.dart';
 import '../models/detection.dart';
 import '../models/ingredient_quantity.dart';
 import '../models/nutrition_data.dart';
@@ -37,6 +38,9 @@ class NutritionRepository {
   /// Datos cacheados (null si no han sido cargados).
   NutritionData? _cachedData;
 
+  /// Índice nativo mapeado (null sin FFI o sin índice: se usa el JSON).
+  NutritionIndexDatasource? _index;
+
   /// Indica si está inicializado.
   bool _initialized = false;
 
@@ -62,6 +66,19 @@ class NutritionRepository {
     AppLogger.debug('Inicializando NutritionRepository...',
         tag: 'NutritionRepo');
 
+    // Con el índice nativo no se parsea el JSON: las consultas leen las filas
+    // mapeadas y los listados completos se materializan solo si se piden
+    _index = _datasource.openIndex();
+    if (_index != null) {
+      _initialized = true;
+      AppLogger.info(
+        'NutritionRepository inicializado desde el índice nativo: '
+        '${_index!.classCount} clases',
+        tag: 'NutritionRepo',
+      );
+      return;
+    }
+
     _cachedData = await _datasource.loadNutritionData();
     _initialized = true;
 
@@ -92,7 +109,16 @@ class NutritionRepository {
   /// Retorna null si no se encuentra.
   Future<NutritionInfo?> getNutrition(String label) async {
     await _ensureInitialized();
-    return _cachedData?.getByLabel(label);
+    return _lookup(label);
+  }
+
+  /// Obtiene información nutricional por classId de labels.txt.
+  ///
+  /// Acceso directo a la fila del índice nativo. Retorna null si no hay
+  /// índice (el JSON no se indexa por classId): usar [getNutrition].
+  Future<NutritionInfo?> getNutritionByClassId(int classId) async {
+    await _ensureInitialized();
+    return _index?.infoAt(classId);
   }
 
   /// Obtiene información nutricional de múltiples etiquetas.
@@ -100,25 +126,36 @@ class NutritionRepository {
   /// Solo retorna las que se encontraron.
   Future<List<NutritionInfo>> getNutritionBatch(List<String> labels) async {
     await _ensureInitialized();
+    if (_index != null) {
+      return labels.map(_lookup).whereType<NutritionInfo>().toList();
+    }
     return _cachedData?.getBatch(labels) ?? [];
   }
 
   /// Obtiene información nutricional de un ingrediente específico.
   Future<NutritionInfo?> getIngredient(String label) async {
     await _ensureInitialized();
+    if (_index != null) {
+      final info = _lookup(label);
+      return info != null && !info.isDish ? info : null;
+    }
     return _cachedData?.getIngredient(label);
   }
 
   /// Obtiene información nutricional de un plato específico.
   Future<NutritionInfo?> getDish(String label) async {
     await _ensureInitialized();
+    if (_index != null) {
+      final info = _lookup(label);
+      return info != null && info.isDish ? info : null;
+    }
     return _cachedData?.getDish(label);
   }
 
   /// Verifica si existe información para una etiqueta.
   Future<bool> hasNutrition(String label) async {
     await _ensureInitialized();
-    return _cachedData?.hasLabel(label) ?? false;
+    return _lookup(label) != null;
   }
 
   // ═══════════════════════════════════════════════════════════════════════════
@@ -137,7 +174,7 @@ class NutritionRepository {
     var total = const NutrientsPer100g.zero();
 
     for (final detection in detections) {
-      final nutrition = _cachedData?.getByLabel(detection.label);
+      final nutrition = _lookupDetection(detection);
       if (nutrition != null && nutrition.hasNutritionData) {
         total = total + nutrition.nutrients;
       }
@@ -170,7 +207,7 @@ class NutritionRepository {
     var total = const NutrientsPer100g.zero();
 
     for (final quantity in quantities) {
-      final nutrition = _cachedData?.getByLabel(quantity.label);
+      final nutrition = _lookup(quantity.label);
       if (nutrition != null && nutrition.hasNutritionData) {
         // Aplicar factor de cantidad: nutrients * (grams / 100)
         final factor = quantity.grams / 100.0;
@@ -191,7 +228,7 @@ class NutritionRepository {
     await _ensureInitialized();
 
     return detections.map((detection) {
-      final nutrition = _cachedData?.getByLabel(detection.label);
+      final nutrition = _lookupDetection(detection);
       return (detection, nutrition);
     }).toList();
   }
@@ -201,7 +238,7 @@ class NutritionRepository {
     await _ensureInitialized();
 
     return detections.where((d) {
-      final nutrition = _cachedData?.getByLabel(d.label);
+      final nutrition = _lookupDetection(d);
       return nutrition != null && nutrition.hasNutritionData;
     }).length;
   }
@@ -210,23 +247,47 @@ class NutritionRepository {
   // ACCESO A DATOS
   // ═══════════════════════════════════════════════════════════════════════════
 
+  /// Datos completos; con el índice nativo se materializan al primer uso.
+  NutritionData? get _data => _cachedData ??= _index?.toNutritionData();
+
   /// Metadata de los datos cargados.
-  NutritionMetadata? get metadata => _cachedData?.metadata;
+  NutritionMetadata? get metadata => _data?.metadata;
 
   /// Todas las etiquetas disponibles.
-  List<String> get availableLabels => _cachedData?.allLabels ?? [];
+  List<String> get availableLabels => _data?.allLabels ?? [];
 
   /// Todos los ingredientes.
-  List<NutritionInfo> get allIngredients => _cachedData?.allIngredients ?? [];
+  List<NutritionInfo> get allIngredients => _data?.allIngredients ?? [];
 
   /// Todos los platos.
-  List<NutritionInfo> get allDishes => _cachedData?.allDishes ?? [];
+  List<NutritionInfo> get allDishes => _data?.allDishes ?? [];
 
   /// Estadísticas de los datos.
-  NutritionDataStats? get stats => _cachedData?.stats;
+  NutritionDataStats? get stats => _data?.stats;
 
   /// Número total de alimentos.
-  int get totalCount => _cachedData?.totalCount ?? 0;
+  int get totalCount => _data?.totalCount ?? 0;
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // MÉTODOS PRIVADOS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Busca por etiqueta en el índice nativo o en los datos del JSON.
+  NutritionInfo? _lookup(String label) {
+    final index = _index;
+    if (index != null) return index.infoByLabel(label);
+    return _cachedData?.getByLabel(label);
+  }
+
+  /// Busca la información de una detección; con el índice nativo usa su
+  /// classId directamente si coincide con la etiqueta.
+  NutritionInfo? _lookupDetection(Detection detection) {
+    final index = _index;
+    if (index != null && index.labelAt(detection.classId) == detection.label) {
+      return index.infoAt(detection.classId);
+    }
+    return _lookup(detection.label);
+  }
 
   // ═══════════════════════════════════════════════════════════════════════════
   // UTILIDADES
@@ -236,6 +297,8 @@ class NutritionRepository {
   ///
   /// Útil para liberar memoria si no se necesitan más los datos.
   void dispose() {
+    // El índice es compartido por proceso: solo se suelta la referencia
+    _index = null;
     _cachedData = null;
     _initialized = false;
     AppLogger.debug('NutritionRepository disposed', tag: 'NutritionRepo');
@@ -246,6 +309,7 @@ class NutritionRepository {
   /// Útil si el archivo JSON ha sido actualizado.
   Future<void> reload() async {
     _initialized = false;
+    _index = null;
     _cachedData = null;
     await initialize();
   }
@@ -6,6 +6,7 @@
 // ║  Cache en memoria para optimizar rendimiento.                                 ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
+import '../datasources/nutrition_index_datasource.dart';
 import '../datasources/portion_datasource.dart';
 import '../models/ingredient_quantity.dart';
 import '../models/standard_portion.dart';
@@ -36,6 +37,9 @@ class PortionRepository {
   /// Cache de porciones cargadas
   Map<String, List<StandardPortion>>? _cachedPortions;
 
+  /// Índice nativo mapeado (null sin FFI o sin índice: se usa el JSON)
+  NutritionIndexDatasource? _index;
+
   /// Indica si el repositorio ha sido inicializado
   bool _isInitialized = false;
 
@@ -59,7 +63,11 @@ class PortionRepository {
   Future<void> initialize() async {
     if (_isInitialized) return;
 
-    _cachedPortions = await _datasource.loadPortionData();
+    // Con el índice nativo las porciones se leen de la región mapeada
+    _index = _datasource.openIndex();
+    if (_index == null) {
+      _cachedPortions = await _datasource.loadPortionData();
+    }
     _isInitialized = true;
   }
 
@@ -85,32 +93,32 @@ class PortionRepository {
   /// ```
   Future<List<StandardPortion>> getPortionsForIngredient(String label) async {
     await _ensureInitialized();
-    return _cachedPortions?[label] ?? [];
+    return _portionsFor(label) ?? [];
   }
 
   /// Verifica si un ingrediente tiene porciones estándar definidas.
   Future<bool> hasPortions(String label) async {
     await _ensureInitialized();
-    final portions = _cachedPortions?[label];
+    final portions = _portionsFor(label);
     return portions != null && portions.isNotEmpty;
   }
 
   /// Obtiene el número de porciones disponibles para un ingrediente.
   Future<int> getPortionCount(String label) async {
     await _ensureInitialized();
-    return _cachedPortions?[label]?.length ?? 0;
+    return _portionsFor(label)?.length ?? 0;
   }
 
   /// Obtiene todos los ingredientes que tienen porciones definidas.
   Future<List<String>> getAvailableIngredients() async {
     await _ensureInitialized();
-    return _cachedPortions?.keys.toList() ?? [];
+    return _portions?.keys.toList() ?? [];
   }
 
   /// Obtiene el total de ingredientes con porciones.
   Future<int> getTotalIngredientsWithPortions() async {
     await _ensureInitialized();
-    return _cachedPortions?.length ?? 0;
+    return _portions?.length ?? 0;
   }
 
   // ═══════════════════════════════════════════════════════════════════════════
@@ -135,7 +143,7 @@ class PortionRepository {
   ) async {
     await _ensureInitialized();
 
-    final portions = _cachedPortions?[ingredientLabel];
+    final portions = _portionsFor(ingredientLabel);
     if (portions == null) return null;
 
     try {
@@ -155,7 +163,7 @@ class PortionRepository {
   ) async {
     await _ensureInitialized();
 
-    final portions = _cachedPortions?[ingredientLabel];
+    final portions = _portionsFor(ingredientLabel);
     if (portions == null) return null;
 
     try {
@@ -206,7 +214,8 @@ class PortionRepository {
   Future<PortionStats> getStats() async {
     await _ensureInitialized();
 
-    if (_cachedPortions == null) {
+    final cachedPortions = _portions;
+    if (cachedPortions == null) {
       return PortionStats(
         totalIngredients: 0,
         totalPortions: 0,
@@ -214,8 +223,8 @@ class PortionRepository {
       );
     }
 
-    final totalIngredients = _cachedPortions!.length;
-    final totalPortions = _cachedPortions!.values
+    final totalIngredients = cachedPortions.length;
+    final totalPortions = cachedPortions.values
         .fold<int>(0, (sum, portions) => sum + portions.length);
     final avgPortionsPerIngredient = totalIngredients > 0
         ? (totalPortions / totalIngredients).toDouble()
@@ -232,6 +241,7 @@ class PortionRepository {
   ///
   /// Útil para testing o para forzar recarga de datos.
   void reset() {
+    _index = null;
     _cachedPortions = null;
     _isInitialized = false;
   }
@@ -244,7 +254,23 @@ class PortionRepository {
   bool get isInitialized => _isInitialized;
 
   /// Total de ingredientes con porciones (solo si está inicializado).
-  int get totalIngredients => _cachedPortions?.length ?? 0;
+  int get totalIngredients => _portions?.length ?? 0;
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // MÉTODOS PRIVADOS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Mapa completo; con el índice nativo se materializa al primer uso.
+  Map<String, List<StandardPortion>>? get _portions =>
+      _cachedPortions ??= _index?.toPortionMap();
+
+  /// Porciones de un ingrediente, o null si no tiene.
+  List<StandardPortion>? _portionsFor(String label) {
+    final index = _index;
+    if (index == null) return _cachedPortions?[label];
+    final portions = index.portionsByLabel(label);
+    return portions.isEmpty ? null : portions;
+  }
 }
 
 /// Estadísticas de porciones estándar.
@@ -164,6 +164,13 @@ class CameraNotifier extends StateNotifier<CameraState> {
     );
   }
 
+  /// Actualiza las cajas predichas por el tracker entre inferencias.
+  ///
+  /// No cuenta como frame inferido ni toca la latencia.
+  void updateTrackedDetections(List<Detection> detections) {
+    state = state.copyWith(detections: detections);
+  }
+
   /// Limpia las detecciones actuales.
   void clearDetections() {
     state = state.copyWith(detections: []);
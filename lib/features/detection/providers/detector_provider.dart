@@ -8,6 +8,7 @@
 
 import 'package:flutter_riverpod/flutter_riverpod.dart';
 
+import '../services/model_warmup.dart';
 import '../services/yolo_service.dart';
 
 /// Provider que gestiona la instancia única del detector YOLO.
@@ -22,8 +23,7 @@ import '../services/yolo_service.dart';
 /// );
 /// ```
 final yoloDetectorProvider = FutureProvider<YoloDetector>((ref) async {
-  final detector = YoloDetector();
-  await detector.initialize();
+  final detector = await ModelWarmup.takeDetector();
 
   // Liberar recursos cuando el provider ya no se use
   ref.onDispose(() {
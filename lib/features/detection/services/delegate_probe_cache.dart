@@ -0,0 +1,141 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                         delegate_probe_cache.dart                             ║
+// ║          Resultado persistido del sondeo GPU → CPU del intérprete             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Guarda qué delegate funcionó por dispositivo (Build.FINGERPRINT) y modelo    ║
+// ║  (MD5 del .tflite): los arranques siguientes no reintentan el que falló.      ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:convert';
+import 'dart:io' show Platform;
+
+import 'package:device_info_plus/device_info_plus.dart';
+import 'package:flutter/services.dart' show rootBundle;
+import 'package:shared_preferences/shared_preferences.dart';
+
+import '../../../core/logging/app_logger.dart';
+
+/// Resultado del sondeo de delegates.
+enum DelegateProbeResult {
+  /// El GPU delegate superó la inferencia de prueba.
+  gpu,
+
+  /// El GPU delegate falló; se usa XNNPack.
+  cpu,
+
+  /// Sondeo GPU en curso: si persiste al arrancar, el proceso murió dentro
+  /// del driver y se trata como [cpu].
+  gpuPending,
+}
+
+/// Caché del sondeo de delegates en SharedPreferences.
+///
+/// La entrada solo vale para el mismo dispositivo y modelo: una
+/// actualización del sistema (drivers GPU) o un modelo nuevo la invalidan.
+///
+/// Ejemplo de uso:
+/// ```dart
+/// final cache = await DelegateProbeCache.open(modelMd5Path);
+/// if (cache?.result != DelegateProbeResult.cpu) { /* probar GPU */ }
+/// await cache?.save(DelegateProbeResult.gpu);
+/// ```
+class DelegateProbeCache {
+  static const String _tag = 'DelegateProbe';
+
+  /// Clave en SharedPreferences.
+  static const String _probeKey = 'yolo_delegate_probe';
+
+  final SharedPreferences _prefs;
+
+  /// Huella del dispositivo (Build.FINGERPRINT).
+  final String deviceFingerprint;
+
+  /// MD5 del modelo, también token de la caché de kernels GPU.
+  final String modelMd5;
+
+  /// Resultado guardado para este dispositivo y modelo, o `null`.
+  DelegateProbeResult? _result;
+
+  DelegateProbeCache._(
+    this._prefs,
+    this.deviceFingerprint,
+    this.modelMd5,
+    this._result,
+  );
+
+  /// Resultado guardado para este dispositivo y modelo, o `null` si no hay.
+  DelegateProbeResult? get result => _result;
+
+  /// Indica si hay que saltarse el GPU delegate.
+  bool get skipGpu =>
+      _result == DelegateProbeResult.cpu ||
+      _result == DelegateProbeResult.gpuPending;
+
+  /// Abre la caché, o retorna `null` fuera de Android o si falta el MD5.
+  ///
+  /// [md5AssetPath] es el `.md5` que acompaña al modelo (formato md5sum).
+  static Future<DelegateProbeCache?> open(String md5AssetPath) async {
+    if (!Platform.isAndroid) return null;
+
+    try {
+      final md5Text = await rootBundle.loadString(md5AssetPath);
+      final modelMd5 = md5Text.trim().split(RegExp(r'\s+')).first;
+      if (modelMd5.isEmpty) return null;
+
+      final androidInfo = await DeviceInfoPlugin().androidInfo;
+      final prefs = await SharedPreferences.getInstance();
+
+      DelegateProbeResult? result;
+      final stored = prefs.getString(_probeKey);
+      if (stored != null) {
+        final entry = json.decode(stored) as Map<String, dynamic>;
+        if (entry['device'] == androidInfo.fingerprint &&
+            entry['model'] == modelMd5) {
+          result = DelegateProbeResult.values
+              .where((value) => value.name == entry['delegate'])
+              .firstOrNull;
+        }
+      }
+
+      if (result == DelegateProbeResult.gpuPending) {
+        AppLogger.warning(
+          'El sondeo GPU anterior no terminó: se usa CPU directamente',
+          tag: _tag,
+        );
+      }
+
+      return DelegateProbeCache._(
+        prefs,
+        androidInfo.fingerprint,
+        modelMd5,
+        result,
+      );
+    } catch (e) {
+      AppLogger.warning('Caché de delegates no disponible: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Guarda el resultado (reemplaza el de otro dispositivo o modelo).
+  Future<void> save(DelegateProbeResult result) async {
+    _result = result;
+    try {
+      await _prefs.setString(
+        _probeKey,
+        json.encode({
+          'device': deviceFingerprint,
+          'model': modelMd5,
+          'delegate': result.name,
+        }),
+      );
+    } catch (e) {
+      AppLogger.warning('No se pudo guardar el sondeo: $e', tag: _tag);
+    }
+  }
+
+  /// Olvida el resultado (p. ej. para volver a probar la GPU).
+  Future<void> clear() async {
+    _result = null;
+    await _prefs.remove(_probeKey);
+  }
+}
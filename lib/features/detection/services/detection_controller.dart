@@ -5,7 +5,8 @@
 // ║  Gestiona el ciclo de vida completo de la detección YOLO:                    ║
 // ║  - Lazy loading del YoloDetector (solo al activar detección)                 ║
 // ║  - Control ON/OFF de detección                                               ║
-// ║  - Throttling de inferencias                                                 ║
+// ║  - Throttling de inferencias (frame skip + salto por escena estática)        ║
+// ║  - Seguimiento de cajas entre inferencias (tracker nativo)                   ║
 // ║  - Métricas runtime (FPS, latency, confidence)                               ║
 // ║  - Cleanup de recursos                                                       ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
@@ -19,6 +20,9 @@ import '../../../core/logging/app_logger.dart';
 import '../../../data/models/detection.dart';
 import 'yolo_service.dart';
 import 'detection_service.dart';
+import 'model_warmup.dart';
+import 'native_box_tracker.dart';
+import 'native_motion_detector.dart';
 
 /// Controlador que gestiona el ciclo de vida completo de la detección.
 ///
@@ -46,6 +50,20 @@ class DetectionController {
   int _frameCounter = 0;
   DateTime? _lastInferenceTime;
 
+  // Salto adaptativo: puntaje nativo de cambio contra el último frame
+  // inferido. Se crea en el primer frame (null sin FFI)
+  NativeMotionDetector? _motionDetector;
+  bool _motionDetectorAttempted = false;
+  int? _referenceTimestampUs; // _clock del frame de referencia
+  int _staticFramesSkipped = 0;
+
+  // Tracker de cajas: asocia cada inferencia y predice las cajas en los
+  // frames intermedios. Se crea en la primera inferencia (null sin FFI)
+  NativeBoxTracker? _boxTracker;
+  bool _boxTrackerAttempted = false;
+  final Stopwatch _clock = Stopwatch()..start();
+  List<TrackedDetection> _currentTracks = const [];
+
   // Métricas runtime
   final List<int> _recentInferenceTimes = []; // Últimos 30 tiempos
   final List<double> _recentConfidences = []; // Últimos 30 confidences
@@ -58,6 +76,7 @@ class DetectionController {
 
   // Callbacks
   Function(List<Detection>, RuntimeMetrics)? _onDetectionsUpdated;
+  Function(List<Detection>)? _onTracksUpdated;
   Function(String)? _onError;
   Function(bool)? _onInitializingChanged;
 
@@ -72,17 +91,28 @@ class DetectionController {
 
   RuntimeMetrics get currentMetrics => _calculateMetrics();
 
+  /// Frames no inferidos por escena estática en la sesión actual.
+  int get staticFramesSkipped => _staticFramesSkipped;
+
+  /// Pistas del último frame (inferido o predicho), con id estable.
+  List<TrackedDetection> get currentTracks => _currentTracks;
+
   // ═══════════════════════════════════════════════════════════════════════════
   // INICIALIZACIÓN
   // ═══════════════════════════════════════════════════════════════════════════
 
   /// Registra callbacks para comunicarse con la UI.
+  ///
+  /// [onDetectionsUpdated] se llama tras cada inferencia y [onTracksUpdated]
+  /// en los frames intermedios, con las cajas predichas por el tracker.
   void registerCallbacks({
     Function(List<Detection>, RuntimeMetrics)? onDetectionsUpdated,
+    Function(List<Detection>)? onTracksUpdated,
     Function(String)? onError,
     Function(bool)? onInitializingChanged,
   }) {
     _onDetectionsUpdated = onDetectionsUpdated;
+    _onTracksUpdated = onTracksUpdated;
     _onError = onError;
     _onInitializingChanged = onInitializingChanged;
   }
@@ -111,8 +141,8 @@ class DetectionController {
 
       AppLogger.info('Inicializando YoloDetector (lazy loading)...', tag: _tag);
 
-      _detector = YoloDetector();
-      await _detector!.initialize();
+      // Normalmente ya precargado desde el arranque (ModelWarmup)
+      _detector = await ModelWarmup.takeDetector();
 
       _frameProcessor = CameraFrameProcessor(_detector!);
 
@@ -159,6 +189,10 @@ class DetectionController {
     _sessionStartTime = DateTime.now();
     _totalFramesProcessed = 0;
     _frameCounter = 0;
+    _staticFramesSkipped = 0;
+    _lastInferenceTime = null;
+    _resetMotionReference();
+    _resetTracks();
 
     AppLogger.info('Detección en tiempo real ACTIVADA', tag: _tag);
   }
@@ -174,6 +208,7 @@ class DetectionController {
     }
 
     _isDetectionActive = false;
+    _resetTracks();
 
     // Limpiar métricas de sesión
     _recentInferenceTimes.clear();
@@ -202,6 +237,11 @@ class DetectionController {
   /// - Detección debe estar activa
   /// - No estar procesando otro frame
   /// - Throttling: frame skip + tiempo mínimo
+  /// - Salto adaptativo ([adaptiveSkip]): si la escena no cambió desde la
+  ///   última inferencia, se conservan las detecciones anteriores
+  ///
+  /// Los frames que no se infieren reciben las cajas predichas por el
+  /// tracker (vía onTracksUpdated) para que el overlay siga al objeto.
   ///
   /// Retorna `true` si el frame fue procesado.
   Future<bool> processFrame(
@@ -209,6 +249,7 @@ class DetectionController {
     required int sensorOrientation,
     required bool isFrontCamera,
     int frameSkip = 4,
+    bool adaptiveSkip = true,
     double confidenceThreshold = 0.50,
     double? iouThreshold,
   }) async {
@@ -217,8 +258,18 @@ class DetectionController {
       return false;
     }
 
-    // GUARD 2: No inferencia concurrente
+    // Cajas predichas para este frame (también mientras se infiere otro)
+    _emitPredictedTracks();
+
+    // GUARD 2: No inferencia concurrente. El frame igual se encola en la
+    // cola nativa (si existe) para convertirlo mientras termina la inferencia
     if (_isInferring || (_frameProcessor?.isBusy ?? false)) {
+      _frameProcessor?.enqueueFrame(
+        cameraImage,
+        sensorOrientation: sensorOrientation,
+        isFrontCamera: isFrontCamera,
+        timestampUs: _clock.elapsedMicroseconds,
+      );
       return false;
     }
 
@@ -238,6 +289,13 @@ class DetectionController {
       }
     }
 
+    // GUARD 5: Escena estática (las detecciones en pantalla siguen válidas)
+    final frameTimestampUs = _clock.elapsedMicroseconds;
+    if (adaptiveSkip && !_sceneChanged(cameraImage, frameTimestampUs)) {
+      _staticFramesSkipped++;
+      return false;
+    }
+
     // ══════════════════════════════════════════════════════════
     // PROCESAR FRAME
     // ══════════════════════════════════════════════════════════
@@ -252,12 +310,27 @@ class DetectionController {
         isFrontCamera: isFrontCamera,
         confidenceThreshold: confidenceThreshold,
         iouThreshold: iouThreshold,
+        timestampUs: frameTimestampUs,
       );
 
       if (result == null) {
+        // Sin detecciones nuevas: no conservar la referencia del frame fallido
+        _resetMotionReference();
+        _resetTracks();
         return false;
       }
 
+      // La referencia de movimiento y el tracker siguen al frame inferido,
+      // normalmente uno encolado durante la inferencia previa
+      final inferredTimestampUs = result.frameTimestampUs ?? frameTimestampUs;
+      if (adaptiveSkip) {
+        if (result.isSubmittedFrame) {
+          _commitMotionReference(inferredTimestampUs);
+        } else {
+          _resetMotionReference();
+        }
+      }
+
       _lastInferenceTime = DateTime.now();
       final inferenceTimeMs =
           _lastInferenceTime!.difference(inferenceStart).inMilliseconds;
@@ -270,15 +343,19 @@ class DetectionController {
       _updateMetrics(inferenceTimeMs, result.detections);
       _totalFramesProcessed++;
 
-      // Callback a la UI
+      // Callback a la UI: con tracker, las cajas filtradas del mismo instante
+      final detections =
+          _trackDetections(result.detections, inferredTimestampUs);
       final metrics = _calculateMetrics();
-      _onDetectionsUpdated?.call(result.detections, metrics);
+      _onDetectionsUpdated?.call(detections, metrics);
 
       return true;
     } catch (e, stackTrace) {
       AppLogger.error('Error procesando frame',
           tag: _tag, error: e, stackTrace: stackTrace);
 
+      _resetMotionReference();
+      _resetTracks();
       _onError?.call('Error en detección: $e');
       return false;
     } finally {
@@ -286,6 +363,99 @@ class DetectionController {
     }
   }
 
+  /// Decide si el frame difiere lo suficiente del último inferido.
+  ///
+  /// Hay cambio si el puntaje supera el umbral, no hay referencia o pasó
+  /// [AppConstants.maxStaticSceneMs] desde el frame de referencia. El frame
+  /// solo pasa a ser la referencia tras inferirlo ([_commitMotionReference]).
+  /// Sin FFI o con un plano no válido siempre retorna `true`.
+  bool _sceneChanged(CameraImage cameraImage, int timestampUs) {
+    if (!_motionDetectorAttempted) {
+      _motionDetectorAttempted = true;
+      _motionDetector = NativeMotionDetector.create();
+    }
+    final motion = _motionDetector;
+    if (motion == null || cameraImage.planes.isEmpty) return true;
+
+    final yPlane = cameraImage.planes[0];
+    final score = motion.score(
+      yBytes: yPlane.bytes,
+      width: cameraImage.width,
+      height: cameraImage.height,
+      yRowStride: yPlane.bytesPerRow,
+    );
+    if (score < 0) return true;
+
+    final reference = _referenceTimestampUs;
+    final stale = reference == null ||
+        timestampUs - reference >= AppConstants.maxStaticSceneMs * 1000;
+    return score >= AppConstants.sceneChangeThreshold || stale;
+  }
+
+  /// Fija como referencia el último frame puntuado por [_sceneChanged] (el
+  /// que se acaba de inferir).
+  void _commitMotionReference(int timestampUs) {
+    final motion = _motionDetector;
+    if (motion == null || !motion.commitReference()) return;
+    _referenceTimestampUs = timestampUs;
+  }
+
+  /// Descarta la referencia: el próximo frame siempre se infiere.
+  void _resetMotionReference() {
+    _motionDetector?.reset();
+    _referenceTimestampUs = null;
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // SEGUIMIENTO DE CAJAS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Incorpora una inferencia al tracker y retorna sus cajas filtradas.
+  ///
+  /// Sin FFI retorna [detections] sin cambios.
+  List<Detection> _trackDetections(
+    List<Detection> detections,
+    int timestampUs,
+  ) {
+    if (!_boxTrackerAttempted) {
+      _boxTrackerAttempted = true;
+      _boxTracker = NativeBoxTracker.create();
+    }
+    final tracker = _boxTracker;
+    if (tracker == null || tracker.update(detections, timestampUs) < 0) {
+      return detections;
+    }
+
+    _currentTracks = tracker.predict(
+      timestampUs,
+      imageWidth: _lastImageWidth,
+      imageHeight: _lastImageHeight,
+    );
+    return _currentTracks.map((t) => t.detection).toList(growable: false);
+  }
+
+  /// Predice las pistas para el frame actual y las envía a la UI.
+  ///
+  /// Solo notifica si hay pistas, o una última vez cuando desaparecen.
+  void _emitPredictedTracks() {
+    final tracker = _boxTracker;
+    if (tracker == null || _currentTracks.isEmpty) return;
+
+    _currentTracks = tracker.predict(
+      _clock.elapsedMicroseconds,
+      imageWidth: _lastImageWidth,
+      imageHeight: _lastImageHeight,
+    );
+    _onTracksUpdated?.call(
+      _currentTracks.map((t) => t.detection).toList(growable: false),
+    );
+  }
+
+  void _resetTracks() {
+    _boxTracker?.reset();
+    _currentTracks = const [];
+  }
+
   // ═══════════════════════════════════════════════════════════════════════════
   // MÉTRICAS RUNTIME
   // ═══════════════════════════════════════════════════════════════════════════
@@ -346,6 +516,7 @@ class DetectionController {
       maxLatencyMs: maxLatencyMs,
       avgConfidence: avgConfidence,
       totalFramesProcessed: _totalFramesProcessed,
+      staticFramesSkipped: _staticFramesSkipped,
       sessionDurationSec: sessionDurationSec,
       imageWidth: _lastImageWidth,
       imageHeight: _lastImageHeight,
@@ -357,6 +528,7 @@ class DetectionController {
     _recentInferenceTimes.clear();
     _recentConfidences.clear();
     _totalFramesProcessed = 0;
+    _staticFramesSkipped = 0;
     _sessionStartTime = DateTime.now();
     _frameCounter = 0;
   }
@@ -374,9 +546,19 @@ class DetectionController {
 
     _detector?.dispose();
     _detector = null;
+    _frameProcessor?.dispose();
     _frameProcessor = null;
+    _motionDetector?.dispose();
+    _motionDetector = null;
+    _motionDetectorAttempted = false;
+    _referenceTimestampUs = null;
+    _boxTracker?.dispose();
+    _boxTracker = null;
+    _boxTrackerAttempted = false;
+    _currentTracks = const [];
 
     _onDetectionsUpdated = null;
+    _onTracksUpdated = null;
     _onError = null;
     _onInitializingChanged = null;
 
@@ -397,6 +579,10 @@ class RuntimeMetrics {
   final int maxLatencyMs;
   final double avgConfidence;
   final int totalFramesProcessed;
+
+  /// Frames candidatos no inferidos porque la escena no cambió.
+  final int staticFramesSkipped;
+
   final int sessionDurationSec;
 
   /// Ancho de la imagen procesada (post-rotación).
@@ -412,6 +598,7 @@ class RuntimeMetrics {
     required this.maxLatencyMs,
     required this.avgConfidence,
     required this.totalFramesProcessed,
+    this.staticFramesSkipped = 0,
     required this.sessionDurationSec,
     this.imageWidth = 0,
     this.imageHeight = 0,
@@ -436,6 +623,7 @@ class RuntimeMetrics {
         'latency: ${avgLatencyMs}ms [$minLatencyMs-$maxLatencyMs], '
         'confidence: ${(avgConfidence * 100).toStringAsFixed(1)}%, '
         'frames: $totalFramesProcessed, '
+        'static: $staticFramesSkipped, '
         'duration: ${sessionDurationSec}s'
         ')';
   }
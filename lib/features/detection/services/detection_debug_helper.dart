@@ -4,14 +4,17 @@
 // ╠═══════════════════════════════════════════════════════════════════════════════╣
 // ║  Guarda imágenes debug para investigar diferencias en detección.              ║
 // ║  ACTIVAR SOLO durante debugging - desactivar en producción.                   ║
+// ║  También graba frames YUV crudos (.nvyuv) para el benchmark del pipeline.     ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
 import 'dart:io';
+import 'package:camera/camera.dart';
 import 'package:image/image.dart' as img;
 import 'package:path_provider/path_provider.dart';
 import 'package:flutter/foundation.dart';
 
 import '../../../core/logging/app_logger.dart';
+import 'yuv_frame_dump.dart';
 
 /// Helper para guardar imágenes debug durante investigación de diferencias
 /// entre detección FOTO y LIVE.
@@ -35,11 +38,25 @@ class DetectionDebugHelper {
   /// (para evitar llenar almacenamiento)
   static const int _maxImagesPerType = 5;
 
+  /// Graba frames YUV crudos: `flutter run --dart-define=NV_RECORD_FRAMES=true`
+  static const bool _recordYuvFrames = bool.fromEnvironment('NV_RECORD_FRAMES');
+
+  /// Frames por sesión de grabación (~4 s a 30 fps, ~55 MB a 720p)
+  static const int _maxRecordedFrames = 120;
+
+  /// Subdirectorio del almacenamiento externo que lee el benchmark
+  static const String benchFramesDirName = 'bench_frames';
+
   /// Contadores de imágenes guardadas
   static int _photoRgbCount = 0;
   static int _photoModelInputCount = 0;
   static int _liveRgbCount = 0;
   static int _liveModelInputCount = 0;
+  static int _recordedFrameCount = 0;
+
+  /// Archivo .nvyuv de la sesión y cola de escrituras (en orden)
+  static File? _recordFile;
+  static Future<void> _recordQueue = Future.value();
 
   /// Guarda imagen RGB post-conversión (antes de preprocesado).
   ///
@@ -131,6 +148,59 @@ class DetectionDebugHelper {
     }
   }
 
+  /// Añade un frame YUV crudo al .nvyuv de la sesión.
+  ///
+  /// Los archivos quedan en `[ExternalStorage]/bench_frames/` para copiarlos
+  /// con `adb pull` o reproducirlos con integration_test/.
+  static void recordYuvFrame(
+    CameraImage cameraImage, {
+    required int sensorOrientation,
+    bool mirror = false,
+  }) {
+    if (!_recordYuvFrames || !kDebugMode) return;
+    if (_recordedFrameCount >= _maxRecordedFrames) return;
+    _recordedFrameCount++;
+
+    // Copiar ya: el plugin reutiliza los buffers del frame
+    final bytes = YuvFrameDump.fromCameraImage(
+      cameraImage,
+      sensorOrientation: sensorOrientation,
+      mirror: mirror,
+      timestampNs: DateTime.now().microsecondsSinceEpoch * 1000,
+    ).toBytes();
+
+    _recordQueue = _recordQueue.then((_) async {
+      try {
+        final file = _recordFile ??= await _createRecordFile();
+        await file.writeAsBytes(bytes, mode: FileMode.append, flush: false);
+
+        if (_recordedFrameCount == _maxRecordedFrames) {
+          AppLogger.info(
+            '💾 Frames YUV grabados: ${file.path} ($_maxRecordedFrames)',
+            tag: _tag,
+          );
+        }
+      } catch (e, stackTrace) {
+        AppLogger.error(
+          'Error grabando frame YUV',
+          tag: _tag,
+          error: e,
+          stackTrace: stackTrace,
+        );
+      }
+    });
+  }
+
+  static Future<File> _createRecordFile() async {
+    final base = await getExternalStorageDirectory() ??
+        await getApplicationDocumentsDirectory();
+    final directory = Directory('${base.path}/$benchFramesDirName');
+    await directory.create(recursive: true);
+
+    final timestamp = DateTime.now().millisecondsSinceEpoch;
+    return File('${directory.path}/live_$timestamp.nvyuv');
+  }
+
   /// Guarda imagen en disco.
   static Future<String> _saveImage(img.Image image, String filename) async {
     // Obtener directorio de documentos
@@ -156,6 +226,8 @@ class DetectionDebugHelper {
     _photoModelInputCount = 0;
     _liveRgbCount = 0;
     _liveModelInputCount = 0;
+    _recordedFrameCount = 0;
+    _recordFile = null;
 
     AppLogger.debug('Contadores de debug reseteados', tag: _tag);
   }
@@ -6,6 +6,8 @@
 // ║  Usa código nativo C++ (si disponible) o Isolates como fallback.              ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
+import 'dart:math';
+
 import 'package:camera/camera.dart';
 import 'package:flutter/foundation.dart';
 import 'package:image/image.dart' as img;
@@ -14,14 +16,33 @@ import '../../../core/constants/app_constants.dart';
 import '../../../core/exceptions/app_exceptions.dart';
 import '../../../core/logging/app_logger.dart';
 import '../../../data/models/detection.dart';
+import '../../../data/models/performance_metrics.dart';
+import 'detection_debug_helper.dart';
 import 'image_processing_isolate.dart';
+import 'native_frame_queue.dart';
 import 'native_image_processor.dart';
 import 'yolo_service.dart';
 
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESOLUCIÓN DE CONVERSIÓN
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Resolución a la que se convierte el frame antes de la inferencia.
+enum FrameResolution {
+  /// Muestreo directo a la resolución de entrada del modelo (640 px en el
+  /// lado mayor): un frame 1920×1080 cuesta lo mismo que uno 640×360.
+  /// Modo por defecto de la detección en vivo.
+  modelInput,
+
+  /// Frame completo a la resolución del sensor (captura de foto, galería o
+  /// cuando se necesita el RGB original).
+  full,
+}
+
 /// Procesador de frames de cámara para detección en tiempo real.
 ///
 /// Maneja:
-/// - Conversión YUV420 → RGB
+/// - Preprocesado fusionado YUV420 → tensor (nativo) o conversión YUV420 → RGB
 /// - Rotación según orientación del sensor
 /// - Throttling para evitar sobrecarga
 /// - Invocación del detector YOLO
@@ -44,6 +65,14 @@ class CameraFrameProcessor {
   /// Contador de frames para throttling.
   int _frameCounter = 0;
 
+  /// Último snapshot de etapas nativas, base del desglose por intervalo.
+  NativeStatsSnapshot? _lastNativeStats;
+
+  /// Cola nativa de frames (FFI): convierte en segundo plano mientras se
+  /// infiere el frame anterior. Se crea en el primer frame.
+  NativeFrameQueue? _frameQueue;
+  bool _frameQueueAttempted = false;
+
   // ═══════════════════════════════════════════════════════════════════════════
   // CONSTRUCTOR
   // ═══════════════════════════════════════════════════════════════════════════
@@ -60,6 +89,9 @@ class CameraFrameProcessor {
   /// Número de frames procesados.
   int get processedFrames => _frameCounter;
 
+  /// Contadores de la cola nativa, o `null` si no está en uso.
+  FrameQueueStats? get frameQueueStats => _frameQueue?.stats();
+
   // ═══════════════════════════════════════════════════════════════════════════
   // PROCESAMIENTO PRINCIPAL
   // ═══════════════════════════════════════════════════════════════════════════
@@ -76,13 +108,36 @@ class CameraFrameProcessor {
   /// [isFrontCamera] - Si es la cámara frontal (para espejo)
   /// [confidenceThreshold] - Umbral mínimo de confianza para detecciones
   /// [iouThreshold] - Umbral IoU para Non-Maximum Suppression
+  /// [resolution] - Resolución de conversión (ver [FrameResolution])
+  /// [timestampUs] - Marca de tiempo del frame en el reloj del llamador; se
+  ///   devuelve en [ProcessingResult.frameTimestampUs]
   Future<ProcessingResult?> processFrame(
     CameraImage cameraImage, {
     int sensorOrientation = 90,
     bool isFrontCamera = false,
     double? confidenceThreshold,
     double? iouThreshold,
+    FrameResolution resolution = FrameResolution.modelInput,
+    int? timestampUs,
   }) async {
+    // No-op salvo con --dart-define=NV_RECORD_FRAMES=true en debug
+    DetectionDebugHelper.recordYuvFrame(
+      cameraImage,
+      sensorOrientation: sensorOrientation,
+      mirror: isFrontCamera,
+    );
+
+    // El frame se encola aunque haya otro en curso: el hilo nativo lo
+    // convierte mientras tanto y el siguiente ciclo lo encuentra listo
+    final frameId = resolution == FrameResolution.modelInput
+        ? enqueueFrame(
+            cameraImage,
+            sensorOrientation: sensorOrientation,
+            isFrontCamera: isFrontCamera,
+            timestampUs: timestampUs,
+          )
+        : -1;
+
     // SIMPLIFICADO: Solo verificar si está ocupado
     // El flag isBusy ya proporciona throttling natural
     // Los checks adicionales descartaban frames innecesariamente
@@ -92,6 +147,7 @@ class CameraFrameProcessor {
 
     _frameCounter++;
     _isProcessing = true;
+    QueuedTensor? queuedTensor;
 
     try {
       // ════════════════════════════════════════════════════════════
@@ -99,78 +155,125 @@ class CameraFrameProcessor {
       // ════════════════════════════════════════════════════════════
       final stopwatchTotal = Stopwatch()..start();
       final stopwatchConversion = Stopwatch();
+      final threshold =
+          confidenceThreshold ?? AppConstants.realtimeConfidenceThreshold;
 
-      img.Image? finalImage;
-      int outputWidth = cameraImage.width;
-      int outputHeight = cameraImage.height;
+      final int outputWidth;
+      final int outputHeight;
+      final List<Detection> detections;
 
-      // ETAPA 1: Conversión YUV→RGB
+      // ETAPA 1: YUV → tensor (fusionado nativo) o YUV → RGB (fallback)
       stopwatchConversion.start();
 
-      // Intentar conversión nativa primero (más rápida)
-      if (NativeImageProcessor.isAvailable) {
-        finalImage = await _tryNativeConversion(
+      // Intentar pipeline fusionado primero: sin frame RGB ni img.Image.
+      // Ya muestrea a la resolución del modelo, así que solo aplica a
+      // FrameResolution.modelInput.
+      NativeTensorResult? tensorResult;
+      // El tensor listo más reciente, aunque sea de un frame encolado
+      // durante la inferencia previa: así su conversión se solapó con ella.
+      // ProcessingResult informa qué frame se infirió.
+      if (frameId >= 0) {
+        queuedTensor = await _frameQueue!.waitLatest();
+        // Sin tensor a tiempo se salta el ciclo: convertir aquí de nuevo
+        // competiría con el hilo de la cola por el mismo frame
+        if (queuedTensor == null) return null;
+        tensorResult = queuedTensor.tensor;
+      }
+      if (tensorResult == null &&
+          resolution == FrameResolution.modelInput &&
+          NativeImageProcessor.isAvailable) {
+        tensorResult = await _tryNativePreprocess(
           cameraImage,
           sensorOrientation,
           isFrontCamera,
         );
       }
 
-      // Fallback a isolate si nativo no disponible/falló
-      if (finalImage == null) {
-        AppLogger.debug('Usando fallback Isolate', tag: _tag);
-        final isolateResult = await _convertWithIsolate(
+      final conversionLabel = queuedTensor != null
+          ? 'Cola→Tensor'
+          : tensorResult != null
+              ? 'YUV→Tensor'
+              : 'YUV→RGB';
+
+      if (tensorResult != null) {
+        stopwatchConversion.stop();
+        outputWidth = tensorResult.imageWidth;
+        outputHeight = tensorResult.imageHeight;
+
+        detections = await _detector.detectFromTensor(
+          tensorBytes: tensorResult.tensorBytes,
+          scale: tensorResult.scale,
+          padLeft: tensorResult.padLeft,
+          padTop: tensorResult.padTop,
+          newWidth: tensorResult.newWidth,
+          newHeight: tensorResult.newHeight,
+          imageWidth: outputWidth,
+          imageHeight: outputHeight,
+          confidenceThreshold: threshold,
+          iouThreshold: iouThreshold,
+        );
+      } else {
+        final rgbFrame = await _convertToRgb(
           cameraImage,
           sensorOrientation,
           isFrontCamera,
+          resolution,
         );
-        if (isolateResult != null) {
-          finalImage = isolateResult.image;
-          outputWidth = isolateResult.width;
-          outputHeight = isolateResult.height;
-        }
-      } else {
-        // Ajustar dimensiones según rotación (nativo exitoso)
-        if (sensorOrientation == 90 || sensorOrientation == 270) {
-          final temp = outputWidth;
-          outputWidth = outputHeight;
-          outputHeight = temp;
+        stopwatchConversion.stop();
+
+        if (rgbFrame == null) {
+          AppLogger.warning('No se pudo convertir el frame', tag: _tag);
+          return null;
         }
-      }
 
-      stopwatchConversion.stop();
+        outputWidth = rgbFrame.width;
+        outputHeight = rgbFrame.height;
 
-      if (finalImage == null) {
-        AppLogger.warning('No se pudo convertir el frame', tag: _tag);
-        return null;
+        // Ejecutar detección con pipeline unificado (LIVE)
+        detections = await _detector.detectFromSource(
+          source: DetectionSource.live,
+          image: rgbFrame.image,
+          confidenceThreshold: threshold,
+          iouThreshold: iouThreshold,
+        );
       }
 
-      // Ejecutar detección con pipeline unificado (LIVE)
-      final detections = await _detector.detectFromSource(
-        source: DetectionSource.live,
-        image: finalImage,
-        confidenceThreshold:
-            confidenceThreshold ?? AppConstants.realtimeConfidenceThreshold,
-        iouThreshold: iouThreshold,
-      );
-
       stopwatchTotal.stop();
 
       // Loggear métricas cada 10 inferencias para no saturar
       if (_frameCounter % 10 == 0) {
         final detectionLabels = detections.map((d) => d.label).join(', ');
+        final nativeStats = await _nativeStatsSinceLastLog();
+        final nativeMemory = NativeImageProcessor.isAvailable
+            ? await NativeImageProcessor.getNativeMemoryStats()
+            : null;
+        final preprocessBackend = tensorResult != null
+            ? await NativeImageProcessor.getPreprocessBackendName()
+            : null;
         AppLogger.tree(
           '📊 Frame #$_frameCounter Performance',
           [
             '📷 Input: ${cameraImage.width}x${cameraImage.height} YUV',
-            '🖼️  Output: ${outputWidth}x$outputHeight RGB',
-            '🎚️  Confidence: ${(confidenceThreshold ?? AppConstants.realtimeConfidenceThreshold).toStringAsFixed(2)}',
+            '🖼️  Output: ${outputWidth}x$outputHeight',
+            '🎚️  Confidence: ${threshold.toStringAsFixed(2)}',
             '⏱️  Total: ${stopwatchTotal.elapsedMilliseconds}ms',
-            '   ├─ YUV→RGB: ${stopwatchConversion.elapsedMilliseconds}ms',
+            '   ├─ $conversionLabel: ${stopwatchConversion.elapsedMilliseconds}ms'
+                '${preprocessBackend != null ? ' ($preprocessBackend)' : ''}',
             '   └─ Detección: ${stopwatchTotal.elapsedMilliseconds - stopwatchConversion.elapsedMilliseconds}ms',
             '📈 FPS: ${(1000 / stopwatchTotal.elapsedMilliseconds).toStringAsFixed(1)}',
             '🎯 DETECCIONES: ${detections.length}',
             if (detections.isNotEmpty) '   └─ Labels: $detectionLabels',
+            if (queuedTensor != null)
+              '📥 Cola: ${_frameQueue!.stats()} '
+                  '(latencia ${queuedTensor.latencyMs.toStringAsFixed(1)}ms)',
+            if (nativeStats != null) ...[
+              '🔧 Nativo (desde el último log):',
+              ...nativeStats.toLogLines().map((line) => '   · $line'),
+            ],
+            if (nativeMemory != null) ...[
+              '🧠 Memoria nativa:',
+              ...nativeMemory.toLogLines().map((line) => '   · $line'),
+            ],
           ],
           tag: _tag,
         );
@@ -181,6 +284,11 @@ class CameraFrameProcessor {
         inferenceTimeMs: stopwatchTotal.elapsedMilliseconds,
         imageWidth: outputWidth,
         imageHeight: outputHeight,
+        frameTimestampUs: queuedTensor != null
+            ? queuedTensor.submitTimestampUs
+            : timestampUs,
+        isSubmittedFrame:
+            queuedTensor == null || queuedTensor.frameId == frameId,
       );
     } on NutriVisionException {
       rethrow;
@@ -191,15 +299,144 @@ class CameraFrameProcessor {
         stackTrace: stackTrace,
       );
     } finally {
+      if (queuedTensor != null) _frameQueue?.release(queuedTensor);
       _isProcessing = false;
     }
   }
 
+  /// Encola un frame en la cola nativa sin esperar su conversión.
+  ///
+  /// Pensado también para frames que llegan mientras otro está en
+  /// inferencia: la cola conserva solo los más recientes. [timestampUs] se
+  /// conserva con el frame hasta entregarlo.
+  ///
+  /// Retorna el id del frame en la cola, o -1 si la cola no está disponible
+  /// (sin FFI) o el frame se descartó.
+  int enqueueFrame(
+    CameraImage cameraImage, {
+    required int sensorOrientation,
+    required bool isFrontCamera,
+    int? timestampUs,
+  }) {
+    if (cameraImage.planes.length < 3) return -1;
+
+    if (!_frameQueueAttempted) {
+      _frameQueueAttempted = true;
+      _frameQueue = NativeFrameQueue.create(
+        targetSize: YoloDetector.inputSize,
+        format: _detector.inputFormat,
+      );
+    }
+    final queue = _frameQueue;
+    if (queue == null) return -1;
+
+    final yPlane = cameraImage.planes[0];
+    final uPlane = cameraImage.planes[1];
+    final vPlane = cameraImage.planes[2];
+
+    return queue.submit(
+      yBytes: yPlane.bytes,
+      uBytes: uPlane.bytes,
+      vBytes: vPlane.bytes,
+      width: cameraImage.width,
+      height: cameraImage.height,
+      yRowStride: yPlane.bytesPerRow,
+      uvRowStride: uPlane.bytesPerRow,
+      uvPixelStride: uPlane.bytesPerPixel ?? 1,
+      sensorOrientation: sensorOrientation,
+      mirror: isFrontCamera,
+      timestampUs: timestampUs,
+    );
+  }
+
+  /// Libera la cola nativa y su hilo.
+  void dispose() {
+    _frameQueue?.dispose();
+    _frameQueue = null;
+  }
+
+  /// Etapas nativas transcurridas desde el último log (tiempos medidos en
+  /// C++, sin el costo de canal/FFI que incluye el Stopwatch de conversión).
+  Future<NativeStatsSnapshot?> _nativeStatsSinceLastLog() async {
+    if (!NativeImageProcessor.isAvailable) return null;
+
+    final current = await NativeImageProcessor.getNativeStats();
+    if (current == null) return null;
+
+    final previous = _lastNativeStats;
+    _lastNativeStats = current;
+    return previous != null ? current.since(previous) : current;
+  }
+
+  /// Intenta el preprocesado fusionado YUV → tensor en C++.
+  Future<NativeTensorResult?> _tryNativePreprocess(
+    CameraImage cameraImage,
+    int sensorOrientation,
+    bool isFrontCamera,
+  ) async {
+    try {
+      if (cameraImage.planes.length < 3) return null;
+
+      final yPlane = cameraImage.planes[0];
+      final uPlane = cameraImage.planes[1];
+      final vPlane = cameraImage.planes[2];
+
+      return await NativeImageProcessor.preprocessYuvToTensor(
+        yBytes: yPlane.bytes,
+        uBytes: uPlane.bytes,
+        vBytes: vPlane.bytes,
+        width: cameraImage.width,
+        height: cameraImage.height,
+        yRowStride: yPlane.bytesPerRow,
+        uvRowStride: uPlane.bytesPerRow,
+        uvPixelStride: uPlane.bytesPerPixel ?? 1,
+        sensorOrientation: sensorOrientation,
+        mirror: isFrontCamera,
+        targetSize: YoloDetector.inputSize,
+        format: _detector.inputFormat,
+      );
+    } catch (e) {
+      AppLogger.warning('Error en preprocesado nativo: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Convierte el frame a RGB rotado: nativo primero, isolate como fallback.
+  ///
+  /// Con [FrameResolution.modelInput] el kernel nativo muestrea directamente
+  /// al tamaño del letterbox; el fallback en isolate siempre convierte el
+  /// frame completo.
+  Future<_RgbFrame?> _convertToRgb(
+    CameraImage cameraImage,
+    int sensorOrientation,
+    bool isFrontCamera,
+    FrameResolution resolution,
+  ) async {
+    if (NativeImageProcessor.isAvailable) {
+      final image = await _tryNativeConversion(
+        cameraImage,
+        sensorOrientation,
+        isFrontCamera,
+        resolution,
+      );
+      if (image != null) {
+        return _RgbFrame(image: image, width: image.width, height: image.height);
+      }
+    }
+
+    AppLogger.debug('Usando fallback Isolate', tag: _tag);
+    return _convertWithIsolate(cameraImage, sensorOrientation, isFrontCamera);
+  }
+
   /// Intenta conversión usando código nativo C++.
+  ///
+  /// La rotación y el espejo se hacen dentro del kernel nativo: la imagen
+  /// devuelta ya está en la orientación final, sin pasadas extra en Dart.
   Future<img.Image?> _tryNativeConversion(
     CameraImage cameraImage,
     int sensorOrientation,
     bool isFrontCamera,
+    FrameResolution resolution,
   ) async {
     try {
       if (cameraImage.planes.length < 3) return null;
@@ -208,6 +445,13 @@ class CameraFrameProcessor {
       final uPlane = cameraImage.planes[1];
       final vPlane = cameraImage.planes[2];
 
+      final transposed = sensorOrientation == 90 || sensorOrientation == 270;
+      final rotatedWidth = transposed ? cameraImage.height : cameraImage.width;
+      final rotatedHeight = transposed ? cameraImage.width : cameraImage.height;
+      final target = resolution == FrameResolution.modelInput
+          ? _modelInputSize(rotatedWidth, rotatedHeight)
+          : null;
+
       // OPTIMIZACIÓN: Evitar copias innecesarias, pasar bytes directamente
       final rgbBytes = await NativeImageProcessor.convertYuvToRgb(
         yBytes: yPlane.bytes,
@@ -218,45 +462,47 @@ class CameraFrameProcessor {
         yRowStride: yPlane.bytesPerRow,
         uvRowStride: uPlane.bytesPerRow,
         uvPixelStride: uPlane.bytesPerPixel ?? 1,
+        sensorOrientation: sensorOrientation,
+        mirror: isFrontCamera,
+        targetWidth: target?.width,
+        targetHeight: target?.height,
       );
 
       if (rgbBytes == null) return null;
 
-      // Crear imagen desde bytes RGB
-      final image = img.Image.fromBytes(
-        width: cameraImage.width,
-        height: cameraImage.height,
+      // Crear imagen desde bytes RGB (ya rotados y espejados)
+      return img.Image.fromBytes(
+        width: target?.width ?? rotatedWidth,
+        height: target?.height ?? rotatedHeight,
         bytes: rgbBytes.buffer,
         format: img.Format.uint8,
         numChannels: 3,
       );
-
-      // Rotar según orientación
-      img.Image rotatedImage;
-      switch (sensorOrientation) {
-        case 90:
-          rotatedImage = img.copyRotate(image, angle: 90);
-          break;
-        case 180:
-          rotatedImage = img.copyRotate(image, angle: 180);
-          break;
-        case 270:
-          rotatedImage = img.copyRotate(image, angle: 270);
-          break;
-        default:
-          rotatedImage = image;
-      }
-
-      // Espejo para cámara frontal
-      return isFrontCamera ? img.flipHorizontal(rotatedImage) : rotatedImage;
     } catch (e) {
       AppLogger.warning('Error en conversión nativa: $e', tag: _tag);
       return null;
     }
   }
 
+  /// Tamaño del letterbox de YOLO para una imagen rotada, o `null` si no
+  /// hay reducción (el frame ya cabe en la entrada del modelo).
+  ///
+  /// Mismo redondeo que `YoloDetector._preprocess`, de modo que allí el
+  /// resize queda como una copia del mismo tamaño.
+  ({int width, int height})? _modelInputSize(int width, int height) {
+    final scale = min(
+      YoloDetector.inputSize / width,
+      YoloDetector.inputSize / height,
+    );
+    if (scale >= 1.0) return null;
+    return (
+      width: (width * scale).round(),
+      height: (height * scale).round(),
+    );
+  }
+
   /// Convierte usando isolate (fallback).
-  Future<_IsolateResult?> _convertWithIsolate(
+  Future<_RgbFrame?> _convertWithIsolate(
     CameraImage cameraImage,
     int sensorOrientation,
     bool isFrontCamera,
@@ -290,7 +536,7 @@ class CameraFrameProcessor {
       numChannels: 3,
     );
 
-    return _IsolateResult(
+    return _RgbFrame(
       image: image,
       width: conversionResult.width,
       height: conversionResult.height,
@@ -360,11 +606,21 @@ class ProcessingResult {
   /// Alto de la imagen procesada.
   final int imageHeight;
 
+  /// Marca de tiempo del frame inferido (la pasada al encolarlo), o `null`
+  /// si el llamador no la indicó.
+  final int? frameTimestampUs;
+
+  /// false si se infirió otro frame de la cola (normalmente uno encolado y
+  /// convertido durante la inferencia previa) en vez del pedido.
+  final bool isSubmittedFrame;
+
   const ProcessingResult({
     required this.detections,
     required this.inferenceTimeMs,
     required this.imageWidth,
     required this.imageHeight,
+    this.frameTimestampUs,
+    this.isSubmittedFrame = true,
   });
 
   /// Número de detecciones.
@@ -378,13 +634,13 @@ class ProcessingResult {
       'ProcessingResult(detections: $count, time: ${inferenceTimeMs}ms, fps: ${estimatedFps.toStringAsFixed(1)})';
 }
 
-/// Resultado interno de conversión en isolate.
-class _IsolateResult {
+/// Frame RGB rotado resultante de la conversión (nativa o en isolate).
+class _RgbFrame {
   final img.Image image;
   final int width;
   final int height;
 
-  const _IsolateResult({
+  const _RgbFrame({
     required this.image,
     required this.width,
     required this.height,
@@ -0,0 +1,96 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                             model_warmup.dart                                 ║
+// ║          Carga del modelo en segundo plano desde el arranque                  ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Crear el intérprete, sondear delegates e inferir la prueba tarda segundos:   ║
+// ║  se programa tras el primer frame para que la pantalla en vivo encuentre el   ║
+// ║  detector ya listo en vez de esperarlo al activar la detección.               ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'package:flutter/scheduler.dart';
+
+import '../../../core/logging/app_logger.dart';
+import 'yolo_service.dart';
+
+/// Planificador del calentamiento del [YoloDetector].
+///
+/// [schedule] arranca la inicialización tras el primer frame de la app y
+/// [takeDetector] entrega ese detector al primer consumidor (que pasa a ser
+/// su dueño y lo libera). Los siguientes reciben uno nuevo, que igualmente
+/// aprovecha el sondeo y la caché GPU que dejó el primero.
+///
+/// Ejemplo de uso:
+/// ```dart
+/// runApp(const NutriVisionApp());
+/// ModelWarmup.schedule();
+///
+/// // Al activar la detección
+/// final detector = await ModelWarmup.takeDetector();
+/// ```
+class ModelWarmup {
+  static const String _tag = 'ModelWarmup';
+
+  ModelWarmup._();
+
+  /// Inicialización en curso o terminada, pendiente de entregar.
+  static Future<YoloDetector?>? _pending;
+
+  /// true cuando el detector calentado ya se entregó (o se pidió antes).
+  static bool _claimed = false;
+
+  /// Programa el calentamiento tras el primer frame. Idempotente.
+  static void schedule() {
+    if (_pending != null || _claimed) return;
+
+    SchedulerBinding.instance.addPostFrameCallback((_) {
+      if (_pending != null || _claimed) return;
+      _pending = _warmUp();
+    });
+  }
+
+  /// Entrega el detector calentado (esperando a que termine) o, si ya se
+  /// entregó o falló, uno nuevo inicializado.
+  ///
+  /// Throws las mismas excepciones que [YoloDetector.initialize].
+  static Future<YoloDetector> takeDetector() async {
+    final pending = _pending;
+    _pending = null;
+    _claimed = true;
+
+    if (pending != null) {
+      final detector = await pending;
+      if (detector != null) {
+        AppLogger.debug('Detector precargado entregado', tag: _tag);
+        return detector;
+      }
+    }
+
+    final detector = YoloDetector();
+    try {
+      await detector.initialize();
+    } catch (_) {
+      detector.dispose();
+      rethrow;
+    }
+    return detector;
+  }
+
+  static Future<YoloDetector?> _warmUp() async {
+    final stopwatch = Stopwatch()..start();
+    final detector = YoloDetector();
+    try {
+      await detector.initialize();
+      AppLogger.info(
+        'Modelo precargado en ${stopwatch.elapsedMilliseconds} ms '
+        '(GPU: ${detector.usesGpuDelegate})',
+        tag: _tag,
+      );
+      return detector;
+    } catch (e) {
+      // El consumidor reintenta y recibe el error
+      AppLogger.warning('Precarga del modelo falló: $e', tag: _tag);
+      detector.dispose();
+      return null;
+    }
+  }
+}
@@ -0,0 +1,151 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          native_box_tracker.dart                              ║
+// ║          Tracker nativo de cajas (IoU + Kalman) entre inferencias             ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  El modelo corre cada pocos frames; el tracker predice las cajas en cada      ║
+// ║  frame de cámara y mantiene ids estables para que el overlay no parpadee.     ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+
+import 'package:flutter/foundation.dart';
+
+import '../../../data/models/detection.dart';
+import 'native_ffi_bindings.dart';
+
+/// Detección con el id de su pista.
+@immutable
+class TrackedDetection {
+  /// Id estable mientras el objeto se siga asociando entre inferencias.
+  final int trackId;
+
+  /// Caja predicha para el instante pedido, en coordenadas de la imagen.
+  final Detection detection;
+
+  const TrackedDetection({required this.trackId, required this.detection});
+}
+
+/// Tracker multi-objeto respaldado por `nv_tracker_*`.
+///
+/// [update] recibe las detecciones de cada inferencia (empaquetadas como la
+/// salida de `nv_decode_yolo_output`) y [predict] extrapola las pistas a
+/// cualquier instante sin modificarlas, para dibujarlas en cada frame.
+///
+/// Los instantes son microsegundos de un mismo reloj monótono (por ejemplo
+/// un [Stopwatch]). Solo disponible con FFI.
+class NativeBoxTracker {
+  /// Pistas máximas simultáneas (BoxTracker::kMaxTracks).
+  static const int maxTracks = 128;
+
+  /// Detecciones máximas por actualización (YoloDetector.maxDetections).
+  static const int maxDetections = 300;
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final Float32List _detections =
+      Float32List(maxDetections * NativeFfiBindings.detectionStride);
+  final Float32List _tracks =
+      Float32List(maxTracks * NativeFfiBindings.trackStride);
+
+  /// Etiqueta de cada clase vista (la salida nativa solo trae el classId).
+  final Map<int, String> _labels = {};
+
+  bool _disposed = false;
+
+  NativeBoxTracker._(this._ffi, this._handle);
+
+  /// Crea el tracker, o retorna `null` si FFI no está disponible.
+  ///
+  /// [iouThreshold] es el IoU mínimo entre la caja predicha y la detección
+  /// para asociarlas; [maxMisses] las inferencias sin asociar antes de
+  /// eliminar una pista.
+  static NativeBoxTracker? create({
+    double iouThreshold = 0.3,
+    int maxMisses = 3,
+  }) {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null) return null;
+
+    final handle = ffi.trackerCreate(iouThreshold, maxMisses);
+    if (handle.address == 0) return null;
+    return NativeBoxTracker._(ffi, handle);
+  }
+
+  /// Asocia las detecciones de una inferencia con las pistas.
+  ///
+  /// [timestampUs] es el instante del frame inferido. Retorna las pistas
+  /// visibles, o -1 si el tracker ya se liberó.
+  int update(List<Detection> detections, int timestampUs) {
+    if (_disposed) return -1;
+
+    final count = detections.length < maxDetections
+        ? detections.length
+        : maxDetections;
+    for (var i = 0; i < count; i++) {
+      final detection = detections[i];
+      final offset = i * NativeFfiBindings.detectionStride;
+      _detections[offset] = detection.x1;
+      _detections[offset + 1] = detection.y1;
+      _detections[offset + 2] = detection.x2;
+      _detections[offset + 3] = detection.y2;
+      _detections[offset + 4] = detection.confidence;
+      _detections[offset + 5] = detection.classId.toDouble();
+      _labels[detection.classId] = detection.label;
+    }
+
+    return _ffi.trackerUpdate(
+      _handle,
+      _detections.address,
+      count,
+      timestampUs * 1000,
+    );
+  }
+
+  /// Pistas visibles extrapoladas a [timestampUs], recortadas a la imagen.
+  List<TrackedDetection> predict(
+    int timestampUs, {
+    required int imageWidth,
+    required int imageHeight,
+  }) {
+    if (_disposed) return const [];
+
+    final count = _ffi.trackerPredict(
+      _handle,
+      timestampUs * 1000,
+      _tracks.address,
+      maxTracks,
+    );
+
+    final tracks = <TrackedDetection>[];
+    for (var i = 0; i < count; i++) {
+      final offset = i * NativeFfiBindings.trackStride;
+      final classId = _tracks[offset + 5].toInt();
+      tracks.add(TrackedDetection(
+        trackId: _tracks[offset + 6].toInt(),
+        detection: Detection.fromModelOutput(
+          x1: _tracks[offset],
+          y1: _tracks[offset + 1],
+          x2: _tracks[offset + 2],
+          y2: _tracks[offset + 3],
+          confidence: _tracks[offset + 4],
+          classId: classId,
+          label: _labels[classId] ?? '',
+          imageWidth: imageWidth,
+          imageHeight: imageHeight,
+        ),
+      ));
+    }
+    return tracks;
+  }
+
+  /// Elimina todas las pistas (cambio de cámara, detección detenida).
+  void reset() {
+    if (!_disposed) _ffi.trackerReset(_handle);
+  }
+
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _ffi.trackerDestroy(_handle);
+  }
+}
@@ -0,0 +1,174 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                         native_camera_ingest.dart                             ║
+// ║          Modo de ingesta nativa: Camera2 → AImageReader → tensor C++          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Los frames no pasan por el plugin camera ni por Dart: solo se leen los       ║
+// ║  tensores ya preprocesados desde la cola nativa de la ingesta.                ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+
+import 'package:flutter/services.dart';
+
+import '../../../core/logging/app_logger.dart';
+import 'native_ffi_bindings.dart';
+import 'native_frame_queue.dart';
+import 'native_image_processor.dart';
+
+/// Configuración efectiva de la sesión de ingesta.
+class NativeIngestConfig {
+  /// Resolución YUV elegida por Camera2 (la más cercana a la pedida).
+  final int width;
+  final int height;
+
+  /// Rotación aplicada a cada frame.
+  final int sensorOrientation;
+
+  /// Espejo horizontal (cámara frontal).
+  final bool mirror;
+
+  const NativeIngestConfig({
+    required this.width,
+    required this.height,
+    required this.sensorOrientation,
+    required this.mirror,
+  });
+}
+
+/// Ingesta de cámara sin copias por frame hacia Dart.
+///
+/// Kotlin abre la cámara con Camera2 y le da la Surface de un `AImageReader`
+/// nativo; cada `AImage` se preprocesa en C++ desde sus planos bloqueados y
+/// el tensor queda en [queue]. Se elimina la copia de planos que hace el
+/// plugin `camera` en cada frame.
+///
+/// La cámara admite un solo cliente: liberar el `CameraController` antes de
+/// [start]. La sesión no tiene vista previa.
+class NativeCameraIngest {
+  static const String _tag = 'NativeCameraIngest';
+
+  static const _channel =
+      MethodChannel('edu.epn.nutrivision/native_image_processor');
+
+  /// Referencia nativa (nv_ingest_acquire): mantiene viva la cola de
+  /// [_queue] aunque Kotlin detenga o reinicie la ingesta.
+  Pointer<Void>? _ingest;
+  NativeFrameQueue? _queue;
+  NativeIngestConfig? _config;
+
+  /// Cola con los tensores listos, o `null` si la ingesta no está activa.
+  NativeFrameQueue? get queue => _queue;
+
+  /// Configuración de la sesión activa.
+  NativeIngestConfig? get config => _config;
+
+  bool get isRunning => _queue != null;
+
+  /// Imágenes recibidas por el lector nativo (incluidas las descartadas).
+  int get receivedFrames {
+    final ingest = _ingest;
+    if (ingest == null) return -1;
+    return NativeFfiBindings.instance?.ingestReceivedFrames(ingest) ?? -1;
+  }
+
+  /// Abre la cámara en modo de ingesta nativa.
+  ///
+  /// Retorna `false` si FFI no está disponible o la sesión no se pudo abrir.
+  /// [format] es el tipo del tensor de entrada del modelo.
+  Future<bool> start({
+    required int targetSize,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+    bool front = false,
+    int width = 1280,
+    int height = 720,
+  }) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null) return false;
+
+    await stop();
+
+    try {
+      final result = await _channel.invokeMapMethod<String, dynamic>(
+        'startNativeIngest',
+        {
+          'front': front,
+          'width': width,
+          'height': height,
+          'targetSize': targetSize,
+          'tensorType': format.type.index,
+          'quantScale': format.scale,
+          'zeroPoint': format.zeroPoint,
+          'tensorLayout': format.layout.index,
+        },
+      );
+      if (result == null) return false;
+
+      final ingest = ffi.ingestAcquire();
+      final queue = ingest.address == 0
+          ? null
+          : NativeFrameQueue.borrow(
+              ffi,
+              ffi.ingestQueue(ingest),
+              targetSize: targetSize,
+              format: format,
+            );
+      if (queue == null) {
+        if (ingest.address != 0) ffi.ingestRelease(ingest);
+        await _channel.invokeMethod<void>('stopNativeIngest');
+        return false;
+      }
+
+      _ingest = ingest;
+      _queue = queue;
+      _config = NativeIngestConfig(
+        width: result['width'] as int,
+        height: result['height'] as int,
+        sensorOrientation: result['sensorOrientation'] as int,
+        mirror: result['mirror'] as bool,
+      );
+      AppLogger.info(
+        'Ingesta nativa ${_config!.width}x${_config!.height} '
+        '(${_config!.sensorOrientation}°)',
+        tag: _tag,
+      );
+      return true;
+    } on PlatformException catch (e) {
+      AppLogger.warning('Error iniciando ingesta nativa: ${e.message}',
+          tag: _tag);
+      return false;
+    } on MissingPluginException {
+      return false;
+    }
+  }
+
+  /// Cambia rotación y espejo (p. ej. al girar el dispositivo).
+  Future<void> setOrientation(int sensorOrientation, bool mirror) async {
+    if (!isRunning) return;
+    await _channel.invokeMethod<void>('setIngestOrientation', {
+      'sensorOrientation': sensorOrientation,
+      'mirror': mirror,
+    });
+  }
+
+  /// Cierra la sesión. Los tensores entregados por [queue] dejan de ser
+  /// válidos: liberar (release) antes de llamar.
+  Future<void> stop() async {
+    final queue = _queue;
+    final ingest = _ingest;
+    if (queue == null || ingest == null) return;
+
+    // Dart suelta la cola antes de que Kotlin la pueda destruir
+    _queue = null;
+    _ingest = null;
+    _config = null;
+    queue.dispose();
+    NativeFfiBindings.instance?.ingestRelease(ingest);
+
+    try {
+      await _channel.invokeMethod<void>('stopNativeIngest');
+    } on PlatformException catch (e) {
+      AppLogger.warning('Error deteniendo ingesta nativa: ${e.message}',
+          tag: _tag);
+    }
+  }
+}
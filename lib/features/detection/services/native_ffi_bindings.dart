@@ -0,0 +1,1115 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                         native_ffi_bindings.dart                              ║
+// ║              Bindings dart:ffi para libnutrivision_native.so                  ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Acceso directo a los kernels C++ sin MethodChannel ni JNI.                   ║
+// ║  Los planos de cámara se pasan como punteros en llamadas leaf (zero-copy).    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+import 'dart:io' show Platform;
+
+import '../../../core/logging/app_logger.dart';
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FIRMAS NATIVAS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+typedef _AllocNative = Pointer<Void> Function(IntPtr bytes);
+typedef _AllocDart = Pointer<Void> Function(int bytes);
+
+typedef _FreeNative = Void Function(Pointer<Void> ptr);
+typedef _FreeDart = void Function(Pointer<Void> ptr);
+
+typedef _PoolCreateNative = Pointer<Void> Function(Int32 slotCount);
+typedef _PoolCreateDart = Pointer<Void> Function(int slotCount);
+
+typedef _PoolAcquireNative = Int32 Function(
+  Pointer<Void> pool,
+  Int32 width,
+  Int32 height,
+  Int32 format,
+);
+typedef _PoolAcquireDart = int Function(
+  Pointer<Void> pool,
+  int width,
+  int height,
+  int format,
+);
+
+typedef _PoolSlotDataNative = Pointer<Uint8> Function(
+  Pointer<Void> pool,
+  Int32 slot,
+);
+typedef _PoolSlotDataDart = Pointer<Uint8> Function(
+  Pointer<Void> pool,
+  int slot,
+);
+
+typedef _PoolSlotBytesNative = IntPtr Function(Pointer<Void> pool);
+typedef _PoolSlotBytesDart = int Function(Pointer<Void> pool);
+
+typedef _PoolGenerationNative = Int64 Function(Pointer<Void> pool);
+typedef _PoolGenerationDart = int Function(Pointer<Void> pool);
+
+typedef _ConvertNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+);
+typedef _ConvertDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+);
+
+typedef _ConvertScaledNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+  Int32 dstWidth,
+  Int32 dstHeight,
+);
+typedef _ConvertScaledDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+  int dstWidth,
+  int dstHeight,
+);
+
+typedef _PreprocessNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+  Int32 targetSize,
+  Pointer<Float> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+typedef _PreprocessDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+  int targetSize,
+  Pointer<Float> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+
+typedef _PreprocessTypedNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+  Int32 targetSize,
+  Int32 dataType,
+  Float quantScale,
+  Int32 zeroPoint,
+  Int32 layout,
+  Pointer<Void> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+typedef _PreprocessTypedDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+  int targetSize,
+  int dataType,
+  double quantScale,
+  int zeroPoint,
+  int layout,
+  Pointer<Void> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+
+typedef _ConvertRoiNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+  Int32 cropX,
+  Int32 cropY,
+  Int32 cropWidth,
+  Int32 cropHeight,
+  Int32 dstWidth,
+  Int32 dstHeight,
+);
+typedef _ConvertRoiDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Pointer<Uint8> rgbOut,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+  int cropX,
+  int cropY,
+  int cropWidth,
+  int cropHeight,
+  int dstWidth,
+  int dstHeight,
+);
+
+typedef _PreprocessRoiNative = Int32 Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+  Int32 cropX,
+  Int32 cropY,
+  Int32 cropWidth,
+  Int32 cropHeight,
+  Int32 targetSize,
+  Int32 dataType,
+  Float quantScale,
+  Int32 zeroPoint,
+  Int32 layout,
+  Pointer<Void> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+typedef _PreprocessRoiDart = int Function(
+  Pointer<Uint8> yPlane,
+  Pointer<Uint8> uPlane,
+  Pointer<Uint8> vPlane,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+  int cropX,
+  int cropY,
+  int cropWidth,
+  int cropHeight,
+  int targetSize,
+  int dataType,
+  double quantScale,
+  int zeroPoint,
+  int layout,
+  Pointer<Void> tensorOut,
+  Pointer<Double> letterboxOut,
+);
+
+typedef _DecodeYoloNative = Int32 Function(
+  Pointer<Float> output,
+  Int32 numClasses,
+  Int32 numPredictions,
+  Int32 inputSize,
+  Float confidenceThreshold,
+  Float iouThreshold,
+  Double scale,
+  Int32 padLeft,
+  Int32 padTop,
+  Int32 imageWidth,
+  Int32 imageHeight,
+  Pointer<Float> detectionsOut,
+  Int32 maxDetections,
+);
+typedef _DecodeYoloDart = int Function(
+  Pointer<Float> output,
+  int numClasses,
+  int numPredictions,
+  int inputSize,
+  double confidenceThreshold,
+  double iouThreshold,
+  double scale,
+  int padLeft,
+  int padTop,
+  int imageWidth,
+  int imageHeight,
+  Pointer<Float> detectionsOut,
+  int maxDetections,
+);
+
+typedef _FrameQueueCreateNative = Pointer<Void> Function(
+  Int32 slotCount,
+  Int32 targetSize,
+  Int32 dataType,
+  Float quantScale,
+  Int32 zeroPoint,
+  Int32 layout,
+);
+typedef _FrameQueueCreateDart = Pointer<Void> Function(
+  int slotCount,
+  int targetSize,
+  int dataType,
+  double quantScale,
+  int zeroPoint,
+  int layout,
+);
+
+typedef _FrameQueueSubmitNative = Int64 Function(
+  Pointer<Void> queue,
+  Pointer<Uint8> yPlane,
+  IntPtr yLength,
+  Pointer<Uint8> uPlane,
+  IntPtr uLength,
+  Pointer<Uint8> vPlane,
+  IntPtr vLength,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+  Int32 uvRowStride,
+  Int32 uvPixelStride,
+  Int32 sensorOrientation,
+  Bool mirror,
+);
+typedef _FrameQueueSubmitDart = int Function(
+  Pointer<Void> queue,
+  Pointer<Uint8> yPlane,
+  int yLength,
+  Pointer<Uint8> uPlane,
+  int uLength,
+  Pointer<Uint8> vPlane,
+  int vLength,
+  int width,
+  int height,
+  int yRowStride,
+  int uvRowStride,
+  int uvPixelStride,
+  int sensorOrientation,
+  bool mirror,
+);
+
+typedef _FrameQueueAcquireNative = Int32 Function(
+  Pointer<Void> queue,
+  Pointer<Double> infoOut,
+);
+typedef _FrameQueueAcquireDart = int Function(
+  Pointer<Void> queue,
+  Pointer<Double> infoOut,
+);
+
+typedef _FrameQueueTensorNative = Pointer<Void> Function(
+  Pointer<Void> queue,
+  Int32 slot,
+);
+typedef _FrameQueueTensorDart = Pointer<Void> Function(
+  Pointer<Void> queue,
+  int slot,
+);
+
+typedef _FrameQueueReleaseNative = Int32 Function(
+  Pointer<Void> queue,
+  Int32 slot,
+);
+typedef _FrameQueueReleaseDart = int Function(Pointer<Void> queue, int slot);
+
+typedef _FrameQueueStatsNative = Int32 Function(
+  Pointer<Void> queue,
+  Pointer<Int64> out,
+  Int32 capacity,
+);
+typedef _FrameQueueStatsDart = int Function(
+  Pointer<Void> queue,
+  Pointer<Int64> out,
+  int capacity,
+);
+
+typedef _StillBatchAddEncodedNative = Int32 Function(
+  Pointer<Void> batch,
+  Pointer<Uint8> data,
+  IntPtr length,
+);
+typedef _StillBatchAddEncodedDart = int Function(
+  Pointer<Void> batch,
+  Pointer<Uint8> data,
+  int length,
+);
+
+typedef _StillBatchAddPixelsNative = Int32 Function(
+  Pointer<Void> batch,
+  Pointer<Uint8> pixels,
+  Int32 width,
+  Int32 height,
+  Int32 rowStride,
+  Int32 pixelFormat,
+);
+typedef _StillBatchAddPixelsDart = int Function(
+  Pointer<Void> batch,
+  Pointer<Uint8> pixels,
+  int width,
+  int height,
+  int rowStride,
+  int pixelFormat,
+);
+
+typedef _StillBatchPollNative = Int32 Function(
+  Pointer<Void> batch,
+  Int32 index,
+  Pointer<Double> infoOut,
+);
+typedef _StillBatchPollDart = int Function(
+  Pointer<Void> batch,
+  int index,
+  Pointer<Double> infoOut,
+);
+
+typedef _VideoOpenNative = Pointer<Void> Function(
+  Pointer<Uint8> path,
+  Int32 sampleEvery,
+  Int32 queueDepth,
+  Int32 targetSize,
+  Int32 dataType,
+  Float quantScale,
+  Int32 zeroPoint,
+  Int32 layout,
+);
+typedef _VideoOpenDart = Pointer<Void> Function(
+  Pointer<Uint8> path,
+  int sampleEvery,
+  int queueDepth,
+  int targetSize,
+  int dataType,
+  double quantScale,
+  int zeroPoint,
+  int layout,
+);
+
+typedef _MotionScoreNative = Float Function(
+  Pointer<Void> motion,
+  Pointer<Uint8> yPlane,
+  IntPtr yLength,
+  Int32 width,
+  Int32 height,
+  Int32 yRowStride,
+);
+typedef _MotionScoreDart = double Function(
+  Pointer<Void> motion,
+  Pointer<Uint8> yPlane,
+  int yLength,
+  int width,
+  int height,
+  int yRowStride,
+);
+
+typedef _TrackerCreateNative = Pointer<Void> Function(
+  Float iouThreshold,
+  Int32 maxMisses,
+);
+typedef _TrackerCreateDart = Pointer<Void> Function(
+  double iouThreshold,
+  int maxMisses,
+);
+
+typedef _TrackerUpdateNative = Int32 Function(
+  Pointer<Void> tracker,
+  Pointer<Float> detections,
+  Int32 count,
+  Int64 timestampNs,
+);
+typedef _TrackerUpdateDart = int Function(
+  Pointer<Void> tracker,
+  Pointer<Float> detections,
+  int count,
+  int timestampNs,
+);
+
+typedef _TrackerPredictNative = Int32 Function(
+  Pointer<Void> tracker,
+  Int64 timestampNs,
+  Pointer<Float> tracksOut,
+  Int32 maxTracks,
+);
+typedef _TrackerPredictDart = int Function(
+  Pointer<Void> tracker,
+  int timestampNs,
+  Pointer<Float> tracksOut,
+  int maxTracks,
+);
+
+typedef _NutritionOpenNative = Pointer<Void> Function(Pointer<Uint8> name);
+typedef _NutritionOpenDart = Pointer<Void> Function(Pointer<Uint8> name);
+
+typedef _NutritionHeaderNative = Pointer<Void> Function(Pointer<Void> index);
+typedef _NutritionHeaderDart = Pointer<Void> Function(Pointer<Void> index);
+
+typedef _NutritionRecordNative = Pointer<Void> Function(
+  Pointer<Void> index,
+  Int32 position,
+);
+typedef _NutritionRecordDart = Pointer<Void> Function(
+  Pointer<Void> index,
+  int position,
+);
+
+typedef _NutritionStringsNative = Pointer<Uint8> Function(Pointer<Void> index);
+typedef _NutritionStringsDart = Pointer<Uint8> Function(Pointer<Void> index);
+
+typedef _NutritionFindNative = Int32 Function(
+  Pointer<Void> index,
+  Pointer<Uint8> label,
+  Int32 length,
+);
+typedef _NutritionFindDart = int Function(
+  Pointer<Void> index,
+  Pointer<Uint8> label,
+  int length,
+);
+
+typedef _GpuDelegateCreateNative = Pointer<Void> Function(
+  Pointer<Uint8> serializationDir,
+  Pointer<Uint8> modelToken,
+  Int32 precisionLossAllowed,
+);
+typedef _GpuDelegateCreateDart = Pointer<Void> Function(
+  Pointer<Uint8> serializationDir,
+  Pointer<Uint8> modelToken,
+  int precisionLossAllowed,
+);
+
+typedef _GpuDelegateGetNative = Pointer<Void> Function(Pointer<Void> handle);
+typedef _GpuDelegateGetDart = Pointer<Void> Function(Pointer<Void> handle);
+
+typedef _HandleCommandNative = Int32 Function(Pointer<Void> handle);
+typedef _HandleCommandDart = int Function(Pointer<Void> handle);
+
+typedef _HandleQueryNative = Pointer<Void> Function();
+typedef _HandleQueryDart = Pointer<Void> Function();
+
+typedef _IngestQueueNative = Pointer<Void> Function(Pointer<Void> ingest);
+typedef _IngestQueueDart = Pointer<Void> Function(Pointer<Void> ingest);
+
+typedef _IngestReceivedFramesNative = Int64 Function(Pointer<Void> ingest);
+typedef _IngestReceivedFramesDart = int Function(Pointer<Void> ingest);
+
+typedef _Int64SetterNative = Int64 Function(Int64 value);
+typedef _Int64SetterDart = int Function(int value);
+
+typedef _IntQueryNative = Int32 Function();
+typedef _IntQueryDart = int Function();
+
+typedef _IntSetterNative = Int32 Function(Int32 value);
+typedef _IntSetterDart = int Function(int value);
+
+typedef _StringQueryNative = Pointer<Uint8> Function();
+typedef _StringQueryDart = Pointer<Uint8> Function();
+
+typedef _MaskQueryNative = Uint32 Function();
+
+typedef _StatsSnapshotNative = Int32 Function(Pointer<Int64> out, Int32 capacity);
+typedef _StatsSnapshotDart = int Function(Pointer<Int64> out, int capacity);
+
+typedef _VoidQueryNative = Void Function();
+typedef _VoidQueryDart = void Function();
+
+typedef _VoidSetterNative = Void Function(Int32 value);
+typedef _VoidSetterDart = void Function(int value);
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// BINDINGS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Bindings FFI a la biblioteca nativa de procesamiento de imágenes.
+///
+/// Las funciones de conversión se declaran `isLeaf: true`, lo que permite
+/// pasar `Uint8List.address` de los planos de `CameraImage` sin copiarlos a
+/// memoria nativa. Las llamadas leaf bloquean el isolate mientras duran, por
+/// lo que solo se exponen kernels acotados (milisegundos).
+class NativeFfiBindings {
+  static const String _tag = 'NativeFfi';
+  static const String _libraryName = 'libnutrivision_native.so';
+
+  /// Código de retorno de éxito de la API `nv_*`.
+  static const int ok = 0;
+
+  /// Floats por detección de `nv_decode_yolo_output`
+  /// (x1, y1, x2, y2, score, classId).
+  static const int detectionStride = 6;
+
+  /// Floats por pista de `nv_tracker_predict`
+  /// (x1, y1, x2, y2, score, classId, trackId).
+  static const int trackStride = 7;
+
+  /// Formatos de slot de `nv_pool_acquire`.
+  static const int bufferFormatRgb888 = 0;
+  static const int bufferFormatTensorF32 = 1;
+  static const int bufferFormatTensorF16 = 2;
+  static const int bufferFormatTensorQ8 = 3;
+
+  /// Valores de `nv_frame_queue_acquire` (NV_FRAME_INFO_SIZE).
+  static const int frameInfoSize = 9;
+
+  /// Valores de `nv_frame_queue_stats` (NV_FRAME_QUEUE_STATS_SIZE).
+  static const int frameQueueStatsSize = 4;
+
+  /// Formatos de píxel de `nv_still_batch_add_pixels` (NV_PIXEL_FORMAT_*).
+  static const int pixelFormatRgba8888 = 0;
+  static const int pixelFormatRgb888 = 1;
+
+  /// Estados de `nv_still_batch_poll` (NV_STILL_*).
+  static const int stillPending = 0;
+  static const int stillReady = 1;
+  static const int stillFailed = 2;
+
+  /// Valores de `nv_still_batch_poll` (NV_STILL_INFO_SIZE).
+  static const int stillInfoSize = 8;
+
+  /// Estados de `nv_video_state` (NV_VIDEO_*).
+  static const int videoDecoding = 0;
+  static const int videoEnded = 1;
+  static const int videoFailed = 2;
+
+  /// Valores de `nv_video_acquire` (NV_VIDEO_INFO_SIZE).
+  static const int videoInfoSize = 10;
+
+  /// Valores de `nv_video_stats` (NV_VIDEO_STATS_SIZE).
+  static const int videoStatsSize = 3;
+
+  /// Puntaje de `nv_motion_score` sin referencia (NV_MOTION_NO_REFERENCE).
+  static const double motionNoReference = 255.0;
+
+  /// Backends de `nv_set_preprocess_backend` (NV_PREPROCESS_BACKEND_*).
+  static const int preprocessBackendCpu = 0;
+  static const int preprocessBackendGpu = 1;
+
+  final _AllocDart alloc;
+  final _FreeDart free;
+  final _PoolCreateDart poolCreate;
+  final _FreeDart poolDestroy;
+  final _PoolAcquireDart poolAcquire;
+  final _PoolSlotDataDart poolSlotData;
+  final _PoolSlotBytesDart poolSlotBytes;
+  final _PoolGenerationDart poolGeneration;
+  final _ConvertDart convertYuv420ToRgb;
+  final _ConvertScaledDart convertYuv420ToRgbScaled;
+  final _PreprocessDart preprocessYuv420ToTensor;
+  final _PreprocessTypedDart preprocessYuv420ToTensorTyped;
+  final _ConvertRoiDart convertYuv420ToRgbRoi;
+  final _PreprocessRoiDart preprocessYuv420ToTensorRoi;
+  final _DecodeYoloDart decodeYoloOutput;
+  final _FrameQueueCreateDart frameQueueCreate;
+  final _FreeDart frameQueueDestroy;
+  final _FrameQueueSubmitDart frameQueueSubmit;
+  final _FrameQueueAcquireDart frameQueueAcquire;
+  final _FrameQueueTensorDart frameQueueTensor;
+  final _FrameQueueReleaseDart frameQueueRelease;
+  final _FrameQueueStatsDart frameQueueStats;
+  final _FrameQueueCreateDart stillBatchCreate;
+  final _FreeDart stillBatchDestroy;
+  final _IntQueryDart imageDecoderAvailable;
+  final _StillBatchAddEncodedDart stillBatchAddEncoded;
+  final _StillBatchAddPixelsDart stillBatchAddPixels;
+  final _StillBatchPollDart stillBatchPoll;
+  final _FrameQueueTensorDart stillBatchTensor;
+  final _HandleQueryDart motionCreate;
+  final _FreeDart motionDestroy;
+  final _MotionScoreDart motionScore;
+  final _HandleCommandDart motionCommit;
+  final _FreeDart motionReset;
+  final _TrackerCreateDart trackerCreate;
+  final _FreeDart trackerDestroy;
+  final _TrackerUpdateDart trackerUpdate;
+  final _TrackerPredictDart trackerPredict;
+  final _FreeDart trackerReset;
+  final _NutritionOpenDart nutritionOpen;
+  final _FreeDart nutritionClose;
+  final _NutritionHeaderDart nutritionHeader;
+  final _NutritionRecordDart nutritionRow;
+  final _NutritionRecordDart nutritionPortion;
+  final _NutritionRecordDart nutritionComponent;
+  final _NutritionStringsDart nutritionStrings;
+  final _NutritionFindDart nutritionFind;
+  final _GpuDelegateCreateDart gpuDelegateCreate;
+  final _GpuDelegateGetDart gpuDelegateGet;
+  final _FreeDart gpuDelegateDestroy;
+  final _HandleQueryDart ingestAcquire;
+  final _IngestQueueDart ingestQueue;
+  final _IngestReceivedFramesDart ingestReceivedFrames;
+  final _FreeDart ingestRelease;
+  final _VideoOpenDart videoOpen;
+  final _FreeDart videoClose;
+  final _FrameQueueAcquireDart videoAcquire;
+  final _FrameQueueTensorDart videoTensor;
+  final _FrameQueueReleaseDart videoRelease;
+  final _HandleCommandDart videoState;
+  final _FrameQueueStatsDart videoStats;
+  final _IntSetterDart setWorkerCount;
+  final _IntQueryDart getWorkerCount;
+  final _IntSetterDart setPreprocessBackend;
+  final _IntQueryDart getPreprocessBackend;
+  final _StringQueryDart _preprocessBackendName;
+  final _IntQueryDart isNeonSupported;
+  final _StringQueryDart _kernelName;
+  final _IntQueryDart cpuFeatures;
+  final _IntQueryDart statsSize;
+  final _StatsSnapshotDart statsSnapshot;
+  final _VoidQueryDart statsReset;
+  final _IntQueryDart memoryStatsSize;
+  final _StatsSnapshotDart memoryStats;
+  final _VoidQueryDart memoryResetPeaks;
+  final _Int64SetterDart memorySetBudget;
+  final _VoidSetterDart setTraceEnabled;
+  final _IntQueryDart isTraceEnabled;
+
+  NativeFfiBindings._(DynamicLibrary library)
+      : alloc = library.lookupFunction<_AllocNative, _AllocDart>('nv_alloc'),
+        free = library.lookupFunction<_FreeNative, _FreeDart>('nv_free'),
+        poolCreate = library.lookupFunction<_PoolCreateNative, _PoolCreateDart>(
+          'nv_pool_create',
+        ),
+        poolDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_pool_destroy',
+        ),
+        poolAcquire =
+            library.lookupFunction<_PoolAcquireNative, _PoolAcquireDart>(
+          'nv_pool_acquire',
+          isLeaf: true,
+        ),
+        poolSlotData =
+            library.lookupFunction<_PoolSlotDataNative, _PoolSlotDataDart>(
+          'nv_pool_slot_data',
+          isLeaf: true,
+        ),
+        poolSlotBytes =
+            library.lookupFunction<_PoolSlotBytesNative, _PoolSlotBytesDart>(
+          'nv_pool_slot_bytes',
+          isLeaf: true,
+        ),
+        poolGeneration =
+            library.lookupFunction<_PoolGenerationNative, _PoolGenerationDart>(
+          'nv_pool_generation',
+          isLeaf: true,
+        ),
+        convertYuv420ToRgb = library.lookupFunction<_ConvertNative, _ConvertDart>(
+          'nv_convert_yuv420_to_rgb',
+          isLeaf: true,
+        ),
+        convertYuv420ToRgbScaled =
+            library.lookupFunction<_ConvertScaledNative, _ConvertScaledDart>(
+          'nv_convert_yuv420_to_rgb_scaled',
+          isLeaf: true,
+        ),
+        preprocessYuv420ToTensor =
+            library.lookupFunction<_PreprocessNative, _PreprocessDart>(
+          'nv_preprocess_yuv420_to_tensor',
+          isLeaf: true,
+        ),
+        preprocessYuv420ToTensorTyped =
+            library.lookupFunction<_PreprocessTypedNative, _PreprocessTypedDart>(
+          'nv_preprocess_yuv420_to_tensor_typed',
+          isLeaf: true,
+        ),
+        convertYuv420ToRgbRoi =
+            library.lookupFunction<_ConvertRoiNative, _ConvertRoiDart>(
+          'nv_convert_yuv420_to_rgb_roi',
+          isLeaf: true,
+        ),
+        preprocessYuv420ToTensorRoi =
+            library.lookupFunction<_PreprocessRoiNative, _PreprocessRoiDart>(
+          'nv_preprocess_yuv420_to_tensor_roi',
+          isLeaf: true,
+        ),
+        decodeYoloOutput =
+            library.lookupFunction<_DecodeYoloNative, _DecodeYoloDart>(
+          'nv_decode_yolo_output',
+          isLeaf: true,
+        ),
+        frameQueueCreate = library
+            .lookupFunction<_FrameQueueCreateNative, _FrameQueueCreateDart>(
+          'nv_frame_queue_create',
+        ),
+        frameQueueDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_frame_queue_destroy',
+        ),
+        frameQueueSubmit = library
+            .lookupFunction<_FrameQueueSubmitNative, _FrameQueueSubmitDart>(
+          'nv_frame_queue_submit',
+          isLeaf: true,
+        ),
+        frameQueueAcquire = library
+            .lookupFunction<_FrameQueueAcquireNative, _FrameQueueAcquireDart>(
+          'nv_frame_queue_acquire',
+          isLeaf: true,
+        ),
+        frameQueueTensor = library
+            .lookupFunction<_FrameQueueTensorNative, _FrameQueueTensorDart>(
+          'nv_frame_queue_tensor',
+          isLeaf: true,
+        ),
+        frameQueueRelease = library
+            .lookupFunction<_FrameQueueReleaseNative, _FrameQueueReleaseDart>(
+          'nv_frame_queue_release',
+          isLeaf: true,
+        ),
+        frameQueueStats = library
+            .lookupFunction<_FrameQueueStatsNative, _FrameQueueStatsDart>(
+          'nv_frame_queue_stats',
+          isLeaf: true,
+        ),
+        stillBatchCreate = library
+            .lookupFunction<_FrameQueueCreateNative, _FrameQueueCreateDart>(
+          'nv_still_batch_create',
+        ),
+        stillBatchDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_still_batch_destroy',
+        ),
+        imageDecoderAvailable =
+            library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_image_decoder_available',
+        ),
+        stillBatchAddEncoded = library.lookupFunction<
+            _StillBatchAddEncodedNative, _StillBatchAddEncodedDart>(
+          'nv_still_batch_add_encoded',
+          isLeaf: true,
+        ),
+        stillBatchAddPixels = library
+            .lookupFunction<_StillBatchAddPixelsNative, _StillBatchAddPixelsDart>(
+          'nv_still_batch_add_pixels',
+          isLeaf: true,
+        ),
+        stillBatchPoll =
+            library.lookupFunction<_StillBatchPollNative, _StillBatchPollDart>(
+          'nv_still_batch_poll',
+          isLeaf: true,
+        ),
+        stillBatchTensor = library
+            .lookupFunction<_FrameQueueTensorNative, _FrameQueueTensorDart>(
+          'nv_still_batch_tensor',
+          isLeaf: true,
+        ),
+        motionCreate =
+            library.lookupFunction<_HandleQueryNative, _HandleQueryDart>(
+          'nv_motion_create',
+        ),
+        motionDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_motion_destroy',
+        ),
+        motionScore =
+            library.lookupFunction<_MotionScoreNative, _MotionScoreDart>(
+          'nv_motion_score',
+          isLeaf: true,
+        ),
+        motionCommit =
+            library.lookupFunction<_HandleCommandNative, _HandleCommandDart>(
+          'nv_motion_commit',
+          isLeaf: true,
+        ),
+        motionReset = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_motion_reset',
+          isLeaf: true,
+        ),
+        trackerCreate =
+            library.lookupFunction<_TrackerCreateNative, _TrackerCreateDart>(
+          'nv_tracker_create',
+        ),
+        trackerDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_tracker_destroy',
+        ),
+        trackerUpdate =
+            library.lookupFunction<_TrackerUpdateNative, _TrackerUpdateDart>(
+          'nv_tracker_update',
+          isLeaf: true,
+        ),
+        trackerPredict =
+            library.lookupFunction<_TrackerPredictNative, _TrackerPredictDart>(
+          'nv_tracker_predict',
+          isLeaf: true,
+        ),
+        trackerReset = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_tracker_reset',
+          isLeaf: true,
+        ),
+        nutritionOpen =
+            library.lookupFunction<_NutritionOpenNative, _NutritionOpenDart>(
+          'nv_nutrition_open',
+          isLeaf: true,
+        ),
+        nutritionClose = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_nutrition_close',
+        ),
+        nutritionHeader =
+            library.lookupFunction<_NutritionHeaderNative, _NutritionHeaderDart>(
+          'nv_nutrition_header',
+          isLeaf: true,
+        ),
+        nutritionRow =
+            library.lookupFunction<_NutritionRecordNative, _NutritionRecordDart>(
+          'nv_nutrition_row',
+          isLeaf: true,
+        ),
+        nutritionPortion =
+            library.lookupFunction<_NutritionRecordNative, _NutritionRecordDart>(
+          'nv_nutrition_portion',
+          isLeaf: true,
+        ),
+        nutritionComponent =
+            library.lookupFunction<_NutritionRecordNative, _NutritionRecordDart>(
+          'nv_nutrition_component',
+          isLeaf: true,
+        ),
+        nutritionStrings = library
+            .lookupFunction<_NutritionStringsNative, _NutritionStringsDart>(
+          'nv_nutrition_strings',
+          isLeaf: true,
+        ),
+        nutritionFind =
+            library.lookupFunction<_NutritionFindNative, _NutritionFindDart>(
+          'nv_nutrition_find',
+          isLeaf: true,
+        ),
+        gpuDelegateCreate =
+            library.lookupFunction<_GpuDelegateCreateNative, _GpuDelegateCreateDart>(
+          'nv_gpu_delegate_create',
+          isLeaf: true,
+        ),
+        gpuDelegateGet =
+            library.lookupFunction<_GpuDelegateGetNative, _GpuDelegateGetDart>(
+          'nv_gpu_delegate_get',
+          isLeaf: true,
+        ),
+        gpuDelegateDestroy = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_gpu_delegate_destroy',
+        ),
+        ingestAcquire =
+            library.lookupFunction<_HandleQueryNative, _HandleQueryDart>(
+          'nv_ingest_acquire',
+          isLeaf: true,
+        ),
+        ingestQueue =
+            library.lookupFunction<_IngestQueueNative, _IngestQueueDart>(
+          'nv_ingest_queue',
+          isLeaf: true,
+        ),
+        ingestReceivedFrames = library.lookupFunction<
+            _IngestReceivedFramesNative, _IngestReceivedFramesDart>(
+          'nv_ingest_received_frames',
+          isLeaf: true,
+        ),
+        ingestRelease = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_ingest_release',
+        ),
+        videoOpen = library.lookupFunction<_VideoOpenNative, _VideoOpenDart>(
+          'nv_video_open',
+        ),
+        videoClose = library.lookupFunction<_FreeNative, _FreeDart>(
+          'nv_video_close',
+        ),
+        videoAcquire = library
+            .lookupFunction<_FrameQueueAcquireNative, _FrameQueueAcquireDart>(
+          'nv_video_acquire',
+          isLeaf: true,
+        ),
+        videoTensor = library
+            .lookupFunction<_FrameQueueTensorNative, _FrameQueueTensorDart>(
+          'nv_video_tensor',
+          isLeaf: true,
+        ),
+        videoRelease = library
+            .lookupFunction<_FrameQueueReleaseNative, _FrameQueueReleaseDart>(
+          'nv_video_release',
+          isLeaf: true,
+        ),
+        videoState =
+            library.lookupFunction<_HandleCommandNative, _HandleCommandDart>(
+          'nv_video_state',
+          isLeaf: true,
+        ),
+        videoStats = library
+            .lookupFunction<_FrameQueueStatsNative, _FrameQueueStatsDart>(
+          'nv_video_stats',
+          isLeaf: true,
+        ),
+        setWorkerCount =
+            library.lookupFunction<_IntSetterNative, _IntSetterDart>(
+          'nv_set_worker_count',
+        ),
+        getWorkerCount = library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_get_worker_count',
+          isLeaf: true,
+        ),
+        setPreprocessBackend =
+            library.lookupFunction<_IntSetterNative, _IntSetterDart>(
+          'nv_set_preprocess_backend',
+          isLeaf: true,
+        ),
+        getPreprocessBackend =
+            library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_get_preprocess_backend',
+          isLeaf: true,
+        ),
+        _preprocessBackendName =
+            library.lookupFunction<_StringQueryNative, _StringQueryDart>(
+          'nv_preprocess_backend_name',
+          isLeaf: true,
+        ),
+        isNeonSupported = library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_is_neon_supported',
+          isLeaf: true,
+        ),
+        _kernelName =
+            library.lookupFunction<_StringQueryNative, _StringQueryDart>(
+          'nv_kernel_name',
+          isLeaf: true,
+        ),
+        cpuFeatures = library.lookupFunction<_MaskQueryNative, _IntQueryDart>(
+          'nv_cpu_features',
+          isLeaf: true,
+        ),
+        statsSize = library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_stats_size',
+          isLeaf: true,
+        ),
+        statsSnapshot =
+            library.lookupFunction<_StatsSnapshotNative, _StatsSnapshotDart>(
+          'nv_stats_snapshot',
+          isLeaf: true,
+        ),
+        statsReset = library.lookupFunction<_VoidQueryNative, _VoidQueryDart>(
+          'nv_stats_reset',
+          isLeaf: true,
+        ),
+        memoryStatsSize = library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_memory_stats_size',
+          isLeaf: true,
+        ),
+        memoryStats =
+            library.lookupFunction<_StatsSnapshotNative, _StatsSnapshotDart>(
+          'nv_memory_stats',
+          isLeaf: true,
+        ),
+        memoryResetPeaks =
+            library.lookupFunction<_VoidQueryNative, _VoidQueryDart>(
+          'nv_memory_reset_peaks',
+          isLeaf: true,
+        ),
+        memorySetBudget =
+            library.lookupFunction<_Int64SetterNative, _Int64SetterDart>(
+          'nv_memory_set_budget',
+          isLeaf: true,
+        ),
+        setTraceEnabled =
+            library.lookupFunction<_VoidSetterNative, _VoidSetterDart>(
+          'nv_set_trace_enabled',
+          isLeaf: true,
+        ),
+        isTraceEnabled =
+            library.lookupFunction<_IntQueryNative, _IntQueryDart>(
+          'nv_is_trace_enabled',
+          isLeaf: true,
+        );
+
+  /// Nombres de los bits de `nv_cpu_features`, en orden (enum CpuFeature).
+  static const List<String> cpuFeatureNames = [
+    'neon',
+    'fp16',
+    'dotprod',
+    'i8mm',
+    'sve',
+    'sve2',
+    'sse4.1',
+    'avx2',
+  ];
+
+  /// Nombre del kernel de conversión instalado (cadena C estática).
+  String kernelName() => _readCString(_kernelName());
+
+  /// Backend que generó el último tensor: `gles31` o `cpu`.
+  String preprocessBackendName() => _readCString(_preprocessBackendName());
+
+  static String _readCString(Pointer<Uint8> chars) {
+    final codes = <int>[];
+    for (var i = 0; chars[i] != 0; i++) {
+      codes.add(chars[i]);
+    }
+    return String.fromCharCodes(codes);
+  }
+
+  static NativeFfiBindings? _instance;
+  static bool _loadAttempted = false;
+
+  /// Instancia compartida, o `null` si la biblioteca no está disponible
+  /// (tests en host, plataforma distinta de Android, símbolo ausente).
+  static NativeFfiBindings? get instance {
+    if (_loadAttempted) return _instance;
+    _loadAttempted = true;
+
+    if (!Platform.isAndroid) return null;
+
+    try {
+      _instance = NativeFfiBindings._(DynamicLibrary.open(_libraryName));
+      AppLogger.debug('Bindings FFI cargados', tag: _tag);
+    } catch (e) {
+      AppLogger.warning('FFI no disponible, usando MethodChannel: $e',
+          tag: _tag);
+      _instance = null;
+    }
+    return _instance;
+  }
+}
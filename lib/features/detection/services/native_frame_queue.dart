@@ -0,0 +1,346 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          native_frame_queue.dart                              ║
+// ║          Cola nativa de frames con preprocesado asíncrono (dart:ffi)          ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  El callback de cámara encola planos sin esperar; un hilo C++ genera el       ║
+// ║  tensor y Dart toma el más reciente mientras infiere el anterior.             ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+
+import 'package:flutter/foundation.dart';
+
+import '../../../core/logging/app_logger.dart';
+import 'native_ffi_bindings.dart';
+import 'native_image_processor.dart';
+
+/// Cola acotada (2–3 slots) respaldada por `nv_frame_queue_*`.
+///
+/// [submit] copia los planos a memoria nativa y retorna de inmediato; un hilo
+/// nativo convierte y normaliza al tensor YOLO de un slot libre. Si llegan
+/// frames más rápido de lo que se infieren, se descarta el más antiguo que aún
+/// no se entregó. [acquireLatest] entrega el tensor listo más reciente y
+/// descarta los anteriores, de modo que la conversión del frame N+1 se solapa
+/// con la inferencia del frame N.
+///
+/// Solo disponible con FFI: el MethodChannel ya copia los planos y no permite
+/// mantener slots entregados mientras corre la inferencia.
+class NativeFrameQueue {
+  static const String _tag = 'NativeFrameQueue';
+
+  /// Slots por defecto: uno en inferencia, uno convirtiendo, uno pendiente.
+  static const int defaultSlots = 3;
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final Pointer<Double> _info;
+  final Pointer<Int64> _stats;
+  final int targetSize;
+
+  /// Tipo y cuantización de los tensores de la cola.
+  final NativeTensorFormat format;
+
+  /// false si la cola pertenece a otro dueño (ingesta nativa): [dispose]
+  /// solo libera los buffers Dart.
+  final bool _owned;
+
+  /// Vistas por slot: el tensor de cada slot no se realoca.
+  final Map<int, Uint8List> _views = {};
+
+  /// Marca de tiempo del llamador por frameId encolado y aún no entregado.
+  final Map<int, int> _submitTimestamps = {};
+
+  bool _disposed = false;
+
+  NativeFrameQueue._(
+    this._ffi,
+    this._handle,
+    this._info,
+    this._stats,
+    this.targetSize,
+    this.format,
+    this._owned,
+  );
+
+  /// Crea la cola, o retorna `null` si FFI no está disponible o falla la
+  /// reserva nativa.
+  ///
+  /// [format] debe coincidir con el tensor de entrada del modelo: cada slot
+  /// ocupa `targetSize² × 3 × bytes por elemento`.
+  static NativeFrameQueue? create({
+    required int targetSize,
+    int slotCount = defaultSlots,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+  }) {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null) return null;
+
+    final handle = ffi.frameQueueCreate(
+      slotCount,
+      targetSize,
+      format.type.index,
+      format.scale,
+      format.zeroPoint,
+      format.layout.index,
+    );
+    if (handle.address == 0) {
+      AppLogger.warning('No se pudo crear la cola nativa de frames',
+          tag: _tag);
+      return null;
+    }
+
+    final info = ffi.alloc(NativeFfiBindings.frameInfoSize * 8).cast<Double>();
+    final stats =
+        ffi.alloc(NativeFfiBindings.frameQueueStatsSize * 8).cast<Int64>();
+    if (info.address == 0 || stats.address == 0) {
+      if (info.address != 0) ffi.free(info.cast());
+      if (stats.address != 0) ffi.free(stats.cast());
+      ffi.frameQueueDestroy(handle);
+      return null;
+    }
+
+    AppLogger.debug('Cola nativa de frames creada ($slotCount slots, $format)',
+        tag: _tag);
+    return NativeFrameQueue._(
+        ffi, handle, info, stats, targetSize, format, true);
+  }
+
+  /// Envuelve una cola creada y destruida en nativo (p. ej. la de la
+  /// ingesta AImageReader). Solo se puede consumir: [submit] la rechaza.
+  /// [format] es el que se usó al crearla en nativo.
+  static NativeFrameQueue? borrow(
+    NativeFfiBindings ffi,
+    Pointer<Void> handle, {
+    required int targetSize,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+  }) {
+    if (handle.address == 0) return null;
+
+    final info = ffi.alloc(NativeFfiBindings.frameInfoSize * 8).cast<Double>();
+    final stats =
+        ffi.alloc(NativeFfiBindings.frameQueueStatsSize * 8).cast<Int64>();
+    if (info.address == 0 || stats.address == 0) {
+      if (info.address != 0) ffi.free(info.cast());
+      if (stats.address != 0) ffi.free(stats.cast());
+      return null;
+    }
+    return NativeFrameQueue._(
+        ffi, handle, info, stats, targetSize, format, false);
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // PRODUCTOR
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Encola un frame YUV420 para preprocesar en segundo plano.
+  ///
+  /// [timestampUs] es la marca de tiempo del frame en el reloj del llamador;
+  /// se devuelve en [QueuedTensor.submitTimestampUs] al entregarlo.
+  ///
+  /// Retorna el id del frame, o -1 si se descartó (todos los slots en uso)
+  /// o los parámetros no son válidos.
+  int submit({
+    required Uint8List yBytes,
+    required Uint8List uBytes,
+    required Uint8List vBytes,
+    required int width,
+    required int height,
+    required int yRowStride,
+    required int uvRowStride,
+    required int uvPixelStride,
+    required int sensorOrientation,
+    required bool mirror,
+    int? timestampUs,
+  }) {
+    if (_disposed || !_owned) return -1;
+
+    final frameId = _ffi.frameQueueSubmit(
+      _handle,
+      yBytes.address,
+      yBytes.length,
+      uBytes.address,
+      uBytes.length,
+      vBytes.address,
+      vBytes.length,
+      width,
+      height,
+      yRowStride,
+      uvRowStride,
+      uvPixelStride,
+      sensorOrientation,
+      mirror,
+    );
+    if (frameId >= 0 && timestampUs != null) {
+      _submitTimestamps[frameId] = timestampUs;
+    }
+    return frameId;
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // CONSUMIDOR
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Tensor listo más reciente, o `null` si aún no hay ninguno.
+  ///
+  /// El tensor es estable hasta [release]; la cola no reutiliza el slot
+  /// mientras tanto.
+  QueuedTensor? acquireLatest() {
+    if (_disposed) return null;
+
+    final slot = _ffi.frameQueueAcquire(_handle, _info);
+    if (slot < 0) return null;
+
+    final info = _info.asTypedList(NativeFfiBindings.frameInfoSize);
+    final frameId = info[0].toInt();
+    // Los anteriores ya no se entregarán: la cola los descartó
+    final submitTimestampUs = _submitTimestamps.remove(frameId);
+    _submitTimestamps.removeWhere((id, _) => id < frameId);
+
+    final view = _views[slot] ??= _ffi
+        .frameQueueTensor(_handle, slot)
+        .cast<Uint8>()
+        .asTypedList(format.tensorBytes(targetSize));
+
+    return QueuedTensor._(
+      slot: slot,
+      frameId: frameId,
+      submitTimestampUs: submitTimestampUs,
+      latencyMs: info[8] / 1e6,
+      tensor: NativeTensorResult(
+        tensorBytes: view,
+        scale: info[1],
+        padLeft: info[2].toInt(),
+        padTop: info[3].toInt(),
+        newWidth: info[4].toInt(),
+        newHeight: info[5].toInt(),
+        imageWidth: info[6].toInt(),
+        imageHeight: info[7].toInt(),
+        format: format,
+      ),
+    );
+  }
+
+  /// Espera hasta [timeout] a que haya un tensor listo y entrega el más
+  /// reciente, sea cual sea su frame.
+  ///
+  /// Normalmente ya hay uno: el convertido mientras corría la inferencia
+  /// anterior. [QueuedTensor.frameId] y [QueuedTensor.submitTimestampUs]
+  /// identifican el frame entregado. Sondea cada [pollInterval] cediendo el
+  /// isolate entre intentos, así que la UI sigue respondiendo mientras el
+  /// hilo nativo convierte.
+  Future<QueuedTensor?> waitLatest({
+    Duration timeout = const Duration(milliseconds: 100),
+    Duration pollInterval = const Duration(milliseconds: 2),
+  }) async {
+    final stopwatch = Stopwatch()..start();
+    while (true) {
+      final tensor = acquireLatest();
+      if (tensor != null) return tensor;
+      if (stopwatch.elapsed >= timeout) return null;
+      await Future<void>.delayed(pollInterval);
+    }
+  }
+
+  /// Devuelve a la cola el slot de [tensor].
+  void release(QueuedTensor tensor) {
+    if (_disposed) return;
+    _ffi.frameQueueRelease(_handle, tensor.slot);
+  }
+
+  /// Contadores acumulados de la cola.
+  FrameQueueStats stats() {
+    if (_disposed) return const FrameQueueStats.empty();
+
+    final written = _ffi.frameQueueStats(
+      _handle,
+      _stats,
+      NativeFfiBindings.frameQueueStatsSize,
+    );
+    if (written < NativeFfiBindings.frameQueueStatsSize) {
+      return const FrameQueueStats.empty();
+    }
+
+    final values = _stats.asTypedList(NativeFfiBindings.frameQueueStatsSize);
+    return FrameQueueStats(
+      submitted: values[0],
+      converted: values[1],
+      dropped: values[2],
+      stale: values[3],
+    );
+  }
+
+  /// Detiene el hilo nativo y libera los slots. Invalida los tensores
+  /// entregados.
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _views.clear();
+    _submitTimestamps.clear();
+    if (_owned) _ffi.frameQueueDestroy(_handle);
+    _ffi.free(_info.cast());
+    _ffi.free(_stats.cast());
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Tensor entregado por [NativeFrameQueue.acquireLatest].
+class QueuedTensor {
+  /// Slot nativo (se devuelve con [NativeFrameQueue.release]).
+  final int slot;
+
+  /// Id creciente asignado al encolar.
+  final int frameId;
+
+  /// Marca de tiempo pasada a [NativeFrameQueue.submit] para este frame, o
+  /// `null` si no se indicó (p. ej. frames de la ingesta nativa).
+  final int? submitTimestampUs;
+
+  /// Tiempo desde el encolado hasta que el tensor quedó listo.
+  final double latencyMs;
+
+  /// Tensor (vista sobre el slot) y letterbox.
+  final NativeTensorResult tensor;
+
+  const QueuedTensor._({
+    required this.slot,
+    required this.frameId,
+    required this.submitTimestampUs,
+    required this.latencyMs,
+    required this.tensor,
+  });
+}
+
+/// Contadores acumulados de la cola nativa.
+class FrameQueueStats {
+  /// Frames encolados.
+  final int submitted;
+
+  /// Tensores generados por el hilo nativo.
+  final int converted;
+
+  /// Frames reemplazados o rechazados antes de convertirse.
+  final int dropped;
+
+  /// Tensores listos descartados por uno más reciente.
+  final int stale;
+
+  const FrameQueueStats({
+    required this.submitted,
+    required this.converted,
+    required this.dropped,
+    required this.stale,
+  });
+
+  const FrameQueueStats.empty()
+      : submitted = 0,
+        converted = 0,
+        dropped = 0,
+        stale = 0;
+
+  @override
+  String toString() => 'encolados: $submitted, convertidos: $converted, '
+      'descartados: $dropped, viejos: $stale';
+}
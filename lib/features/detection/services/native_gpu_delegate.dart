@@ -0,0 +1,92 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          native_gpu_delegate.dart                             ║
+// ║          GPU delegate con caché de kernels serializados en disco              ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  GpuDelegateOptionsV2 de tflite_flutter no expone serialization_dir ni        ║
+// ║  model_token: el delegate se crea en C++ (nv_gpu_delegate_*) y se añade al    ║
+// ║  intérprete como un Delegate más. Sin caché, recompilar los kernels OpenCL    ║
+// ║  cuesta segundos en cada arranque.                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:path_provider/path_provider.dart';
+// ignore: implementation_imports
+import 'package:tflite_flutter/src/bindings/tensorflow_lite_bindings_generated.dart'
+    show TfLiteDelegate;
+import 'package:tflite_flutter/tflite_flutter.dart' show Delegate;
+
+import '../../../core/logging/app_logger.dart';
+import 'native_ffi_bindings.dart';
+
+/// GPU delegate (TfLiteGpuDelegateV2) que guarda los programas compilados.
+///
+/// La primera creación del intérprete con un [modelToken] compila los
+/// kernels y los escribe en el directorio de soporte de la app; las
+/// siguientes los cargan. Cambiar el modelo (otro MD5) invalida la caché.
+///
+/// Ejemplo de uso:
+/// ```dart
+/// final delegate = await NativeGpuDelegate.create(modelToken: md5);
+/// options.addDelegate(delegate ?? GpuDelegateV2());
+/// ```
+class NativeGpuDelegate implements Delegate {
+  static const String _tag = 'NativeGpuDelegate';
+
+  /// Subdirectorio de [getApplicationSupportDirectory] con la caché.
+  static const String cacheDirName = 'gpu_delegate_cache';
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  bool _deleted = false;
+
+  NativeGpuDelegate._(this._ffi, this._handle);
+
+  /// Crea el delegate, o retorna `null` si FFI o el GPU delegate nativo no
+  /// están disponibles (el llamador usa entonces `GpuDelegateV2`).
+  static Future<NativeGpuDelegate?> create({
+    required String modelToken,
+    bool precisionLossAllowed = false,
+  }) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null || modelToken.isEmpty) return null;
+
+    final String cachePath;
+    try {
+      final support = await getApplicationSupportDirectory();
+      final directory = Directory('${support.path}/$cacheDirName');
+      await directory.create(recursive: true);
+      cachePath = directory.path;
+    } catch (e) {
+      AppLogger.warning('Sin directorio para la caché GPU: $e', tag: _tag);
+      return null;
+    }
+
+    final handle = ffi.gpuDelegateCreate(
+      _cString(cachePath).address,
+      _cString(modelToken).address,
+      precisionLossAllowed ? 1 : 0,
+    );
+    if (handle.address == 0) return null;
+
+    AppLogger.debug('GPU delegate con caché en $cachePath', tag: _tag);
+    return NativeGpuDelegate._(ffi, handle);
+  }
+
+  @override
+  Pointer<TfLiteDelegate> get base => _ffi.gpuDelegateGet(_handle).cast();
+
+  /// Destruye el delegate. Llamar después de cerrar el intérprete.
+  @override
+  void delete() {
+    if (_deleted) return;
+    _deleted = true;
+    _ffi.gpuDelegateDestroy(_handle);
+  }
+
+  static Uint8List _cString(String value) =>
+      Uint8List.fromList([...utf8.encode(value), 0]);
+}
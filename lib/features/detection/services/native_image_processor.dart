@@ -2,18 +2,29 @@
 // ║                        native_image_processor.dart                            ║
 // ║              Cliente Dart para procesamiento nativo de imágenes               ║
 // ╠═══════════════════════════════════════════════════════════════════════════════╣
-// ║  Platform Channel para acceder a código C++ optimizado.                       ║
+// ║  dart:ffi (zero-copy) o Platform Channel para acceder a código C++.           ║
 // ║  Provee conversión YUV→RGB ~10x más rápida que Dart puro.                     ║
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
+import 'dart:ffi';
+import 'dart:math' show max, min;
+
 import 'package:flutter/services.dart';
 
 import '../../../core/logging/app_logger.dart';
+import '../../../data/models/performance_metrics.dart';
+import 'native_ffi_bindings.dart';
 
 /// Cliente para procesamiento de imágenes nativo.
 ///
 /// Usa código C++ optimizado con NEON (ARM SIMD) para conversión
 /// de color YUV420 a RGB significativamente más rápida.
+///
+/// Ruta preferida: dart:ffi con llamadas leaf. Los planos de `CameraImage`
+/// se pasan por puntero y la salida se escribe en un anillo de buffers
+/// nativos persistentes que Dart lee vía `asTypedList`, así que el costo de
+/// transferencia por frame no escala con la resolución. Si FFI no está
+/// disponible se usa el MethodChannel (copia planos y resultado).
 class NativeImageProcessor {
   static const String _tag = 'NativeProcessor';
 
@@ -24,16 +35,37 @@ class NativeImageProcessor {
   /// Cache del soporte NEON.
   static bool? _neonSupported;
 
-  /// Indica si el procesador nativo está disponible.
+  /// Cache del kernel nativo (no cambia durante el proceso).
+  static NativeKernelInfo? _kernelInfo;
+
+  /// Indica si el MethodChannel nativo está disponible.
   static bool _available = true;
 
+  /// Slots del anillo de salida: el frame N sigue siendo válido mientras se
+  /// produce el N+1.
+  static const int _poolSlots = 2;
+
+  /// Buffers nativos persistentes del camino FFI.
+  static _NativePool? _rgbPool;
+  static _NativePool? _tensorPool;
+  static _NativeBuffer? _letterboxBuffer;
+  static _NativeBuffer? _statsBuffer;
+  static _NativeBuffer? _memoryBuffer;
+
   /// Verifica si el procesador nativo está disponible.
-  static bool get isAvailable => _available;
+  static bool get isAvailable =>
+      NativeFfiBindings.instance != null || _available;
 
   /// Verifica si las optimizaciones NEON están soportadas.
   static Future<bool> isNeonSupported() async {
     if (_neonSupported != null) return _neonSupported!;
 
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      _neonSupported = ffi.isNeonSupported() != 0;
+      return _neonSupported!;
+    }
+
     try {
       _neonSupported =
           await _channel.invokeMethod<bool>('isNeonSupported') ?? false;
@@ -45,11 +77,289 @@ class NativeImageProcessor {
     }
   }
 
+  /// Kernel de conversión elegido en tiempo de ejecución y extensiones SIMD
+  /// de la CPU, para atribuir diferencias de tiempo de frame al camino ISA.
+  ///
+  /// Retorna `null` si el procesador nativo no está disponible.
+  static Future<NativeKernelInfo?> getKernelInfo() async {
+    if (_kernelInfo != null) return _kernelInfo;
+
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      final mask = ffi.cpuFeatures();
+      final names = NativeFfiBindings.cpuFeatureNames;
+      _kernelInfo = NativeKernelInfo(
+        kernel: ffi.kernelName(),
+        cpuFeatures: [
+          for (var bit = 0; bit < names.length; bit++)
+            if (mask & (1 << bit) != 0) names[bit],
+        ],
+      );
+      return _kernelInfo;
+    }
+
+    try {
+      final info = await _channel.invokeMapMethod<String, String>(
+        'getKernelInfo',
+      );
+      if (info == null) return null;
+
+      final features = info['cpuFeatures'] ?? '';
+      _kernelInfo = NativeKernelInfo(
+        kernel: info['kernel'] ?? 'unknown',
+        cpuFeatures: features.isEmpty ? const [] : features.split(' '),
+      );
+      return _kernelInfo;
+    } catch (e) {
+      AppLogger.warning('Error consultando kernel nativo: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Tiempos por etapa y contadores acumulados del código nativo.
+  ///
+  /// Con FFI es una llamada leaf sobre un buffer persistente (sin reservas
+  /// por llamada), apta para consultarse cada pocos frames. Retorna `null`
+  /// si el procesador nativo no está disponible.
+  static Future<NativeStatsSnapshot?> getNativeStats() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      final size = ffi.statsSize();
+      if (size < NativeStatsSnapshot.length) return null;
+
+      final buffer = (_statsBuffer ??= _NativeBuffer(ffi));
+      final pointer = buffer.ensure(size * 8).cast<Int64>();
+      if (pointer.address == 0) return null;
+      if (ffi.statsSnapshot(pointer, size) < 0) return null;
+      return NativeStatsSnapshot.fromValues(pointer.asTypedList(size));
+    }
+
+    try {
+      final values = await _channel.invokeMethod<List<int>>('getNativeStats');
+      if (values == null || values.length < NativeStatsSnapshot.length) {
+        return null;
+      }
+      return NativeStatsSnapshot.fromValues(values);
+    } catch (e) {
+      AppLogger.warning('Error consultando estadísticas nativas: $e',
+          tag: _tag);
+      return null;
+    }
+  }
+
+  /// Pone a cero los tiempos y contadores nativos.
+  static Future<void> resetNativeStats() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      ffi.statsReset();
+      return;
+    }
+
+    try {
+      await _channel.invokeMethod<void>('resetNativeStats');
+    } catch (e) {
+      AppLogger.warning('Error reiniciando estadísticas nativas: $e',
+          tag: _tag);
+    }
+  }
+
+  /// Bytes vivos, pico y reservas de la memoria nativa, global y por arena.
+  ///
+  /// Con FFI es una llamada leaf sobre un buffer persistente. Retorna `null`
+  /// si el procesador nativo no está disponible.
+  static Future<NativeMemoryStats?> getNativeMemoryStats() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      final size = ffi.memoryStatsSize();
+      if (size < NativeMemoryStats.length) return null;
+
+      final buffer = (_memoryBuffer ??= _NativeBuffer(ffi));
+      final pointer = buffer.ensure(size * 8).cast<Int64>();
+      if (pointer.address == 0) return null;
+      if (ffi.memoryStats(pointer, size) < 0) return null;
+      return NativeMemoryStats.fromValues(pointer.asTypedList(size));
+    }
+
+    try {
+      final values =
+          await _channel.invokeMethod<List<int>>('getNativeMemoryStats');
+      if (values == null || values.length < NativeMemoryStats.length) {
+        return null;
+      }
+      return NativeMemoryStats.fromValues(values);
+    } catch (e) {
+      AppLogger.warning('Error consultando memoria nativa: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Lleva los picos de memoria nativa a los bytes vivos actuales (inicio de
+  /// una medición, p. ej. antes de un lote de galería).
+  static Future<void> resetNativeMemoryPeaks() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      ffi.memoryResetPeaks();
+      return;
+    }
+
+    try {
+      await _channel.invokeMethod<void>('resetNativeMemoryPeaks');
+    } catch (e) {
+      AppLogger.warning('Error reiniciando picos de memoria nativa: $e',
+          tag: _tag);
+    }
+  }
+
+  /// Fija el presupuesto de memoria nativa en bytes.
+  ///
+  /// Pasado el límite las reservas nativas fallan y el pipeline degrada en
+  /// vez de crecer: la cola preprocesa sin copiar los planos y con menos
+  /// slots, y las imágenes se decodifican más submuestreadas.
+  ///
+  /// [bytes] > 0 fija el límite, 0 lo quita y < 0 restaura el valor por
+  /// defecto (1/8 de la RAM física). Retorna el presupuesto vigente, o
+  /// `null` si el procesador nativo no está disponible.
+  static Future<int?> setNativeMemoryBudget(int bytes) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.memorySetBudget(bytes);
+
+    try {
+      return await _channel.invokeMethod<int>('setNativeMemoryBudget', {
+        'bytes': bytes,
+      });
+    } catch (e) {
+      AppLogger.warning('Error fijando presupuesto de memoria nativa: $e',
+          tag: _tag);
+      return null;
+    }
+  }
+
+  /// Activa o desactiva las secciones ATrace por etapa del código nativo
+  /// (`nv:convert`, `nv:normalize`, `nv:nms`...) y los contadores
+  /// `nv.frame`, `nv.width` y `nv.height`.
+  ///
+  /// Solo se emiten mientras hay una captura de Perfetto/systrace; apagado
+  /// el costo por etapa es una lectura atómica.
+  static Future<void> setTraceEnabled(bool enabled) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      ffi.setTraceEnabled(enabled ? 1 : 0);
+      return;
+    }
+
+    try {
+      await _channel.invokeMethod<void>('setTraceEnabled', {
+        'enabled': enabled,
+      });
+    } catch (e) {
+      AppLogger.warning('Error configurando trazas nativas: $e', tag: _tag);
+    }
+  }
+
+  /// Estado del interruptor de [setTraceEnabled]; `false` si el procesador
+  /// nativo no está disponible.
+  static Future<bool> isTraceEnabled() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.isTraceEnabled() != 0;
+
+    try {
+      return await _channel.invokeMethod<bool>('isTraceEnabled') ?? false;
+    } catch (e) {
+      AppLogger.warning('Error consultando trazas nativas: $e', tag: _tag);
+      return false;
+    }
+  }
+
+  /// Fija los hilos nativos que reparten conversión y preprocesado en bandas
+  /// de filas (incluido el hilo llamador).
+  ///
+  /// [count] <= 0 restaura el valor por defecto (núcleos grandes del SoC).
+  /// Retorna el número de hilos efectivo, o `null` si el procesador nativo
+  /// no está disponible.
+  static Future<int?> setWorkerCount(int count) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.setWorkerCount(count);
+
+    try {
+      return await _channel.invokeMethod<int>('setWorkerCount', {
+        'count': count,
+      });
+    } catch (e) {
+      AppLogger.warning('Error configurando hilos nativos: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Número de hilos nativos actual, o `null` si no está disponible.
+  static Future<int?> getWorkerCount() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.getWorkerCount();
+
+    try {
+      return await _channel.invokeMethod<int>('getWorkerCount');
+    } catch (e) {
+      AppLogger.warning('Error consultando hilos nativos: $e', tag: _tag);
+      return null;
+    }
+  }
+
+  /// Elige dónde se genera el tensor YOLO en todas las rutas nativas
+  /// (llamada directa, cola de frames e ingesta).
+  ///
+  /// Con [NativePreprocessBackend.gpu] se usa un compute shader GLES 3.1;
+  /// los frames que no se puedan ejecutar ahí (sin GLES 3.1, error de
+  /// contexto) usan el kernel CPU con el mismo resultado bit a bit. Retorna
+  /// `false` si el procesador nativo no está disponible.
+  static Future<bool> setPreprocessBackend(
+    NativePreprocessBackend backend,
+  ) async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.setPreprocessBackend(backend.index) == 0;
+
+    try {
+      return await _channel.invokeMethod<bool>('setPreprocessBackend', {
+            'backend': backend.index,
+          }) ??
+          false;
+    } catch (e) {
+      AppLogger.warning('Error configurando backend de preprocesado: $e',
+          tag: _tag);
+      return false;
+    }
+  }
+
+  /// Backend que generó el último tensor (`gles31` o `cpu`), o `null` si el
+  /// procesador nativo no está disponible.
+  static Future<String?> getPreprocessBackendName() async {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) return ffi.preprocessBackendName();
+
+    try {
+      return await _channel.invokeMethod<String>('getPreprocessBackendName');
+    } catch (e) {
+      AppLogger.warning('Error consultando backend de preprocesado: $e',
+          tag: _tag);
+      return null;
+    }
+  }
+
   /// Convierte una imagen YUV420 a RGB usando código nativo.
   ///
+  /// La rotación y el espejo se aplican en la misma pasada nativa, así que el
+  /// resultado ya está en la orientación final: con 90/270 mide
+  /// `height × width`.
+  ///
   /// Retorna `null` si el procesador nativo no está disponible
   /// o si ocurre un error. En ese caso, usar fallback Dart.
   ///
+  /// Con FFI el resultado es una vista sobre un slot del anillo nativo:
+  /// es válido hasta que el anillo reutilice el slot (dos llamadas después).
+  ///
+  /// Si se indican [targetWidth] y [targetHeight] (dimensiones de la imagen
+  /// ya rotada) el kernel muestrea directamente a esa resolución (bilineal
+  /// sobre Y y croma a la escala correspondiente) y el resultado mide
+  /// `targetWidth × targetHeight`: el costo no depende del tamaño del sensor.
+  ///
   /// [yBytes] - Bytes del plano Y (luminancia)
   /// [uBytes] - Bytes del plano U (crominancia)
   /// [vBytes] - Bytes del plano V (crominancia)
@@ -58,6 +368,12 @@ class NativeImageProcessor {
   /// [yRowStride] - Stride del plano Y en bytes
   /// [uvRowStride] - Stride del plano UV en bytes
   /// [uvPixelStride] - Stride entre píxeles UV
+  /// [sensorOrientation] - Rotación horaria a aplicar (0, 90, 180, 270)
+  /// [mirror] - Espejo horizontal tras rotar (cámara frontal)
+  /// [targetWidth] / [targetHeight] - Resolución de salida (opcional)
+  /// [crop] - Región de interés en coordenadas del sensor (opcional): solo
+  ///   se leen sus filas y columnas y la salida es la región rotada (ver
+  ///   [NativeCropRect.clampTo] para el ajuste aplicado)
   static Future<Uint8List?> convertYuvToRgb({
     required Uint8List yBytes,
     required Uint8List uBytes,
@@ -67,7 +383,91 @@ class NativeImageProcessor {
     required int yRowStride,
     required int uvRowStride,
     required int uvPixelStride,
+    int sensorOrientation = 0,
+    bool mirror = false,
+    int? targetWidth,
+    int? targetHeight,
+    NativeCropRect? crop,
   }) async {
+    final scaled = targetWidth != null &&
+        targetHeight != null &&
+        targetWidth > 0 &&
+        targetHeight > 0;
+
+    final region = crop?.clampTo(width, height);
+    if (crop != null && region == null) return null;
+    final regionWidth = region?.width ?? width;
+    final regionHeight = region?.height ?? height;
+
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      final transposed = sensorOrientation == 90 || sensorOrientation == 270;
+      final rgbPool = _rgbPool ??= _NativePool(ffi, _poolSlots);
+      final outputWidth =
+          scaled ? targetWidth : (transposed ? regionHeight : regionWidth);
+      final outputHeight =
+          scaled ? targetHeight : (transposed ? regionWidth : regionHeight);
+      final slot = rgbPool.acquire(
+        outputWidth,
+        outputHeight,
+        NativeFfiBindings.bufferFormatRgb888,
+      );
+      if (slot >= 0) {
+        final status = region != null
+            ? ffi.convertYuv420ToRgbRoi(
+                yBytes.address,
+                uBytes.address,
+                vBytes.address,
+                rgbPool.data(slot),
+                width,
+                height,
+                yRowStride,
+                uvRowStride,
+                uvPixelStride,
+                sensorOrientation,
+                mirror,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                scaled ? outputWidth : 0,
+                scaled ? outputHeight : 0,
+              )
+            : scaled
+            ? ffi.convertYuv420ToRgbScaled(
+                yBytes.address,
+                uBytes.address,
+                vBytes.address,
+                rgbPool.data(slot),
+                width,
+                height,
+                yRowStride,
+                uvRowStride,
+                uvPixelStride,
+                sensorOrientation,
+                mirror,
+                outputWidth,
+                outputHeight,
+              )
+            : ffi.convertYuv420ToRgb(
+                yBytes.address,
+                uBytes.address,
+                vBytes.address,
+                rgbPool.data(slot),
+                width,
+                height,
+                yRowStride,
+                uvRowStride,
+                uvPixelStride,
+                sensorOrientation,
+                mirror,
+              );
+        if (status == NativeFfiBindings.ok) return rgbPool.view(slot);
+      }
+      AppLogger.warning('Conversión FFI falló, usando MethodChannel',
+          tag: _tag);
+    }
+
     if (!_available) return null;
 
     try {
@@ -80,6 +480,11 @@ class NativeImageProcessor {
         'yRowStride': yRowStride,
         'uvRowStride': uvRowStride,
         'uvPixelStride': uvPixelStride,
+        'sensorOrientation': sensorOrientation,
+        'mirror': mirror,
+        if (scaled) 'targetWidth': targetWidth,
+        if (scaled) 'targetHeight': targetHeight,
+        if (region != null) ...region._channelArguments(),
       });
 
       return result;
@@ -96,4 +501,548 @@ class NativeImageProcessor {
       return null;
     }
   }
+
+  /// Preprocesa un frame YUV420 directamente al tensor de entrada YOLO.
+  ///
+  /// Conversión, rotación, espejo, resize, letterbox y normalización se hacen
+  /// en una sola pasada nativa: no se crea ningún frame RGB ni `img.Image`.
+  ///
+  /// Retorna `null` si el procesador nativo no está disponible
+  /// o si ocurre un error. En ese caso, usar el pipeline RGB.
+  ///
+  /// Con FFI [NativeTensorResult.tensorBytes] es una vista sobre un slot del
+  /// anillo nativo: es válido hasta que el anillo reutilice el slot.
+  ///
+  /// [sensorOrientation] - Rotación horaria a aplicar (0, 90, 180, 270)
+  /// [mirror] - Espejo horizontal tras rotar (cámara frontal)
+  /// [targetSize] - Lado del tensor cuadrado (640 para YOLO11n)
+  /// [format] - Tipo y cuantización del tensor de entrada del modelo: con
+  ///   uint8/int8 la cuantización se aplica en el kernel y el tensor ocupa
+  ///   4× menos que en float32
+  /// [crop] - Región de interés en coordenadas del sensor (opcional): el
+  ///   letterbox se calcula sobre la región rotada y las detecciones quedan
+  ///   en sus coordenadas (ver [NativeTensorResult.crop])
+  static Future<NativeTensorResult?> preprocessYuvToTensor({
+    required Uint8List yBytes,
+    required Uint8List uBytes,
+    required Uint8List vBytes,
+    required int width,
+    required int height,
+    required int yRowStride,
+    required int uvRowStride,
+    required int uvPixelStride,
+    required int sensorOrientation,
+    required bool mirror,
+    required int targetSize,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+    NativeCropRect? crop,
+  }) async {
+    final region = crop?.clampTo(width, height);
+    if (crop != null && region == null) return null;
+
+    final transposed = sensorOrientation == 90 || sensorOrientation == 270;
+    final regionWidth = region?.width ?? width;
+    final regionHeight = region?.height ?? height;
+    final imageWidth = transposed ? regionHeight : regionWidth;
+    final imageHeight = transposed ? regionWidth : regionHeight;
+
+    final ffi = NativeFfiBindings.instance;
+    if (ffi != null) {
+      final tensorPool = _tensorPool ??= _NativePool(ffi, _poolSlots);
+      final letterboxBuffer = _letterboxBuffer ??= _NativeBuffer(ffi);
+      final slot = tensorPool.acquire(
+        targetSize,
+        targetSize,
+        format.bufferFormat,
+      );
+      final letterboxOut = letterboxBuffer.ensure(5 * 8);
+
+      if (slot >= 0 && letterboxOut.address != 0) {
+        final status = region != null
+            ? ffi.preprocessYuv420ToTensorRoi(
+                yBytes.address,
+                uBytes.address,
+                vBytes.address,
+                width,
+                height,
+                yRowStride,
+                uvRowStride,
+                uvPixelStride,
+                sensorOrientation,
+                mirror,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                targetSize,
+                format.type.index,
+                format.scale,
+                format.zeroPoint,
+                format.layout.index,
+                tensorPool.data(slot).cast<Void>(),
+                letterboxOut.cast<Double>(),
+              )
+            : ffi.preprocessYuv420ToTensorTyped(
+                yBytes.address,
+                uBytes.address,
+                vBytes.address,
+                width,
+                height,
+                yRowStride,
+                uvRowStride,
+                uvPixelStride,
+                sensorOrientation,
+                mirror,
+                targetSize,
+                format.type.index,
+                format.scale,
+                format.zeroPoint,
+                format.layout.index,
+                tensorPool.data(slot).cast<Void>(),
+                letterboxOut.cast<Double>(),
+              );
+
+        if (status == NativeFfiBindings.ok) {
+          final letterbox = letterboxOut.cast<Double>().asTypedList(5);
+          return NativeTensorResult(
+            tensorBytes: tensorPool.view(slot),
+            scale: letterbox[0],
+            padLeft: letterbox[1].toInt(),
+            padTop: letterbox[2].toInt(),
+            newWidth: letterbox[3].toInt(),
+            newHeight: letterbox[4].toInt(),
+            imageWidth: imageWidth,
+            imageHeight: imageHeight,
+            format: format,
+            crop: region,
+          );
+        }
+      }
+      AppLogger.warning('Preprocesado FFI falló, usando MethodChannel',
+          tag: _tag);
+    }
+
+    if (!_available) return null;
+
+    try {
+      final result = await _channel
+          .invokeMapMethod<String, dynamic>('preprocessYuvToTensor', {
+        'yBytes': yBytes,
+        'uBytes': uBytes,
+        'vBytes': vBytes,
+        'width': width,
+        'height': height,
+        'yRowStride': yRowStride,
+        'uvRowStride': uvRowStride,
+        'uvPixelStride': uvPixelStride,
+        'sensorOrientation': sensorOrientation,
+        'mirror': mirror,
+        'targetSize': targetSize,
+        'tensorType': format.type.index,
+        'quantScale': format.scale,
+        'zeroPoint': format.zeroPoint,
+        'tensorLayout': format.layout.index,
+        if (region != null) ...region._channelArguments(),
+      });
+
+      if (result == null) return null;
+
+      return NativeTensorResult(
+        tensorBytes: result['tensor'] as Uint8List,
+        scale: (result['scale'] as num).toDouble(),
+        padLeft: result['padLeft'] as int,
+        padTop: result['padTop'] as int,
+        newWidth: result['newWidth'] as int,
+        newHeight: result['newHeight'] as int,
+        imageWidth: imageWidth,
+        imageHeight: imageHeight,
+        format: format,
+        crop: region,
+      );
+    } on PlatformException catch (e) {
+      AppLogger.warning('Error en preprocesado nativo: ${e.message}',
+          tag: _tag);
+      return null;
+    } on MissingPluginException {
+      _available = false;
+      AppLogger.debug('Procesador nativo no disponible', tag: _tag);
+      return null;
+    } catch (e) {
+      AppLogger.warning('Error inesperado: $e', tag: _tag);
+      return null;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// KERNEL NATIVO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Backend del preprocesado nativo YUV → tensor (orden de
+/// `NV_PREPROCESS_BACKEND_*`).
+enum NativePreprocessBackend {
+  /// Kernel CPU (NEON/SSE/AVX2) repartido en el pool de hilos.
+  cpu,
+
+  /// Compute shader GLES 3.1 con el kernel CPU como respaldo.
+  gpu,
+}
+
+/// Camino ISA que usa la conversión nativa en este dispositivo.
+class NativeKernelInfo {
+  /// Kernel instalado: `neon`, `avx2`, `sse4.1` o `scalar`.
+  final String kernel;
+
+  /// Extensiones SIMD detectadas (p. ej. `neon`, `dotprod`, `sve2`).
+  final List<String> cpuFeatures;
+
+  const NativeKernelInfo({
+    required this.kernel,
+    required this.cpuFeatures,
+  });
+
+  @override
+  String toString() => '$kernel [${cpuFeatures.join(' ')}]';
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// REGIÓN DE INTERÉS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Rectángulo de un frame YUV: en coordenadas del sensor (antes de rotar)
+/// para [NativeImageProcessor.convertYuvToRgb] y
+/// [NativeImageProcessor.preprocessYuvToTensor], o de la imagen rotada en
+/// [rotated] / [fromRotated].
+class NativeCropRect {
+  final int x;
+  final int y;
+  final int width;
+  final int height;
+
+  const NativeCropRect(this.x, this.y, this.width, this.height);
+
+  /// Región efectiva dentro de un frame [frameWidth] × [frameHeight]:
+  /// intersección con el frame y origen alineado a píxeles pares (la croma
+  /// es 2×2), ampliando el tamaño para seguir cubriendo lo pedido. Mismo
+  /// ajuste que `clampCropRect` en C++. `null` si queda vacía.
+  NativeCropRect? clampTo(int frameWidth, int frameHeight) {
+    if (width <= 0 || height <= 0) return null;
+    final right = min(x + width, frameWidth);
+    final bottom = min(y + height, frameHeight);
+    final left = max(x, 0) & ~1;
+    final top = max(y, 0) & ~1;
+    if (right <= left || bottom <= top) return null;
+    return NativeCropRect(left, top, right - left, bottom - top);
+  }
+
+  /// Esta región (del sensor) en la imagen rotada y espejada con
+  /// [sensorOrientation] / [mirror]; su origen es el desplazamiento de las
+  /// detecciones hechas sobre la región.
+  NativeCropRect rotated(
+    int frameWidth,
+    int frameHeight,
+    int sensorOrientation,
+    bool mirror,
+  ) {
+    final transposed = sensorOrientation == 90 || sensorOrientation == 270;
+    final rotatedWidth = transposed ? frameHeight : frameWidth;
+
+    int left;
+    int top;
+    switch (sensorOrientation) {
+      case 90:
+        left = frameHeight - (y + height);
+        top = x;
+        break;
+      case 180:
+        left = frameWidth - (x + width);
+        top = frameHeight - (y + height);
+        break;
+      case 270:
+        left = y;
+        top = frameWidth - (x + width);
+        break;
+      default:
+        left = x;
+        top = y;
+        break;
+    }
+
+    final outWidth = transposed ? height : width;
+    final outHeight = transposed ? width : height;
+    if (mirror) left = rotatedWidth - (left + outWidth);
+    return NativeCropRect(left, top, outWidth, outHeight);
+  }
+
+  /// Región del sensor que corresponde a [rect] de la imagen rotada (p. ej.
+  /// la caja de una detección, para recortar un tile a resolución completa
+  /// en una segunda pasada). Inversa de [rotated].
+  static NativeCropRect fromRotated(
+    NativeCropRect rect,
+    int frameWidth,
+    int frameHeight,
+    int sensorOrientation,
+    bool mirror,
+  ) {
+    final transposed = sensorOrientation == 90 || sensorOrientation == 270;
+    final rotatedWidth = transposed ? frameHeight : frameWidth;
+    final left = mirror ? rotatedWidth - (rect.x + rect.width) : rect.x;
+    final top = rect.y;
+    final sensorWidth = transposed ? rect.height : rect.width;
+    final sensorHeight = transposed ? rect.width : rect.height;
+
+    switch (sensorOrientation) {
+      case 90:
+        return NativeCropRect(
+            top, frameHeight - (left + rect.width), sensorWidth, sensorHeight);
+      case 180:
+        return NativeCropRect(frameWidth - (left + rect.width),
+            frameHeight - (top + rect.height), sensorWidth, sensorHeight);
+      case 270:
+        return NativeCropRect(
+            frameWidth - (top + rect.height), left, sensorWidth, sensorHeight);
+      default:
+        return NativeCropRect(left, top, sensorWidth, sensorHeight);
+    }
+  }
+
+  Map<String, int> _channelArguments() => {
+        'cropX': x,
+        'cropY': y,
+        'cropWidth': width,
+        'cropHeight': height,
+      };
+
+  @override
+  bool operator ==(Object other) =>
+      other is NativeCropRect &&
+      other.x == x &&
+      other.y == y &&
+      other.width == width &&
+      other.height == height;
+
+  @override
+  int get hashCode => Object.hash(x, y, width, height);
+
+  @override
+  String toString() => 'NativeCropRect($x, $y, ${width}x$height)';
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// FORMATO DEL TENSOR
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Tipo de elemento del tensor de entrada (orden de `NV_TENSOR_TYPE_*`).
+enum NativeTensorType {
+  float32,
+  float16,
+  uint8,
+  int8,
+}
+
+/// Disposición de los canales del tensor (orden de `NV_TENSOR_LAYOUT_*`).
+enum NativeTensorLayout {
+  /// `[1, H, W, 3]`: RGB intercalado por píxel (TFLite).
+  nhwc,
+
+  /// `[1, 3, H, W]`: un plano por canal (exportes ONNX/NNAPI).
+  nchw,
+}
+
+/// Tipo, cuantización y disposición del tensor de entrada del modelo.
+///
+/// Con [NativeTensorType.uint8] / [NativeTensorType.int8] el kernel escribe
+/// `round((pixel / 255) / scale) + zeroPoint` saturado al rango del tipo,
+/// con los parámetros del tensor de entrada del `.tflite`.
+class NativeTensorFormat {
+  final NativeTensorType type;
+
+  /// Escala de cuantización (solo uint8/int8).
+  final double scale;
+
+  /// Zero-point de cuantización (solo uint8/int8).
+  final int zeroPoint;
+
+  final NativeTensorLayout layout;
+
+  const NativeTensorFormat(
+    this.type, {
+    this.scale = 1.0,
+    this.zeroPoint = 0,
+    this.layout = NativeTensorLayout.nhwc,
+  });
+
+  /// Tensor float32 NHWC en [0, 1] (modelo `yolov11n_float32`).
+  static const float32 = NativeTensorFormat(NativeTensorType.float32);
+
+  bool get isQuantized =>
+      type == NativeTensorType.uint8 || type == NativeTensorType.int8;
+
+  /// Bytes por elemento.
+  int get elementBytes {
+    switch (type) {
+      case NativeTensorType.float32:
+        return 4;
+      case NativeTensorType.float16:
+        return 2;
+      case NativeTensorType.uint8:
+      case NativeTensorType.int8:
+        return 1;
+    }
+  }
+
+  /// Formato de slot de `nv_pool_acquire` para este tipo.
+  int get bufferFormat {
+    switch (type) {
+      case NativeTensorType.float32:
+        return NativeFfiBindings.bufferFormatTensorF32;
+      case NativeTensorType.float16:
+        return NativeFfiBindings.bufferFormatTensorF16;
+      case NativeTensorType.uint8:
+      case NativeTensorType.int8:
+        return NativeFfiBindings.bufferFormatTensorQ8;
+    }
+  }
+
+  /// Bytes de un tensor de lado [size] (igual en ambas disposiciones).
+  int tensorBytes(int size) => size * size * 3 * elementBytes;
+
+  @override
+  bool operator ==(Object other) =>
+      other is NativeTensorFormat &&
+      other.type == type &&
+      other.scale == scale &&
+      other.zeroPoint == zeroPoint &&
+      other.layout == layout;
+
+  @override
+  int get hashCode => Object.hash(type, scale, zeroPoint, layout);
+
+  @override
+  String toString() => isQuantized
+      ? '${type.name} ${layout.name} (scale $scale, zp $zeroPoint)'
+      : '${type.name} ${layout.name}';
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADO DEL PREPROCESADO NATIVO
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Tensor de entrada generado en nativo junto con su letterbox.
+///
+/// Los campos de letterbox son los mismos que usa `YoloDetector` para
+/// devolver las cajas al espacio de la imagen rotada.
+class NativeTensorResult {
+  /// Bytes del tensor `[1, size, size, 3]` (o `[1, 3, size, size]`) en el
+  /// tipo y la disposición de [format].
+  final Uint8List tensorBytes;
+
+  /// Factor de escala aplicado.
+  final double scale;
+
+  /// Padding izquierdo en píxeles del tensor.
+  final int padLeft;
+
+  /// Padding superior en píxeles del tensor.
+  final int padTop;
+
+  /// Ancho del contenido escalado.
+  final int newWidth;
+
+  /// Alto del contenido escalado.
+  final int newHeight;
+
+  /// Ancho de la imagen tras rotar.
+  final int imageWidth;
+
+  /// Alto de la imagen tras rotar.
+  final int imageHeight;
+
+  /// Tipo y cuantización de [tensorBytes].
+  final NativeTensorFormat format;
+
+  /// Región del sensor preprocesada, o `null` si fue el frame completo.
+  /// [imageWidth]/[imageHeight] son entonces los de la región rotada; para
+  /// llevar una detección al frame completo sumar el origen de
+  /// [NativeCropRect.rotated].
+  final NativeCropRect? crop;
+
+  const NativeTensorResult({
+    required this.tensorBytes,
+    required this.scale,
+    required this.padLeft,
+    required this.padTop,
+    required this.newWidth,
+    required this.newHeight,
+    required this.imageWidth,
+    required this.imageHeight,
+    this.format = NativeTensorFormat.float32,
+    this.crop,
+  });
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// BUFFER NATIVO PERSISTENTE
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Buffer de memoria nativa reutilizado entre frames por el camino FFI.
+///
+/// Solo se realoca cuando cambia el tamaño requerido (p. ej. al cambiar la
+/// resolución de cámara), de modo que en régimen estable no hay reservas.
+class _NativeBuffer {
+  final NativeFfiBindings _ffi;
+  Pointer<Uint8> _pointer = nullptr;
+  int _length = 0;
+
+  _NativeBuffer(this._ffi);
+
+  /// Garantiza un buffer de exactamente [bytes] bytes.
+  Pointer<Uint8> ensure(int bytes) {
+    if (_length == bytes && _pointer.address != 0) return _pointer;
+
+    if (_pointer.address != 0) _ffi.free(_pointer.cast());
+    _pointer = _ffi.alloc(bytes).cast<Uint8>();
+    _length = _pointer.address != 0 ? bytes : 0;
+    return _pointer;
+  }
+
+  /// Vista Dart sobre la memoria nativa (sin copia).
+  Uint8List view() => _pointer.asTypedList(_length);
+}
+
+/// Anillo de buffers de salida respaldado por `nv_pool_*`.
+///
+/// Las vistas `Uint8List` de cada slot se crean una vez y se invalidan solo
+/// cuando cambia la generación del pool nativo (realocación por cambio de
+/// resolución o formato).
+class _NativePool {
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final List<Uint8List?> _views;
+  int _generation = -1;
+
+  _NativePool(this._ffi, int slotCount)
+      : _handle = _ffi.poolCreate(slotCount),
+        _views = List<Uint8List?>.filled(slotCount, null);
+
+  /// Reserva el siguiente slot; -1 si falla.
+  int acquire(int width, int height, int format) {
+    if (_handle.address == 0) return -1;
+    final slot = _ffi.poolAcquire(_handle, width, height, format);
+    if (slot < 0) return slot;
+
+    final generation = _ffi.poolGeneration(_handle);
+    if (generation != _generation) {
+      _views.fillRange(0, _views.length, null);
+      _generation = generation;
+    }
+    return slot;
+  }
+
+  /// Puntero nativo del slot.
+  Pointer<Uint8> data(int slot) => _ffi.poolSlotData(_handle, slot);
+
+  /// Vista Dart sobre el slot (sin copia).
+  Uint8List view(int slot) => _views[slot] ??=
+      _ffi.poolSlotData(_handle, slot).asTypedList(_ffi.poolSlotBytes(_handle));
 }
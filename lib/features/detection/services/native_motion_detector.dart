@@ -0,0 +1,81 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                        native_motion_detector.dart                            ║
+// ║          Puntaje nativo de cambio de escena sobre el plano Y                  ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Miniatura de luma 64×48 + SAD NEON contra el último frame inferido: la       ║
+// ║  detección en vivo salta la inferencia mientras el plato no cambia.           ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+
+import 'package:flutter/foundation.dart';
+
+import 'native_ffi_bindings.dart';
+
+/// Detector de cambios de escena respaldado por `nv_motion_*`.
+///
+/// [score] reduce el plano Y a una miniatura y la compara con la
+/// referencia; [commitReference] fija como referencia el frame que se va a
+/// inferir. Comparar contra el último frame inferido (y no contra el frame
+/// anterior) hace que un movimiento lento acumule puntaje hasta superar el
+/// umbral.
+///
+/// Solo disponible con FFI. Cada llamada a [score] es leaf y cuesta unas
+/// decenas de microsegundos, sin importar la resolución.
+class NativeMotionDetector {
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  bool _disposed = false;
+
+  NativeMotionDetector._(this._ffi, this._handle);
+
+  /// Crea el detector, o retorna `null` si FFI no está disponible.
+  static NativeMotionDetector? create() {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null) return null;
+
+    final handle = ffi.motionCreate();
+    if (handle.address == 0) return null;
+    return NativeMotionDetector._(ffi, handle);
+  }
+
+  /// Puntaje de cambio del frame respecto a la referencia, en niveles de luma
+  /// (0–255) de la región que más cambió.
+  ///
+  /// Retorna [NativeFfiBindings.motionNoReference] si aún no hay referencia
+  /// (primer frame, tras [reset] o tras un cambio de resolución) y un valor
+  /// negativo si el plano no es válido.
+  double score({
+    required Uint8List yBytes,
+    required int width,
+    required int height,
+    required int yRowStride,
+  }) {
+    if (_disposed) return -1;
+    return _ffi.motionScore(
+      _handle,
+      yBytes.address,
+      yBytes.length,
+      width,
+      height,
+      yRowStride,
+    );
+  }
+
+  /// Toma el último frame de [score] como referencia.
+  bool commitReference() {
+    if (_disposed) return false;
+    return _ffi.motionCommit(_handle) == NativeFfiBindings.ok;
+  }
+
+  /// Descarta la referencia: el próximo frame siempre se infiere.
+  void reset() {
+    if (!_disposed) _ffi.motionReset(_handle);
+  }
+
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _ffi.motionDestroy(_handle);
+  }
+}
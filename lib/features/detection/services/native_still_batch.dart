@@ -0,0 +1,211 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                          native_still_batch.dart                              ║
+// ║          Lote nativo de imágenes fijas → tensores YOLO contiguos              ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Un hilo C++ decodifica (AImageDecoder) y aplica el letterbox de cada         ║
+// ║  imagen de la galería mientras Dart infiere las que ya están listas.          ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:ffi';
+
+import 'package:flutter/foundation.dart';
+
+import '../../../core/logging/app_logger.dart';
+import 'native_ffi_bindings.dart';
+import 'native_image_processor.dart';
+
+/// Estado de una imagen de [NativeStillBatch].
+enum NativeStillStatus { pending, ready, failed }
+
+/// Lote de hasta [maxImages] imágenes respaldado por `nv_still_batch_*`.
+///
+/// [addEncoded] / [addRgba] copian la entrada a memoria nativa y retornan de
+/// inmediato; un hilo nativo procesa las imágenes en orden y escribe el
+/// tensor de cada una en un único buffer `[N, size, size, 3]` (o NCHW) en el
+/// formato del lote. El tensor de una imagen lista ya no cambia, así que la
+/// inferencia de la imagen i se solapa con la decodificación de la i+1.
+///
+/// Solo disponible con FFI.
+class NativeStillBatch {
+  static const String _tag = 'NativeStillBatch';
+
+  /// Imágenes máximas por lote (StillBatch::kMaxImages).
+  static const int maxImages = 16;
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final Pointer<Double> _info;
+
+  /// Imágenes que admite el lote.
+  final int capacity;
+  final int targetSize;
+
+  /// Tipo, cuantización y disposición de los tensores.
+  final NativeTensorFormat format;
+
+  bool _disposed = false;
+
+  NativeStillBatch._(
+    this._ffi,
+    this._handle,
+    this._info,
+    this.capacity,
+    this.targetSize,
+    this.format,
+  );
+
+  /// true si [addEncoded] puede decodificar (AImageDecoder, Android 11+).
+  /// Sin decodificador, decodificar en Dart y usar [addRgba].
+  static bool get decoderAvailable =>
+      (NativeFfiBindings.instance?.imageDecoderAvailable() ?? 0) == 1;
+
+  /// Crea el lote, o retorna `null` si FFI no está disponible o falla la
+  /// reserva nativa.
+  ///
+  /// [format] debe coincidir con el tensor de entrada del modelo: el buffer
+  /// ocupa `capacity × targetSize² × 3 × bytes por elemento`.
+  static NativeStillBatch? create({
+    required int capacity,
+    required int targetSize,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+  }) {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null || capacity <= 0 || capacity > maxImages) return null;
+
+    final handle = ffi.stillBatchCreate(
+      capacity,
+      targetSize,
+      format.type.index,
+      format.scale,
+      format.zeroPoint,
+      format.layout.index,
+    );
+    if (handle.address == 0) {
+      AppLogger.warning('No se pudo crear el lote nativo de imágenes',
+          tag: _tag);
+      return null;
+    }
+
+    final info =
+        ffi.alloc(NativeFfiBindings.stillInfoSize * 8).cast<Double>();
+    if (info.address == 0) {
+      ffi.stillBatchDestroy(handle);
+      return null;
+    }
+
+    return NativeStillBatch._(ffi, handle, info, capacity, targetSize, format);
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // PRODUCTOR
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Agrega un archivo JPEG/PNG/WebP para decodificar en nativo.
+  ///
+  /// Retorna el índice de la imagen en el lote, o -1 si está lleno o los
+  /// bytes no son válidos. Un archivo corrupto se reporta después como
+  /// [NativeStillStatus.failed].
+  int addEncoded(Uint8List bytes) {
+    if (_disposed || bytes.isEmpty) return -1;
+    return _ffi.stillBatchAddEncoded(_handle, bytes.address, bytes.length);
+  }
+
+  /// Agrega una imagen ya decodificada en RGBA8888 sin relleno entre filas
+  /// (`img.Image.getBytes(order: img.ChannelOrder.rgba)`).
+  int addRgba(Uint8List pixels, int width, int height) {
+    if (_disposed || pixels.length < width * height * 4) return -1;
+    return _ffi.stillBatchAddPixels(
+      _handle,
+      pixels.address,
+      width,
+      height,
+      width * 4,
+      NativeFfiBindings.pixelFormatRgba8888,
+    );
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // CONSUMIDOR
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Estado de la imagen [index], sin esperar.
+  NativeStillStatus status(int index) {
+    if (_disposed) return NativeStillStatus.failed;
+    switch (_ffi.stillBatchPoll(_handle, index, _info)) {
+      case NativeFfiBindings.stillPending:
+        return NativeStillStatus.pending;
+      case NativeFfiBindings.stillReady:
+        return NativeStillStatus.ready;
+      default:
+        return NativeStillStatus.failed;
+    }
+  }
+
+  /// Tensor y letterbox de la imagen [index], o `null` si aún no está lista
+  /// o falló. El tensor es una vista sobre el buffer del lote: válido hasta
+  /// [dispose].
+  NativeTensorResult? result(int index) {
+    if (status(index) != NativeStillStatus.ready) return null;
+
+    final info = _info.asTypedList(NativeFfiBindings.stillInfoSize);
+    final view = _ffi
+        .stillBatchTensor(_handle, index)
+        .cast<Uint8>()
+        .asTypedList(format.tensorBytes(targetSize));
+
+    return NativeTensorResult(
+      tensorBytes: view,
+      scale: info[0],
+      padLeft: info[1].toInt(),
+      padTop: info[2].toInt(),
+      newWidth: info[3].toInt(),
+      newHeight: info[4].toInt(),
+      imageWidth: info[5].toInt(),
+      imageHeight: info[6].toInt(),
+      format: format,
+    );
+  }
+
+  /// Espera hasta [timeout] a que la imagen [index] esté lista.
+  ///
+  /// Retorna `null` si falló o se agotó el tiempo. Sondea cada
+  /// [pollInterval] cediendo el isolate entre intentos.
+  Future<NativeTensorResult?> wait(
+    int index, {
+    Duration timeout = const Duration(seconds: 5),
+    Duration pollInterval = const Duration(milliseconds: 2),
+  }) async {
+    final stopwatch = Stopwatch()..start();
+    while (true) {
+      switch (status(index)) {
+        case NativeStillStatus.ready:
+          return result(index);
+        case NativeStillStatus.failed:
+          return null;
+        case NativeStillStatus.pending:
+          break;
+      }
+      if (stopwatch.elapsed >= timeout) return null;
+      await Future<void>.delayed(pollInterval);
+    }
+  }
+
+  /// Buffer contiguo de los [capacity] tensores (las imágenes no agregadas o
+  /// pendientes contienen datos sin definir).
+  Uint8List get tensorBytes {
+    if (_disposed) return Uint8List(0);
+    return _ffi
+        .stillBatchTensor(_handle, 0)
+        .cast<Uint8>()
+        .asTypedList(format.tensorBytes(targetSize) * capacity);
+  }
+
+  /// Detiene el hilo nativo y libera el buffer. Invalida los tensores
+  /// entregados.
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _ffi.stillBatchDestroy(_handle);
+    _ffi.free(_info.cast());
+  }
+}
@@ -0,0 +1,281 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                         native_video_source.dart                              ║
+// ║          Análisis de video nativo: AMediaCodec → tensores YOLO                ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Un hilo C++ decodifica el archivo y genera el tensor de cada frame           ║
+// ║  muestreado desde los buffers del códec; Dart solo recibe tensores listos.    ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:convert';
+import 'dart:ffi';
+
+import 'package:flutter/foundation.dart';
+
+import '../../../core/logging/app_logger.dart';
+import 'native_ffi_bindings.dart';
+import 'native_image_processor.dart';
+
+/// Estado de [NativeVideoSource].
+enum NativeVideoStatus { decoding, ended, failed }
+
+/// Video decodificado en nativo respaldado por `nv_video_*`.
+///
+/// AMediaExtractor + AMediaCodec decodifican en un hilo nativo y el tensor
+/// de 1 de cada [sampleEvery] frames se genera directamente desde el buffer
+/// YUV del códec: los frames no pasan por Dart. Los tensores se entregan en
+/// orden de video; con los [queueDepth] slots entregados o listos el hilo
+/// deja de decodificar, así que la memoria no crece aunque la inferencia
+/// sea más lenta que el video.
+///
+/// Solo disponible con FFI.
+class NativeVideoSource {
+  static const String _tag = 'NativeVideoSource';
+
+  /// Slots máximos del anillo (VideoDecoder::kMaxSlots).
+  static const int maxQueueDepth = 4;
+
+  final NativeFfiBindings _ffi;
+  final Pointer<Void> _handle;
+  final Pointer<Double> _info;
+  final Pointer<Int64> _stats;
+
+  final int sampleEvery;
+  final int queueDepth;
+  final int targetSize;
+
+  /// Tipo, cuantización y disposición de los tensores.
+  final NativeTensorFormat format;
+
+  /// Vistas por slot: el tensor de cada slot no se realoca.
+  final Map<int, Uint8List> _views = {};
+
+  bool _disposed = false;
+
+  NativeVideoSource._(
+    this._ffi,
+    this._handle,
+    this._info,
+    this._stats,
+    this.sampleEvery,
+    this.queueDepth,
+    this.targetSize,
+    this.format,
+  );
+
+  /// Abre [path] y arranca la decodificación, o retorna `null` si FFI no está
+  /// disponible o el archivo no tiene una pista de video decodificable.
+  ///
+  /// [format] debe coincidir con el tensor de entrada del modelo.
+  static NativeVideoSource? open(
+    String path, {
+    required int targetSize,
+    int sampleEvery = 1,
+    int queueDepth = 2,
+    NativeTensorFormat format = NativeTensorFormat.float32,
+  }) {
+    final ffi = NativeFfiBindings.instance;
+    if (ffi == null ||
+        sampleEvery <= 0 ||
+        queueDepth <= 0 ||
+        queueDepth > maxQueueDepth) {
+      return null;
+    }
+
+    // nv_video_open no es leaf: la ruta va en memoria nativa
+    final encoded = utf8.encode(path);
+    final pathPtr = ffi.alloc(encoded.length + 1).cast<Uint8>();
+    if (pathPtr.address == 0) return null;
+    pathPtr.asTypedList(encoded.length + 1)
+      ..setAll(0, encoded)
+      ..[encoded.length] = 0;
+
+    final handle = ffi.videoOpen(
+      pathPtr,
+      sampleEvery,
+      queueDepth,
+      targetSize,
+      format.type.index,
+      format.scale,
+      format.zeroPoint,
+      format.layout.index,
+    );
+    ffi.free(pathPtr.cast());
+    if (handle.address == 0) {
+      AppLogger.warning('No se pudo abrir el video en nativo', tag: _tag);
+      return null;
+    }
+
+    final info = ffi.alloc(NativeFfiBindings.videoInfoSize * 8).cast<Double>();
+    final stats =
+        ffi.alloc(NativeFfiBindings.videoStatsSize * 8).cast<Int64>();
+    if (info.address == 0 || stats.address == 0) {
+      if (info.address != 0) ffi.free(info.cast());
+      if (stats.address != 0) ffi.free(stats.cast());
+      ffi.videoClose(handle);
+      return null;
+    }
+
+    return NativeVideoSource._(ffi, handle, info, stats, sampleEvery,
+        queueDepth, targetSize, format);
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // CONSUMIDOR
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// [NativeVideoStatus.decoding] mientras queden frames por entregar.
+  NativeVideoStatus get status {
+    if (_disposed) return NativeVideoStatus.failed;
+    switch (_ffi.videoState(_handle)) {
+      case NativeFfiBindings.videoDecoding:
+        return NativeVideoStatus.decoding;
+      case NativeFfiBindings.videoEnded:
+        return NativeVideoStatus.ended;
+      default:
+        return NativeVideoStatus.failed;
+    }
+  }
+
+  /// Siguiente frame listo, o `null` si aún no hay ninguno.
+  ///
+  /// El tensor es estable hasta [release]; devolverlo en cuanto termine la
+  /// inferencia para que el hilo siga decodificando.
+  VideoFrameTensor? tryNext() {
+    if (_disposed) return null;
+    final slot = _ffi.videoAcquire(_handle, _info);
+    if (slot < 0) return null;
+
+    final info = _info.asTypedList(NativeFfiBindings.videoInfoSize);
+    final view = _views[slot] ??= _ffi
+        .videoTensor(_handle, slot)
+        .cast<Uint8>()
+        .asTypedList(format.tensorBytes(targetSize));
+
+    return VideoFrameTensor._(
+      slot: slot,
+      frameIndex: info[0].toInt(),
+      position: Duration(microseconds: info[1].toInt()),
+      latencyMs: info[9] / 1e6,
+      tensor: NativeTensorResult(
+        tensorBytes: view,
+        scale: info[2],
+        padLeft: info[3].toInt(),
+        padTop: info[4].toInt(),
+        newWidth: info[5].toInt(),
+        newHeight: info[6].toInt(),
+        imageWidth: info[7].toInt(),
+        imageHeight: info[8].toInt(),
+        format: format,
+      ),
+    );
+  }
+
+  /// Espera el siguiente frame.
+  ///
+  /// Retorna `null` al terminar el video, si la decodificación falló o si
+  /// pasó [timeout] sin frames nuevos. Sondea cada [pollInterval] cediendo el
+  /// isolate entre intentos.
+  Future<VideoFrameTensor?> next({
+    Duration timeout = const Duration(seconds: 5),
+    Duration pollInterval = const Duration(milliseconds: 2),
+  }) async {
+    final stopwatch = Stopwatch()..start();
+    while (true) {
+      final frame = tryNext();
+      if (frame != null) return frame;
+      if (status != NativeVideoStatus.decoding) return null;
+      if (stopwatch.elapsed >= timeout) return null;
+      await Future<void>.delayed(pollInterval);
+    }
+  }
+
+  /// Devuelve el slot de [frame] para que el hilo lo reutilice.
+  void release(VideoFrameTensor frame) {
+    if (_disposed) return;
+    _ffi.videoRelease(_handle, frame.slot);
+  }
+
+  /// Contadores de la decodificación.
+  VideoDecodeStats stats() {
+    if (_disposed) return const VideoDecodeStats.empty();
+    final written =
+        _ffi.videoStats(_handle, _stats, NativeFfiBindings.videoStatsSize);
+    if (written < NativeFfiBindings.videoStatsSize) {
+      return const VideoDecodeStats.empty();
+    }
+    final values = _stats.asTypedList(NativeFfiBindings.videoStatsSize);
+    return VideoDecodeStats(
+      decoded: values[0],
+      sampled: values[1],
+      duration: Duration(microseconds: values[2]),
+    );
+  }
+
+  /// Detiene el hilo nativo y libera el códec y los slots. Invalida los
+  /// tensores entregados.
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _views.clear();
+    _ffi.videoClose(_handle);
+    _ffi.free(_info.cast());
+    _ffi.free(_stats.cast());
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+// RESULTADOS
+// ═══════════════════════════════════════════════════════════════════════════════
+
+/// Tensor de un frame entregado por [NativeVideoSource.tryNext].
+class VideoFrameTensor {
+  /// Slot nativo (se devuelve con [NativeVideoSource.release]).
+  final int slot;
+
+  /// Índice del frame en el video, contando los no muestreados.
+  final int frameIndex;
+
+  /// Instante del frame en el video.
+  final Duration position;
+
+  /// Tiempo desde que el códec entregó el frame hasta el tensor.
+  final double latencyMs;
+
+  /// Tensor (vista sobre el slot) y letterbox.
+  final NativeTensorResult tensor;
+
+  const VideoFrameTensor._({
+    required this.slot,
+    required this.frameIndex,
+    required this.position,
+    required this.latencyMs,
+    required this.tensor,
+  });
+}
+
+/// Contadores de [NativeVideoSource].
+class VideoDecodeStats {
+  /// Frames entregados por el códec.
+  final int decoded;
+
+  /// Frames convertidos a tensor.
+  final int sampled;
+
+  /// Duración declarada por el contenedor (cero si no la declara).
+  final Duration duration;
+
+  const VideoDecodeStats({
+    required this.decoded,
+    required this.sampled,
+    required this.duration,
+  });
+
+  const VideoDecodeStats.empty()
+      : decoded = 0,
+        sampled = 0,
+        duration = Duration.zero;
+
+  @override
+  String toString() => 'decodificados: $decoded, muestreados: $sampled, '
+      'duración: ${duration.inMilliseconds} ms';
+}
@@ -11,7 +11,9 @@
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
 import 'dart:async' show Completer;
+import 'dart:ffi';
 import 'dart:math';
+import 'dart:typed_data';
 
 import 'package:flutter/foundation.dart' show kDebugMode;
 import 'package:flutter/services.dart' show rootBundle;
@@ -21,7 +23,13 @@ import 'package:tflite_flutter/tflite_flutter.dart';
 import '../../../core/exceptions/app_exceptions.dart';
 import '../../../core/logging/app_logger.dart';
 import '../../../data/models/detection.dart';
+import 'delegate_probe_cache.dart';
 import 'detection_debug_helper.dart';
+import 'native_ffi_bindings.dart';
+import 'native_gpu_delegate.dart';
+import 'native_image_processor.dart';
+import 'native_still_batch.dart';
+import 'native_video_source.dart';
 
 /// Fuente de la imagen para detección.
 enum DetectionSource {
@@ -48,11 +56,21 @@ class YoloDetector {
   /// y elimine demasiadas detecciones en modo LIVE.
   static const double defaultIouThreshold = 0.30;
   static const String modelPath = 'assets/models/yolov11n_float32.tflite';
+  static const String modelMd5Path = 'assets/models/yolov11n_float32.md5';
   static const String labelsPath = 'assets/labels/labels.txt';
 
-  // Optimización: límite de detecciones antes de NMS para reducir O(n²)
-  // Reducido de 200 a 50 para mejorar rendimiento
-  static const int maxDetectionsBeforeNms = 50;
+  /// Candidatos de mayor score que entran al NMS (kMaxNmsCandidates nativo).
+  static const int maxNmsCandidates = 1024;
+
+  /// Detecciones máximas devueltas tras el NMS.
+  static const int maxDetections = 300;
+
+  /// Preprocesado en compute shader GLES 3.1 junto al delegate GPU
+  /// (`--dart-define=NV_GPU_PREPROCESS=true`). Opcional hasta que un
+  /// benchmark muestre que supera al kernel NEON con hilos: el tensor no se
+  /// puede enlazar al intérprete, así que cada frame paga subida de planos,
+  /// dispatch, lectura bloqueante del SSBO y la misma copia que el CPU.
+  static const bool gpuPreprocess = bool.fromEnvironment('NV_GPU_PREPROCESS');
 
   // ═══════════════════════════════════════════════════════════════════════════
   // PROPIEDADES PRIVADAS
@@ -66,8 +84,22 @@ class YoloDetector {
   // Completer para prevenir inicializaciones concurrentes
   Completer<void>? _initializationCompleter;
 
-  List<List<List<List<double>>>>? _inputTensor;
-  List<List<List<double>>>? _outputTensor;
+  /// Tensor de entrada plano `[1, 640, 640, 3]` (o `[1, 3, 640, 640]` en
+  /// NCHW) en el tipo y la disposición del modelo ([_inputFormat]).
+  Uint8List? _inputBytes;
+
+  /// Tipo y cuantización del tensor de entrada, leídos del intérprete.
+  NativeTensorFormat _inputFormat = NativeTensorFormat.float32;
+
+  /// Tensor de salida plano `[1, 87, 8400]`; el intérprete copia sus bytes
+  /// en [_outputBytes] y el postprocesado lee [_outputTensor] (float32; si
+  /// la salida está cuantizada se decuantiza tras cada inferencia).
+  Uint8List? _outputBytes;
+  Float32List? _outputTensor;
+  NativeTensorFormat _outputFormat = NativeTensorFormat.float32;
+
+  /// Salida empaquetada del decodificador nativo.
+  Float32List? _detectionBuffer;
 
   // Contador de inferencias para logging periódico
   int _inferenceCounter = 0;
@@ -75,14 +107,38 @@ class YoloDetector {
   // Contador de validación para logging LIVE (cada 30 frames)
   int _validationCounter = 0;
 
+  // true si la inferencia corre con GpuDelegateV2
+  bool _usesGpuDelegate = false;
+
+  // GPU delegate del intérprete: se destruye después de cerrarlo
+  Delegate? _gpuDelegate;
+
+  // Duración por etapa de la última inferencia (µs), para benchmarks
+  int _lastRunMicros = 0;
+  int _lastPostprocessMicros = 0;
+
   // ═══════════════════════════════════════════════════════════════════════════
   // PROPIEDADES PÚBLICAS
   // ═══════════════════════════════════════════════════════════════════════════
 
   bool get isInitialized => _isInitialized;
+
+  /// Indica si la inferencia corre en la GPU (GpuDelegateV2).
+  bool get usesGpuDelegate => _usesGpuDelegate;
+
+  /// Tipo y disposición del tensor de entrada: el preprocesado nativo debe
+  /// generarlo así.
+  NativeTensorFormat get inputFormat => _inputFormat;
   List<String> get labels => List.unmodifiable(_labels);
   int get labelCount => _labels.length;
 
+  /// Duración de `Interpreter.run` en la última inferencia (µs).
+  int get lastInterpreterRunMicros => _lastRunMicros;
+
+  /// Duración de decuantización, decodificación y NMS en la última
+  /// inferencia (µs).
+  int get lastPostprocessMicros => _lastPostprocessMicros;
+
   // ═══════════════════════════════════════════════════════════════════════════
   // INICIALIZACIÓN
   // ═══════════════════════════════════════════════════════════════════════════
@@ -129,72 +185,100 @@ class YoloDetector {
   }
 
   /// Realiza la inicialización con fallback GPU → CPU.
+  ///
+  /// El resultado del sondeo se persiste por dispositivo y MD5 del modelo
+  /// ([DelegateProbeCache]): si la GPU falló (o el proceso murió probándola)
+  /// los arranques siguientes van directos a XNNPack. Con GPU, los kernels
+  /// compilados se cargan de la caché de [NativeGpuDelegate].
   Future<void> _performInitialization() async {
     Interpreter? tempInterpreter;
-    GpuDelegateV2? gpuDelegate;
+    Delegate? gpuDelegate;
     String delegateUsed = 'None';
+    Object? gpuError;
+
+    final probeCache = await DelegateProbeCache.open(modelMd5Path);
 
     // ═══════════════════════════════════════════════════════════════════════════
     // INTENTO 1: GPU DELEGATE
     // ═══════════════════════════════════════════════════════════════════════════
 
-    try {
-      AppLogger.info('INIT GPU START', tag: _tag);
-
-      final gpuOptions = InterpreterOptions();
-      gpuOptions.threads = 4;
+    if (probeCache?.skipGpu ?? false) {
+      gpuError = 'omitido (falló en un arranque anterior)';
+      AppLogger.info('INIT GPU SKIP - sondeo previo: CPU', tag: _tag);
+    } else {
+      // Si el driver mata el proceso, el pendiente queda guardado
+      await probeCache?.save(DelegateProbeResult.gpuPending);
 
-      // Crear GPU delegate
-      gpuDelegate = GpuDelegateV2(
-        options: GpuDelegateOptionsV2(
-          isPrecisionLossAllowed: false, // Mantener FP32
-        ),
-      );
-      gpuOptions.addDelegate(gpuDelegate);
-      AppLogger.debug('GPU delegate created', tag: _tag);
-
-      // Cargar modelo
-      tempInterpreter = await Interpreter.fromAsset(
-        modelPath,
-        options: gpuOptions,
-      );
-      AppLogger.debug('Interpreter.fromAsset OK (GPU)', tag: _tag);
-
-      // Allocate tensors
-      tempInterpreter.allocateTensors();
-      AppLogger.debug('GPU allocateTensors OK', tag: _tag);
+      try {
+        AppLogger.info('INIT GPU START', tag: _tag);
+
+        final gpuOptions = InterpreterOptions();
+        gpuOptions.threads = 4;
+
+        // Crear GPU delegate (con caché de kernels si está disponible)
+        final modelToken = probeCache?.modelMd5;
+        gpuDelegate = (modelToken != null
+                ? await NativeGpuDelegate.create(modelToken: modelToken)
+                : null) ??
+            GpuDelegateV2(
+              options: GpuDelegateOptionsV2(
+                isPrecisionLossAllowed: false, // Mantener FP32
+              ),
+            );
+        gpuOptions.addDelegate(gpuDelegate);
+        AppLogger.debug('GPU delegate created (${gpuDelegate.runtimeType})',
+            tag: _tag);
+
+        // Cargar modelo
+        tempInterpreter = await Interpreter.fromAsset(
+          modelPath,
+          options: gpuOptions,
+        );
+        AppLogger.debug('Interpreter.fromAsset OK (GPU)', tag: _tag);
 
-      // Test de inferencia
-      _testInference(tempInterpreter);
-      AppLogger.debug('GPU test inference OK', tag: _tag);
+        // Allocate tensors
+        tempInterpreter.allocateTensors();
+        AppLogger.debug('GPU allocateTensors OK', tag: _tag);
 
-      delegateUsed = 'GPU (GpuDelegateV2)';
-      AppLogger.info('INIT GPU OK', tag: _tag);
-    } catch (eGpu, stackGpu) {
-      // ═══════════════════════════════════════════════════════════════════════════
-      // GPU FALLÓ - LOG ERROR Y LIMPIAR RECURSOS
-      // ═══════════════════════════════════════════════════════════════════════════
+        // Test de inferencia
+        _testInference(tempInterpreter);
+        AppLogger.debug('GPU test inference OK', tag: _tag);
+
+        delegateUsed = 'GPU (GpuDelegateV2)';
+        _usesGpuDelegate = true;
+        _gpuDelegate = gpuDelegate;
+        await probeCache?.save(DelegateProbeResult.gpu);
+        AppLogger.info('INIT GPU OK', tag: _tag);
+      } catch (eGpu, stackGpu) {
+        // ═══════════════════════════════════════════════════════════════════════════
+        // GPU FALLÓ - LOG ERROR Y LIMPIAR RECURSOS
+        // ═══════════════════════════════════════════════════════════════════════════
 
-      AppLogger.error(
-        'INIT GPU FAIL - Fallback to CPU',
-        tag: _tag,
-        error: eGpu,
-      );
-      AppLogger.debug('GPU error stack: $stackGpu', tag: _tag);
+        AppLogger.error(
+          'INIT GPU FAIL - Fallback to CPU',
+          tag: _tag,
+          error: eGpu,
+        );
+        AppLogger.debug('GPU error stack: $stackGpu', tag: _tag);
+        gpuError = eGpu;
+        await probeCache?.save(DelegateProbeResult.cpu);
 
-      // Limpiar recursos GPU
-      try {
-        tempInterpreter?.close();
-        gpuDelegate?.delete();
-      } catch (eCleanup) {
-        AppLogger.warning('Error limpiando GPU: $eCleanup', tag: _tag);
+        // Limpiar recursos GPU
+        try {
+          tempInterpreter?.close();
+          gpuDelegate?.delete();
+        } catch (eCleanup) {
+          AppLogger.warning('Error limpiando GPU: $eCleanup', tag: _tag);
+        }
+        tempInterpreter = null;
       }
-      tempInterpreter = null;
+    }
 
-      // ═══════════════════════════════════════════════════════════════════════════
-      // INTENTO 2: CPU (XNNPack) FALLBACK
-      // ═══════════════════════════════════════════════════════════════════════════
+    // ═══════════════════════════════════════════════════════════════════════════
+    // INTENTO 2: CPU (XNNPack) FALLBACK
+    // ═══════════════════════════════════════════════════════════════════════════
 
+    if (tempInterpreter == null) {
       try {
         AppLogger.info('FALLBACK CPU START', tag: _tag);
 
@@ -241,7 +325,7 @@ class YoloDetector {
         tempInterpreter = null;
 
         throw ModelLoadException(
-          message: 'Falló inicialización GPU y CPU:\nGPU: $eGpu\nCPU: $eCpu',
+          message: 'Falló inicialización GPU y CPU:\nGPU: $gpuError\nCPU: $eCpu',
           modelPath: modelPath,
           originalError: eCpu,
           stackTrace: stackCpu,
@@ -288,6 +372,17 @@ class YoloDetector {
 
     _preallocateTensors();
 
+    // ═══════════════════════════════════════════════════════════════════════════
+    // BACKEND DE PREPROCESADO
+    // ═══════════════════════════════════════════════════════════════════════════
+
+    // CPU por defecto; GLES 3.1 solo si se pidió ([gpuPreprocess]) y la
+    // inferencia ya corre en GPU. Cada frame que falle vuelve al kernel CPU
+    final preprocessBackend = gpuPreprocess && _usesGpuDelegate
+        ? NativePreprocessBackend.gpu
+        : NativePreprocessBackend.cpu;
+    await NativeImageProcessor.setPreprocessBackend(preprocessBackend);
+
     // ═══════════════════════════════════════════════════════════════════════════
     // LOG FINAL
     // ═══════════════════════════════════════════════════════════════════════════
@@ -299,8 +394,9 @@ class YoloDetector {
       'YoloDetector inicializado',
       [
         'Config: 4 threads + $delegateUsed',
+        'Preprocesado nativo: ${preprocessBackend.name}',
         'Modelo: ${modelPath.split('/').last}',
-        'Input: $inputShape',
+        'Input: $inputShape ($_inputFormat)',
         'Output: $outputShape',
         'Labels: ${_labels.length} clases',
       ],
@@ -314,26 +410,10 @@ class YoloDetector {
   /// Lanza exception si la inferencia falla.
   void _testInference(Interpreter interpreter) {
     try {
-      // Crear tensor dummy de entrada [1, 640, 640, 3]
-      final dummyInput = List.generate(
-        1,
-        (_) => List.generate(
-          640,
-          (_) => List.generate(
-            640,
-            (_) => List.filled(3, 0.0),
-          ),
-        ),
-      );
-
-      // Crear tensor dummy de salida [1, 87, 8400]
-      final dummyOutput = List.generate(
-        1,
-        (_) => List.generate(
-          87,
-          (_) => List.filled(8400, 0.0),
-        ),
-      );
+      // Buffers dummy del tamaño en bytes de cada tensor: vale para modelos
+      // float32, float16 y cuantizados
+      final dummyInput = Uint8List(interpreter.getInputTensor(0).numBytes());
+      final dummyOutput = Uint8List(interpreter.getOutputTensor(0).numBytes());
 
       // Ejecutar inferencia
       interpreter.run(dummyInput, dummyOutput);
@@ -347,24 +427,54 @@ class YoloDetector {
   }
 
   void _preallocateTensors() {
-    _inputTensor = List.generate(
-      1,
-      (_) => List.generate(
-        inputSize,
-        (_) => List.generate(
-          inputSize,
-          (_) => List.filled(3, 0.0),
-        ),
-      ),
-    );
+    _inputFormat = _tensorFormat(_interpreter!.getInputTensor(0));
+    _outputFormat = _tensorFormat(_interpreter!.getOutputTensor(0));
 
-    _outputTensor = List.generate(
-      1,
-      (_) => List.generate(
-        4 + numClasses,
-        (_) => List.filled(numPredictions, 0.0),
-      ),
-    );
+    _inputBytes = Uint8List(_inputFormat.tensorBytes(inputSize));
+
+    _outputTensor = Float32List((4 + numClasses) * numPredictions);
+    _outputBytes = _outputFormat.isQuantized
+        ? Uint8List(_outputTensor!.length)
+        : _outputTensor!.buffer.asUint8List();
+  }
+
+  /// Formato de un tensor del intérprete. Lanza [ModelException] si el tipo
+  /// no es float32, float16, uint8 o int8.
+  ///
+  /// La disposición solo importa para la entrada: `[1, 3, H, W]` es NCHW
+  /// (exportes ONNX/NNAPI), cualquier otra forma se trata como NHWC.
+  static NativeTensorFormat _tensorFormat(Tensor tensor) {
+    final shape = tensor.shape;
+    final layout = shape.length == 4 && shape[1] == 3 && shape[3] != 3
+        ? NativeTensorLayout.nchw
+        : NativeTensorLayout.nhwc;
+
+    switch (tensor.type) {
+      case TensorType.float32:
+        return NativeTensorFormat(NativeTensorType.float32, layout: layout);
+      case TensorType.float16:
+        return NativeTensorFormat(NativeTensorType.float16, layout: layout);
+      case TensorType.uint8:
+      case TensorType.int8:
+        final params = tensor.params;
+        if (params.scale <= 0) {
+          throw ModelException(
+            message: 'Tensor ${tensor.name} cuantizado sin escala',
+          );
+        }
+        return NativeTensorFormat(
+          tensor.type == TensorType.uint8
+              ? NativeTensorType.uint8
+              : NativeTensorType.int8,
+          scale: params.scale,
+          zeroPoint: params.zeroPoint,
+          layout: layout,
+        );
+      default:
+        throw ModelException(
+          message: 'Tipo de tensor no soportado: ${tensor.type}',
+        );
+    }
   }
 
   // ═══════════════════════════════════════════════════════════════════════════
@@ -404,60 +514,84 @@ class YoloDetector {
       final preprocessResult = _preprocess(image);
       stopwatchPreprocess.stop();
 
-      // NOTA: No guardamos imagen preprocesada porque ya está en tensor Float32List
+      // NOTA: No guardamos imagen preprocesada porque ya está en el tensor
       // (requeriría reconstrucción compleja desde el tensor)
 
-      final stopwatchRun = Stopwatch()..start();
-      _interpreter!.run(_inputTensor!, _outputTensor!);
-      stopwatchRun.stop();
-
-      final stopwatchPostprocess = Stopwatch()..start();
-      final detections = _postprocess(
-        _outputTensor!,
+      return _runInference(
+        _inputBytes!,
         preprocessResult,
         image.width,
         image.height,
         confidenceThreshold,
         iouThreshold,
         verbose: verbose,
+        preprocessMs: stopwatchPreprocess.elapsedMilliseconds,
       );
-      stopwatchPostprocess.stop();
-
-      _inferenceCounter++;
-
-      // Loggear cada 10 inferencias para no saturar
-      if (verbose && _inferenceCounter % 10 == 0) {
-        AppLogger.tree(
-          'YOLO Metrics (Inference #$_inferenceCounter)',
-          [
-            'Preprocess: ${stopwatchPreprocess.elapsedMilliseconds}ms',
-            'Interpreter.run: ${stopwatchRun.elapsedMilliseconds}ms',
-            'Postprocess+NMS: ${stopwatchPostprocess.elapsedMilliseconds}ms',
-            'Total YOLO: ${stopwatchPreprocess.elapsedMilliseconds + stopwatchRun.elapsedMilliseconds + stopwatchPostprocess.elapsedMilliseconds}ms',
-            'Detecciones: ${detections.length}',
-          ],
-          tag: _tag,
-        );
-      } else if (verbose) {
-        // Log resumido de detección
-        final items = <String>[
-          'Imagen: ${image.width}x${image.height}',
-          'Scale: ${preprocessResult.scale.toStringAsFixed(3)}',
-          'Detecciones: ${detections.length}',
-        ];
+    } on NutriVisionException {
+      rethrow;
+    } catch (e, stackTrace) {
+      throw InferenceException(
+        message: 'Error durante la inferencia: $e',
+        originalError: e,
+        stackTrace: stackTrace,
+      );
+    }
+  }
 
-        // Agregar primeras detecciones si hay
-        if (kDebugMode && detections.isNotEmpty) {
-          for (int i = 0; i < min(3, detections.length); i++) {
-            final d = detections[i];
-            items.add('${d.label}: ${d.confidenceFormatted}');
-          }
-        }
+  /// Detecta objetos a partir de un tensor ya preprocesado en nativo.
+  ///
+  /// Usado por el pipeline LIVE fusionado (YUV → tensor en C++), donde no
+  /// existe `img.Image`. Los parámetros de letterbox son los devueltos por
+  /// el preprocesado nativo y se usan igual que los de [_preprocess].
+  ///
+  /// [tensorBytes] - Tensor de entrada en [inputFormat] (tipo y disposición)
+  /// [imageWidth] / [imageHeight] - Dimensiones de la imagen ya rotada
+  Future<List<Detection>> detectFromTensor({
+    required Uint8List tensorBytes,
+    required double scale,
+    required int padLeft,
+    required int padTop,
+    required int newWidth,
+    required int newHeight,
+    required int imageWidth,
+    required int imageHeight,
+    double? confidenceThreshold,
+    double? iouThreshold,
+  }) async {
+    if (_isDisposed) {
+      throw ModelDisposedException();
+    }
 
-        AppLogger.tree('Detección completada', items, tag: _tag);
-      }
+    if (!_isInitialized || _interpreter == null) {
+      throw ModelNotInitializedException();
+    }
+
+    final expectedBytes = _inputFormat.tensorBytes(inputSize);
+    if (tensorBytes.length != expectedBytes) {
+      throw PreprocessingException(
+        message: 'Tensor nativo inválido: ${tensorBytes.length} bytes '
+            '(esperado $expectedBytes)',
+      );
+    }
 
-      return detections;
+    _validationCounter++;
+
+    try {
+      return _runInference(
+        tensorBytes,
+        _PreprocessResult(
+          scale: scale,
+          padLeft: padLeft,
+          padTop: padTop,
+          newWidth: newWidth,
+          newHeight: newHeight,
+        ),
+        imageWidth,
+        imageHeight,
+        confidenceThreshold ?? defaultConfidenceThreshold,
+        iouThreshold ?? defaultIouThreshold,
+        verbose: false,
+      );
     } on NutriVisionException {
       rethrow;
     } catch (e, stackTrace) {
@@ -469,6 +603,76 @@ class YoloDetector {
     }
   }
 
+  /// Ejecuta el interpreter sobre un tensor de entrada y postprocesa.
+  ///
+  /// Común a [detect] (preprocesado Dart) y [detectFromTensor] (nativo).
+  List<Detection> _runInference(
+    Uint8List inputBytes,
+    _PreprocessResult preprocessResult,
+    int imageWidth,
+    int imageHeight,
+    double confidenceThreshold,
+    double iouThreshold, {
+    required bool verbose,
+    int preprocessMs = 0,
+  }) {
+    final stopwatchRun = Stopwatch()..start();
+    _interpreter!.run(inputBytes, _outputBytes!);
+    stopwatchRun.stop();
+
+    final stopwatchPostprocess = Stopwatch()..start();
+    if (_outputFormat.isQuantized) _dequantizeOutput();
+
+    final detections = _postprocess(
+      _outputTensor!,
+      preprocessResult,
+      imageWidth,
+      imageHeight,
+      confidenceThreshold,
+      iouThreshold,
+      verbose: verbose,
+    );
+    stopwatchPostprocess.stop();
+
+    _inferenceCounter++;
+    _lastRunMicros = stopwatchRun.elapsedMicroseconds;
+    _lastPostprocessMicros = stopwatchPostprocess.elapsedMicroseconds;
+
+    // Loggear cada 10 inferencias para no saturar
+    if (verbose && _inferenceCounter % 10 == 0) {
+      AppLogger.tree(
+        'YOLO Metrics (Inference #$_inferenceCounter)',
+        [
+          'Preprocess: ${preprocessMs}ms',
+          'Interpreter.run: ${stopwatchRun.elapsedMilliseconds}ms',
+          'Postprocess+NMS: ${stopwatchPostprocess.elapsedMilliseconds}ms',
+          'Total YOLO: ${preprocessMs + stopwatchRun.elapsedMilliseconds + stopwatchPostprocess.elapsedMilliseconds}ms',
+          'Detecciones: ${detections.length}',
+        ],
+        tag: _tag,
+      );
+    } else if (verbose) {
+      // Log resumido de detección
+      final items = <String>[
+        'Imagen: ${imageWidth}x$imageHeight',
+        'Scale: ${preprocessResult.scale.toStringAsFixed(3)}',
+        'Detecciones: ${detections.length}',
+      ];
+
+      // Agregar primeras detecciones si hay
+      if (kDebugMode && detections.isNotEmpty) {
+        for (int i = 0; i < min(3, detections.length); i++) {
+          final d = detections[i];
+          items.add('${d.label}: ${d.confidenceFormatted}');
+        }
+      }
+
+      AppLogger.tree('Detección completada', items, tag: _tag);
+    }
+
+    return detections;
+  }
+
   /// Detecta objetos desde diferentes fuentes con pipeline unificado y logging.
   ///
   /// Esta función wrapper unifica el logging para validar que PHOTO y LIVE
@@ -526,6 +730,232 @@ class YoloDetector {
     );
   }
 
+  // ═══════════════════════════════════════════════════════════════════════════
+  // LOTE DE IMÁGENES FIJAS
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Detecta objetos en varias imágenes codificadas (JPEG/PNG) de la galería.
+  ///
+  /// Con FFI, las imágenes se decodifican y preprocesan en un hilo nativo
+  /// ([NativeStillBatch]) en grupos de [NativeStillBatch.maxImages]: mientras
+  /// se infiere la imagen i ya se prepara la i+1. AImageDecoder decodifica
+  /// ya reducido al tamaño del letterbox y con la orientación EXIF aplicada;
+  /// sin él (Android < 11) la decodificación se hace en Dart y solo el
+  /// letterbox es nativo. Las cajas quedan en coordenadas de la imagen
+  /// orientada a resolución completa. Las
+  /// imágenes que el lote no pudo procesar, o todas si no hay FFI, pasan por
+  /// el pipeline Dart de [detectFromSource].
+  ///
+  /// Retorna un resultado por imagen, en el mismo orden; `null` si la imagen
+  /// no se pudo decodificar.
+  Future<List<StillDetectionResult?>> detectStillBatch(
+    List<Uint8List> encodedImages, {
+    double? confidenceThreshold,
+    double? iouThreshold,
+  }) async {
+    if (_isDisposed) {
+      throw ModelDisposedException();
+    }
+
+    if (!_isInitialized || _interpreter == null) {
+      throw ModelNotInitializedException();
+    }
+
+    final results =
+        List<StillDetectionResult?>.filled(encodedImages.length, null);
+    final useNative = NativeFfiBindings.instance != null;
+    final nativeDecode = useNative && NativeStillBatch.decoderAvailable;
+
+    for (int start = 0;
+        start < encodedImages.length;
+        start += NativeStillBatch.maxImages) {
+      final end =
+          min(start + NativeStillBatch.maxImages, encodedImages.length);
+      final batch = useNative
+          ? NativeStillBatch.create(
+              capacity: end - start,
+              targetSize: inputSize,
+              format: _inputFormat,
+            )
+          : null;
+
+      try {
+        // Encolar todo el grupo: el hilo nativo avanza mientras se infiere
+        final indices = <int>[];
+        for (int i = start; i < end; i++) {
+          indices.add(batch == null
+              ? -1
+              : _addStill(batch, encodedImages[i], nativeDecode));
+        }
+
+        for (int i = start; i < end; i++) {
+          final index = indices[i - start];
+          final tensor = index >= 0 ? await batch!.wait(index) : null;
+          if (tensor == null) {
+            results[i] = await _detectStillDart(
+              encodedImages[i],
+              confidenceThreshold,
+              iouThreshold,
+            );
+            continue;
+          }
+
+          final detections = await detectFromTensor(
+            tensorBytes: tensor.tensorBytes,
+            scale: tensor.scale,
+            padLeft: tensor.padLeft,
+            padTop: tensor.padTop,
+            newWidth: tensor.newWidth,
+            newHeight: tensor.newHeight,
+            imageWidth: tensor.imageWidth,
+            imageHeight: tensor.imageHeight,
+            confidenceThreshold: confidenceThreshold,
+            iouThreshold: iouThreshold,
+          );
+          results[i] = StillDetectionResult(
+            detections: detections,
+            imageWidth: tensor.imageWidth,
+            imageHeight: tensor.imageHeight,
+          );
+        }
+      } finally {
+        batch?.dispose();
+      }
+    }
+
+    return results;
+  }
+
+  /// Agrega una imagen al lote: el archivo tal cual si hay AImageDecoder, o
+  /// los píxeles RGBA decodificados en Dart. Retorna -1 si no se pudo.
+  int _addStill(NativeStillBatch batch, Uint8List bytes, bool nativeDecode) {
+    if (nativeDecode) return batch.addEncoded(bytes);
+
+    final image = _decodeOriented(bytes);
+    if (image == null) return -1;
+    return batch.addRgba(
+      image.getBytes(order: img.ChannelOrder.rgba),
+      image.width,
+      image.height,
+    );
+  }
+
+  /// Decodifica en Dart aplicando la orientación EXIF, igual que
+  /// AImageDecoder en el camino nativo.
+  static img.Image? _decodeOriented(Uint8List bytes) {
+    final image = img.decodeImage(bytes);
+    return image == null ? null : img.bakeOrientation(image);
+  }
+
+  /// Pipeline Dart completo para una imagen del lote.
+  Future<StillDetectionResult?> _detectStillDart(
+    Uint8List bytes,
+    double? confidenceThreshold,
+    double? iouThreshold,
+  ) async {
+    final image = _decodeOriented(bytes);
+    if (image == null) return null;
+
+    final detections = await detectFromSource(
+      source: DetectionSource.photo,
+      image: image,
+      confidenceThreshold: confidenceThreshold,
+      iouThreshold: iouThreshold,
+    );
+    return StillDetectionResult(
+      detections: detections,
+      imageWidth: image.width,
+      imageHeight: image.height,
+    );
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // ANÁLISIS DE VIDEO
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Detecta objetos en 1 de cada [sampleEvery] frames de un archivo de video.
+  ///
+  /// [NativeVideoSource] decodifica con AMediaCodec en un hilo nativo y
+  /// prepara el tensor de cada frame muestreado desde el buffer del códec
+  /// mientras se infiere el anterior: los frames no se copian a Dart. Emite
+  /// un resultado por frame muestreado, en orden de video; cancelar la
+  /// suscripción detiene la decodificación.
+  ///
+  /// Throws [VideoDecodeException] si no hay FFI, el archivo no tiene una
+  /// pista de video decodificable o la decodificación se interrumpe.
+  Stream<VideoFrameDetections> detectVideo(
+    String path, {
+    int sampleEvery = 1,
+    double? confidenceThreshold,
+    double? iouThreshold,
+  }) async* {
+    if (_isDisposed) {
+      throw ModelDisposedException();
+    }
+
+    if (!_isInitialized || _interpreter == null) {
+      throw ModelNotInitializedException();
+    }
+
+    final source = NativeVideoSource.open(
+      path,
+      targetSize: inputSize,
+      sampleEvery: sampleEvery,
+      format: _inputFormat,
+    );
+    if (source == null) {
+      throw VideoDecodeException(
+        message: 'No se pudo abrir el video',
+        filePath: path,
+      );
+    }
+
+    try {
+      while (true) {
+        final frame = await source.next();
+        if (frame == null) break;
+
+        final tensor = frame.tensor;
+        final List<Detection> detections;
+        try {
+          detections = await detectFromTensor(
+            tensorBytes: tensor.tensorBytes,
+            scale: tensor.scale,
+            padLeft: tensor.padLeft,
+            padTop: tensor.padTop,
+            newWidth: tensor.newWidth,
+            newHeight: tensor.newHeight,
+            imageWidth: tensor.imageWidth,
+            imageHeight: tensor.imageHeight,
+            confidenceThreshold: confidenceThreshold,
+            iouThreshold: iouThreshold,
+          );
+        } finally {
+          // El hilo nativo sigue decodificando en cuanto vuelve el slot
+          source.release(frame);
+        }
+
+        yield VideoFrameDetections(
+          frameIndex: frame.frameIndex,
+          position: frame.position,
+          detections: detections,
+          imageWidth: tensor.imageWidth,
+          imageHeight: tensor.imageHeight,
+        );
+      }
+
+      if (source.status != NativeVideoStatus.ended) {
+        throw VideoDecodeException(
+          message: 'Decodificación interrumpida (${source.stats()})',
+          filePath: path,
+        );
+      }
+      AppLogger.debug('Video analizado: ${source.stats()}', tag: _tag);
+    } finally {
+      source.dispose();
+    }
+  }
+
   // ═══════════════════════════════════════════════════════════════════════════
   // PREPROCESAMIENTO
   // ═══════════════════════════════════════════════════════════════════════════
@@ -563,25 +993,34 @@ class YoloDetector {
       // El formato es RGBA (4 bytes por pixel)
       final resizedBytes = resized.getBytes(order: img.ChannelOrder.rgba);
 
-      for (int y = 0; y < inputSize; y++) {
-        for (int x = 0; x < inputSize; x++) {
-          final int srcX = x - padLeft;
-          final int srcY = y - padTop;
-
-          if (srcX >= 0 && srcX < newWidth && srcY >= 0 && srcY < newHeight) {
-            // Acceso directo a bytes (RGBA format: 4 bytes per pixel)
-            final int index = (srcY * newWidth + srcX) * 4;
-            _inputTensor![0][y][x][0] = resizedBytes[index] / 255.0; // R
-            _inputTensor![0][y][x][1] = resizedBytes[index + 1] / 255.0; // G
-            _inputTensor![0][y][x][2] = resizedBytes[index + 2] / 255.0; // B
-            // Alpha channel (index+3) no se usa
-          } else {
-            // Padding con valor gris (114)
-            _inputTensor![0][y][x][0] = padValue;
-            _inputTensor![0][y][x][1] = padValue;
-            _inputTensor![0][y][x][2] = padValue;
+      if (_inputFormat.type == NativeTensorType.float32) {
+        final tensor = _inputBytes!.buffer.asFloat32List();
+        final int pixelStep = _pixelStep;
+        final int channelStep = _channelStep;
+
+        for (int y = 0; y < inputSize; y++) {
+          for (int x = 0; x < inputSize; x++) {
+            final int srcX = x - padLeft;
+            final int srcY = y - padTop;
+            final int dst = (y * inputSize + x) * pixelStep;
+
+            if (srcX >= 0 && srcX < newWidth && srcY >= 0 && srcY < newHeight) {
+              // Acceso directo a bytes (RGBA format: 4 bytes per pixel)
+              final int index = (srcY * newWidth + srcX) * 4;
+              tensor[dst] = resizedBytes[index] / 255.0; // R
+              tensor[dst + channelStep] = resizedBytes[index + 1] / 255.0; // G
+              tensor[dst + 2 * channelStep] = resizedBytes[index + 2] / 255.0; // B
+              // Alpha channel (index+3) no se usa
+            } else {
+              // Padding con valor gris (114)
+              tensor[dst] = padValue;
+              tensor[dst + channelStep] = padValue;
+              tensor[dst + 2 * channelStep] = padValue;
+            }
           }
         }
+      } else {
+        _writeEncodedTensor(resizedBytes, newWidth, newHeight, padLeft, padTop);
       }
 
       return _PreprocessResult(
@@ -600,12 +1039,118 @@ class YoloDetector {
     }
   }
 
+  /// Elementos entre píxeles consecutivos del tensor de entrada: 3 en NHWC
+  /// (RGB intercalado), 1 en NCHW.
+  int get _pixelStep =>
+      _inputFormat.layout == NativeTensorLayout.nchw ? 1 : 3;
+
+  /// Elementos entre canales de un mismo píxel: 1 en NHWC, un plano en NCHW.
+  int get _channelStep => _inputFormat.layout == NativeTensorLayout.nchw
+      ? inputSize * inputSize
+      : 1;
+
+  /// Variante de [_preprocess] para modelos float16 / cuantizados: cada byte
+  /// RGB se traduce con una tabla de 256 códigos (mismo redondeo que el
+  /// kernel nativo), escritos como enteros de 16 u 8 bits.
+  void _writeEncodedTensor(
+    Uint8List resizedBytes,
+    int newWidth,
+    int newHeight,
+    int padLeft,
+    int padTop,
+  ) {
+    final format = _inputFormat;
+    final List<int> tensor;
+    switch (format.type) {
+      case NativeTensorType.float16:
+        tensor = _inputBytes!.buffer.asUint16List();
+        break;
+      case NativeTensorType.int8:
+        tensor = _inputBytes!.buffer.asInt8List();
+        break;
+      default:
+        tensor = _inputBytes!;
+    }
+
+    final table = List<int>.generate(256, (i) => _encode(i / 255.0, format));
+    final pad = _encode(114.0 / 255.0, format);
+    final int pixelStep = _pixelStep;
+    final int channelStep = _channelStep;
+
+    for (int y = 0; y < inputSize; y++) {
+      for (int x = 0; x < inputSize; x++) {
+        final int srcX = x - padLeft;
+        final int srcY = y - padTop;
+        final int dst = (y * inputSize + x) * pixelStep;
+
+        if (srcX >= 0 && srcX < newWidth && srcY >= 0 && srcY < newHeight) {
+          final int index = (srcY * newWidth + srcX) * 4;
+          tensor[dst] = table[resizedBytes[index]];
+          tensor[dst + channelStep] = table[resizedBytes[index + 1]];
+          tensor[dst + 2 * channelStep] = table[resizedBytes[index + 2]];
+        } else {
+          tensor[dst] = pad;
+          tensor[dst + channelStep] = pad;
+          tensor[dst + 2 * channelStep] = pad;
+        }
+      }
+    }
+  }
+
+  /// Código de [value] en el tipo de [format]: bits IEEE half o entero
+  /// cuantizado `round(value / scale) + zeroPoint` saturado.
+  static int _encode(double value, NativeTensorFormat format) {
+    if (format.type == NativeTensorType.float16) {
+      return _floatToHalfBits(value);
+    }
+    final bool signed = format.type == NativeTensorType.int8;
+    final q = (value / format.scale).round() + format.zeroPoint;
+    return q.clamp(signed ? -128 : 0, signed ? 127 : 255);
+  }
+
+  /// Bits float16 (redondeo al par más cercano) de un valor en [0, 1].
+  static int _floatToHalfBits(double value) {
+    final data = ByteData(4)..setFloat32(0, value);
+    final bits = data.getUint32(0);
+    final exponent = ((bits >> 23) & 0xFF) - 127 + 15;
+    var mantissa = bits & 0x7FFFFF;
+
+    if (exponent <= 0) {
+      // Subnormal o cero
+      if (exponent < -10) return 0;
+      mantissa |= 0x800000;
+      final shift = 14 - exponent;
+      final half = mantissa >> shift;
+      final rest = mantissa & ((1 << shift) - 1);
+      final halfway = 1 << (shift - 1);
+      final round = rest > halfway || (rest == halfway && (half & 1) == 1);
+      return half + (round ? 1 : 0);
+    }
+
+    var half = (exponent << 10) | (mantissa >> 13);
+    final rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1) == 1)) half++;
+    return half;
+  }
+
+  /// Decuantiza [_outputBytes] (uint8/int8) en [_outputTensor].
+  void _dequantizeOutput() {
+    final format = _outputFormat;
+    final List<int> raw = format.type == NativeTensorType.int8
+        ? _outputBytes!.buffer.asInt8List()
+        : _outputBytes!;
+    final output = _outputTensor!;
+    for (int i = 0; i < output.length; i++) {
+      output[i] = (raw[i] - format.zeroPoint) * format.scale;
+    }
+  }
+
   // ═══════════════════════════════════════════════════════════════════════════
   // POSTPROCESAMIENTO - CORREGIDO
   // ═══════════════════════════════════════════════════════════════════════════
 
   List<Detection> _postprocess(
-    List<List<List<double>>> output,
+    Float32List output,
     _PreprocessResult preprocess,
     int origWidth,
     int origHeight,
@@ -614,101 +1159,32 @@ class YoloDetector {
     bool verbose = true,
   }) {
     try {
-      List<Detection> detections = [];
-
-      for (int i = 0; i < numPredictions; i++) {
-        // Optimización: Early exit si ya tenemos suficientes detecciones
-        if (detections.length >= maxDetectionsBeforeNms) {
-          break;
-        }
-
-        // Coordenadas normalizadas (0-1)
-        final double cxNorm = output[0][0][i];
-        final double cyNorm = output[0][1][i];
-        final double wNorm = output[0][2][i];
-        final double hNorm = output[0][3][i];
-
-        // Desnormalizar: convertir de rango [0,1] a [0,640]
-        final double cx = cxNorm * inputSize;
-        final double cy = cyNorm * inputSize;
-        final double w = wNorm * inputSize;
-        final double h = hNorm * inputSize;
-
-        // Encontrar la clase con mayor score
-        double maxScore = 0;
-        int maxClassId = 0;
-
-        for (int c = 0; c < numClasses; c++) {
-          final double score = output[0][4 + c][i];
-          if (score > maxScore) {
-            maxScore = score;
-            maxClassId = c;
-          }
-        }
-
-        // Filtrar por umbral de confianza
-        if (maxScore < confidenceThreshold) {
-          continue;
-        }
-
-        // Convertir de (cx, cy, w, h) a (x1, y1, x2, y2) en espacio 640x640
-        final double x1Model = cx - w / 2;
-        final double y1Model = cy - h / 2;
-        final double x2Model = cx + w / 2;
-        final double y2Model = cy + h / 2;
-
-        // Convertir de espacio del modelo (con padding) a imagen original
-        final double x1 = (x1Model - preprocess.padLeft) / preprocess.scale;
-        final double y1 = (y1Model - preprocess.padTop) / preprocess.scale;
-        final double x2 = (x2Model - preprocess.padLeft) / preprocess.scale;
-        final double y2 = (y2Model - preprocess.padTop) / preprocess.scale;
-
-        // Clampear a los límites de la imagen original
-        final double x1Clamped = x1.clamp(0.0, origWidth.toDouble());
-        final double y1Clamped = y1.clamp(0.0, origHeight.toDouble());
-        final double x2Clamped = x2.clamp(0.0, origWidth.toDouble());
-        final double y2Clamped = y2.clamp(0.0, origHeight.toDouble());
-
-        // Verificar que el bounding box es válido
-        if (x2Clamped <= x1Clamped || y2Clamped <= y1Clamped) {
-          continue;
-        }
-
-        // Obtener etiqueta
-        final String label = maxClassId < _labels.length
-            ? _labels[maxClassId]
-            : 'clase_$maxClassId';
-
-        detections.add(Detection.fromModelOutput(
-          x1: x1Clamped,
-          y1: y1Clamped,
-          x2: x2Clamped,
-          y2: y2Clamped,
-          confidence: maxScore,
-          classId: maxClassId,
-          label: label,
-          imageWidth: origWidth,
-          imageHeight: origHeight,
-        ));
-      }
-
-      // ════════════════════════════════════════════════════════════
-      // OPTIMIZACIÓN: TopK antes de NMS para reducir O(n²)
-      // Ordenar por confidence y tomar top 50 antes de NMS
-      // ════════════════════════════════════════════════════════════
-
-      if (detections.length > maxDetectionsBeforeNms) {
-        detections.sort((a, b) => b.confidence.compareTo(a.confidence));
-        detections = detections.sublist(0, maxDetectionsBeforeNms);
-      }
-
-      final finalDetections = _nonMaxSuppression(detections, iouThreshold);
+      final ffi = NativeFfiBindings.instance;
+      final bool usedNative = ffi != null;
+      final finalDetections = usedNative
+          ? _postprocessNative(
+              ffi,
+              output,
+              preprocess,
+              origWidth,
+              origHeight,
+              confidenceThreshold,
+              iouThreshold,
+            )
+          : _postprocessDart(
+              output,
+              preprocess,
+              origWidth,
+              origHeight,
+              confidenceThreshold,
+              iouThreshold,
+            );
 
       // Logging para debugging LIVE vs PHOTO
       if (verbose || (_validationCounter > 0 && _validationCounter % 30 == 0)) {
         AppLogger.debug(
           'Postprocessing Results:\n'
-          '  #Detections pre-NMS: ${detections.length}\n'
+          '  Decoder: ${usedNative ? 'nativo' : 'Dart'}\n'
           '  #Detections post-NMS: ${finalDetections.length}\n'
           '  Confidence threshold: $confidenceThreshold\n'
           '  IoU threshold: $iouThreshold',
@@ -726,6 +1202,152 @@ class YoloDetector {
     }
   }
 
+  /// Decodificación + NMS en C++ (`nv_decode_yolo_output`).
+  ///
+  /// El resultado llega empaquetado como (x1, y1, x2, y2, score, classId) ya
+  /// en espacio de la imagen original y ordenado por score.
+  List<Detection> _postprocessNative(
+    NativeFfiBindings ffi,
+    Float32List output,
+    _PreprocessResult preprocess,
+    int origWidth,
+    int origHeight,
+    double confidenceThreshold,
+    double iouThreshold,
+  ) {
+    final packed = _detectionBuffer ??=
+        Float32List(maxDetections * NativeFfiBindings.detectionStride);
+
+    final count = ffi.decodeYoloOutput(
+      output.address,
+      numClasses,
+      numPredictions,
+      inputSize,
+      confidenceThreshold,
+      iouThreshold,
+      preprocess.scale,
+      preprocess.padLeft,
+      preprocess.padTop,
+      origWidth,
+      origHeight,
+      packed.address,
+      maxDetections,
+    );
+
+    if (count < 0) {
+      throw PostprocessingException(
+        message: 'Decodificador nativo devolvió error $count',
+      );
+    }
+
+    final detections = <Detection>[];
+    for (int i = 0; i < count; i++) {
+      final base = i * NativeFfiBindings.detectionStride;
+      final classId = packed[base + 5].toInt();
+      detections.add(Detection.fromModelOutput(
+        x1: packed[base],
+        y1: packed[base + 1],
+        x2: packed[base + 2],
+        y2: packed[base + 3],
+        confidence: packed[base + 4],
+        classId: classId,
+        label: _labelFor(classId),
+        imageWidth: origWidth,
+        imageHeight: origHeight,
+      ));
+    }
+    return detections;
+  }
+
+  /// Decodificación + NMS en Dart (tests en host o sin biblioteca nativa).
+  ///
+  /// Mismo algoritmo que el decodificador nativo: argmax por predicción,
+  /// filtro de confianza, top-K por score y NMS por clase.
+  List<Detection> _postprocessDart(
+    Float32List output,
+    _PreprocessResult preprocess,
+    int origWidth,
+    int origHeight,
+    double confidenceThreshold,
+    double iouThreshold,
+  ) {
+    // El tensor es [canal][predicción]: recorrer cada fila de clase de forma
+    // secuencial en lugar de saltar 8400 posiciones por clase.
+    final bestScores = Float32List(numPredictions);
+    final bestClasses = Int32List(numPredictions);
+    for (int c = 0; c < numClasses; c++) {
+      final rowOffset = (4 + c) * numPredictions;
+      for (int i = 0; i < numPredictions; i++) {
+        final score = output[rowOffset + i];
+        if (score > bestScores[i]) {
+          bestScores[i] = score;
+          bestClasses[i] = c;
+        }
+      }
+    }
+
+    List<Detection> detections = [];
+
+    for (int i = 0; i < numPredictions; i++) {
+      final double maxScore = bestScores[i];
+
+      // Filtrar por umbral de confianza
+      if (maxScore < confidenceThreshold) {
+        continue;
+      }
+
+      // Desnormalizar: convertir de rango [0,1] a [0,640]
+      final double cx = output[i] * inputSize;
+      final double cy = output[numPredictions + i] * inputSize;
+      final double w = output[2 * numPredictions + i] * inputSize;
+      final double h = output[3 * numPredictions + i] * inputSize;
+
+      // Convertir de espacio del modelo (con padding) a imagen original
+      final double x1 = (cx - w / 2 - preprocess.padLeft) / preprocess.scale;
+      final double y1 = (cy - h / 2 - preprocess.padTop) / preprocess.scale;
+      final double x2 = (cx + w / 2 - preprocess.padLeft) / preprocess.scale;
+      final double y2 = (cy + h / 2 - preprocess.padTop) / preprocess.scale;
+
+      // Clampear a los límites de la imagen original
+      final double x1Clamped = x1.clamp(0.0, origWidth.toDouble());
+      final double y1Clamped = y1.clamp(0.0, origHeight.toDouble());
+      final double x2Clamped = x2.clamp(0.0, origWidth.toDouble());
+      final double y2Clamped = y2.clamp(0.0, origHeight.toDouble());
+
+      // Verificar que el bounding box es válido
+      if (x2Clamped <= x1Clamped || y2Clamped <= y1Clamped) {
+        continue;
+      }
+
+      final int maxClassId = bestClasses[i];
+      detections.add(Detection.fromModelOutput(
+        x1: x1Clamped,
+        y1: y1Clamped,
+        x2: x2Clamped,
+        y2: y2Clamped,
+        confidence: maxScore,
+        classId: maxClassId,
+        label: _labelFor(maxClassId),
+        imageWidth: origWidth,
+        imageHeight: origHeight,
+      ));
+    }
+
+    // Top-K por confianza antes del NMS (nunca por orden de predicción)
+    detections.sort((a, b) => b.confidence.compareTo(a.confidence));
+    if (detections.length > maxNmsCandidates) {
+      detections = detections.sublist(0, maxNmsCandidates);
+    }
+
+    final result = _nonMaxSuppression(detections, iouThreshold);
+    return result.length > maxDetections
+        ? result.sublist(0, maxDetections)
+        : result;
+  }
+
+  String _labelFor(int classId) =>
+      classId < _labels.length ? _labels[classId] : 'clase_$classId';
+
   List<Detection> _nonMaxSuppression(
     List<Detection> detections,
     double iouThreshold,
@@ -765,9 +1387,16 @@ class YoloDetector {
       _interpreter!.close();
       _interpreter = null;
     }
-    _inputTensor = null;
+    _gpuDelegate?.delete();
+    _gpuDelegate = null;
+    _inputBytes = null;
+    _inputFormat = NativeTensorFormat.float32;
+    _outputFormat = NativeTensorFormat.float32;
+    _outputBytes = null;
     _outputTensor = null;
+    _detectionBuffer = null;
     _labels = [];
+    _usesGpuDelegate = false;
     _isInitialized = false;
     _isDisposed = true;
     AppLogger.debug('YoloDetector disposed', tag: _tag);
@@ -778,6 +1407,44 @@ class YoloDetector {
 // CLASES AUXILIARES
 // ═══════════════════════════════════════════════════════════════════════════════
 
+/// Resultado de [YoloDetector.detectStillBatch] para una imagen.
+class StillDetectionResult {
+  final List<Detection> detections;
+
+  /// Dimensiones de la imagen decodificada (espacio de las cajas).
+  final int imageWidth;
+  final int imageHeight;
+
+  const StillDetectionResult({
+    required this.detections,
+    required this.imageWidth,
+    required this.imageHeight,
+  });
+}
+
+/// Resultado de [YoloDetector.detectVideo] para un frame muestreado.
+class VideoFrameDetections {
+  /// Índice del frame en el video, contando los no muestreados.
+  final int frameIndex;
+
+  /// Instante del frame en el video.
+  final Duration position;
+
+  final List<Detection> detections;
+
+  /// Dimensiones del frame ya rotado (espacio de las cajas).
+  final int imageWidth;
+  final int imageHeight;
+
+  const VideoFrameDetections({
+    required this.frameIndex,
+    required this.position,
+    required this.detections,
+    required this.imageWidth,
+    required this.imageHeight,
+  });
+}
+
 class _PreprocessResult {
   final double scale;
   final int padLeft;
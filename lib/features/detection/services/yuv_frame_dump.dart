@@ -0,0 +1,209 @@
+// ╔═══════════════════════════════════════════════════════════════════════════════╗
+// ║                            yuv_frame_dump.dart                                ║
+// ║          Volcados de frames YUV_420_888 para reproducir el pipeline           ║
+// ╠═══════════════════════════════════════════════════════════════════════════════╣
+// ║  Formato .nvyuv: secuencia de [header de 64 bytes | plano Y | U | V], con     ║
+// ║  los rowStride y pixelStride reales de la cámara. Lo graba                    ║
+// ║  DetectionDebugHelper y lo reproducen integration_test/ y                     ║
+// ║  bench/nutrivision_pipeline_bench.cpp (mismo layout).                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════════╝
+
+import 'dart:typed_data';
+
+import 'package:camera/camera.dart';
+
+import '../../../core/exceptions/app_exceptions.dart';
+
+/// Un frame YUV_420_888 tal como lo entregó la cámara.
+///
+/// Los planos se guardan sin reempaquetar: en NV21 (pixelStride 2) U y V
+/// son las copias intercaladas que entrega el plugin `camera`, con el
+/// relleno de fila del HAL.
+class YuvFrameDump {
+  // ═══════════════════════════════════════════════════════════════════════════
+  // FORMATO
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// "NVYU" en little-endian.
+  static const int magic = 0x5559564E;
+  static const int version = 1;
+  static const int headerBytes = 64;
+
+  /// Bit de [flags]: frame de la cámara frontal (espejo tras rotar).
+  static const int flagMirror = 1;
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // PROPIEDADES
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  final int width;
+  final int height;
+  final int yRowStride;
+  final int uvRowStride;
+  final int uvPixelStride;
+
+  /// Rotación horaria que el pipeline aplica (0, 90, 180, 270).
+  final int sensorOrientation;
+
+  /// Instante de captura en nanosegundos (0 si se desconoce).
+  final int timestampNs;
+
+  final int flags;
+  final Uint8List yBytes;
+  final Uint8List uBytes;
+  final Uint8List vBytes;
+
+  const YuvFrameDump({
+    required this.width,
+    required this.height,
+    required this.yRowStride,
+    required this.uvRowStride,
+    required this.uvPixelStride,
+    required this.sensorOrientation,
+    required this.yBytes,
+    required this.uBytes,
+    required this.vBytes,
+    this.timestampNs = 0,
+    this.flags = 0,
+  });
+
+  /// Copia los planos de un frame de cámara (YUV_420_888).
+  factory YuvFrameDump.fromCameraImage(
+    CameraImage image, {
+    required int sensorOrientation,
+    bool mirror = false,
+    int timestampNs = 0,
+  }) {
+    final planes = image.planes;
+    return YuvFrameDump(
+      width: image.width,
+      height: image.height,
+      yRowStride: planes[0].bytesPerRow,
+      uvRowStride: planes[1].bytesPerRow,
+      uvPixelStride: planes[1].bytesPerPixel ?? 1,
+      sensorOrientation: sensorOrientation,
+      timestampNs: timestampNs,
+      flags: mirror ? flagMirror : 0,
+      yBytes: Uint8List.fromList(planes[0].bytes),
+      uBytes: Uint8List.fromList(planes[1].bytes),
+      vBytes: Uint8List.fromList(planes[2].bytes),
+    );
+  }
+
+  /// Espejo horizontal tras rotar (cámara frontal).
+  bool get mirror => flags & flagMirror != 0;
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // SERIALIZACIÓN
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Header más planos, listo para añadir a un .nvyuv.
+  Uint8List toBytes() {
+    final total = headerBytes + yBytes.length + uBytes.length + vBytes.length;
+    final out = Uint8List(total);
+    final header = ByteData.sublistView(out, 0, headerBytes);
+    header
+      ..setUint32(0, magic, Endian.little)
+      ..setUint32(4, version, Endian.little)
+      ..setInt32(8, width, Endian.little)
+      ..setInt32(12, height, Endian.little)
+      ..setInt32(16, yRowStride, Endian.little)
+      ..setInt32(20, uvRowStride, Endian.little)
+      ..setInt32(24, uvPixelStride, Endian.little)
+      ..setInt32(28, sensorOrientation, Endian.little)
+      ..setInt64(32, timestampNs, Endian.little)
+      ..setUint32(40, yBytes.length, Endian.little)
+      ..setUint32(44, uBytes.length, Endian.little)
+      ..setUint32(48, vBytes.length, Endian.little)
+      ..setUint32(52, flags, Endian.little);
+
+    var offset = headerBytes;
+    out.setAll(offset, yBytes);
+    offset += yBytes.length;
+    out.setAll(offset, uBytes);
+    offset += uBytes.length;
+    out.setAll(offset, vBytes);
+    return out;
+  }
+
+  /// Lee todos los frames de un .nvyuv. Los planos son vistas sobre [bytes].
+  ///
+  /// Throws [FrameConversionException] si un header no es válido o un plano
+  /// es más corto de lo que sus strides exigen.
+  static List<YuvFrameDump> parseAll(Uint8List bytes) {
+    final frames = <YuvFrameDump>[];
+    var offset = 0;
+
+    while (offset < bytes.length) {
+      if (bytes.length - offset < headerBytes) {
+        throw FrameConversionException(
+          message: 'Header truncado en el byte $offset',
+        );
+      }
+      final header = ByteData.sublistView(bytes, offset, offset + headerBytes);
+      if (header.getUint32(0, Endian.little) != magic ||
+          header.getUint32(4, Endian.little) != version) {
+        throw FrameConversionException(
+          message: 'Header inválido en el byte $offset',
+        );
+      }
+
+      final yLength = header.getUint32(40, Endian.little);
+      final uLength = header.getUint32(44, Endian.little);
+      final vLength = header.getUint32(48, Endian.little);
+      var cursor = offset + headerBytes;
+      if (bytes.length - cursor < yLength + uLength + vLength) {
+        throw FrameConversionException(
+          message: 'Planos truncados en el byte $offset',
+        );
+      }
+
+      Uint8List plane(int length) {
+        final view = Uint8List.sublistView(bytes, cursor, cursor + length);
+        cursor += length;
+        return view;
+      }
+
+      final frame = YuvFrameDump(
+        width: header.getInt32(8, Endian.little),
+        height: header.getInt32(12, Endian.little),
+        yRowStride: header.getInt32(16, Endian.little),
+        uvRowStride: header.getInt32(20, Endian.little),
+        uvPixelStride: header.getInt32(24, Endian.little),
+        sensorOrientation: header.getInt32(28, Endian.little),
+        timestampNs: header.getInt64(32, Endian.little),
+        flags: header.getUint32(52, Endian.little),
+        yBytes: plane(yLength),
+        uBytes: plane(uLength),
+        vBytes: plane(vLength),
+      );
+      if (!frame._planesCoverStrides) {
+        throw FrameConversionException(
+          message: 'Planos más cortos que sus strides en el byte $offset',
+        );
+      }
+
+      frames.add(frame);
+      offset = cursor;
+    }
+    return frames;
+  }
+
+  /// Los kernels leen hasta el último píxel de cada plano según los strides.
+  bool get _planesCoverStrides {
+    if (width <= 0 || height <= 0 || uvPixelStride < 1) return false;
+    final chromaWidth = (width + 1) ~/ 2;
+    final chromaHeight = (height + 1) ~/ 2;
+    final yNeeded = yRowStride * (height - 1) + width;
+    final uvNeeded =
+        uvRowStride * (chromaHeight - 1) + (chromaWidth - 1) * uvPixelStride + 1;
+    return yRowStride >= width &&
+        yBytes.length >= yNeeded &&
+        uBytes.length >= uvNeeded &&
+        vBytes.length >= uvNeeded;
+  }
+
+  @override
+  String toString() => 'YuvFrameDump(${width}x$height, rowStride $yRowStride/'
+      '$uvRowStride, pixelStride $uvPixelStride, rot $sensorOrientation)';
+}
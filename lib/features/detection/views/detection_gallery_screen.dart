@@ -8,10 +8,10 @@
 
 import 'dart:io';
 import 'dart:math';
+import 'dart:ui' as ui;
 import 'package:flutter/material.dart';
 import 'package:flutter_riverpod/flutter_riverpod.dart';
 import 'package:image_picker/image_picker.dart';
-import 'package:image/image.dart' as img;
 
 import '../../../app/routes.dart';
 import '../services/yolo_service.dart';
@@ -123,10 +123,12 @@ class _GalleryDetectionPageState extends ConsumerState<GalleryDetectionPage> {
         );
       }
 
+      // Solo se leen las dimensiones del encabezado: la decodificación
+      // completa (reducida en nativo) ocurre al detectar
       final bytes = await file.readAsBytes();
-      final decodedImage = img.decodeImage(bytes);
+      final size = await _readImageSize(bytes);
 
-      if (decodedImage == null) {
+      if (size == null) {
         throw ImageDecodeException(message: 'No se pudo leer la imagen');
       }
 
@@ -134,8 +136,8 @@ class _GalleryDetectionPageState extends ConsumerState<GalleryDetectionPage> {
 
       setState(() {
         _selectedImage = file;
-        _imageWidth = decodedImage.width;
-        _imageHeight = decodedImage.height;
+        _imageWidth = size.width.toInt();
+        _imageHeight = size.height.toInt();
         _detections = [];
         _selectedIngredient = null;
         _statusMessage =
@@ -148,6 +150,23 @@ class _GalleryDetectionPageState extends ConsumerState<GalleryDetectionPage> {
     }
   }
 
+  /// Dimensiones de la imagen leyendo solo su encabezado, o `null` si el
+  /// formato no es válido.
+  static Future<Size?> _readImageSize(Uint8List bytes) async {
+    final buffer = await ui.ImmutableBuffer.fromUint8List(bytes);
+    try {
+      final descriptor = await ui.ImageDescriptor.encoded(buffer);
+      final size =
+          Size(descriptor.width.toDouble(), descriptor.height.toDouble());
+      descriptor.dispose();
+      return size;
+    } catch (_) {
+      return null;
+    } finally {
+      buffer.dispose();
+    }
+  }
+
   Future<void> _runDetection() async {
     if (_selectedImage == null || !_isModelLoaded) return;
 
@@ -160,27 +179,28 @@ class _GalleryDetectionPageState extends ConsumerState<GalleryDetectionPage> {
 
     try {
       final bytes = await _selectedImage!.readAsBytes();
-      final image = img.decodeImage(bytes);
-
-      if (image == null) {
-        throw ImageDecodeException(message: 'No se pudo decodificar la imagen');
-      }
-
-      _imageWidth = image.width;
-      _imageHeight = image.height;
 
       // Obtener ajustes de detección
       final settings = await ref.read(cameraSettingsProvider.future);
 
+      // Decodificación y letterbox nativos cuando hay FFI; si no, pipeline Dart
       final stopwatch = Stopwatch()..start();
-      final detections = await _detector.detectFromSource(
-        source: DetectionSource.photo,
-        image: image,
+      final results = await _detector.detectStillBatch(
+        [bytes],
         confidenceThreshold: settings.confidenceThreshold,
         iouThreshold: settings.iouThreshold,
       );
       stopwatch.stop();
 
+      final result = results.first;
+      if (result == null) {
+        throw ImageDecodeException(message: 'No se pudo decodificar la imagen');
+      }
+
+      final detections = result.detections;
+      _imageWidth = result.imageWidth;
+      _imageHeight = result.imageHeight;
+
       if (!mounted) return;
 
       setState(() {
@@ -13,7 +13,6 @@ import 'package:camera/camera.dart';
 import 'package:flutter/material.dart';
 import 'package:flutter_riverpod/flutter_riverpod.dart';
 import 'package:go_router/go_router.dart';
-import 'package:image/image.dart' as img;
 import 'package:permission_handler/permission_handler.dart';
 
 import '../../../app/routes.dart';
@@ -113,6 +112,14 @@ class _CameraDetectionPageState extends ConsumerState<CameraDetectionPage>
                 );
           }
         },
+        onTracksUpdated: (detections) {
+          // Frames sin inferencia: solo el overlay (escucha el provider)
+          if (mounted) {
+            ref
+                .read(cameraStateProvider.notifier)
+                .updateTrackedDetections(detections);
+          }
+        },
         onError: (message) {
           if (mounted) {
             setState(() => _errorMessage = message);
@@ -362,6 +369,7 @@ class _CameraDetectionPageState extends ConsumerState<CameraDetectionPage>
           '📐 Preview Size: ${previewSize?.width.toInt()}x${previewSize?.height.toInt()}',
           '⚙️  Resolution Setting: ${settings?.resolution.displayName ?? "unknown"} (${settings?.resolution.description ?? "unknown"})',
           '⏭️  Frame Skip: ${settings?.frameSkip ?? "unknown"} (procesa 1 de cada ${settings?.frameSkip ?? "?"} frames)',
+          '💤 Salto adaptativo: ${settings?.adaptiveSkip ?? "unknown"} (estáticos saltados: ${_detectionController.staticFramesSkipped})',
           '🎚️  Confidence: ${settings != null ? settings.confidenceThreshold.toStringAsFixed(2) : "unknown"}',
           '🔲 IoU (NMS): ${settings != null ? settings.iouThreshold.toStringAsFixed(2) : "unknown"}',
           '🎯 Front Camera: ${cameraState.isFrontCamera}',
@@ -381,6 +389,7 @@ class _CameraDetectionPageState extends ConsumerState<CameraDetectionPage>
       sensorOrientation: sensorOrientation,
       isFrontCamera: cameraState.isFrontCamera,
       frameSkip: settings?.frameSkip ?? CameraSettings.defaultFrameSkip,
+      adaptiveSkip: settings?.adaptiveSkip ?? CameraSettings.defaultAdaptiveSkip,
       confidenceThreshold: settings?.confidenceThreshold ??
           CameraSettings.defaultConfidenceThreshold,
       iouThreshold: settings?.iouThreshold ?? CameraSettings.defaultIouThreshold,
@@ -444,24 +453,24 @@ class _CameraDetectionPageState extends ConsumerState<CameraDetectionPage>
       final xFile = await _cameraController!.takePicture();
       final file = File(xFile.path);
 
-      // Leer y decodificar imagen
       final bytes = await file.readAsBytes();
-      final image = img.decodeImage(bytes);
-
-      if (image == null) {
-        throw Exception('No se pudo decodificar la imagen');
-      }
 
       // Ejecutar detección usando el provider (para one-off detection)
-      // NOTA: Esto cargará el detector si aún no está cargado
+      // NOTA: Esto cargará el detector si aún no está cargado. La foto se
+      // decodifica en nativo ya reducida y orientada (EXIF) cuando hay FFI
       final detector = await ref.read(yoloDetectorProvider.future);
       final settings = await ref.read(cameraSettingsProvider.future);
-      final detections = await detector.detect(
-        image,
+      final results = await detector.detectStillBatch(
+        [bytes],
         confidenceThreshold: settings.confidenceThreshold,
         iouThreshold: settings.iouThreshold,
       );
 
+      final result = results.first;
+      if (result == null) {
+        throw Exception('No se pudo decodificar la imagen');
+      }
+
       if (!mounted) return;
 
       setState(() {
@@ -475,9 +484,9 @@ class _CameraDetectionPageState extends ConsumerState<CameraDetectionPage>
           MaterialPageRoute(
             builder: (_) => DetectionResultsScreen(
               imageFile: file,
-              detections: detections,
-              imageWidth: image.width,
-              imageHeight: image.height,
+              detections: result.detections,
+              imageWidth: result.imageWidth,
+              imageHeight: result.imageHeight,
               title: 'Resultados de Captura',
               retakeButtonText: 'Nueva Captura',
               showShareButton: false,
@@ -162,6 +162,19 @@ class _SettingsContentState extends ConsumerState<_SettingsContent> {
               },
             ),
 
+            const SizedBox(height: 8),
+
+            // Salto adaptativo
+            _SettingToggle(
+              icon: Icons.motion_photos_paused,
+              title: 'Pausar con escena quieta',
+              subtitle: 'No infiere mientras el plato no cambia',
+              value: _localSettings.adaptiveSkip,
+              onChanged: (value) {
+                _updateSetting(_localSettings.copyWith(adaptiveSkip: value));
+              },
+            ),
+
             const SizedBox(height: 16),
 
             // Resolucion
@@ -12,6 +12,7 @@ import 'package:flutter/services.dart';
 import 'package:flutter_riverpod/flutter_riverpod.dart';
 
 import 'app/app.dart';
+import 'features/detection/services/model_warmup.dart';
 
 Future<void> main() async {
   // Asegurar que Flutter esté inicializado antes de cualquier operación
@@ -40,4 +41,7 @@ Future<void> main() async {
       child: NutriVisionApp(),
     ),
   );
+
+  // Cargar el modelo en segundo plano tras el primer frame
+  ModelWarmup.schedule();
 }
@@ -58,6 +58,7 @@ void main() {
         const settings = CameraSettings();
 
         expect(settings.frameSkip, 4);
+        expect(settings.adaptiveSkip, isTrue);
         expect(settings.resolution, CameraResolution.medium);
         expect(settings.confidenceThreshold, 0.40);
         expect(settings.iouThreshold, 0.30);
@@ -165,6 +166,7 @@ void main() {
         final settings = CameraSettings.fromJson(json);
 
         expect(settings.frameSkip, CameraSettings.defaultFrameSkip);
+        expect(settings.adaptiveSkip, CameraSettings.defaultAdaptiveSkip);
         expect(settings.resolution, CameraSettings.defaultResolution);
         expect(settings.confidenceThreshold,
             CameraSettings.defaultConfidenceThreshold);
@@ -172,6 +174,17 @@ void main() {
         expect(settings.showMemoryInfo, CameraSettings.defaultShowMemoryInfo);
       });
 
+      test('toJson y fromJson conservan adaptiveSkip', () {
+        const original = CameraSettings(adaptiveSkip: false);
+
+        final json = original.toJson();
+        final restored = CameraSettings.fromJson(json);
+
+        expect(json['adaptiveSkip'], false);
+        expect(restored.adaptiveSkip, isFalse);
+        expect(restored, equals(original));
+      });
+
       test('toJson y fromJson son inversos', () {
         const original = CameraSettings(
           frameSkip: 2,
@@ -243,6 +256,11 @@ void main() {
         expect(settings.isDefault, isFalse);
       });
 
+      test('retorna false si adaptiveSkip difiere', () {
+        const settings = CameraSettings(adaptiveSkip: false);
+        expect(settings.isDefault, isFalse);
+      });
+
       test('retorna false si resolution difiere', () {
         const settings = CameraSettings(resolution: CameraResolution.high);
         expect(settings.isDefault, isFalse);
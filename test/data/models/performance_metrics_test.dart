@@ -0,0 +1,186 @@
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ║                      performance_metrics_test.dart                              ║
+// ║            Tests para métricas de rendimiento y snapshot nativo                 ║
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ║  Verifica PerformanceMetrics y el parseo/diferencia de NativeStatsSnapshot.     ║
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:nutrivision_aiepn_mobile/data/models/performance_metrics.dart';
+
+/// Snapshot plano con [calls] llamadas de 2 ms y 1000 bytes en cada etapa.
+List<int> _values({int calls = 1, int allocations = 0, int bytes = 0}) {
+  return [
+    for (var i = 0; i < NativeStatsSnapshot.stageNames.length; i++) ...[
+      calls,
+      calls * 2000000,
+      2000000,
+      3000000,
+      calls * 1000,
+    ],
+    allocations,
+    bytes,
+  ];
+}
+
+void main() {
+  // ═══════════════════════════════════════════════════════════════════════════
+  // TESTS PARA PerformanceMetrics
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  group('PerformanceMetrics', () {
+    test('calcula fps y porcentajes', () {
+      final metrics = PerformanceMetrics(
+        frameNumber: 1,
+        totalMs: 50,
+        conversionMs: 10,
+        preprocessMs: 5,
+        inferenceMs: 30,
+        postprocessMs: 5,
+        detectionCount: 2,
+        timestamp: DateTime(2024),
+      );
+
+      expect(metrics.fps, 20);
+      expect(metrics.conversionPercent, 20);
+      expect(metrics.inferencePercent, 60);
+      expect(metrics.nativeStats, isNull);
+    });
+
+    test('toLogLines incluye las etapas nativas', () {
+      final metrics = PerformanceMetrics.empty().copyWith(
+        nativeStats: NativeStatsSnapshot.fromValues(_values()),
+      );
+
+      final lines = metrics.toLogLines();
+      expect(lines, contains('Native:'));
+      expect(lines.any((line) => line.contains('convert: 2.00ms')), isTrue);
+    });
+  });
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // TESTS PARA NativeStatsSnapshot
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  group('NativeStatsSnapshot', () {
+    test('length coincide con el formato de etapas', () {
+      expect(
+        NativeStatsSnapshot.length,
+        NativeStatsSnapshot.stageNames.length *
+                NativeStatsSnapshot.fieldsPerStage +
+            2,
+      );
+    });
+
+    test('fromValues asigna campos por etapa y globales', () {
+      final snapshot = NativeStatsSnapshot.fromValues(
+        _values(calls: 4, allocations: 3, bytes: 4096),
+      );
+
+      final convert = snapshot.stage('convert');
+      expect(convert.calls, 4);
+      expect(convert.totalNs, 8000000);
+      expect(convert.averageMs, 2.0);
+      expect(convert.maxMs, 3.0);
+      expect(convert.megabytesPerSecond, closeTo(0.5, 1e-9));
+      expect(snapshot.allocationCount, 3);
+      expect(snapshot.allocatedBytes, 4096);
+    });
+
+    test('fromValues rechaza arrays incompletos', () {
+      expect(
+        () => NativeStatsSnapshot.fromValues(const [1, 2, 3]),
+        throwsArgumentError,
+      );
+    });
+
+    test('since resta contadores acumulados', () {
+      final previous = NativeStatsSnapshot.fromValues(
+        _values(calls: 2, allocations: 1, bytes: 100),
+      );
+      final current = NativeStatsSnapshot.fromValues(
+        _values(calls: 5, allocations: 3, bytes: 300),
+      );
+
+      final delta = current.since(previous);
+      expect(delta.stage('nms').calls, 3);
+      expect(delta.stage('nms').totalNs, 6000000);
+      expect(delta.stage('nms').maxNs, 3000000);
+      expect(delta.allocationCount, 2);
+      expect(delta.allocatedBytes, 200);
+    });
+
+    test('toLogLines omite etapas sin llamadas', () {
+      final snapshot = NativeStatsSnapshot.fromValues(_values(calls: 0));
+
+      expect(snapshot.toLogLines(), hasLength(1));
+    });
+
+    test('igualdad por valor', () {
+      expect(
+        NativeStatsSnapshot.fromValues(_values()),
+        NativeStatsSnapshot.fromValues(_values()),
+      );
+    });
+  });
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // TESTS PARA NativeMemoryStats
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  group('NativeMemoryStats', () {
+    List<int> memoryValues({int budget = 0}) => [
+          6144, 8192, 5, 2, 1, budget,
+          for (var i = 0; i < NativeMemoryStats.arenaNames.length; i++) ...[
+            i == 1 ? 6144 : 0,
+            i == 1 ? 8192 : 0,
+            i == 1 ? 3 : 0,
+          ],
+        ];
+
+    test('length coincide con el formato de arenas', () {
+      expect(
+        NativeMemoryStats.length,
+        NativeMemoryStats.globalFields +
+            NativeMemoryStats.arenaNames.length *
+                NativeMemoryStats.fieldsPerArena,
+      );
+    });
+
+    test('fromValues asigna globales y arenas', () {
+      final stats = NativeMemoryStats.fromValues(memoryValues(budget: 16384));
+
+      expect(stats.currentBytes, 6144);
+      expect(stats.peakBytes, 8192);
+      expect(stats.allocations, 5);
+      expect(stats.frees, 2);
+      expect(stats.rejected, 1);
+      expect(stats.budgetBytes, 16384);
+      expect(stats.peakBudgetRatio, 0.5);
+      expect(stats.arenas['tensors']!.peakBytes, 8192);
+      expect(stats.arenas['tensors']!.allocations, 3);
+      expect(stats.arenas['frames']!.currentBytes, 0);
+    });
+
+    test('fromValues rechaza arrays incompletos', () {
+      expect(
+        () => NativeMemoryStats.fromValues(const [1, 2, 3]),
+        throwsArgumentError,
+      );
+    });
+
+    test('toLogLines omite arenas sin uso', () {
+      final stats = NativeMemoryStats.fromValues(memoryValues());
+
+      expect(stats.peakBudgetRatio, 0);
+      expect(stats.toLogLines(), hasLength(2));
+    });
+
+    test('igualdad por valor', () {
+      expect(
+        NativeMemoryStats.fromValues(memoryValues()),
+        NativeMemoryStats.fromValues(memoryValues()),
+      );
+    });
+  });
+}
@@ -9,6 +9,7 @@
 // ╚═══════════════════════════════════════════════════════════════════════════════╝
 
 import 'dart:io';
+import 'dart:typed_data';
 
 import 'package:flutter_test/flutter_test.dart';
 import 'package:image/image.dart' as img;
@@ -631,6 +632,42 @@ void main() {
       expect(low.length, greaterThanOrEqualTo(mid.length));
       expect(mid.length, greaterThanOrEqualTo(high.length));
     });
+
+    test('detectFromTensor acepta tensor de padding gris', () async {
+      const size = YoloDetector.inputSize;
+      final tensor = Float32List(size * size * 3)
+        ..fillRange(0, size * size * 3, 114.0 / 255.0);
+
+      final detections = await detector.detectFromTensor(
+        tensorBytes: tensor.buffer.asUint8List(),
+        scale: 1.0,
+        padLeft: 0,
+        padTop: 80,
+        newWidth: 640,
+        newHeight: 480,
+        imageWidth: 640,
+        imageHeight: 480,
+      );
+
+      expect(detections.length, lessThan(5),
+          reason: 'Tensor gris no debería generar muchas detecciones');
+    });
+
+    test('detectFromTensor rechaza tensor de tamaño inválido', () async {
+      expect(
+        () => detector.detectFromTensor(
+          tensorBytes: Uint8List(16),
+          scale: 1.0,
+          padLeft: 0,
+          padTop: 0,
+          newWidth: 640,
+          newHeight: 640,
+          imageWidth: 640,
+          imageHeight: 640,
+        ),
+        throwsA(isA<PreprocessingException>()),
+      );
+    });
   });
 
   // ═══════════════════════════════════════════════════════════════════════════